@@ -17,7 +17,6 @@
 
 #include "files.h"
 
-#include "../common/streamutil.h"
 #include "../resource/resources.h"
 
 #include "format/mp3reader.h"
@@ -43,22 +42,29 @@ shared_ptr<AudioStream> AudioFiles::doGet(string resRef) {
 
     shared_ptr<ByteArray> mp3Data(_resources.getRaw(resRef, ResourceType::Mp3, false));
     if (mp3Data) {
-        Mp3Reader mp3;
-        mp3.load(wrap(mp3Data));
-        result = mp3.stream();
+        result = load(move(mp3Data), ResourceType::Mp3);
     }
     if (!result) {
         shared_ptr<ByteArray> wavData(_resources.getRaw(resRef, ResourceType::Wav));
         if (wavData) {
-            WavReader wav;
-            wav.load(wrap(wavData));
-            result = wav.stream();
+            result = load(move(wavData), ResourceType::Wav);
         }
     }
 
     return move(result);
 }
 
+shared_ptr<AudioStream> AudioFiles::load(shared_ptr<ByteArray> data, ResourceType type) {
+    if (type == ResourceType::Mp3) {
+        Mp3Reader mp3;
+        mp3.load(move(data));
+        return mp3.stream();
+    }
+    WavReader wav;
+    wav.load(move(data));
+    return wav.stream();
+}
+
 } // namespace audio
 
 } // namespace reone
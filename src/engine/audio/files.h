@@ -18,6 +18,8 @@
 #pragma once
 
 #include "../common/cache.h"
+#include "../common/types.h"
+#include "../resource/types.h"
 
 namespace reone {
 
@@ -35,6 +37,13 @@ class AudioFiles : public MemoryCache<std::string, AudioStream> {
 public:
     AudioFiles(resource::Resources &resources);
 
+    /**
+     * Prepares an audio stream from MP3 or WAV data. Thread-safe.
+     *
+     * @param type either ResourceType::Mp3 or ResourceType::Wav
+     */
+    static std::shared_ptr<AudioStream> load(std::shared_ptr<ByteArray> data, resource::ResourceType type);
+
 private:
     resource::Resources &_resources;
 
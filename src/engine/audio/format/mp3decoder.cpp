@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2020-2021 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mp3decoder.h"
+
+#include "../sampleutil.h"
+
+using namespace std;
+
+namespace reone {
+
+namespace audio {
+
+static constexpr int kMinFrameSize = 32768; // bytes
+static constexpr int kMaxMp3FrameSize = 1152 * 2 * sizeof(int16_t); // bytes
+
+static_assert(sizeof(mad_fixed_t) == sizeof(int32_t) && MAD_F_FRACBITS == 28, "Unexpected libmad fixed-point format");
+
+Mp3Decoder::Mp3Decoder(shared_ptr<ByteArray> data, size_t offset) : _data(move(data)), _offset(offset) {
+    mad_stream_init(&_stream);
+    mad_frame_init(&_frame);
+    mad_synth_init(&_synth);
+
+    rewind();
+}
+
+Mp3Decoder::~Mp3Decoder() {
+    mad_synth_finish(&_synth);
+    mad_frame_finish(&_frame);
+    mad_stream_finish(&_stream);
+}
+
+void Mp3Decoder::rewind() {
+    size_t size = _offset < _data->size() ? _data->size() - _offset : 0;
+    mad_stream_buffer(&_stream, reinterpret_cast<const unsigned char *>(_data->data() + min(_offset, _data->size())), static_cast<unsigned long>(size));
+
+    // Reinitialize the frame to discard a header left over from seeking
+    mad_frame_finish(&_frame);
+    mad_frame_init(&_frame);
+    mad_synth_mute(&_synth);
+    _ended = false;
+    _pending = false;
+}
+
+void Mp3Decoder::seek(float time) {
+    rewind();
+
+    // Skip whole MP3 frames by parsing their headers only
+    mad_timer_t target = mad_timer_zero;
+    mad_timer_set(&target, 0, static_cast<unsigned long>(1000 * max(0.0f, time)), 1000);
+
+    mad_timer_t position = mad_timer_zero;
+    while (true) {
+        mad_timer_t next = position;
+        if (mad_header_decode(&_frame.header, &_stream) == -1) {
+            if (MAD_RECOVERABLE(_stream.error)) continue;
+            _ended = true;
+            break;
+        }
+        mad_timer_add(&next, _frame.header.duration);
+        if (mad_timer_compare(next, target) > 0) {
+            // Header is left incomplete, so that mad_frame_decode decodes this frame next
+            break;
+        }
+        position = next;
+    }
+}
+
+bool Mp3Decoder::decode(AudioStream::Frame &frame) {
+    frame.samples.clear();
+    frame.samples.reserve(kMinFrameSize + kMaxMp3FrameSize);
+
+    // Accumulate several MP3 frames per audio frame to keep the number of buffer updates low
+    while (static_cast<int>(frame.samples.size()) < kMinFrameSize) {
+        if (!_pending) {
+            if (_ended) break;
+            if (mad_frame_decode(&_frame, &_stream) == -1) {
+                if (MAD_RECOVERABLE(_stream.error)) continue;
+                _ended = true;
+                break;
+            }
+            mad_synth_frame(&_synth, &_frame);
+        }
+        const mad_pcm &pcm = _synth.pcm;
+        AudioFormat format = pcm.channels == 2 ? AudioFormat::Stereo16 : AudioFormat::Mono16;
+        if (!frame.samples.empty() && (frame.format != format || frame.sampleRate != static_cast<int>(pcm.samplerate))) {
+            // Format changed mid-stream: synthesized samples go into the next frame
+            _pending = true;
+            break;
+        }
+        frame.format = format;
+        frame.sampleRate = pcm.samplerate;
+        appendSamples(pcm, frame);
+        _pending = false;
+    }
+
+    return !frame.samples.empty();
+}
+
+void Mp3Decoder::appendSamples(const mad_pcm &pcm, AudioStream::Frame &frame) {
+    size_t offset = frame.samples.size();
+    size_t sampleCount = static_cast<size_t>(pcm.channels) * pcm.length;
+    frame.samples.resize(offset + sampleCount * sizeof(int16_t));
+
+    auto out = reinterpret_cast<int16_t *>(&frame.samples[offset]);
+    auto left = reinterpret_cast<const int32_t *>(pcm.samples[0]);
+    auto right = pcm.channels == 2 ? reinterpret_cast<const int32_t *>(pcm.samples[1]) : nullptr;
+    convertFixedToInt16(left, right, pcm.length, out);
+}
+
+} // namespace audio
+
+} // namespace reone
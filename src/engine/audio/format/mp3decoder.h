@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2020-2021 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "mad.h"
+
+#include "../../common/types.h"
+
+#include "../stream.h"
+
+namespace reone {
+
+namespace audio {
+
+/**
+ * Decodes MP3 data into 16-bit PCM frames on demand, using the low-level
+ * libmad API.
+ */
+class Mp3Decoder : public IAudioDecoder, boost::noncopyable {
+public:
+    /**
+     * @param data MP3 data, shared with other decoders of the same stream
+     * @param offset offset of the first MP3 frame in data
+     */
+    Mp3Decoder(std::shared_ptr<ByteArray> data, size_t offset = 0);
+    ~Mp3Decoder();
+
+    bool decode(AudioStream::Frame &frame) override;
+    void rewind() override;
+    void seek(float time) override;
+
+private:
+    std::shared_ptr<ByteArray> _data;
+    size_t _offset { 0 };
+    bool _ended { false };
+    bool _pending { false }; /**< synthesized samples have not been output yet */
+
+    mad_stream _stream;
+    mad_frame _frame;
+    mad_synth _synth;
+
+    void appendSamples(const mad_pcm &pcm, AudioStream::Frame &frame);
+};
+
+} // namespace audio
+
+} // namespace reone
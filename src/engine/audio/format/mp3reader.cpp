@@ -17,101 +17,49 @@
 
 #include "mp3reader.h"
 
+#include "mad.h"
+
 #include "../stream.h"
 
+#include "mp3decoder.h"
+
 using namespace std;
 
 namespace reone {
 
 namespace audio {
 
-static inline int scale(mad_fixed_t sample) {
-    // round
-    sample += (1L << (MAD_F_FRACBITS - 16));
-
-    // clip
-    if (sample >= MAD_F_ONE) {
-        sample = MAD_F_ONE - 1;
-    } else if (sample < -MAD_F_ONE) {
-        sample = -MAD_F_ONE;
-    }
-
-    // quantize
-    return sample >> (MAD_F_FRACBITS + 1 - 16);
-}
-
-void Mp3Reader::load(const shared_ptr<istream> &stream) {
-    stream->seekg(0, ios::end);
-    size_t size = stream->tellg();
+void Mp3Reader::load(shared_ptr<ByteArray> data, size_t offset) {
+    float duration = scanDuration(*data, offset);
 
-    ByteArray data(size);
-
-    stream->seekg(0);
-    stream->read(&data[0], size);
-
-    load(move(data));
+    _stream = make_shared<AudioStream>(
+        [data, offset]() { return make_unique<Mp3Decoder>(data, offset); },
+        duration);
 }
 
-void Mp3Reader::load(ByteArray &&data) {
-    _input = data;
-    _stream = make_shared<AudioStream>();
-
-    mad_decoder decoder;
-    mad_decoder_init(
-        &decoder,
-        this,
-        inputFunc,
-        headerFunc,
-        nullptr,
-        outputFunc,
-        nullptr,
-        nullptr);
-
-    mad_decoder_run(&decoder, MAD_DECODER_MODE_SYNC);
-    mad_decoder_finish(&decoder);
-}
+float Mp3Reader::scanDuration(const ByteArray &data, size_t offset) const {
+    if (offset >= data.size()) return 0.0f;
 
-mad_flow Mp3Reader::inputFunc(void *playbuf, mad_stream *stream) {
-    Mp3Reader *mp3 = reinterpret_cast<Mp3Reader *>(playbuf);
-    if (mp3->_done) {
-        return MAD_FLOW_BREAK;
-    }
-    mad_stream_buffer(stream, reinterpret_cast<unsigned char *>(&mp3->_input[0]), static_cast<int>(mp3->_input.size()));
-    mp3->_done = true;
+    mad_stream stream;
+    mad_header header;
+    mad_timer_t duration = mad_timer_zero;
 
-    return MAD_FLOW_CONTINUE;
-}
-
-mad_flow Mp3Reader::headerFunc(void *playbuf, mad_header const *header) {
-    return MAD_FLOW_CONTINUE;
-}
+    mad_stream_init(&stream);
+    mad_header_init(&header);
+    mad_stream_buffer(&stream, reinterpret_cast<const unsigned char *>(data.data() + offset), static_cast<unsigned long>(data.size() - offset));
 
-mad_flow Mp3Reader::outputFunc(void *playbuf, mad_header const *header, mad_pcm *pcm) {
-    Mp3Reader *mp3 = reinterpret_cast<Mp3Reader *>(playbuf);
-    unsigned short sampleCount = pcm->length;
-    mad_fixed_t *chLeft = pcm->samples[0];
-    mad_fixed_t *chRight = pcm->samples[1];
-
-    AudioStream::Frame frame;
-    frame.format = pcm->channels == 2 ? AudioFormat::Stereo16 : AudioFormat::Mono16;
-    frame.sampleRate = pcm->samplerate;
-    frame.samples.reserve(static_cast<uint64_t>(pcm->channels) * sampleCount * sizeof(int16_t));
-
-    while (sampleCount--) {
-        int sample = scale(*chLeft++);
-        frame.samples.push_back((sample >> 0) & 0xff);
-        frame.samples.push_back((sample >> 8) & 0xff);
-
-        if (pcm->channels == 2) {
-            sample = scale(*chRight++);
-            frame.samples.push_back((sample >> 0) & 0xff);
-            frame.samples.push_back((sample >> 8) & 0xff);
+    while (true) {
+        if (mad_header_decode(&header, &stream) == -1) {
+            if (MAD_RECOVERABLE(stream.error)) continue;
+            break;
         }
+        mad_timer_add(&duration, header.duration);
     }
 
-    mp3->_stream->add(move(frame));
+    mad_header_finish(&header);
+    mad_stream_finish(&stream);
 
-    return MAD_FLOW_CONTINUE;
+    return mad_timer_count(duration, MAD_UNITS_MILLISECONDS) / 1000.0f;
 }
 
 } // namespace audio
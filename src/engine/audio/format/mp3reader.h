@@ -17,8 +17,6 @@
 
 #pragma once
 
-#include "mad.h"
-
 #include "../../common/types.h"
 
 namespace reone {
@@ -27,21 +25,25 @@ namespace audio {
 
 class AudioStream;
 
+/**
+ * Prepares a streaming AudioStream from MP3 data. Only frame headers are
+ * parsed here, to compute the stream duration; samples are decoded on
+ * demand by Mp3Decoder.
+ */
 class Mp3Reader : boost::noncopyable {
 public:
-    void load(const std::shared_ptr<std::istream> &stream);
-    void load(ByteArray &&data);
+    /**
+     * @param data MP3 data
+     * @param offset offset of the first MP3 frame in data
+     */
+    void load(std::shared_ptr<ByteArray> data, size_t offset = 0);
 
     std::shared_ptr<AudioStream> stream() const { return _stream; }
 
 private:
-    ByteArray _input;
     std::shared_ptr<AudioStream> _stream;
-    bool _done { false };
 
-    static mad_flow inputFunc(void *playbuf, mad_stream *stream);
-    static mad_flow headerFunc(void *playbuf, mad_header const *header);
-    static mad_flow outputFunc(void *playbuf, mad_header const *header, mad_pcm *pcm);
+    float scanDuration(const ByteArray &data, size_t offset) const;
 };
 
 } // namespace audio
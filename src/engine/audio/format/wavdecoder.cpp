@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) 2020-2021 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "wavdecoder.h"
+
+using namespace std;
+
+namespace reone {
+
+namespace audio {
+
+static constexpr int kMinFrameSize = 32768; // bytes
+
+static constexpr int kIMAIndexTable[] = { -1, -1, -1, -1, 2, 4, 6, 8 };
+
+static constexpr int kIMAStepTable[] = {
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17,
+    19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+    50, 55, 60, 66, 73, 80, 88, 97, 107, 118,
+    130, 143, 157, 173, 190, 209, 230, 253, 279, 307,
+    337, 371, 408, 449, 494, 544, 598, 658, 724, 796,
+    876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066,
+    2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358,
+    5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899,
+    15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+};
+
+struct IMAState {
+    int sample { 0 };
+    int stepIndex { 0 };
+};
+
+static inline int16_t decodeIMANibble(IMAState &state, uint8_t nibble) {
+    int step = (2 * (nibble & 0x7) + 1) * kIMAStepTable[state.stepIndex] / 8;
+    int diff = nibble & 0x8 ? -step : step;
+
+    state.sample = min(max(state.sample + diff, -32768), 32767);
+    state.stepIndex = min(max(state.stepIndex + kIMAIndexTable[nibble & 0x7], 0), 88);
+
+    return static_cast<int16_t>(state.sample);
+}
+
+static size_t getIMABlockSampleCount(size_t blockSize, int channelCount) {
+    // Every channel has a 4-byte header, followed by interleaved groups of 4 bytes per channel, 8 samples each
+    size_t headerSize = 4ll * channelCount;
+    if (blockSize < headerSize) return 0;
+
+    return 8 * ((blockSize - headerSize) / headerSize);
+}
+
+WavDecoder::WavDecoder(shared_ptr<ByteArray> data, size_t offset, size_t size, WavFormat format) :
+    _data(move(data)),
+    _offset(offset),
+    _size(size),
+    _format(move(format)) {
+
+    if (_offset + _size > _data->size()) {
+        throw out_of_range("WAV: sample data out of range");
+    }
+    if (_format.blockAlign == 0) {
+        throw invalid_argument("WAV: invalid block align");
+    }
+    _audioFormat = getAudioFormat(_format);
+}
+
+void WavDecoder::rewind() {
+    _position = 0;
+}
+
+void WavDecoder::seek(float time) {
+    size_t sample = static_cast<size_t>(max(0.0f, time) * _format.sampleRate);
+    size_t block;
+    switch (_format.audioFormat) {
+        case WavAudioFormat::IMAADPCM: {
+            size_t blockSamples = max<size_t>(getIMABlockSampleCount(_format.blockAlign, _format.channelCount), 1);
+            block = sample / blockSamples;
+            break;
+        }
+        default:
+            block = sample;
+            break;
+    }
+    _position = min(block * _format.blockAlign, _size);
+}
+
+bool WavDecoder::decode(AudioStream::Frame &frame) {
+    frame.format = _audioFormat;
+    frame.sampleRate = _format.sampleRate;
+    frame.samples.clear();
+
+    if (_position >= _size) return false;
+
+    switch (_format.audioFormat) {
+        case WavAudioFormat::PCM:
+            decodePCM(frame);
+            break;
+        case WavAudioFormat::IMAADPCM:
+            decodeIMAADPCM(frame);
+            break;
+    }
+
+    return !frame.samples.empty();
+}
+
+void WavDecoder::decodePCM(AudioStream::Frame &frame) {
+    size_t chunkSize = max<size_t>(kMinFrameSize - kMinFrameSize % _format.blockAlign, _format.blockAlign);
+    size_t size = min(chunkSize, _size - _position);
+
+    const char *begin = _data->data() + _offset + _position;
+    frame.samples.assign(begin, begin + size);
+
+    _position += size;
+}
+
+void WavDecoder::decodeIMAADPCM(AudioStream::Frame &frame) {
+    int channelCount = _format.channelCount;
+    size_t blockSamples = getIMABlockSampleCount(_format.blockAlign, channelCount) * channelCount;
+    size_t blockOutputSize = max<size_t>(blockSamples * sizeof(int16_t), 1);
+    size_t blockCount = (kMinFrameSize + blockOutputSize - 1) / blockOutputSize;
+
+    frame.samples.resize(blockCount * blockSamples * sizeof(int16_t));
+    auto out = reinterpret_cast<int16_t *>(&frame.samples[0]);
+    size_t sampleCount = 0;
+
+    for (size_t i = 0; i < blockCount && _position < _size; ++i) {
+        size_t blockSize = min<size_t>(_format.blockAlign, _size - _position);
+        auto block = reinterpret_cast<const uint8_t *>(_data->data() + _offset + _position);
+        sampleCount += decodeIMABlock(block, blockSize, out + sampleCount);
+        _position += blockSize;
+    }
+
+    frame.samples.resize(sampleCount * sizeof(int16_t));
+}
+
+int WavDecoder::decodeIMABlock(const uint8_t *block, size_t blockSize, int16_t *out) const {
+    int channelCount = _format.channelCount;
+    size_t groupCount = getIMABlockSampleCount(blockSize, channelCount) / 8;
+    if (groupCount == 0) return 0;
+
+    // Decoder state is reset by the header of every block
+    IMAState state[2];
+    for (int i = 0; i < channelCount; ++i) {
+        state[i].sample = static_cast<int16_t>(block[4 * i + 0] | (block[4 * i + 1] << 8));
+        state[i].stepIndex = min(max<int>(static_cast<int16_t>(block[4 * i + 2] | (block[4 * i + 3] << 8)), 0), 88);
+    }
+    const uint8_t *in = block + 4 * channelCount;
+
+    for (size_t group = 0; group < groupCount; ++group) {
+        // Each group contains 4 bytes (8 samples) per channel, which are interleaved on output
+        for (int i = 0; i < channelCount; ++i) {
+            IMAState &channelState = state[i];
+            int16_t *channelOut = out + i;
+            for (int j = 0; j < 4; ++j) {
+                uint8_t nibbles = *in++;
+                channelOut[channelCount * (2 * j + 0)] = decodeIMANibble(channelState, nibbles & 0xf);
+                channelOut[channelCount * (2 * j + 1)] = decodeIMANibble(channelState, nibbles >> 4);
+            }
+        }
+        out += 8 * channelCount;
+    }
+
+    return static_cast<int>(8 * channelCount * groupCount);
+}
+
+size_t WavDecoder::getSampleCount(size_t size, const WavFormat &format) {
+    switch (format.audioFormat) {
+        case WavAudioFormat::PCM:
+            return size / format.blockAlign;
+        case WavAudioFormat::IMAADPCM:
+            return (size / format.blockAlign) * getIMABlockSampleCount(format.blockAlign, format.channelCount) +
+                getIMABlockSampleCount(size % format.blockAlign, format.channelCount);
+        default:
+            return 0;
+    }
+}
+
+AudioFormat WavDecoder::getAudioFormat(const WavFormat &format) {
+    switch (format.audioFormat) {
+        case WavAudioFormat::PCM:
+            switch (format.bitsPerSample) {
+                case 16:
+                    return format.channelCount == 2 ? AudioFormat::Stereo16 : AudioFormat::Mono16;
+                case 8:
+                    return format.channelCount == 2 ? AudioFormat::Stereo8 : AudioFormat::Mono8;
+                default:
+                    throw logic_error("WAV: PCM: invalid bits per sample: " + to_string(format.bitsPerSample));
+            }
+        case WavAudioFormat::IMAADPCM:
+            if (format.bitsPerSample != 4) {
+                throw logic_error("WAV: IMA ADPCM: invalid bits per sample: " + to_string(format.bitsPerSample));
+            }
+            return format.channelCount == 2 ? AudioFormat::Stereo16 : AudioFormat::Mono16;
+        default:
+            throw logic_error("WAV: invalid audio format: " + to_string(static_cast<int>(format.audioFormat)));
+    }
+}
+
+} // namespace audio
+
+} // namespace reone
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2020-2021 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "../../common/types.h"
+
+#include "../stream.h"
+
+namespace reone {
+
+namespace audio {
+
+enum class WavAudioFormat {
+    PCM = 1,
+    IMAADPCM = 0x11
+};
+
+struct WavFormat {
+    WavAudioFormat audioFormat { WavAudioFormat::PCM };
+    uint16_t channelCount { 0 };
+    uint32_t sampleRate { 0 };
+    uint16_t blockAlign { 0 };
+    uint16_t bitsPerSample { 0 };
+};
+
+/**
+ * Decodes PCM and IMA ADPCM WAV data on demand. PCM samples are copied in
+ * large block-aligned chunks, ADPCM is decoded a whole number of blocks at
+ * a time.
+ */
+class WavDecoder : public IAudioDecoder, boost::noncopyable {
+public:
+    /**
+     * @param data WAV file data, shared with other decoders of the same stream
+     * @param offset offset of the sample data in data
+     * @param size size of the sample data
+     * @param format format of the sample data
+     */
+    WavDecoder(std::shared_ptr<ByteArray> data, size_t offset, size_t size, WavFormat format);
+
+    bool decode(AudioStream::Frame &frame) override;
+    void rewind() override;
+    void seek(float time) override;
+
+    /**
+     * @return number of samples per channel, stored in size bytes of data in the specified format
+     */
+    static size_t getSampleCount(size_t size, const WavFormat &format);
+
+    static AudioFormat getAudioFormat(const WavFormat &format);
+
+private:
+    std::shared_ptr<ByteArray> _data;
+    size_t _offset { 0 };
+    size_t _size { 0 };
+    WavFormat _format;
+    AudioFormat _audioFormat { AudioFormat::Mono8 };
+    size_t _position { 0 }; /**< position relative to offset */
+
+    void decodePCM(AudioStream::Frame &frame);
+    void decodeIMAADPCM(AudioStream::Frame &frame);
+    int decodeIMABlock(const uint8_t *block, size_t blockSize, int16_t *out) const;
+};
+
+} // namespace audio
+
+} // namespace reone
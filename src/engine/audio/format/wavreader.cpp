@@ -32,6 +32,11 @@ namespace audio {
 WavReader::WavReader() : BinaryReader(0) {
 }
 
+void WavReader::load(shared_ptr<ByteArray> data) {
+    _data = data;
+    BinaryReader::load(wrap(data));
+}
+
 void WavReader::doLoad() {
     string sign(readString(4));
     if (sign == "\xff\xf3\x60\xc4") {
@@ -71,159 +76,54 @@ bool WavReader::readChunkHeader(ChunkHeader &chunk) {
 }
 
 void WavReader::loadFormat(ChunkHeader chunk) {
-    _audioFormat = static_cast<WavAudioFormat>(readUint16());
-    if (_audioFormat != WavAudioFormat::PCM && _audioFormat != WavAudioFormat::IMAADPCM) {
-        throw runtime_error("WAV: unsupported audio format: " + to_string(static_cast<int>(_audioFormat)));
+    _format.audioFormat = static_cast<WavAudioFormat>(readUint16());
+    if (_format.audioFormat != WavAudioFormat::PCM && _format.audioFormat != WavAudioFormat::IMAADPCM) {
+        throw runtime_error("WAV: unsupported audio format: " + to_string(static_cast<int>(_format.audioFormat)));
     }
-    _channelCount = readUint16();
-    if (_channelCount != 1 && _channelCount != 2) {
-        throw runtime_error("WAV: invalid number of channels: " + to_string(_channelCount));
+    _format.channelCount = readUint16();
+    if (_format.channelCount != 1 && _format.channelCount != 2) {
+        throw runtime_error("WAV: invalid number of channels: " + to_string(_format.channelCount));
     }
-    _sampleRate = readUint32();
+    _format.sampleRate = readUint32();
 
     uint32_t byteRate = readUint32();
 
-    _blockAlign = readUint16();
-    _bitsPerSample = readUint16();
+    _format.blockAlign = readUint16();
+    _format.bitsPerSample = readUint16();
 
-    if (_bitsPerSample != 4 && _bitsPerSample != 8 && _bitsPerSample != 16) {
-        throw runtime_error("WAV: invalid bits per sample: " + to_string(_bitsPerSample));
+    if (_format.bitsPerSample != 4 && _format.bitsPerSample != 8 && _format.bitsPerSample != 16) {
+        throw runtime_error("WAV: invalid bits per sample: " + to_string(_format.bitsPerSample));
     }
 
     ignore(chunk.size - 16);
 }
 
 void WavReader::loadData(ChunkHeader chunk) {
-    if (chunk.size == 0) {
-        size_t pos = tell();
-        ByteArray data(_reader->getBytes(static_cast<int>(_size - pos)));
+    size_t offset = tell();
 
+    if (chunk.size == 0) {
         Mp3Reader mp3;
-        mp3.load(move(data));
+        mp3.load(_data, offset);
         _stream = mp3.stream();
-
         return;
     }
 
-    switch (_audioFormat) {
-        case WavAudioFormat::PCM:
-            loadPCM(chunk.size);
-            break;
-        case WavAudioFormat::IMAADPCM:
-            loadIMAADPCM(chunk.size);
-            break;
+    if (_format.blockAlign == 0 ||
+        (_format.audioFormat == WavAudioFormat::IMAADPCM && _format.blockAlign <= 4 * _format.channelCount)) {
+        throw runtime_error("WAV: invalid block align: " + to_string(_format.blockAlign));
     }
-}
-
-void WavReader::loadPCM(uint32_t chunkSize) {
-    ByteArray data(_reader->getBytes(chunkSize));
-
-    AudioStream::Frame frame;
-    frame.format = getAudioFormat();
-    frame.sampleRate = _sampleRate;
-    frame.samples.resize(chunkSize);
-    frame.samples = move(data);
-
-    _stream = make_shared<AudioStream>();
-    _stream->add(move(frame));
-}
-
-static constexpr int kIMAIndexTable[] = { -1, -1, -1, -1, 2, 4, 6, 8 };
-
-static constexpr int kIMAStepTable[] = {
-    7, 8, 9, 10, 11, 12, 13, 14, 16, 17,
-    19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
-    50, 55, 60, 66, 73, 80, 88, 97, 107, 118,
-    130, 143, 157, 173, 190, 209, 230, 253, 279, 307,
-    337, 371, 408, 449, 494, 544, 598, 658, 724, 796,
-    876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066,
-    2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358,
-    5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899,
-    15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
-};
-
-void WavReader::loadIMAADPCM(uint32_t chunkSize) {
-    ByteArray chunk(_reader->getBytes(chunkSize));
-
-    AudioStream::Frame frame;
-    frame.format = getAudioFormat();
-    frame.sampleRate = _sampleRate;
-    frame.samples.reserve(2 * (chunkSize - 4 * _channelCount * chunkSize / _blockAlign));
-
-    uint32_t off = 0;
-    while (off < chunkSize) {
-        if (off % _blockAlign == 0) {
-            for (int i = 0; i < _channelCount; ++i) {
-                _ima[i].lastSample = *reinterpret_cast<int16_t *>(&chunk[off + 0]);
-                _ima[i].stepIndex = *reinterpret_cast<int16_t *>(&chunk[off + 2]);
-                off += 4;
-            }
-        }
-        int16_t samples[16];
-        for (int i = 0; i < _channelCount; ++i) {
-            for (int j = 0; j < 4; ++j) {
-                int idx = 8 * i + 2 * j;
-                getIMASamples(i, chunk[off++], samples[idx + 0], samples[idx + 1]);
-            }
-        }
-        if (_channelCount == 2) {
-            for (int i = 0; i < 8; ++i) {
-                frame.samples.push_back((samples[i + 0] >> 0) & 0xff);
-                frame.samples.push_back((samples[i + 0] >> 8) & 0xff);
-                frame.samples.push_back((samples[i + 8] >> 0) & 0xff);
-                frame.samples.push_back((samples[i + 8] >> 8) & 0xff);
-            }
-        } else {
-            for (int i = 0; i < 8; ++i) {
-                frame.samples.push_back((samples[i] >> 0) & 0xff);
-                frame.samples.push_back((samples[i] >> 8) & 0xff);
-            }
-        }
-    }
-
-    _stream = make_shared<AudioStream>();
-    _stream->add(move(frame));
-}
-
-AudioFormat WavReader::getAudioFormat() const {
-    switch (_audioFormat) {
-        case WavAudioFormat::PCM:
-            switch (_bitsPerSample) {
-                case 16:
-                    return _channelCount == 2 ? AudioFormat::Stereo16 : AudioFormat::Mono16;
-                case 8:
-                    return _channelCount == 2 ? AudioFormat::Stereo8 : AudioFormat::Mono8;
-                default:
-                    throw logic_error("WAV: PCM: invalid bits per sample: " + to_string(_bitsPerSample));
-            }
-        case WavAudioFormat::IMAADPCM:
-            if (_bitsPerSample != 4) {
-                throw logic_error("WAV: IMA ADPCM: invalid bits per sample: " + to_string(_bitsPerSample));
-            }
-            return _channelCount == 2 ? AudioFormat::Stereo16 : AudioFormat::Mono16;
-        default:
-            throw logic_error("WAV: invalid audio format: " + to_string(static_cast<int>(_audioFormat)));
-
-    }
-}
-
-void WavReader::getIMASamples(int channel, uint8_t nibbles, int16_t &sample1, int16_t &sample2) {
-    uint8_t n1 = (nibbles >> 0) & 0xf;
-    uint8_t n2 = (nibbles >> 4) & 0xf;
-
-    sample1 = getIMASample(channel, n1);
-    sample2 = getIMASample(channel, n2);
-}
+    WavDecoder::getAudioFormat(_format); // throws if the format is not supported
 
-int16_t WavReader::getIMASample(int channel, uint8_t nibble) {
-    int step = (2 * (nibble & 0x7) + 1) * kIMAStepTable[_ima[channel].stepIndex] / 8;
-    int diff = nibble & 0x8 ? -step : step;
-    int sample = min(max(_ima[channel].lastSample + diff, -32768), 32767);
+    size_t size = min<size_t>(chunk.size, _size - offset);
+    size -= size % (_format.audioFormat == WavAudioFormat::PCM ? _format.blockAlign : 1);
 
-    _ima[channel].lastSample = sample;
-    _ima[channel].stepIndex = min(max(_ima[channel].stepIndex + kIMAIndexTable[nibble & 0x7], 0), 88);
+    float duration = WavDecoder::getSampleCount(size, _format) / static_cast<float>(_format.sampleRate);
+    shared_ptr<ByteArray> data(_data);
+    WavFormat format(_format);
 
-    return sample;
+    _stream = make_shared<AudioStream>(
+        [data, offset, size, format]() { return make_unique<WavDecoder>(data, offset, size, format); },
+        duration);
 }
 
 } // namespace audio
@@ -21,21 +21,25 @@
 
 #include "../types.h"
 
+#include "wavdecoder.h"
+
 namespace reone {
 
 namespace audio {
 
-enum class WavAudioFormat {
-    PCM = 1,
-    IMAADPCM = 0x11
-};
-
 class AudioStream;
 
+/**
+ * Parses WAV headers and prepares a streaming AudioStream. Sample data is
+ * decoded on demand by WavDecoder, or by Mp3Decoder for MP3 data wrapped
+ * in a WAV container.
+ */
 class WavReader : public resource::BinaryReader {
 public:
     WavReader();
 
+    void load(std::shared_ptr<ByteArray> data);
+
     std::shared_ptr<AudioStream> stream() const { return _stream; }
 
 private:
@@ -44,30 +48,15 @@ private:
         uint32_t size { 0 };
     };
 
-    struct IMA {
-        int16_t lastSample { 0 };
-        int16_t stepIndex { 0 };
-    };
-
-    WavAudioFormat _audioFormat { WavAudioFormat::PCM };
-    uint16_t _channelCount { 0 };
-    uint32_t _sampleRate { 0 };
-    uint16_t _blockAlign { 0 };
-    uint16_t _bitsPerSample { 0 };
-    IMA _ima[2];
+    std::shared_ptr<ByteArray> _data;
+    WavFormat _format;
     std::shared_ptr<AudioStream> _stream;
 
     void doLoad() override;
 
-    int16_t getIMASample(int channel, uint8_t nibble);
-    void getIMASamples(int channel, uint8_t nibbles, int16_t &sample1, int16_t &sample2);
     void loadData(ChunkHeader chunk);
     void loadFormat(ChunkHeader chunk);
-    void loadIMAADPCM(uint32_t chunkSize);
-    void loadPCM(uint32_t chunkSize);
     bool readChunkHeader(ChunkHeader &chunk);
-
-    AudioFormat getAudioFormat() const;
 };
 
 } // namespace audio
@@ -33,6 +33,12 @@ namespace audio {
 static constexpr float kMaxPositionalSoundDistance = 16.0f;
 static constexpr float kMaxPositionalSoundDistance2 = kMaxPositionalSoundDistance * kMaxPositionalSoundDistance;
 
+static constexpr float kMinUpdateInterval = 0.002f; // seconds
+static constexpr float kMaxUpdateInterval = 0.1f; // seconds
+
+static constexpr int kVoiceCount = 32;
+static constexpr int kBuffersPerVoice = 4;
+
 AudioPlayer::AudioPlayer(AudioOptions opts, AudioFiles &files) : _opts(move(opts)), _files(files) {
 }
 
@@ -42,33 +48,153 @@ void AudioPlayer::init() {
 
 void AudioPlayer::threadStart() {
     initAL();
+    _voices.init(kVoiceCount, kBuffersPerVoice);
+    _lastUpdate = chrono::steady_clock::now();
 
-    vector<shared_ptr<SoundInstance>> sounds;
     while (_run) {
-        {
-            lock_guard<recursive_mutex> lock(_soundsMutex);
-            auto maybeSounds = remove_if(
-                _sounds.begin(), _sounds.end(),
-                [](auto &sound) { return sound->handle()->isStopped(); });
-
-            _sounds.erase(maybeSounds, _sounds.end());
-            sounds = _sounds;
-        }
-        if (_listenerPositionDirty) {
-            glm::vec3 position(_listenerPosition.load());
-            alListener3f(AL_POSITION, position.x, position.y, position.z);
-            _listenerPositionDirty = false;
+        // Batch state changes of all sounds into a single OpenAL update
+        alcSuspendContext(_context);
+        _commands.consume([this](const Command &command) { applyCommand(command); });
+        updateSounds();
+        alcProcessContext(_context);
+
+        waitForCommands();
+    }
+
+    // Release sounds while the OpenAL context is still current
+    _commands.consume([](const Command &) {});
+    _sounds.clear();
+    _soundsByRank.clear();
+    _voices.deinit();
+
+    deinitAL();
+}
+
+void AudioPlayer::applyCommand(const Command &command) {
+    switch (command.type) {
+        case Command::Type::Play:
+            if (command.sound->handle()->isStopped()) break;
+            command.sound->init();
+            _sounds.push_back(command.sound);
+            break;
+        case Command::Type::Stop:
+            command.sound->stop();
+            break;
+        case Command::Type::SetPosition:
+            command.sound->setPosition(command.position);
+            break;
+        case Command::Type::SetListenerPosition:
+            alListener3f(AL_POSITION, command.position.x, command.position.y, command.position.z);
+            _currentListenerPosition = command.position;
+            break;
+        default:
+            break;
+    }
+}
+
+void AudioPlayer::updateSounds() {
+    auto now = chrono::steady_clock::now();
+    float dt = chrono::duration<float>(now - _lastUpdate).count();
+    _lastUpdate = now;
+
+    for (auto &sound : _sounds) {
+        sound->update(dt);
+    }
+    auto maybeSounds = remove_if(
+        _sounds.begin(), _sounds.end(),
+        [this](auto &sound) {
+            if (!sound->handle()->isStopped()) return false;
+            _voices.release(sound->virtualize());
+            return true;
+        });
+
+    _sounds.erase(maybeSounds, _sounds.end());
+
+    assignVoices();
+}
+
+void AudioPlayer::assignVoices() {
+    _soundsByRank.clear();
+    for (auto &sound : _sounds) {
+        _soundsByRank.push_back(make_pair(sound.get(), getAudibility(*sound)));
+    }
+    sort(_soundsByRank.begin(), _soundsByRank.end(), [](auto &left, auto &right) {
+        int leftPriority = left.first->priority();
+        int rightPriority = right.first->priority();
+
+        if (leftPriority < rightPriority) return true;
+        if (leftPriority > rightPriority) return false;
+
+        return left.second > right.second;
+    });
+
+    // Audible sounds of the highest rank get voices, the rest become virtual.
+    // Voices are released first, so that they can be stolen by higher-ranked sounds.
+    int voiceCount = _voices.size();
+    int audibleCount = 0;
+    for (auto &sound : _soundsByRank) {
+        bool real = sound.second > 0.0f && audibleCount < voiceCount;
+        if (real) {
+            ++audibleCount;
+        } else if (sound.first->isReal()) {
+            _voices.release(sound.first->virtualize());
         }
-        for (auto &sound : sounds) {
-            if (sound->handle()->isNotInited()) {
-                sound->init();
-            }
-            sound->update();
+    }
+    for (int i = 0, count = 0; i < static_cast<int>(_soundsByRank.size()) && count < audibleCount; ++i) {
+        SoundInstance &sound = *_soundsByRank[i].first;
+        if (_soundsByRank[i].second <= 0.0f) continue;
+
+        ++count;
+        if (sound.isReal()) continue;
+
+        Voice *voice = _voices.acquire();
+        if (!voice) break;
+
+        if (!sound.realize(*voice)) {
+            _voices.release(voice);
         }
-        this_thread::yield();
     }
+}
 
-    deinitAL();
+float AudioPlayer::getAudibility(const SoundInstance &sound) const {
+    if (!sound.isPositional()) return sound.gain();
+
+    // Approximates the OpenAL inverse distance clamped model with default parameters
+    float distance2 = glm::distance2(_currentListenerPosition, sound.position());
+    if (distance2 > kMaxPositionalSoundDistance2) return 0.0f;
+
+    return sound.gain() / glm::max(1.0f, glm::sqrt(distance2));
+}
+
+void AudioPlayer::waitForCommands() {
+    unique_lock<mutex> lock(_wakeMutex);
+    auto hasWork = [this]() { return !_run || !_commands.empty(); };
+
+    // Without playing sounds, there is nothing to do until the next command
+    if (_sounds.empty()) {
+        _wakeCondVar.wait(lock, hasWork);
+        return;
+    }
+    float interval = kMaxUpdateInterval;
+    for (auto &sound : _sounds) {
+        interval = min(interval, sound->updateInterval());
+    }
+    interval = max(interval, kMinUpdateInterval);
+
+    _wakeCondVar.wait_for(lock, chrono::microseconds(static_cast<int64_t>(1000000 * interval)), hasWork);
+}
+
+void AudioPlayer::post(Command command) {
+    // Without the audio thread, commands would never be consumed
+    if (_opts.headless) return;
+
+    _commands.push(move(command));
+
+    // Synchronize with the audio thread, so that the notification is not lost between its check and wait
+    {
+        lock_guard<mutex> lock(_wakeMutex);
+    }
+    _wakeCondVar.notify_one();
 }
 
 void AudioPlayer::initAL() {
@@ -101,19 +227,25 @@ AudioPlayer::~AudioPlayer() {
 
 void AudioPlayer::deinit() {
     _run = false;
+    {
+        lock_guard<mutex> lock(_wakeMutex);
+    }
+    _wakeCondVar.notify_one();
 
     if (_thread.joinable()) {
         _thread.join();
     }
 }
 
-shared_ptr<SoundHandle> AudioPlayer::play(const string &resRef, AudioType type, bool loop, float gain, bool positional, glm::vec3 position) {
+shared_ptr<SoundHandle> AudioPlayer::play(const string &resRef, AudioType type, bool loop, float gain, bool positional, glm::vec3 position, int priority) {
+    if (_opts.headless) return nullptr;
+
     shared_ptr<AudioStream> stream(_files.get(resRef));
     if (!stream) {
         warn("AudioPlayer: file not found: " + resRef);
         return nullptr;
     }
-    auto sound = make_shared<SoundInstance>(stream, loop, getGain(type, gain), positional, move(position));
+    auto sound = make_shared<SoundInstance>(stream, loop, getGain(type, gain), positional, move(position), getPriority(type, priority));
     enqueue(sound);
     return sound->handle();
 }
@@ -140,15 +272,43 @@ float AudioPlayer::getGain(AudioType type, float gain) const {
     return gain * (volume / 100.0f);
 }
 
+int AudioPlayer::getPriority(AudioType type, int priority) const {
+    // Music, voice-over and movie audio are never made virtual in favor of sound effects
+    return type == AudioType::Sound ? priority : INT_MIN;
+}
+
 void AudioPlayer::enqueue(const shared_ptr<SoundInstance> &sound) {
-    lock_guard<recursive_mutex> lock(_soundsMutex);
-    _sounds.push_back(sound);
+    weak_ptr<SoundInstance> weakSound(sound);
+    sound->handle()->setCallbacks(
+        [this, weakSound]() {
+            shared_ptr<SoundInstance> sound(weakSound.lock());
+            if (!sound) return;
+            Command command;
+            command.type = Command::Type::Stop;
+            command.sound = move(sound);
+            post(move(command));
+        },
+        [this, weakSound](glm::vec3 position) {
+            shared_ptr<SoundInstance> sound(weakSound.lock());
+            if (!sound) return;
+            Command command;
+            command.type = Command::Type::SetPosition;
+            command.sound = move(sound);
+            command.position = move(position);
+            post(move(command));
+        });
+
+    Command command;
+    command.type = Command::Type::Play;
+    command.sound = sound;
+    post(move(command));
 }
 
-shared_ptr<SoundHandle> AudioPlayer::play(const shared_ptr<AudioStream> &stream, AudioType type, bool loop, float gain, bool positional, glm::vec3 position) {
+shared_ptr<SoundHandle> AudioPlayer::play(const shared_ptr<AudioStream> &stream, AudioType type, bool loop, float gain, bool positional, glm::vec3 position, int priority) {
+    if (_opts.headless) return nullptr;
     if (positional && glm::distance2(_listenerPosition.load(), position) > kMaxPositionalSoundDistance2) return nullptr;
 
-    auto sound = make_shared<SoundInstance>(stream, loop, getGain(type, gain), positional, move(position));
+    auto sound = make_shared<SoundInstance>(stream, loop, getGain(type, gain), positional, move(position), getPriority(type, priority));
     enqueue(sound);
 
     return sound->handle();
@@ -157,7 +317,11 @@ shared_ptr<SoundHandle> AudioPlayer::play(const shared_ptr<AudioStream> &stream,
 void AudioPlayer::setListenerPosition(const glm::vec3 &position) {
     if (_listenerPosition.load() != position) {
         _listenerPosition = position;
-        _listenerPositionDirty = true;
+
+        Command command;
+        command.type = Command::Type::SetListenerPosition;
+        command.position = position;
+        post(move(command));
     }
 }
 
@@ -17,8 +17,13 @@
 
 #pragma once
 
+#include <condition_variable>
+
+#include "../common/mpscqueue.h"
+
 #include "options.h"
 #include "types.h"
+#include "voicepool.h"
 
 namespace reone {
 
@@ -37,8 +42,16 @@ public:
     void init();
     void deinit();
 
-    std::shared_ptr<SoundHandle> play(const std::string &resRef, AudioType type, bool loop = false, float gain = 1.0f, bool positional = false, glm::vec3 position = glm::vec3(0.0f));
-    std::shared_ptr<SoundHandle> play(const std::shared_ptr<AudioStream> &stream, AudioType type, bool loop = false, float gain = 1.0f, bool positional = false, glm::vec3 position = glm::vec3(0.0f));
+    /**
+     * Starts playing the sound. When there are more sounds than voices,
+     * sounds with lower priority and lower audibility become virtual.
+     * Does nothing and returns nullptr in headless mode.
+     *
+     * @param priority sound priority, lower values meaning higher priority. Only applies to AudioType::Sound
+     */
+    std::shared_ptr<SoundHandle> play(const std::string &resRef, AudioType type, bool loop = false, float gain = 1.0f, bool positional = false, glm::vec3 position = glm::vec3(0.0f), int priority = 0);
+
+    std::shared_ptr<SoundHandle> play(const std::shared_ptr<AudioStream> &stream, AudioType type, bool loop = false, float gain = 1.0f, bool positional = false, glm::vec3 position = glm::vec3(0.0f), int priority = 0);
 
     void setListenerPosition(const glm::vec3 &position);
 
@@ -46,23 +59,58 @@ private:
     AudioOptions _opts;
     AudioFiles &_files;
 
+    /**
+     * Request from the game thread, applied on the audio thread.
+     */
+    struct Command {
+        enum class Type {
+            Play,
+            Stop,
+            SetPosition,
+            SetListenerPosition
+        };
+
+        Type type { Type::Play };
+        std::shared_ptr<SoundInstance> sound;
+        glm::vec3 position { 0.0f };
+    };
+
     ALCdevice *_device { nullptr };
     ALCcontext *_context { nullptr };
     std::thread _thread;
     std::atomic_bool _run { true };
-    std::vector<std::shared_ptr<SoundInstance>> _sounds;
-    std::recursive_mutex _soundsMutex;
     std::atomic<glm::vec3> _listenerPosition;
-    std::atomic_bool _listenerPositionDirty { false };
+
+    MpscQueue<Command> _commands;
+    std::mutex _wakeMutex;
+    std::condition_variable _wakeCondVar;
+
+    // Audio thread
+
+    VoicePool _voices;
+    std::vector<std::shared_ptr<SoundInstance>> _sounds;
+    std::vector<std::pair<SoundInstance *, float>> _soundsByRank; /**< sounds with their audibility, sorted by rank */
+    glm::vec3 _currentListenerPosition { 0.0f };
+    std::chrono::steady_clock::time_point _lastUpdate;
 
     void threadStart();
+    void applyCommand(const Command &command);
+    void updateSounds();
+    void assignVoices();
+    void waitForCommands();
+
+    float getAudibility(const SoundInstance &sound) const;
+
+    // END Audio thread
 
     void initAL();
     void deinitAL();
 
     void enqueue(const std::shared_ptr<SoundInstance> &sound);
+    void post(Command command);
 
     float getGain(AudioType type, float gain) const;
+    int getPriority(AudioType type, int priority) const;
 };
 
 } // namespace audio
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2020-2021 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "sampleutil.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define REONE_AUDIO_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define REONE_AUDIO_NEON
+#include <arm_neon.h>
+#endif
+
+using namespace std;
+
+namespace reone {
+
+namespace audio {
+
+static constexpr int kFixedFracBits = 28;
+static constexpr int32_t kFixedOne = 1 << kFixedFracBits;
+static constexpr int32_t kFixedRound = 1 << (kFixedFracBits - 16);
+static constexpr int kFixedShift = kFixedFracBits + 1 - 16;
+
+static inline int16_t fixedToInt16(int32_t sample) {
+    // round
+    sample += kFixedRound;
+
+    // clip
+    if (sample >= kFixedOne) {
+        sample = kFixedOne - 1;
+    } else if (sample < -kFixedOne) {
+        sample = -kFixedOne;
+    }
+
+    // quantize
+    return static_cast<int16_t>(sample >> kFixedShift);
+}
+
+// Vectorized variants round and quantize, relying on saturating narrowing
+// for clipping: after the shift, clipped values map exactly onto the int16
+// range limits.
+
+#if defined(REONE_AUDIO_SSE2)
+
+static inline __m128i fixedToInt16x8(const int32_t *samples, __m128i round) {
+    __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i *>(samples));
+    __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i *>(samples + 4));
+    lo = _mm_srai_epi32(_mm_add_epi32(lo, round), kFixedShift);
+    hi = _mm_srai_epi32(_mm_add_epi32(hi, round), kFixedShift);
+    return _mm_packs_epi32(lo, hi);
+}
+
+static int convertVectorized(const int32_t *left, const int32_t *right, int count, int16_t *out) {
+    __m128i round = _mm_set1_epi32(kFixedRound);
+    int i = 0;
+    if (right) {
+        for (; i + 8 <= count; i += 8) {
+            __m128i l = fixedToInt16x8(left + i, round);
+            __m128i r = fixedToInt16x8(right + i, round);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 2 * i), _mm_unpacklo_epi16(l, r));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 2 * i + 8), _mm_unpackhi_epi16(l, r));
+        }
+    } else {
+        for (; i + 8 <= count; i += 8) {
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), fixedToInt16x8(left + i, round));
+        }
+    }
+    return i;
+}
+
+#elif defined(REONE_AUDIO_NEON)
+
+static inline int16x8_t fixedToInt16x8(const int32_t *samples, int32x4_t round) {
+    int32x4_t lo = vshrq_n_s32(vaddq_s32(vld1q_s32(samples), round), kFixedShift);
+    int32x4_t hi = vshrq_n_s32(vaddq_s32(vld1q_s32(samples + 4), round), kFixedShift);
+    return vcombine_s16(vqmovn_s32(lo), vqmovn_s32(hi));
+}
+
+static int convertVectorized(const int32_t *left, const int32_t *right, int count, int16_t *out) {
+    int32x4_t round = vdupq_n_s32(kFixedRound);
+    int i = 0;
+    if (right) {
+        for (; i + 8 <= count; i += 8) {
+            int16x8x2_t lr;
+            lr.val[0] = fixedToInt16x8(left + i, round);
+            lr.val[1] = fixedToInt16x8(right + i, round);
+            vst2q_s16(out + 2 * i, lr);
+        }
+    } else {
+        for (; i + 8 <= count; i += 8) {
+            vst1q_s16(out + i, fixedToInt16x8(left + i, round));
+        }
+    }
+    return i;
+}
+
+#else
+
+static int convertVectorized(const int32_t *left, const int32_t *right, int count, int16_t *out) {
+    return 0;
+}
+
+#endif
+
+void convertFixedToInt16(const int32_t *left, const int32_t *right, int count, int16_t *out) {
+    int i = convertVectorized(left, right, count, out);
+    if (right) {
+        for (; i < count; ++i) {
+            out[2 * i + 0] = fixedToInt16(left[i]);
+            out[2 * i + 1] = fixedToInt16(right[i]);
+        }
+    } else {
+        for (; i < count; ++i) {
+            out[i] = fixedToInt16(left[i]);
+        }
+    }
+}
+
+} // namespace audio
+
+} // namespace reone
@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2020-2021 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  Sample format conversion routines, vectorized where SSE2 or NEON is available.
+ */
+
+#pragma once
+
+namespace reone {
+
+namespace audio {
+
+/**
+ * Converts fixed-point samples, with 28 fraction bits as produced by libmad,
+ * to signed 16-bit samples, rounding and clipping them.
+ *
+ * @param left samples of the left (or the only) channel
+ * @param right samples of the right channel, or nullptr for mono output
+ * @param count number of samples per channel
+ * @param out output buffer, must hold count samples per channel; stereo output is interleaved
+ */
+void convertFixedToInt16(const int32_t *left, const int32_t *right, int count, int16_t *out);
+
+} // namespace audio
+
+} // namespace reone
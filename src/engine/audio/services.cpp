@@ -39,7 +39,9 @@ void AudioServices::init() {
     _files = make_unique<AudioFiles>(_resource.resources());
 
     _player = make_unique<AudioPlayer>(_options, *_files);
-    _player->init();
+    if (!_options.headless) {
+        _player->init();
+    }
 }
 
 } // namespace audio
@@ -27,11 +27,11 @@ SoundHandle::SoundHandle(float duration, const glm::vec3 &position) : _duration(
 }
 
 void SoundHandle::stop() {
-    _state = State::Stopped;
-}
+    if (_state.exchange(State::Stopped) == State::Stopped) return;
 
-void SoundHandle::resetPositionDirty() {
-    _positionDirty = false;
+    if (_onStop) {
+        _onStop();
+    }
 }
 
 bool SoundHandle::isNotInited() const {
@@ -49,10 +49,17 @@ void SoundHandle::setState(State state) {
 void SoundHandle::setPosition(const glm::vec3 &position) {
     if (_position.load() != position) {
         _position = position;
-        _positionDirty = true;
+        if (_onMove) {
+            _onMove(position);
+        }
     }
 }
 
+void SoundHandle::setCallbacks(StopCallback onStop, MoveCallback onMove) {
+    _onStop = move(onStop);
+    _onMove = move(onMove);
+}
+
 } // namespace audio
 
 } // namespace reone
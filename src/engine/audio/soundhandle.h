@@ -29,14 +29,15 @@ public:
         Stopped
     };
 
+    typedef std::function<void()> StopCallback;
+    typedef std::function<void(glm::vec3)> MoveCallback;
+
     SoundHandle(float duration, const glm::vec3 &position);
 
     void stop();
-    void resetPositionDirty();
 
     bool isNotInited() const;
     bool isStopped() const;
-    bool isPositionDirty() const { return _positionDirty; }
 
     float duration() const { return _duration; }
     glm::vec3 position() const { return _position; }
@@ -44,11 +45,18 @@ public:
     void setState(State state);
     void setPosition(const glm::vec3 &position);
 
+    /**
+     * Sets functions to call, on the calling thread, when the sound is
+     * stopped or moved through this handle.
+     */
+    void setCallbacks(StopCallback onStop, MoveCallback onMove);
+
 private:
     std::atomic<State> _state { State::NotInited };
     float _duration { 0.0f };
     std::atomic<glm::vec3> _position;
-    std::atomic_bool _positionDirty { false };
+    StopCallback _onStop;
+    MoveCallback _onMove;
 };
 
 } // namespace audio
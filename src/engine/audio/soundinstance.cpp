@@ -21,7 +21,7 @@
 #include "../common/log.h"
 
 #include "soundhandle.h"
-#include "stream.h"
+#include "voicepool.h"
 
 using namespace std;
 
@@ -29,97 +29,208 @@ namespace reone {
 
 namespace audio {
 
-static constexpr int kMaxBufferCount = 8;
+static constexpr float kMaxUpdateInterval = 0.05f;
 
-SoundInstance::SoundInstance(shared_ptr<AudioStream> stream, bool loop, float gain, bool positional, glm::vec3 position) :
+SoundInstance::SoundInstance(shared_ptr<AudioStream> stream, bool loop, float gain, bool positional, glm::vec3 position, int priority) :
     _stream(stream),
     _loop(loop),
     _gain(gain),
     _positional(positional),
+    _position(position),
+    _priority(priority),
     _handle(make_shared<SoundHandle>(stream->duration(), move(position))) {
 
     ensureNotNull(stream, "stream");
 }
 
 void SoundInstance::init() {
-    int frameCount = _stream->getFrameCount();
-    int bufferCount = min(max(frameCount, 1), kMaxBufferCount);
+    _position = _handle->position();
+    _handle->setState(SoundHandle::State::Playing);
+}
+
+bool SoundInstance::realize(Voice &voice) {
+    _decoder = _stream->createDecoder();
 
-    _buffers.resize(bufferCount);
-    _buffered = bufferCount > 1;
+    // Live streams cannot be probed without losing samples, and are always buffered
+    if (!_bufferedKnown && _stream->isLive()) {
+        _buffered = true;
+        _bufferedKnown = true;
+    }
 
-    alGenBuffers(bufferCount, &_buffers[0]);
-    alGenSources(1, &_source);
-    alSourcef(_source, AL_GAIN, _gain);
+    // Whether the sound fits into a single frame is only known after decoding it for the first time
+    if (!_bufferedKnown) {
+        if (!_decoder->decode(_frame)) {
+            _decoder.reset();
+            _handle->setState(SoundHandle::State::Stopped);
+            return false;
+        }
+        AudioStream::fill(_frame, voice.buffers[0]);
+        _buffered = _decoder->decode(_frame);
+        _bufferedKnown = true;
+        if (_buffered) {
+            _decoder->rewind();
+        }
+    } else if (!_buffered) {
+        _decoder->decode(_frame);
+        AudioStream::fill(_frame, voice.buffers[0]);
+    }
 
+    uint32_t source = voice.source;
+    alSourcef(source, AL_GAIN, _gain);
     if (_positional) {
-        glm::vec3 position(_handle->position());
-        alSource3f(_source, AL_POSITION, position.x, position.y, position.z);
+        alSource3f(source, AL_POSITION, _position.x, _position.y, _position.z);
     } else {
-        alSourcei(_source, AL_SOURCE_RELATIVE, AL_TRUE);
+        alSourcei(source, AL_SOURCE_RELATIVE, AL_TRUE);
     }
+
     if (_buffered) {
-        for (int i = 0; i < bufferCount; ++i) {
-            _stream->fill(_nextFrame, _buffers[i]);
-            ++_nextFrame;
+        // Sound does not fit into a single frame - queue up to all of the voice buffers and refill them as they are processed
+        if (_time > 0.0f) {
+            _decoder->seek(_time);
+        }
+        _freeBuffers.clear();
+        _ended = false;
+        int bufferCount = 0;
+        for (uint32_t buffer : voice.buffers) {
+            if (bufferCount == static_cast<int>(_freeBuffers.size()) && fillBuffer(buffer)) {
+                ++bufferCount;
+            } else {
+                _freeBuffers.push_back(buffer);
+            }
+        }
+        if (bufferCount == 0 && _ended) {
+            _decoder.reset();
+            _handle->setState(SoundHandle::State::Stopped);
+            return false;
+        }
+        if (bufferCount > 0) {
+            alSourceQueueBuffers(source, bufferCount, &voice.buffers[0]);
         }
-        alSourceQueueBuffers(_source, bufferCount, &_buffers[0]);
     } else {
-        _stream->fill(0, _buffers[0]);
-        alSourcei(_source, AL_BUFFER, _buffers[0]);
-        alSourcei(_source, AL_LOOPING, _loop);
+        _decoder.reset();
+        alSourcei(source, AL_BUFFER, voice.buffers[0]);
+        alSourcei(source, AL_LOOPING, _loop);
+        if (_time > 0.0f) {
+            alSourcef(source, AL_SEC_OFFSET, _time);
+        }
     }
 
-    alSourcePlay(_source);
-    _handle->setState(SoundHandle::State::Playing);
+    alSourcePlay(source);
+    _voice = &voice;
+
+    return true;
 }
 
-SoundInstance::~SoundInstance() {
-    deinit();
+Voice *SoundInstance::virtualize() {
+    Voice *voice = _voice;
+    _voice = nullptr;
+    _decoder.reset();
+
+    return voice;
 }
 
-void SoundInstance::deinit() {
-    if (_source) {
-        alSourceStop(_source);
-        alDeleteSources(1, &_source);
-        _source = 0;
+bool SoundInstance::fillBuffer(uint32_t buffer) {
+    if (_ended) return false;
+
+    bool live = _stream->isLive();
+    if (live) {
+        // Live streams do not wait for the player - skip samples that should have been played by now
+        _decoder->seek(_time);
     }
-    if (!_buffers.empty()) {
-        alDeleteBuffers(static_cast<int>(_buffers.size()), &_buffers[0]);
-        _buffers.clear();
+    if (!_decoder->decode(_frame)) {
+        if (!_loop) {
+            _ended = true;
+            return false;
+        }
+        _decoder->rewind();
+        if (!_decoder->decode(_frame)) {
+            _ended = true;
+            return false;
+        }
     }
+    if (live && _frame.samples.empty()) return false;
+
+    AudioStream::fill(_frame, buffer);
+    _bufferDuration = _frame.duration();
+    return true;
 }
 
-void SoundInstance::update() {
-    if (_positional && _handle->isPositionDirty()) {
-        glm::vec3 position(_handle->position());
-        alSource3f(_source, AL_POSITION, position.x, position.y, position.z);
-        _handle->resetPositionDirty();
+void SoundInstance::stop() {
+    _handle->setState(SoundHandle::State::Stopped);
+}
+
+float SoundInstance::updateInterval() const {
+    if (!_voice || !_buffered) return kMaxUpdateInterval;
+
+    // Refill buffers well before the queue runs dry
+    return min(0.5f * _bufferDuration, kMaxUpdateInterval);
+}
+
+void SoundInstance::setPosition(const glm::vec3 &position) {
+    _position = position;
+
+    if (_positional && _voice) {
+        alSource3f(_voice->source, AL_POSITION, position.x, position.y, position.z);
+    }
+}
+
+void SoundInstance::update(float dt) {
+    if (_handle->isStopped()) return;
+
+    _time += dt;
+
+    float duration = _stream->duration();
+    if (_loop && duration > 0.0f) {
+        _time = fmod(_time, duration);
+    }
+    if (_voice) {
+        updateReal();
+    } else {
+        updateVirtual();
     }
+}
+
+void SoundInstance::updateReal() {
+    uint32_t source = _voice->source;
+
     if (!_buffered) {
         ALint state = 0;
-        alGetSourcei(_source, AL_SOURCE_STATE, &state);
+        alGetSourcei(source, AL_SOURCE_STATE, &state);
         if (state == AL_STOPPED) {
             _handle->setState(SoundHandle::State::Stopped);
         }
         return;
     }
     ALint processed = 0;
-    alGetSourcei(_source, AL_BUFFERS_PROCESSED, &processed);
+    alGetSourcei(source, AL_BUFFERS_PROCESSED, &processed);
     while (processed-- > 0) {
-        alSourceUnqueueBuffers(_source, 1, &_buffers[_nextBuffer]);
-        if (_loop && _nextFrame == _stream->getFrameCount()) {
-            _nextFrame = 0;
-        }
-        if (_nextFrame < _stream->getFrameCount()) {
-            _stream->fill(_nextFrame++, _buffers[_nextBuffer]);
-            alSourceQueueBuffers(_source, 1, &_buffers[_nextBuffer]);
-        }
-        _nextBuffer = (_nextBuffer + 1) % static_cast<int>(_buffers.size());
+        uint32_t buffer = 0;
+        alSourceUnqueueBuffers(source, 1, &buffer);
+        _freeBuffers.push_back(buffer);
+    }
+    // Refill processed buffers, as well as those left empty when a live stream ran dry
+    while (!_freeBuffers.empty() && fillBuffer(_freeBuffers.back())) {
+        alSourceQueueBuffers(source, 1, &_freeBuffers.back());
+        _freeBuffers.pop_back();
     }
     ALint queued = 0;
-    alGetSourcei(_source, AL_BUFFERS_QUEUED, &queued);
+    alGetSourcei(source, AL_BUFFERS_QUEUED, &queued);
     if (queued == 0) {
+        if (_ended) {
+            _handle->setState(SoundHandle::State::Stopped);
+        }
+        return;
+    }
+    ALint state = 0;
+    alGetSourcei(source, AL_SOURCE_STATE, &state);
+    if (state == AL_STOPPED) {
+        // Source ran out of buffers before they were refilled
+        alSourcePlay(source);
+    }
+}
+
+void SoundInstance::updateVirtual() {
+    if (!_loop && _time >= _stream->duration()) {
         _handle->setState(SoundHandle::State::Stopped);
     }
 }
@@ -17,39 +17,103 @@
 
 #pragma once
 
+#include "stream.h"
+
 namespace reone {
 
 namespace audio {
 
-class AudioStream;
 class SoundHandle;
 
+struct Voice;
+
+/**
+ * Playing sound. A sound is either real, i.e. playing on a voice borrowed
+ * from the VoicePool, or virtual, in which case only its playback time is
+ * tracked, so that it can resume from the right position when it becomes
+ * real again. Must only be used on the audio thread, except for the handle.
+ */
 class SoundInstance {
 public:
-    SoundInstance(std::shared_ptr<AudioStream> stream, bool loop, float gain, bool positional, glm::vec3 position);
+    SoundInstance(std::shared_ptr<AudioStream> stream, bool loop, float gain, bool positional, glm::vec3 position, int priority = 0);
     SoundInstance(SoundInstance &&) = default;
-    ~SoundInstance();
 
     SoundInstance &operator=(SoundInstance &&) = default;
 
     void init();
-    void update();
 
+    /**
+     * Advances playback time, refilling buffers of a real sound.
+     *
+     * @param dt number of seconds since the last update
+     */
+    void update(float dt);
+
+    void stop();
+
+    /**
+     * Starts playing on the specified voice from the current playback time.
+     *
+     * @return false if the stream contains no samples, true otherwise
+     */
+    bool realize(Voice &voice);
+
+    /**
+     * Stops playing on the current voice, if any, keeping track of playback time.
+     *
+     * @return voice, which the sound was playing on, or nullptr if the sound was virtual
+     */
+    Voice *virtualize();
+
+    bool isReal() const { return _voice != nullptr; }
+    bool isPositional() const { return _positional; }
+
+    /**
+     * @return maximum number of seconds until the next call to update
+     */
+    float updateInterval() const;
+
+    float gain() const { return _gain; }
+    int priority() const { return _priority; }
+    const glm::vec3 &position() const { return _position; }
     std::shared_ptr<SoundHandle> handle() const { return _handle; }
 
+    void setPosition(const glm::vec3 &position);
+
 private:
     std::shared_ptr<AudioStream> _stream;
     bool _loop { false };
     float _gain { 0.0f };
     bool _positional { false };
+    glm::vec3 _position { 0.0f };
+    int _priority { 0 };
     std::shared_ptr<SoundHandle> _handle;
-    std::vector<uint32_t> _buffers;
+    float _time { 0.0f }; /**< playback time in seconds */
+
+    // Real sound
+
+    Voice *_voice { nullptr };
+    std::unique_ptr<IAudioDecoder> _decoder;
+    AudioStream::Frame _frame; /**< decoded samples, reused between buffers */
     bool _buffered { false };
-    uint32_t _source { 0 };
-    int _nextFrame { 0 };
-    int _nextBuffer { 0 };
+    bool _bufferedKnown { false };
+    bool _ended { false }; /**< decoder has reached the end of stream */
+    std::vector<uint32_t> _freeBuffers; /**< unqueued buffers, waiting to be refilled */
+    float _bufferDuration { 0.0f }; /**< duration of the last filled buffer in seconds */
+
+    // END Real sound
+
+    void updateReal();
+    void updateVirtual();
 
-    void deinit();
+    /**
+     * Decodes the next frame into the OpenAL buffer, rewinding the decoder
+     * if the sound is looping.
+     *
+     * @return false if the end of stream has been reached or a live stream
+     *         ran dry, true otherwise
+     */
+    bool fillBuffer(uint32_t buffer);
 };
 
 } // namespace audio
@@ -23,20 +23,92 @@ namespace reone {
 
 namespace audio {
 
+namespace {
+
+/**
+ * Decoder over the frames of an in-memory audio stream.
+ */
+class FrameListDecoder : public IAudioDecoder {
+public:
+    FrameListDecoder(const AudioStream &stream) : _stream(stream) {
+    }
+
+    bool decode(AudioStream::Frame &frame) override {
+        if (_nextFrame >= _stream.getFrameCount()) return false;
+
+        const AudioStream::Frame &next = _stream.getFrame(_nextFrame++);
+        frame.format = next.format;
+        frame.sampleRate = next.sampleRate;
+        frame.samples.assign(next.samples.begin(), next.samples.end());
+
+        return true;
+    }
+
+    void rewind() override {
+        _nextFrame = 0;
+    }
+
+    void seek(float time) override {
+        rewind();
+        while (_nextFrame < _stream.getFrameCount()) {
+            float duration = _stream.getFrame(_nextFrame).duration();
+            if (time < duration) break;
+            time -= duration;
+            ++_nextFrame;
+        }
+    }
+
+private:
+    const AudioStream &_stream;
+    int _nextFrame { 0 };
+};
+
+} // namespace
+
+float AudioStream::Frame::duration() const {
+    return samples.size() / static_cast<float>(getBytesPerSample(format) * sampleRate);
+}
+
+AudioStream::AudioStream(DecoderFactory decoderFactory, float duration, bool live) :
+    _decoderFactory(move(decoderFactory)),
+    _duration(duration),
+    _live(live) {
+}
+
 void AudioStream::add(Frame &&frame) {
-    _duration += frame.samples.size() / static_cast<float>(frame.sampleRate);
+    if (isStreaming()) {
+        throw logic_error("Cannot add frames to a streaming audio stream");
+    }
+    _duration += frame.duration();
     _frames.push_back(move(frame));
 }
 
-void AudioStream::fill(int frameIdx, uint32_t buffer) {
-    if (frameIdx >= _frames.size()) {
-        throw out_of_range("Frame index out of range: " + to_string(frameIdx));
+unique_ptr<IAudioDecoder> AudioStream::createDecoder() const {
+    if (_decoderFactory) {
+        return _decoderFactory();
+    }
+    return make_unique<FrameListDecoder>(*this);
+}
+
+void AudioStream::fill(const Frame &frame, uint32_t buffer) {
+    alBufferData(buffer, getALAudioFormat(frame.format), frame.samples.data(), static_cast<int>(frame.samples.size()), frame.sampleRate);
+}
+
+int AudioStream::getBytesPerSample(AudioFormat format) {
+    switch (format) {
+        case AudioFormat::Mono8:
+            return 1;
+        case AudioFormat::Mono16:
+        case AudioFormat::Stereo8:
+            return 2;
+        case AudioFormat::Stereo16:
+            return 4;
+        default:
+            throw logic_error("Unknown audio format: " + to_string(static_cast<int>(format)));
     }
-    Frame &frame = _frames[frameIdx];
-    alBufferData(buffer, getALAudioFormat(frame.format), &frame.samples[0], static_cast<int>(frame.samples.size()), frame.sampleRate);
 }
 
-int AudioStream::getALAudioFormat(AudioFormat format) const {
+int AudioStream::getALAudioFormat(AudioFormat format) {
     switch (format) {
         case AudioFormat::Mono8:
             return AL_FORMAT_MONO8;
@@ -25,27 +25,96 @@ namespace reone {
 
 namespace audio {
 
+class IAudioDecoder;
+
+/**
+ * Audio data, either materialized as a list of PCM frames, or decoded on
+ * demand from the raw resource bytes. In the latter case, every playing
+ * sound instance creates its own decoder, so that only a few buffers worth
+ * of PCM samples are held in memory at once.
+ */
 class AudioStream : boost::noncopyable {
 public:
     struct Frame {
         AudioFormat format { AudioFormat::Mono8 };
         int sampleRate { 0 };
         ByteArray samples;
+
+        /**
+         * @return duration of samples in seconds
+         */
+        float duration() const;
     };
 
+    typedef std::function<std::unique_ptr<IAudioDecoder>()> DecoderFactory;
+
+    AudioStream() = default;
+    AudioStream(DecoderFactory decoderFactory, float duration, bool live = false);
+
     void add(Frame &&frame);
-    void fill(int frameIdx, uint32_t buffer);
+
+    /**
+     * @return new decoder positioned at the beginning of this stream
+     */
+    std::unique_ptr<IAudioDecoder> createDecoder() const;
+
+    bool isStreaming() const { return static_cast<bool>(_decoderFactory); }
+
+    /**
+     * Live streams are fed while playing, e.g. movie audio. They can be
+     * neither probed nor rewound, and their decoders may run dry
+     * temporarily.
+     */
+    bool isLive() const { return _live; }
 
     int getFrameCount() const;
     const Frame &getFrame(int index) const;
 
     float duration() const { return _duration; }
 
+    /**
+     * Uploads samples of the specified frame into the OpenAL buffer.
+     */
+    static void fill(const Frame &frame, uint32_t buffer);
+
+    static int getBytesPerSample(AudioFormat format);
+
 private:
+    DecoderFactory _decoderFactory;
     float _duration { 0 };
+    bool _live { false };
     std::vector<Frame> _frames;
 
-    int getALAudioFormat(AudioFormat format) const;
+    static int getALAudioFormat(AudioFormat format);
+};
+
+/**
+ * Pull-based audio decoder. Not thread-safe: a single decoder must only be
+ * used by one sound instance.
+ */
+class IAudioDecoder {
+public:
+    virtual ~IAudioDecoder() = default;
+
+    /**
+     * Decodes the next portion of samples into the frame, reusing its storage.
+     * Decoders of live streams leave the frame empty when samples are not
+     * available yet.
+     *
+     * @return false if the end of stream has been reached, true otherwise
+     */
+    virtual bool decode(AudioStream::Frame &frame) = 0;
+
+    /**
+     * Restarts decoding from the beginning of the stream.
+     */
+    virtual void rewind() = 0;
+
+    /**
+     * Positions the decoder at the specified time in seconds. Precision is
+     * implementation-specific, e.g. an MP3 frame or an ADPCM block.
+     */
+    virtual void seek(float time) = 0;
 };
 
 } // namespace audio
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2020-2021 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "voicepool.h"
+
+#include "../common/log.h"
+
+using namespace std;
+
+namespace reone {
+
+namespace audio {
+
+VoicePool::~VoicePool() {
+    deinit();
+}
+
+void VoicePool::init(int voiceCount, int bufferCount) {
+    if (!_voices.empty()) return;
+
+    alGetError();
+
+    for (int i = 0; i < voiceCount; ++i) {
+        auto voice = make_unique<Voice>();
+        alGenSources(1, &voice->source);
+        if (alGetError() != AL_NO_ERROR) break;
+
+        voice->buffers.resize(bufferCount);
+        alGenBuffers(bufferCount, &voice->buffers[0]);
+        if (alGetError() != AL_NO_ERROR) {
+            alDeleteSources(1, &voice->source);
+            break;
+        }
+        _free.push_back(voice.get());
+        _voices.push_back(move(voice));
+    }
+    if (static_cast<int>(_voices.size()) < voiceCount) {
+        warn(boost::format("VoicePool: allocated %d out of %d voices") % _voices.size() % voiceCount);
+    }
+}
+
+void VoicePool::deinit() {
+    for (auto &voice : _voices) {
+        alSourceStop(voice->source);
+        alSourcei(voice->source, AL_BUFFER, 0);
+        alDeleteSources(1, &voice->source);
+        alDeleteBuffers(static_cast<int>(voice->buffers.size()), &voice->buffers[0]);
+    }
+    _voices.clear();
+    _free.clear();
+}
+
+Voice *VoicePool::acquire() {
+    if (_free.empty()) return nullptr;
+
+    Voice *voice = _free.back();
+    _free.pop_back();
+
+    return voice;
+}
+
+void VoicePool::release(Voice *voice) {
+    if (!voice) return;
+
+    alSourceStop(voice->source);
+    alSourcei(voice->source, AL_BUFFER, 0);
+    alSourcei(voice->source, AL_LOOPING, AL_FALSE);
+    alSourcei(voice->source, AL_SOURCE_RELATIVE, AL_FALSE);
+    alSource3f(voice->source, AL_POSITION, 0.0f, 0.0f, 0.0f);
+
+    _free.push_back(voice);
+}
+
+} // namespace audio
+
+} // namespace reone
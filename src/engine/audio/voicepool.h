@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2020-2021 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+namespace reone {
+
+namespace audio {
+
+/**
+ * OpenAL source with buffers to queue on it.
+ */
+struct Voice {
+    uint32_t source { 0 };
+    std::vector<uint32_t> buffers;
+};
+
+/**
+ * Fixed set of voices, allocated once and lent to playing sounds. Must only
+ * be used on the audio thread, with the OpenAL context current.
+ */
+class VoicePool : boost::noncopyable {
+public:
+    ~VoicePool();
+
+    /**
+     * Allocates up to voiceCount voices, fewer if the OpenAL implementation
+     * runs out of sources.
+     *
+     * @param bufferCount number of buffers per voice
+     */
+    void init(int voiceCount, int bufferCount);
+    void deinit();
+
+    /**
+     * @return free voice, or nullptr if all voices are in use
+     */
+    Voice *acquire();
+
+    /**
+     * Stops the source of the voice, detaches its buffers and returns it to
+     * the pool.
+     */
+    void release(Voice *voice);
+
+    int size() const { return static_cast<int>(_voices.size()); }
+
+private:
+    std::vector<std::unique_ptr<Voice>> _voices;
+    std::vector<Voice *> _free;
+};
+
+} // namespace audio
+
+} // namespace reone
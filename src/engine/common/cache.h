@@ -35,6 +35,20 @@ public:
         _objects.clear();
     }
 
+    /**
+     * Removes cached misses, i.e. keys for which no object could be computed,
+     * so that they are computed again.
+     */
+    void invalidateMissing() {
+        for (auto it = _objects.begin(); it != _objects.end();) {
+            if (it->second) {
+                ++it;
+            } else {
+                it = _objects.erase(it);
+            }
+        }
+    }
+
     std::shared_ptr<V> get(K key) {
         auto maybeObject = _objects.find(key);
         if (maybeObject != _objects.end()) return maybeObject->second;
@@ -44,6 +58,13 @@ public:
         return _objects.insert(make_pair(key, move(object))).first->second;
     }
 
+    /**
+     * Caches a precomputed object, replacing an existing one.
+     */
+    void put(K key, std::shared_ptr<V> object) {
+        _objects[key] = move(object);
+    }
+
 private:
     std::function<std::shared_ptr<V>(K)> _compute;
 
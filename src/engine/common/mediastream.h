@@ -19,46 +19,28 @@
 
 namespace reone {
 
+/**
+ * Source of media frames for presentation, e.g. video frames decoded ahead
+ * of time on another thread.
+ */
 template <class Frame>
 class MediaStream : boost::noncopyable {
 public:
-    static constexpr int kBufferSize = 8;
-
     virtual ~MediaStream() {
     }
 
-    std::shared_ptr<Frame> get(int frame) {
-        int relFrame = frame - _frameOffset;
-        if (relFrame < 0) {
-            throw std::logic_error("frame was unloaded: " + std::to_string(frame));
-        }
-        if (relFrame < static_cast<int>(_frames.size())) {
-            return _frames[relFrame];
-        }
-        if (_ended) {
-            return nullptr;
-        }
-        _frames.clear();
-
-        int nextFrame = _frameOffset + kBufferSize;
-        int framesToIgnore = std::max(0, frame - nextFrame);
-        ignoreFrames(framesToIgnore);
-        fetchFrames(kBufferSize);
-
-        _frameOffset = frame;
-
-        return get(frame);
-    }
-
-protected:
-    virtual void ignoreFrames(int count) = 0;
-    virtual void fetchFrames(int count) = 0;
-
-    std::vector<std::shared_ptr<Frame>> _frames;
-    bool _ended { false };
-
-private:
-    int _frameOffset { 0 };
+    /**
+     * Advances the stream to the specified frame, dropping frames that are
+     * late. Must not block.
+     *
+     * @return the latest decoded frame not past the specified one, or nullptr if none has been decoded yet
+     */
+    virtual std::shared_ptr<Frame> get(int frame) = 0;
+
+    /**
+     * @return true if all frames have been presented, false otherwise
+     */
+    virtual bool isEnded() const = 0;
 };
 
 } // namespace reone
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2020-2021 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+namespace reone {
+
+/**
+ * Unbounded lock-free queue with multiple producers and a single consumer.
+ * Producers push onto an atomic singly-linked list; the consumer detaches
+ * the whole list at once and consumes it in the order of pushing.
+ */
+template <class T>
+class MpscQueue : boost::noncopyable {
+public:
+    ~MpscQueue() {
+        Node *node = _head.exchange(nullptr);
+        while (node) {
+            Node *next = node->next;
+            delete node;
+            node = next;
+        }
+    }
+
+    /**
+     * Pushes the value onto the queue. Safe to call from any thread.
+     */
+    void push(T value) {
+        Node *node = new Node { std::move(value), _head.load(std::memory_order_relaxed) };
+        while (!_head.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed)) {
+        }
+    }
+
+    /**
+     * Removes all values from the queue, calling the specified function for
+     * every one of them, in the order of pushing. Must only be called from
+     * the consumer thread.
+     */
+    template <class F>
+    void consume(F func) {
+        Node *node = _head.exchange(nullptr, std::memory_order_acquire);
+
+        // Reverse the list, so that values are consumed in FIFO order
+        Node *reversed = nullptr;
+        while (node) {
+            Node *next = node->next;
+            node->next = reversed;
+            reversed = node;
+            node = next;
+        }
+        while (reversed) {
+            std::unique_ptr<Node> current(reversed);
+            reversed = current->next;
+            func(current->value);
+        }
+    }
+
+    bool empty() const {
+        return _head.load(std::memory_order_acquire) == nullptr;
+    }
+
+private:
+    struct Node {
+        T value;
+        Node *next { nullptr };
+    };
+
+    std::atomic<Node *> _head { nullptr };
+};
+
+} // namespace reone
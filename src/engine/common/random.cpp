@@ -23,6 +23,10 @@ namespace reone {
 
 static default_random_engine g_generator(static_cast<uint32_t>(time(nullptr)));
 
+void setRandomSeed(uint32_t seed) {
+    g_generator.seed(seed);
+}
+
 int random(int min, int max) {
     uniform_int_distribution<int> dist(min, max);
     return dist(g_generator);
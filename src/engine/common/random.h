@@ -19,6 +19,12 @@
 
 namespace reone {
 
+/**
+ * Reseeds the random number generator, making subsequent random numbers
+ * reproducible.
+ */
+void setRandomSeed(uint32_t seed);
+
 /**
  * Generates a random integer between min and max (inclusive).
  */
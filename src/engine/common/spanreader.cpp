@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2020-2021 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "spanreader.h"
+
+using namespace std;
+
+namespace reone {
+
+SpanReader::SpanReader(const char *data, size_t size) :
+    _data(data),
+    _size(size) {
+}
+
+SpanReader::SpanReader(const ByteArray &data) :
+    _data(data.data()),
+    _size(data.size()) {
+}
+
+void SpanReader::ensureReadable(size_t offset, size_t count) const {
+    if (offset > _size || count > _size - offset) {
+        throw out_of_range(str(boost::format("Read of %d bytes at offset %d is out of bounds [0, %d)") % count % offset % _size));
+    }
+}
+
+void SpanReader::seek(size_t pos) {
+    ensureReadable(pos, 0);
+    _pos = pos;
+}
+
+void SpanReader::ignore(size_t count) {
+    ensureReadable(_pos, count);
+    _pos += count;
+}
+
+uint8_t SpanReader::getByte() {
+    return get<uint8_t>();
+}
+
+uint16_t SpanReader::getUint16() {
+    return get<uint16_t>();
+}
+
+uint32_t SpanReader::getUint32() {
+    return get<uint32_t>();
+}
+
+int32_t SpanReader::getInt32() {
+    return get<int32_t>();
+}
+
+float SpanReader::getFloat() {
+    return get<float>();
+}
+
+string SpanReader::getCString(size_t len) {
+    ensureReadable(_pos, len);
+    const char *begin = _data + _pos;
+    _pos += len;
+
+    return string(begin, find(begin, begin + len, '\0'));
+}
+
+string SpanReader::getCStringAt(size_t offset) const {
+    ensureReadable(offset, 0);
+    const char *begin = _data + offset;
+    const char *end = _data + _size;
+
+    return string(begin, find(begin, end, '\0'));
+}
+
+} // namespace reone
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2020-2021 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "types.h"
+
+namespace reone {
+
+/**
+ * Reads little-endian values from a contiguous in-memory byte range. Unlike
+ * StreamReader, every read is checked against the bounds of the range, and
+ * arrays are copied in bulk. Reading past the end throws std::out_of_range.
+ *
+ * SpanReader does not own the data: the byte range must outlive it.
+ */
+class SpanReader {
+public:
+    SpanReader() = default;
+    SpanReader(const char *data, size_t size);
+    SpanReader(const ByteArray &data);
+
+    size_t tell() const { return _pos; }
+    size_t size() const { return _size; }
+
+    void seek(size_t pos);
+    void ignore(size_t count);
+
+    uint8_t getByte();
+    uint16_t getUint16();
+    uint32_t getUint32();
+    int32_t getInt32();
+    float getFloat();
+
+    /**
+     * Reads a fixed-length string, truncating it at the first null character.
+     */
+    std::string getCString(size_t len);
+
+    /**
+     * Reads a null-terminated string at the specified offset, without
+     * changing the current position.
+     */
+    std::string getCStringAt(size_t offset) const;
+
+    /**
+     * Reads count values of type T into out.
+     */
+    template <class T>
+    void getArray(size_t count, T *out) {
+        copyArray(_pos, count, out);
+        _pos += count * sizeof(T);
+    }
+
+    template <class T>
+    std::vector<T> getArray(size_t count) {
+        std::vector<T> result(count);
+        if (count > 0) {
+            getArray(count, &result[0]);
+        }
+        return std::move(result);
+    }
+
+    /**
+     * Reads count values of type T at the specified offset, without changing
+     * the current position.
+     */
+    template <class T>
+    std::vector<T> getArrayAt(size_t offset, size_t count) const {
+        std::vector<T> result(count);
+        if (count > 0) {
+            copyArray(offset, count, &result[0]);
+        }
+        return std::move(result);
+    }
+
+private:
+    const char *_data { nullptr };
+    size_t _size { 0 };
+    size_t _pos { 0 };
+
+    void ensureReadable(size_t offset, size_t count) const;
+
+    template <class T>
+    void copyArray(size_t offset, size_t count, T *out) const {
+        static_assert(std::is_arithmetic<T>::value, "T must be an arithmetic type");
+        if (count == 0) return;
+
+        ensureReadable(offset, count * sizeof(T));
+        memcpy(out, _data + offset, count * sizeof(T));
+
+        if (boost::endian::order::native != boost::endian::order::little) {
+            for (size_t i = 0; i < count; ++i) {
+                swapBytes(out[i]);
+            }
+        }
+    }
+
+    template <class T>
+    T get() {
+        T val;
+        getArray(1, &val);
+        return val;
+    }
+
+    template <class T>
+    static void swapBytes(T &val) {
+        char *bytes = reinterpret_cast<char *>(&val);
+        std::reverse(bytes, bytes + sizeof(T));
+    }
+};
+
+} // namespace reone
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2020-2021 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "threadpool.h"
+
+using namespace std;
+
+namespace reone {
+
+static thread_local ThreadPool *g_workerPool = nullptr; /**< pool, that the current thread is a worker of */
+
+ThreadPool::ThreadPool(int threadCount) {
+    if (threadCount <= 0) {
+        threadCount = glm::max(1, static_cast<int>(thread::hardware_concurrency()) - 1);
+    }
+    for (int i = 0; i < threadCount; ++i) {
+        _threads.push_back(thread(bind(&ThreadPool::workerThreadStart, this)));
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard<mutex> lock(_mutex);
+        _quit = true;
+    }
+    _jobsCondVar.notify_all();
+
+    for (auto &thread : _threads) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+}
+
+void ThreadPool::workerThreadStart() {
+    g_workerPool = this;
+
+    while (true) {
+        function<void()> job;
+        {
+            unique_lock<mutex> lock(_mutex);
+            _jobsCondVar.wait(lock, [this]() { return _quit || !_priorityJobs.empty() || !_jobs.empty(); });
+            if (!_priorityJobs.empty()) {
+                job = move(_priorityJobs.front());
+                _priorityJobs.pop();
+            } else if (!_jobs.empty()) {
+                job = move(_jobs.front());
+                _jobs.pop();
+            } else {
+                return;
+            }
+        }
+        job();
+    }
+}
+
+void ThreadPool::enqueuePriority(function<void()> job) {
+    {
+        lock_guard<mutex> lock(_mutex);
+        _priorityJobs.push(move(job));
+    }
+    _jobsCondVar.notify_one();
+}
+
+/**
+ * State of a parallelFor call, shared between the calling thread and worker
+ * threads. Worker threads might only get to it after the call has returned,
+ * hence it is reference counted.
+ */
+struct ParallelForState {
+    const function<void(int)> *func { nullptr }; /**< only valid until all chunks have been claimed and completed */
+    int count { 0 };
+    int chunkSize { 0 };
+    int chunkCount { 0 };
+    atomic<int> nextChunk { 0 };
+
+    mutex completedMutex;
+    condition_variable completedCondVar;
+    int completedCount { 0 };
+    exception_ptr error;
+};
+
+/**
+ * Claims and processes the next chunk, if any.
+ *
+ * @return false if all chunks have been claimed, true otherwise
+ */
+static bool processNextChunk(ParallelForState &state) {
+    int chunk = state.nextChunk++;
+    if (chunk >= state.chunkCount) return false;
+
+    int start = chunk * state.chunkSize;
+    int end = glm::min(state.count, start + state.chunkSize);
+    exception_ptr error;
+    try {
+        for (int i = start; i < end; ++i) {
+            (*state.func)(i);
+        }
+    } catch (...) {
+        error = current_exception();
+    }
+
+    lock_guard<mutex> lock(state.completedMutex);
+    if (error && !state.error) {
+        state.error = error;
+    }
+    ++state.completedCount;
+    state.completedCondVar.notify_all();
+
+    return true;
+}
+
+void ThreadPool::parallelFor(int count, const function<void(int)> &func) {
+    if (count <= 0) return;
+    if (g_workerPool == this) {
+        throw logic_error("ThreadPool: parallelFor must not be called from a worker thread");
+    }
+
+    int chunkCount = glm::min(count, threadCount() + 1);
+    if (chunkCount == 1) {
+        for (int i = 0; i < count; ++i) {
+            func(i);
+        }
+        return;
+    }
+    auto state = make_shared<ParallelForState>();
+    state->func = &func;
+    state->count = count;
+    state->chunkSize = (count + chunkCount - 1) / chunkCount;
+    state->chunkCount = (count + state->chunkSize - 1) / state->chunkSize;
+
+    for (int i = 1; i < state->chunkCount; ++i) {
+        enqueuePriority([state]() {
+            while (processNextChunk(*state)) {
+            }
+        });
+    }
+
+    // Rather than waiting for worker threads, that might be busy with other jobs, process unclaimed chunks on the calling thread
+    while (processNextChunk(*state)) {
+    }
+
+    // Wait for chunks in progress on worker threads before returning, as they reference func
+    unique_lock<mutex> lock(state->completedMutex);
+    state->completedCondVar.wait(lock, [&state]() { return state->completedCount == state->chunkCount; });
+    if (state->error) {
+        rethrow_exception(state->error);
+    }
+}
+
+} // namespace reone
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2020-2021 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <future>
+
+namespace reone {
+
+/**
+ * Fixed-size pool of worker threads, executing queued jobs in FIFO order.
+ * Chunks of parallelFor take precedence over queued jobs.
+ */
+class ThreadPool : boost::noncopyable {
+public:
+    /**
+     * @param threadCount number of worker threads, or 0 to use one less than the number of hardware threads
+     */
+    ThreadPool(int threadCount = 0);
+    ~ThreadPool();
+
+    /**
+     * Queues the specified function for execution on a worker thread.
+     *
+     * @return future, holding the result of the function
+     */
+    template <class F>
+    std::future<typename std::result_of<F()>::type> enqueue(F func) {
+        typedef typename std::result_of<F()>::type Result;
+
+        auto task = std::make_shared<std::packaged_task<Result()>>(std::move(func));
+        std::future<Result> result(task->get_future());
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _jobs.push([task]() { (*task)(); });
+        }
+        _jobsCondVar.notify_one();
+
+        return std::move(result);
+    }
+
+    /**
+     * Calls the specified function for every index in [0, count), distributing
+     * calls between worker threads and the calling thread. Blocks until all
+     * calls have completed. Exceptions are rethrown in the calling thread.
+     *
+     * Chunks are queued ahead of regular jobs, and the calling thread keeps
+     * processing chunks, that no worker thread has picked up yet. Hence, it
+     * only waits for chunks in progress, never for long jobs queued before.
+     *
+     * Must not be called from a worker thread of this pool.
+     *
+     * @throws std::logic_error if called from a worker thread of this pool
+     */
+    void parallelFor(int count, const std::function<void(int)> &func);
+
+    int threadCount() const { return static_cast<int>(_threads.size()); }
+
+private:
+    std::vector<std::thread> _threads;
+    std::queue<std::function<void()>> _jobs;
+    std::queue<std::function<void()>> _priorityJobs; /**< executed before regular jobs */
+    std::mutex _mutex;
+    std::condition_variable _jobsCondVar;
+    bool _quit { false };
+
+    void workerThreadStart();
+
+    void enqueuePriority(std::function<void()> job);
+};
+
+} // namespace reone
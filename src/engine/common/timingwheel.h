@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2020-2021 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+namespace reone {
+
+/**
+ * Schedules values to be released after a delay. Values are bucketed into
+ * slots by due time, so that advancing the wheel only visits slots whose
+ * time has come, regardless of how many values are pending. Values with
+ * delays longer than a revolution of the wheel remain in their slot and are
+ * skipped until due.
+ */
+template <class T>
+class TimingWheel : boost::noncopyable {
+public:
+    /**
+     * @param resolution duration of a slot in seconds
+     * @param slotCount number of slots in the wheel
+     */
+    TimingWheel(float resolution = 0.01f, int slotCount = 1024) :
+        _resolution(resolution),
+        _slots(slotCount) {
+
+        if (resolution <= 0.0f) {
+            throw std::invalid_argument("resolution must be a positive number");
+        }
+        if (slotCount <= 0) {
+            throw std::invalid_argument("slotCount must be a positive number");
+        }
+    }
+
+    void clear() {
+        for (auto &slot : _slots) {
+            slot.clear();
+        }
+        _size = 0;
+    }
+
+    /**
+     * Schedules the value to be released after the specified number of seconds.
+     */
+    void schedule(float delay, T value) {
+        Entry entry;
+        entry.dueTime = _time + std::max(0.0f, delay);
+        entry.value = std::move(value);
+
+        // Never schedule into a slot that has already been visited
+        int64_t tick = std::max(getTick(entry.dueTime), _nextTick);
+        _slots[tick % _slots.size()].push_back(std::move(entry));
+        ++_size;
+    }
+
+    /**
+     * Advances the wheel by the specified number of seconds, releasing values
+     * that are due, in order of slots and, within a slot, of scheduling.
+     *
+     * @param release function to call for every released value
+     */
+    void update(float dt, const std::function<void(T &)> &release) {
+        _time += dt;
+        if (_size == 0) {
+            _nextTick = getTick(_time);
+            return;
+        }
+        int64_t currentTick = getTick(_time);
+        int64_t lastTick = std::min(currentTick, _nextTick + static_cast<int64_t>(_slots.size()) - 1);
+
+        for (int64_t tick = _nextTick; tick <= lastTick; ++tick) {
+            releaseDue(_slots[tick % _slots.size()], release);
+        }
+
+        // Current slot is visited again, as it may contain values due later within it
+        _nextTick = currentTick;
+    }
+
+    double time() const { return _time; }
+
+    int size() const { return _size; }
+
+private:
+    struct Entry {
+        double dueTime { 0.0 };
+        T value;
+    };
+
+    float _resolution;
+    std::vector<std::vector<Entry>> _slots;
+    double _time { 0.0 };
+    int64_t _nextTick { 0 }; /**< first tick, whose slot has not been fully processed */
+    int _size { 0 };
+
+    int64_t getTick(double time) const {
+        return static_cast<int64_t>(time / _resolution);
+    }
+
+    void releaseDue(std::vector<Entry> &slot, const std::function<void(T &)> &release) {
+        std::vector<Entry> due;
+        size_t kept = 0;
+        for (size_t i = 0; i < slot.size(); ++i) {
+            if (slot[i].dueTime <= _time) {
+                due.push_back(std::move(slot[i]));
+            } else {
+                if (kept != i) {
+                    slot[kept] = std::move(slot[i]);
+                }
+                ++kept;
+            }
+        }
+        slot.erase(slot.begin() + kept, slot.end());
+        _size -= static_cast<int>(due.size());
+
+        // Released values may schedule new values, so the slot is not touched here
+        for (auto &entry : due) {
+            release(entry.value);
+        }
+    }
+};
+
+} // namespace reone
@@ -171,11 +171,7 @@ void ActionExecutor::executeFollow(const shared_ptr<Object> &actor, FollowAction
 }
 
 void ActionExecutor::executeDoCommand(const shared_ptr<Object> &actor, CommandAction &action, float dt) {
-    auto context = make_unique<ExecutionContext>(*action.context());
-    context->callerId = actor ? actor->id() : kObjectInvalid;
-
-    shared_ptr<ScriptProgram> program(action.context()->savedState->program);
-    ScriptExecution(program, move(context)).run();
+    ScriptExecution::resume(*action.context(), actor ? actor->id() : kObjectInvalid);
     action.complete();
 }
 
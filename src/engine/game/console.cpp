@@ -35,6 +35,9 @@ using namespace std::placeholders;
 using namespace reone::gui;
 using namespace reone::graphics;
 using namespace reone::scene;
+using namespace reone::script;
+
+namespace fs = boost::filesystem;
 
 namespace reone {
 
@@ -59,6 +62,9 @@ void Console::initCommands() {
     addCommand("kill", bind(&Console::cmdKill, this, _1));
     addCommand("additem", bind(&Console::cmdAddItem, this, _1));
     addCommand("givexp", bind(&Console::cmdGiveXP, this, _1));
+    addCommand("scriptstats", bind(&Console::cmdScriptStats, this, _1));
+    addCommand("routinestats", bind(&Console::cmdRoutineStats, this, _1));
+    addCommand("profiler", bind(&Console::cmdProfiler, this, _1));
 }
 
 void Console::addCommand(const std::string &name, const CommandHandler &handler) {
@@ -188,6 +194,90 @@ void Console::cmdGiveXP(vector<string> tokens) {
     static_pointer_cast<Creature>(object)->giveXP(amount);
 }
 
+void Console::cmdScriptStats(vector<string> tokens) {
+    ScriptRunner &runner = _game.services().scriptRunner();
+    if (tokens.size() > 1 && tokens[1] == "reset") {
+        runner.resetStats();
+        return;
+    }
+    int count = static_cast<int>(tokens.size()) > 1 ? stoi(tokens[1]) : 10;
+
+    auto stats = runner.getStatsByTotalTime();
+    for (int i = 0; i < count && i < static_cast<int>(stats.size()); ++i) {
+        stringstream ss;
+        ss
+            << setprecision(2) << fixed
+            << stats[i].first
+            << " " << "runs=" << stats[i].second.runCount
+            << " " << "total=" << 1000.0f * stats[i].second.totalTime << "ms"
+            << " " << "max=" << 1000.0f * stats[i].second.maxTime << "ms";
+        print(ss.str());
+    }
+}
+
+void Console::cmdRoutineStats(vector<string> tokens) {
+    Routines &routines = _game.services().routines();
+    if (tokens.size() > 1 && tokens[1] == "reset") {
+        routines.resetStats();
+        return;
+    }
+    int count = static_cast<int>(tokens.size()) > 1 ? stoi(tokens[1]) : 10;
+
+    auto stats = routines.getRoutinesByTotalTime();
+    for (int i = 0; i < count && i < static_cast<int>(stats.size()); ++i) {
+        stringstream ss;
+        ss
+            << setprecision(2) << fixed
+            << stats[i]->name()
+            << " " << "calls=" << stats[i]->callCount()
+            << " " << "total=" << 1000.0f * stats[i]->totalTime() << "ms"
+            << " " << "avg=" << 1.0e6f * stats[i]->totalTime() / stats[i]->callCount() << "us";
+        print(ss.str());
+    }
+}
+
+void Console::cmdProfiler(vector<string> tokens) {
+    if (tokens.size() < 2) {
+        print("Usage: profiler on|off|clear|top [count]|export path [instructions]");
+        return;
+    }
+    ScriptProfiler &profiler = _game.services().script().profiler();
+    const string &command = tokens[1];
+
+    if (command == "on" || command == "off") {
+        profiler.setEnabled(command == "on");
+        print(str(boost::format("Script profiler %s") % (profiler.isEnabled() ? "enabled" : "disabled")));
+
+    } else if (command == "clear") {
+        profiler.clear();
+
+    } else if (command == "top") {
+        int count = tokens.size() > 2 ? stoi(tokens[2]) : 10;
+        auto stats = profiler.getFrameStatsBySelfTime();
+        for (int i = 0; i < count && i < static_cast<int>(stats.size()); ++i) {
+            stringstream ss;
+            ss
+                << setprecision(2) << fixed
+                << stats[i].name
+                << " " << "self=" << 1000.0f * stats[i].selfTime << "ms"
+                << " " << "instructions=" << stats[i].instructionCount;
+            print(ss.str());
+        }
+
+    } else if (command == "export") {
+        if (tokens.size() < 3) {
+            print("Usage: profiler export path [instructions]");
+            return;
+        }
+        fs::ofstream out(tokens[2]);
+        profiler.exportCollapsedStacks(out, tokens.size() > 3 && tokens[3] == "instructions");
+        print(str(boost::format("Exported %d profiler records to %s") % profiler.getRecordCount() % tokens[2]));
+
+    } else {
+        print("Unknown profiler command: " + command);
+    }
+}
+
 void Console::print(const string &text) {
     _output.push_front(text);
     trimOutput();
@@ -75,6 +75,9 @@ private:
     void cmdKill(std::vector<std::string> tokens);
     void cmdAddItem(std::vector<std::string> tokens);
     void cmdGiveXP(std::vector<std::string> tokens);
+    void cmdScriptStats(std::vector<std::string> tokens);
+    void cmdRoutineStats(std::vector<std::string> tokens);
+    void cmdProfiler(std::vector<std::string> tokens);
 
     // END Commands
 };
@@ -49,6 +49,10 @@ namespace game {
 static constexpr char kDataDirectoryName[] = "data";
 static constexpr char kModulesDirectoryName[] = "modules";
 
+static constexpr float kMaxFrameTime = 0.25f; /**< frame time is clamped to this to avoid the spiral of death */
+static constexpr int kMaxUpdateStepsPerFrame = 5;
+static constexpr int kOutOfFocusSleepMs = 50;
+
 static bool g_conversationsEnabled = true;
 
 Game::Game(
@@ -70,6 +74,9 @@ Game::Game(
 }
 
 int Game::run() {
+    if (_options.headless) {
+        return runHeadless();
+    }
     init();
     openMainMenu();
 
@@ -100,7 +107,7 @@ void Game::init() {
     _console = make_unique<Console>(*this);
     _console->init();
 
-    _profileOverlay = make_unique<ProfileOverlay>(_graphics);
+    _profileOverlay = make_unique<ProfileOverlay>(_graphics, _game->scriptScheduler());
     _profileOverlay->init();
 
     loadModuleNames();
@@ -141,6 +148,8 @@ void Game::loadModuleNames() {
 }
 
 void Game::setCursorType(CursorType type) {
+    if (_options.headless) return;
+
     if (_cursorType != type) {
         if (type == CursorType::None) {
             _graphics.window().setCursor(nullptr);
@@ -152,6 +161,8 @@ void Game::setCursorType(CursorType type) {
 }
 
 void Game::playVideo(const string &name) {
+    if (_options.headless) return;
+
     fs::path path(getPathIgnoreCase(_path, "movies/" + name + ".bik"));
     if (path.empty()) return;
 
@@ -238,7 +249,9 @@ void Game::loadModule(const string &name, string entry) {
         _graphics.textures().invalidateCache();
         _graphics.models().invalidateCache();
         _graphics.walkmeshes().invalidateCache();
-        _graphics.lips().invalidate();
+        // LIP files are named after globally unique voice-over files, so only
+        // the misses need to be looked up again in the new module
+        _graphics.lips().invalidateMissing();
         _audio.files().invalidate();
         _script.scripts().invalidate();
 
@@ -248,6 +261,7 @@ void Game::loadModule(const string &name, string entry) {
             _module->area()->runOnExitScript();
             _module->area()->unloadParty();
         }
+        _game->scriptScheduler().clear();
 
         _loadScreen->setProgress(50);
         drawAll();
@@ -273,7 +287,7 @@ void Game::loadModule(const string &name, string entry) {
         string musicName(_module->area()->music());
         playMusic(musicName);
 
-        _ticks = SDL_GetTicks();
+        resetFrameTime();
         openInGame();
         _loadFromSaveGame = false;
     });
@@ -309,6 +323,16 @@ void Game::loadModuleResources(const string &moduleName) {
     if (isTSL()) {
         _resource.resources().indexErfFile(getPathIgnoreCase(modulesPath, moduleName + "_dlg.erf"), true);
     }
+
+    precompileModuleScripts();
+}
+
+void Game::precompileModuleScripts() {
+    // Scripts are compiled in the background, while the module is being loaded
+    vector<string> resRefs(_resource.resources().getTransientResRefs(ResourceType::Ncs));
+    _script.scripts().precompile(resRefs, _game->threadPool(), &_game->routines());
+
+    debug(boost::format("Game: precompiling %d module scripts") % resRefs.size(), 1, DebugChannels::script);
 }
 
 void Game::drawAll() {
@@ -361,6 +385,22 @@ Camera *Game::getActiveCamera() const {
     return _module ? &(_module->area()->getCamera(_cameraType)) : nullptr;
 }
 
+void Game::delayAction(uint32_t objectId, unique_ptr<Action> action, float seconds) {
+    DelayedAction delayed;
+    delayed.objectId = objectId;
+    delayed.action = move(action);
+    _delayedActions.schedule(seconds, move(delayed));
+}
+
+void Game::updateDelayedActions(float dt) {
+    _delayedActions.update(dt, [this](DelayedAction &delayed) {
+        shared_ptr<Object> object(getObjectById(delayed.objectId));
+        if (object) {
+            object->addAction(move(delayed.action));
+        }
+    });
+}
+
 shared_ptr<Object> Game::getObjectById(uint32_t id) const {
     switch (id) {
         case kObjectSelf:
@@ -463,18 +503,32 @@ void Game::setLoadFromSaveGame(bool load) {
 }
 
 void Game::runMainLoop() {
-    _ticks = SDL_GetTicks();
+    resetFrameTime();
 
     while (!_quit) {
+        auto frameStart = chrono::steady_clock::now();
+
         _graphics.window().processEvents(_quit);
 
         if (_graphics.window().isInFocus()) {
             update();
             drawAll();
+            limitFrameRate(frameStart);
+        } else {
+            // Do not consume CPU while the window is out of focus
+            this_thread::sleep_for(chrono::milliseconds(kOutOfFocusSleepMs));
+            resetFrameTime();
         }
+    }
+}
 
+void Game::limitFrameRate(const chrono::steady_clock::time_point &frameStart) {
+    if (_options.maxFps <= 0) {
         this_thread::yield();
+        return;
     }
+    auto frameEnd = frameStart + chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<double>(1.0 / _options.maxFps));
+    this_thread::sleep_until(frameEnd);
 }
 
 void Game::update() {
@@ -492,8 +546,7 @@ void Game::update() {
 
     bool updModule = !_video && _module && (_screen == GameScreen::InGame || _screen == GameScreen::Conversation);
     if (updModule && !_paused) {
-        _module->update(dt);
-        _game->combat().update(dt);
+        updateSimulation(dt);
     }
 
     GUI *gui = getScreenGUI();
@@ -505,6 +558,41 @@ void Game::update() {
     _profileOverlay->update(dt);
 }
 
+void Game::updateSimulation(float dt) {
+    if (_options.updateRate <= 0) {
+        updateModule(dt);
+        return;
+    }
+    float step = 1.0f / _options.updateRate;
+    _updateAccumulator += dt;
+
+    int stepCount = 0;
+    while (_updateAccumulator >= step && stepCount < kMaxUpdateStepsPerFrame) {
+        _module->area()->savePreviousTransforms();
+        updateModule(step);
+        _updateAccumulator -= step;
+        ++stepCount;
+
+        // Module might have been changed or unloaded by a script
+        if (!_module || !_nextModule.empty()) {
+            _updateAccumulator = 0.0f;
+            return;
+        }
+    }
+    if (stepCount == kMaxUpdateStepsPerFrame) {
+        // Simulation cannot keep up: drop the remaining time instead of accumulating it
+        _updateAccumulator = glm::min(_updateAccumulator, step);
+    }
+
+    _module->area()->interpolateTransforms(_updateAccumulator / step);
+}
+
+void Game::updateModule(float dt) {
+    _module->update(dt);
+    _game->combat().update(dt);
+    _game->scriptScheduler().update();
+}
+
 void Game::updateVideo(float dt) {
     _video->update(dt);
 
@@ -533,13 +621,18 @@ void Game::loadNextModule() {
 }
 
 float Game::measureFrameTime() {
-    uint32_t ticks = SDL_GetTicks();
-    float dt = (ticks - _ticks) / 1000.0f;
-    _ticks = ticks;
+    auto now = chrono::steady_clock::now();
+    float dt = glm::min(chrono::duration<float>(now - _frameTime).count(), kMaxFrameTime);
+    _frameTime = now;
 
     return dt * _gameSpeed;
 }
 
+void Game::resetFrameTime() {
+    _frameTime = chrono::steady_clock::now();
+    _updateAccumulator = 0.0f;
+}
+
 void Game::loadLoadingScreen() {
     _loadScreen = make_unique<LoadingScreen>(this);
     _loadScreen->load();
@@ -619,7 +712,7 @@ void Game::openInGameMenu(InGameMenu::Tab tab) {
 }
 
 void Game::startDialog(const shared_ptr<SpatialObject> &owner, const string &resRef) {
-    if (!g_conversationsEnabled) return;
+    if (!g_conversationsEnabled || _options.headless) return;
 
     shared_ptr<GffStruct> dlg(_resource.resources().getGFF(resRef, ResourceType::Dlg));
     if (!dlg) {
@@ -646,6 +739,8 @@ void Game::stopMovement() {
 }
 
 void Game::openContainer(const shared_ptr<SpatialObject> &container) {
+    if (_options.headless) return;
+
     stopMovement();
     setRelativeMouseMode(false);
     setCursorType(CursorType::Default);
@@ -654,6 +749,8 @@ void Game::openContainer(const shared_ptr<SpatialObject> &container) {
 }
 
 void Game::openPartySelection(const PartySelection::Context &ctx) {
+    if (_options.headless) return;
+
     stopMovement();
     setRelativeMouseMode(false);
     setCursorType(CursorType::Default);
@@ -670,6 +767,8 @@ void Game::openSaveLoad(SaveLoad::Mode mode) {
 }
 
 void Game::openLevelUp() {
+    if (_options.headless) return;
+
     setRelativeMouseMode(false);
     setCursorType(CursorType::Default);
     _charGen->startLevelUp();
@@ -834,36 +933,39 @@ bool Game::handleKeyDown(const SDL_KeyboardEvent &event) {
 }
 
 bool Game::getGlobalBoolean(const string &name) const {
-    return getFromLookupOrElse(_globalBooleans, name, false);
+    int index = _globals.findIndex(name);
+    return index != -1 && _globals.getBoolean(index);
 }
 
 int Game::getGlobalNumber(const string &name) const {
-    return getFromLookupOrElse(_globalNumbers, name, 0);
+    int index = _globals.findIndex(name);
+    return index != -1 ? _globals.getNumber(index) : 0;
 }
 
 string Game::getGlobalString(const string &name) const {
-    static string empty;
-    return getFromLookupOrElse(_globalStrings, name, empty);
+    int index = _globals.findIndex(name);
+    return index != -1 ? _globals.getString(index) : "";
 }
 
 shared_ptr<Location> Game::getGlobalLocation(const string &name) const {
-    return getFromLookupOrNull(_globalLocations, name);
+    int index = _globals.findIndex(name);
+    return index != -1 ? _globals.getLocation(index) : nullptr;
 }
 
 void Game::setGlobalBoolean(const string &name, bool value) {
-    _globalBooleans[name] = value;
+    _globals.setBoolean(_globals.getIndex(name), value);
 }
 
 void Game::setGlobalNumber(const string &name, int value) {
-    _globalNumbers[name] = value;
+    _globals.setNumber(_globals.getIndex(name), value);
 }
 
 void Game::setGlobalString(const string &name, const string &value) {
-    _globalStrings[name] = value;
+    _globals.setString(_globals.getIndex(name), value);
 }
 
 void Game::setGlobalLocation(const string &name, const shared_ptr<Location> &location) {
-    _globalLocations[name] = location;
+    _globals.setLocation(_globals.getIndex(name), location);
 }
 
 void Game::setPaused(bool paused) {
@@ -19,6 +19,7 @@
 #pragma once
 
 #include "../audio/services.h"
+#include "../common/timingwheel.h"
 #include "../graphics/eventhandler.h"
 #include "../graphics/services.h"
 #include "../resource/services.h"
@@ -28,6 +29,7 @@
 
 #include "camera/camera.h"
 #include "console.h"
+#include "globalvariables.h"
 #include "gui/chargen/chargen.h"
 #include "gui/computer.h"
 #include "gui/container.h"
@@ -42,6 +44,7 @@
 #include "gui/saveload.h"
 #include "object/module.h"
 #include "options.h"
+#include "replay.h"
 #include "services.h"
 
 namespace reone {
@@ -76,7 +79,9 @@ public:
         script::ScriptServices &script);
 
     /**
-     * Initialize the engine, run the main game loop and clean up on exit.
+     * Initialize the engine, run the main game loop and clean up on exit. In
+     * headless mode, simulate the module for a fixed number of steps and
+     * report timings instead.
      *
      * @return the exit code
      */
@@ -165,8 +170,29 @@ public:
     void setGlobalNumber(const std::string &name, int value);
     void setGlobalString(const std::string &name, const std::string &value);
 
+    GlobalVariables &globals() { return _globals; }
+
     // END Globals/locals
 
+    // Delayed actions
+
+    /**
+     * Queues an action on the object, once the specified number of seconds
+     * has passed. Delayed actions belong to the game rather than to an area,
+     * so that those of party members survive module transitions.
+     */
+    void delayAction(uint32_t objectId, std::unique_ptr<Action> action, float seconds);
+
+    /**
+     * Queues actions, whose time has come, on their objects. Actions of
+     * objects that no longer exist are dropped.
+     */
+    void updateDelayedActions(float dt);
+
+    int getDelayedActionCount() const { return _delayedActions.size(); }
+
+    // END Delayed actions
+
     // Saved games
 
     void saveToFile(const boost::filesystem::path &path);
@@ -207,7 +233,8 @@ private:
 
     GameID _gameId { GameID::KotOR };
     GameScreen _screen { GameScreen::MainMenu };
-    uint32_t _ticks { 0 };
+    std::chrono::steady_clock::time_point _frameTime;
+    float _updateAccumulator { 0.0f }; /**< simulation time not yet consumed by fixed steps */
     bool _quit { false };
     std::shared_ptr<video::Video> _video;
     CursorType _cursorType { CursorType::None };
@@ -271,13 +298,21 @@ private:
 
     // Globals/locals
 
-    std::map<std::string, std::string> _globalStrings;
-    std::map<std::string, bool> _globalBooleans;
-    std::map<std::string, int> _globalNumbers;
-    std::map<std::string, std::shared_ptr<Location>> _globalLocations;
+    GlobalVariables _globals;
 
     // END Globals/locals
 
+    // Delayed actions
+
+    struct DelayedAction {
+        uint32_t objectId { 0 };
+        std::unique_ptr<Action> action;
+    };
+
+    TimingWheel<DelayedAction> _delayedActions;
+
+    // END Delayed actions
+
     void init();
     void deinit();
 
@@ -285,6 +320,8 @@ private:
 
     void loadNextModule();
     float measureFrameTime();
+    void resetFrameTime();
+    void limitFrameRate(const std::chrono::steady_clock::time_point &frameStart);
     void playMusic(const std::string &resRef);
     void runMainLoop();
     void toggleInGameCameraType();
@@ -299,6 +336,8 @@ private:
     bool handleKeyDown(const SDL_KeyboardEvent &event);
 
     void updateCamera(float dt);
+    void updateSimulation(float dt);
+    void updateModule(float dt);
     void updateVideo(float dt);
     void updateMusic();
     void updateSceneGraph(float dt);
@@ -315,6 +354,7 @@ private:
 
     void loadModuleNames();
     void loadModuleResources(const std::string &moduleName);
+    void precompileModuleScripts();
 
     // END Resource management
 
@@ -347,6 +387,14 @@ private:
 
     // END Save games
 
+    // Headless mode
+
+    int runHeadless();
+    void loadModuleHeadless(const std::string &name);
+    void applyReplayCommand(const Replay::Command &command);
+
+    // END Headless mode
+
     // Helper methods
 
     void withLoadingScreen(const std::string &imageResRef, const std::function<void()> &block);
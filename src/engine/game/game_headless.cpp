@@ -0,0 +1,261 @@
+/*
+ * Copyright (c) 2020-2021 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  Game routines related to the headless mode.
+ */
+
+#include "game.h"
+
+#include "../common/log.h"
+#include "../common/random.h"
+#include "../graphics/walkmesh/walkmeshes.h"
+#include "../resource/resources.h"
+
+#include "action/movetopoint.h"
+#include "action/objectaction.h"
+#include "party.h"
+
+using namespace std;
+
+using namespace reone::resource;
+using namespace reone::script;
+
+namespace fs = boost::filesystem;
+
+namespace reone {
+
+namespace game {
+
+static constexpr int kDefaultHeadlessUpdateRate = 60;
+static constexpr int kHeadlessScriptStatsCount = 10;
+
+struct HeadlessTimings {
+    float objects { 0.0f };
+    float perception { 0.0f };
+    float heartbeat { 0.0f };
+    float scripts { 0.0f };
+    float combat { 0.0f };
+    float animation { 0.0f };
+    float total { 0.0f };
+};
+
+static float getSeconds(const chrono::steady_clock::time_point &start, const chrono::steady_clock::time_point &end) {
+    return chrono::duration<float>(end - start).count();
+}
+
+int Game::runHeadless() {
+    if (_options.module.empty()) {
+        throw invalid_argument("Module must be specified in headless mode");
+    }
+    setRandomSeed(_options.seed);
+
+    _gameId = determineGameID(_path);
+    initResourceProviders();
+
+    _game = make_unique<GameServices>(*this, _resource, _graphics, _audio, _scene, _script);
+    _game->init();
+
+    _graphics.walkmeshes().setWalkableSurfaces(_game->surfaces().getWalkableSurfaceIndices());
+
+    // Run all queued scripts every step, so that results do not depend on the machine speed
+    _game->scriptScheduler().setFrameBudget(numeric_limits<float>::max());
+
+    Replay replay;
+    if (!_options.replay.empty()) {
+        replay.load(_options.replay);
+    }
+
+    auto loadStart = chrono::steady_clock::now();
+    _game->party().createDefault();
+    loadModuleHeadless(_options.module);
+    float loadTime = getSeconds(loadStart, chrono::steady_clock::now());
+
+    int updateRate = _options.updateRate > 0 ? _options.updateRate : kDefaultHeadlessUpdateRate;
+    float dt = 1.0f / updateRate;
+
+    _game->scriptRunner().resetStats();
+
+    ScriptProfiler &profiler = _script.profiler();
+    if (!_options.profile.empty()) {
+        profiler.clear();
+        profiler.setEnabled(true);
+    }
+
+    HeadlessTimings timings;
+    for (int step = 0; step < _options.headlessSteps; ++step) {
+        for (auto &command : replay.getCommands(step)) {
+            applyReplayCommand(command);
+        }
+        auto moduleStart = chrono::steady_clock::now();
+        _module->update(dt);
+
+        auto combatStart = chrono::steady_clock::now();
+        _game->combat().update(dt);
+
+        auto scriptsStart = chrono::steady_clock::now();
+        _game->scriptScheduler().update();
+
+        auto animationStart = chrono::steady_clock::now();
+        _scene.graph().update(dt);
+
+        auto stepEnd = chrono::steady_clock::now();
+        timings.combat += getSeconds(combatStart, scriptsStart);
+        timings.scripts += getSeconds(scriptsStart, animationStart);
+        timings.animation += getSeconds(animationStart, stepEnd);
+        timings.total += getSeconds(moduleStart, stepEnd);
+
+        // Transitions would make the run depend on more than one module
+        if (!_nextModule.empty()) {
+            warn("Headless: module transition ignored: " + _nextModule);
+            _nextModule.clear();
+            _nextEntry.clear();
+        }
+    }
+
+    const Area::UpdateTimings &areaTimings = _module->area()->updateTimings();
+    timings.objects = areaTimings.objects;
+    timings.perception = areaTimings.perception;
+    timings.heartbeat = areaTimings.heartbeat;
+
+    // State digest allows comparing the outcome of two runs with the same seed and replay
+    uint32_t digest = 2166136261u;
+    auto hashValue = [&digest](uint32_t value) {
+        digest = (digest ^ value) * 16777619u;
+    };
+    for (auto &object : _module->area()->objects()) {
+        const glm::vec3 &position = object->position();
+        uint32_t bits[3];
+        memcpy(bits, &position[0], sizeof(bits));
+        hashValue(object->id());
+        hashValue(bits[0]);
+        hashValue(bits[1]);
+        hashValue(bits[2]);
+        hashValue(static_cast<uint32_t>(object->currentHitPoints()));
+    }
+
+    int stepCount = glm::max(1, _options.headlessSteps);
+
+    cout << boost::format("Module %s loaded in %.3f s") % _options.module % loadTime << endl;
+    cout << boost::format("Simulated %d steps of %.2f ms in %.3f s") % _options.headlessSteps % (1000.0f * dt) % timings.total << endl;
+    cout << boost::format("%-12s %12s %14s") % "Subsystem" % "Total, ms" % "Per step, us" << endl;
+
+    vector<pair<string, float>> subsystems {
+        { "objects", timings.objects },
+        { "perception", timings.perception },
+        { "heartbeat", timings.heartbeat },
+        { "scripts", timings.scripts },
+        { "combat", timings.combat },
+        { "animation", timings.animation },
+        { "total", timings.total }
+    };
+    for (auto &subsystem : subsystems) {
+        cout << boost::format("%-12s %12.3f %14.3f") % subsystem.first % (1000.0f * subsystem.second) % (1e6f * subsystem.second / stepCount) << endl;
+    }
+
+    auto scriptStats = _game->scriptRunner().getStatsByTotalTime();
+    for (int i = 0; i < kHeadlessScriptStatsCount && i < static_cast<int>(scriptStats.size()); ++i) {
+        const ScriptRunner::ScriptStats &stats = scriptStats[i].second;
+        cout << boost::format("script %-16s runs=%d total=%.3fms max=%.3fms") % scriptStats[i].first % stats.runCount % (1000.0f * stats.totalTime) % (1000.0f * stats.maxTime) << endl;
+    }
+
+    if (profiler.isEnabled()) {
+        profiler.setEnabled(false);
+
+        auto frameStats = profiler.getFrameStatsBySelfTime();
+        for (int i = 0; i < kHeadlessScriptStatsCount && i < static_cast<int>(frameStats.size()); ++i) {
+            const ScriptProfiler::FrameStats &stats = frameStats[i];
+            cout << boost::format("frame %-24s self=%.3fms instructions=%d") % stats.name % (1000.0f * stats.selfTime) % stats.instructionCount << endl;
+        }
+        fs::ofstream profile(_options.profile);
+        profiler.exportCollapsedStacks(profile);
+        cout << boost::format("Collapsed script stacks exported to %s") % _options.profile << endl;
+    }
+
+    cout << boost::format("State digest: %08x") % digest << endl;
+
+    return 0;
+}
+
+void Game::loadModuleHeadless(const string &name) {
+    info("Load module '" + name + "' in headless mode");
+
+    loadModuleResources(name);
+
+    _module = _game->objectFactory().newModule();
+
+    shared_ptr<GffStruct> ifo(_resource.resources().getGFF("module", ResourceType::Ifo));
+    if (!ifo) {
+        throw runtime_error("Module not found: " + name);
+    }
+    _module->load(name, *ifo);
+    _module->loadParty();
+    _module->area()->fill(_scene.graph());
+
+    _screen = GameScreen::InGame;
+}
+
+void Game::applyReplayCommand(const Replay::Command &command) {
+    shared_ptr<Creature> leader(_game->party().getLeader());
+
+    if (command.name == "keydown" || command.name == "keyup") {
+        if (command.arguments.empty()) {
+            warn("Replay: key name expected: " + command.name);
+            return;
+        }
+        const char *keyName = command.arguments[0].c_str();
+        bool down = command.name == "keydown";
+
+        SDL_Event event;
+        memset(&event, 0, sizeof(event));
+        event.type = down ? SDL_KEYDOWN : SDL_KEYUP;
+        event.key.state = down ? SDL_PRESSED : SDL_RELEASED;
+        event.key.keysym.scancode = SDL_GetScancodeFromName(keyName);
+        event.key.keysym.sym = SDL_GetKeyFromName(keyName);
+
+        _module->handle(event);
+
+    } else if (command.name == "moveto") {
+        if (command.arguments.size() < 3 || !leader) {
+            warn("Replay: point expected: " + command.name);
+            return;
+        }
+        glm::vec3 point(stof(command.arguments[0]), stof(command.arguments[1]), stof(command.arguments[2]));
+        leader->clearAllActions();
+        leader->addAction(make_unique<MoveToPointAction>(point));
+
+    } else if (command.name == "attack") {
+        if (command.arguments.empty() || !leader) {
+            warn("Replay: tag expected: " + command.name);
+            return;
+        }
+        shared_ptr<SpatialObject> target(_module->area()->getObjectByTag(command.arguments[0]));
+        if (!target) {
+            warn("Replay: object not found: " + command.arguments[0]);
+            return;
+        }
+        leader->clearAllActions();
+        leader->addAction(make_unique<ObjectAction>(ActionType::AttackObject, target, leader->getAttackRange(), true));
+
+    } else {
+        warn("Replay: unsupported command: " + command.name);
+    }
+}
+
+} // namespace game
+
+} // namespace reone
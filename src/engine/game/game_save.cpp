@@ -58,41 +58,41 @@ void Game::saveToFile(const fs::path &path) {
     }
 
     vector<shared_ptr<GffStruct>> nfoGlobalBooleans;
-    for (auto &global : _globalBooleans) {
+    _globals.forEachBoolean([&nfoGlobalBooleans](const string &name, bool value) {
         auto gffs = make_shared<GffStruct>(2, vector<GffStruct::Field> {
-            GffStruct::Field::newCExoString("Name", global.first),
-            GffStruct::Field::newByte("Value", static_cast<uint32_t>(global.second))
+            GffStruct::Field::newCExoString("Name", name),
+            GffStruct::Field::newByte("Value", static_cast<uint32_t>(value))
         });
         nfoGlobalBooleans.push_back(move(gffs));
-    }
+    });
 
     vector<shared_ptr<GffStruct>> nfoGlobalNumbers;
-    for (auto &global : _globalNumbers) {
+    _globals.forEachNumber([&nfoGlobalNumbers](const string &name, int value) {
         auto gffs = make_shared<GffStruct>(2, vector<GffStruct::Field> {
-            GffStruct::Field::newCExoString("Name", global.first),
-            GffStruct::Field::newInt("Value", global.second)
+            GffStruct::Field::newCExoString("Name", name),
+            GffStruct::Field::newInt("Value", value)
         });
         nfoGlobalNumbers.push_back(move(gffs));
-    }
+    });
 
     vector<shared_ptr<GffStruct>> nfoGlobalStrings;
-    for (auto &global : _globalStrings) {
+    _globals.forEachString([&nfoGlobalStrings](const string &name, const string &value) {
         auto gffs = make_shared<GffStruct>(2, vector<GffStruct::Field> {
-            GffStruct::Field::newCExoString("Name", global.first),
-            GffStruct::Field::newCExoString("Value", global.second)
+            GffStruct::Field::newCExoString("Name", name),
+            GffStruct::Field::newCExoString("Value", value)
         });
         nfoGlobalStrings.push_back(move(gffs));
-    }
+    });
 
     vector<shared_ptr<GffStruct>> nfoGlobalLocations;
-    for (auto &global : _globalLocations) {
+    _globals.forEachLocation([&nfoGlobalLocations](const string &name, const Location &location) {
         auto gffs = make_shared<GffStruct>(3, vector<GffStruct::Field> {
-            GffStruct::Field::newCExoString("Name", global.first),
-            GffStruct::Field::newVector("Position", global.second->position()),
-            GffStruct::Field::newFloat("Facing", global.second->facing())
+            GffStruct::Field::newCExoString("Name", name),
+            GffStruct::Field::newVector("Position", location.position()),
+            GffStruct::Field::newFloat("Facing", location.facing())
         });
         nfoGlobalLocations.push_back(move(gffs));
-    }
+    });
 
     auto nfoRoot = make_shared<GffStruct>(0xffffffff);
     nfoRoot->add(GffStruct::Field::newCExoString("LastModule", _module->name()));
@@ -175,6 +175,7 @@ void Game::loadFromFile(const fs::path &path) {
     // Party
     vector<shared_ptr<GffStruct>> nfoParty(nfoRoot->getList("Party"));
     _game->party().clear();
+    _delayedActions.clear();
     for (size_t i = 0; i < nfoParty.size(); ++i) {
         shared_ptr<GffStruct> member(nfoParty[i]);
         int npc = member->getInt("NPC");
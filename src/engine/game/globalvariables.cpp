@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2020-2021 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "globalvariables.h"
+
+#include "../script/variable.h"
+
+#include "enginetype/location.h"
+
+using namespace std;
+
+using namespace reone::script;
+
+namespace reone {
+
+namespace game {
+
+static atomic<uint32_t> g_nextId { 1 };
+
+GlobalVariables::GlobalVariables() : _id(g_nextId++) {
+}
+
+int GlobalVariables::getIndex(const string &name) {
+    auto maybeIndex = _indexByName.find(name);
+    if (maybeIndex != _indexByName.end()) return maybeIndex->second;
+
+    int index = static_cast<int>(_names.size());
+    _indexByName.insert(make_pair(name, index));
+    _names.push_back(name);
+    _flags.push_back(0);
+    _booleans.push_back(false);
+    _numbers.push_back(0);
+    _strings.push_back("");
+    _locations.push_back(nullptr);
+
+    return index;
+}
+
+int GlobalVariables::getIndex(const Variable &name) {
+    if (name.type != VariableType::String) {
+        throw invalid_argument("name must be a string");
+    }
+    int index = name.getCachedIndex(_id);
+    if (index != -1) return index;
+
+    index = getIndex(name.strValue());
+    name.setCachedIndex(_id, index);
+
+    return index;
+}
+
+int GlobalVariables::findIndex(const string &name) const {
+    auto maybeIndex = _indexByName.find(name);
+    return maybeIndex != _indexByName.end() ? maybeIndex->second : -1;
+}
+
+int GlobalVariables::findIndex(const Variable &name) const {
+    if (name.type != VariableType::String) {
+        throw invalid_argument("name must be a string");
+    }
+    int index = name.getCachedIndex(_id);
+    if (index != -1) return index;
+
+    index = findIndex(name.strValue());
+    if (index != -1) {
+        name.setCachedIndex(_id, index);
+    }
+
+    return index;
+}
+
+void GlobalVariables::setBoolean(int index, bool value) {
+    _booleans[index] = value;
+    _flags[index] |= BooleanSet;
+    ++_version;
+}
+
+void GlobalVariables::setNumber(int index, int value) {
+    _numbers[index] = value;
+    _flags[index] |= NumberSet;
+    ++_version;
+}
+
+void GlobalVariables::setString(int index, string value) {
+    _strings[index] = move(value);
+    _flags[index] |= StringSet;
+    ++_version;
+}
+
+void GlobalVariables::setLocation(int index, shared_ptr<Location> location) {
+    _locations[index] = move(location);
+    ++_version;
+}
+
+void GlobalVariables::forEachBoolean(const function<void(const string &, bool)> &fn) const {
+    for (size_t i = 0; i < _names.size(); ++i) {
+        if (_flags[i] & BooleanSet) {
+            fn(_names[i], _booleans[i]);
+        }
+    }
+}
+
+void GlobalVariables::forEachNumber(const function<void(const string &, int)> &fn) const {
+    for (size_t i = 0; i < _names.size(); ++i) {
+        if (_flags[i] & NumberSet) {
+            fn(_names[i], _numbers[i]);
+        }
+    }
+}
+
+void GlobalVariables::forEachString(const function<void(const string &, const string &)> &fn) const {
+    for (size_t i = 0; i < _names.size(); ++i) {
+        if (_flags[i] & StringSet) {
+            fn(_names[i], _strings[i]);
+        }
+    }
+}
+
+void GlobalVariables::forEachLocation(const function<void(const string &, const Location &)> &fn) const {
+    for (size_t i = 0; i < _names.size(); ++i) {
+        if (_locations[i]) {
+            fn(_names[i], *_locations[i]);
+        }
+    }
+}
+
+} // namespace game
+
+} // namespace reone
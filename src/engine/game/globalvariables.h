@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2020-2021 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+namespace reone {
+
+namespace script {
+
+struct Variable;
+
+}
+
+namespace game {
+
+class Location;
+
+/**
+ * Storage of global script variables. Each name is resolved to a slot index
+ * once, after which variables of all types under that name are addressed
+ * by the index. Values are stored in dense per-type arrays.
+ */
+class GlobalVariables : boost::noncopyable {
+public:
+    GlobalVariables();
+
+    /**
+     * @return slot index of the specified name, allocating a slot if necessary
+     */
+    int getIndex(const std::string &name);
+
+    /**
+     * Resolves a name held by a script string. Slot index is cached on the
+     * interned string, so that names coming from script constants are only
+     * looked up once per program.
+     */
+    int getIndex(const script::Variable &name);
+
+    /**
+     * @return slot index of the specified name, or -1 if not found
+     */
+    int findIndex(const std::string &name) const;
+
+    /**
+     * Same as getIndex, but does not allocate a slot.
+     *
+     * @return slot index of the specified name, or -1 if not found
+     */
+    int findIndex(const script::Variable &name) const;
+
+    bool getBoolean(int index) const { return _booleans[index]; }
+    int getNumber(int index) const { return _numbers[index]; }
+    const std::string &getString(int index) const { return _strings[index]; }
+    std::shared_ptr<Location> getLocation(int index) const { return _locations[index]; }
+
+    void setBoolean(int index, bool value);
+    void setNumber(int index, int value);
+    void setString(int index, std::string value);
+    void setLocation(int index, std::shared_ptr<Location> location);
+
+    /**
+     * Version of script variables, incremented whenever a global or a local
+     * variable changes. Used to invalidate results of scripts that only read
+     * variables.
+     */
+    uint32_t version() const { return _version; }
+
+    void incrementVersion() { ++_version; }
+
+    /**
+     * Calls the function for every variable of the respective type that
+     * has been set, in the order of slot allocation.
+     */
+    void forEachBoolean(const std::function<void(const std::string &, bool)> &fn) const;
+    void forEachNumber(const std::function<void(const std::string &, int)> &fn) const;
+    void forEachString(const std::function<void(const std::string &, const std::string &)> &fn) const;
+    void forEachLocation(const std::function<void(const std::string &, const Location &)> &fn) const;
+
+private:
+    enum Flags {
+        BooleanSet = 1,
+        NumberSet = 2,
+        StringSet = 4
+    };
+
+    uint32_t _id; /**< distinguishes indices cached on script strings by different instances */
+    uint32_t _version { 0 };
+    std::unordered_map<std::string, int> _indexByName;
+
+    // Slots
+
+    std::vector<std::string> _names;
+    std::vector<uint8_t> _flags;
+    std::vector<bool> _booleans;
+    std::vector<int> _numbers;
+    std::vector<std::string> _strings;
+    std::vector<std::shared_ptr<Location>> _locations;
+
+    // END Slots
+};
+
+} // namespace game
+
+} // namespace reone
@@ -40,10 +40,13 @@ namespace reone {
 namespace game {
 
 static constexpr float kDefaultEntryDuration = 10.0f;
+static constexpr size_t kMaxVoiceOverCacheSize = 16 * 1024 * 1024; // bytes
 
 static bool g_allEntriesSkippable = false;
 
-Conversation::Conversation(Game *game) : GameGUI(game) {
+Conversation::Conversation(Game *game) :
+    GameGUI(game),
+    _voiceOvers(game->services().resource().resources(), game->services().threadPool(), kMaxVoiceOverCacheSize) {
 }
 
 void Conversation::start(const shared_ptr<Dialog> &dialog, const shared_ptr<SpatialObject> &owner) {
@@ -94,21 +97,27 @@ void Conversation::loadStartEntry() {
 }
 
 int Conversation::indexOfFirstActive(const vector<Dialog::EntryReplyLink> &links) {
-    for (auto &link : links) {
-        if (link.active.empty() || evaluateCondition(link.active)) {
-            return link.index;
-        }
+    vector<bool> active(evaluateConditions(links, true));
+    for (size_t i = 0; i < links.size(); ++i) {
+        if (active[i]) return links[i].index;
     }
     return -1;
 }
 
-bool Conversation::evaluateCondition(const string &scriptResRef) {
-    return _game->services().scriptRunner().run(scriptResRef, _owner->id()) != 0;
+vector<bool> Conversation::evaluateConditions(const vector<Dialog::EntryReplyLink> &links, bool stopAtFirstTrue) {
+    vector<string> resRefs;
+    resRefs.reserve(links.size());
+    for (auto &link : links) {
+        resRefs.push_back(link.active);
+    }
+    return _game->services().scriptRunner().evaluateConditions(resRefs, _owner->id(), stopAtFirstTrue);
 }
 
 void Conversation::finish() {
     onFinish();
 
+    _voiceOvers.clear();
+
     _game->openInGame();
 
     // Run EndConversation script
@@ -127,6 +136,7 @@ void Conversation::loadEntry(int index, bool start) {
     setMessage(_currentEntry->text);
     loadReplies();
     loadVoiceOver();
+    prefetchVoiceOvers();
     scheduleEndOfEntry();
     onLoadEntry();
 
@@ -152,6 +162,13 @@ void Conversation::loadEntry(int index, bool start) {
 void Conversation::onLoadEntry() {
 }
 
+/**
+ * @return voice over ResRef of the entry, either from Sound or from VO_ResRef
+ */
+static string getVoiceResRef(const Dialog::EntryReply &entry) {
+    return !entry.sound.empty() ? entry.sound : entry.voResRef;
+}
+
 void Conversation::loadVoiceOver() {
     // Stop previous voice, if any
     if (_currentVoice) {
@@ -160,20 +177,34 @@ void Conversation::loadVoiceOver() {
         _lipAnimation.reset();
     }
 
-    // Play current voice over either from Sound or from VO_ResRef
-    string voiceResRef;
-    if (!_currentEntry->sound.empty()) {
-        voiceResRef = _currentEntry->sound;
-    }
-    if (voiceResRef.empty() && !_currentEntry->voResRef.empty()) {
-        voiceResRef = _currentEntry->voResRef;
-    }
-    if (!voiceResRef.empty()) {
+    // Play current voice over, prefetched if possible
+    string voiceResRef(getVoiceResRef(*_currentEntry));
+    if (voiceResRef.empty()) return;
+
+    shared_ptr<VoiceOverCache::VoiceOver> voiceOver(_voiceOvers.get(voiceResRef));
+    if (voiceOver && voiceOver->stream) {
+        _currentVoice = _game->services().audio().player().play(voiceOver->stream, AudioType::Voice);
+        _lipAnimation = voiceOver->lipAnimation;
+    } else {
         _currentVoice = _game->services().audio().player().play(voiceResRef, AudioType::Voice);
         _lipAnimation = _game->services().graphics().lips().get(voiceResRef);
     }
 }
 
+void Conversation::prefetchVoiceOvers() {
+    // Entries that might follow the current one, regardless of their conditions
+    vector<string> resRefs;
+    for (auto &reply : _replies) {
+        for (auto &link : reply->entries) {
+            string voiceResRef(getVoiceResRef(_dialog->getEntry(link.index)));
+            if (!voiceResRef.empty()) {
+                resRefs.push_back(move(voiceResRef));
+            }
+        }
+    }
+    _voiceOvers.prefetch(resRefs);
+}
+
 static string getCameraAnimationName(int ordinal) {
     return str(boost::format("cut%03dw") % (ordinal - 1200 + 1));
 }
@@ -200,9 +231,10 @@ void Conversation::scheduleEndOfEntry() {
 
 void Conversation::loadReplies() {
     _replies.clear();
-    for (auto &link : _currentEntry->replies) {
-        if (link.active.empty() || evaluateCondition(link.active)) {
-            _replies.push_back(&_dialog->getReply(link.index));
+    vector<bool> active(evaluateConditions(_currentEntry->replies));
+    for (size_t i = 0; i < _currentEntry->replies.size(); ++i) {
+        if (active[i]) {
+            _replies.push_back(&_dialog->getReply(_currentEntry->replies[i].index));
         }
     }
 
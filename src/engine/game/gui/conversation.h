@@ -25,6 +25,7 @@
 #include "../dialog.h"
 #include "../object/spatial.h"
 #include "../types.h"
+#include "../voiceovercache.h"
 
 #include "gui.h"
 
@@ -96,11 +97,13 @@ private:
     float _entryDuration { 0.0f };
     std::vector<const Dialog::EntryReply *> _replies;
     bool _autoPickFirstReply { false };
+    VoiceOverCache _voiceOvers;
 
     void loadConversationBackground();
     void loadCameraModel();
     void loadStartEntry();
     void loadVoiceOver();
+    void prefetchVoiceOvers();
     void scheduleEndOfEntry();
     void loadReplies();
 
@@ -120,11 +123,11 @@ private:
     int indexOfFirstActive(const std::vector<Dialog::EntryReplyLink> &links);
 
     /**
-     * Executes the specified script and checks its return value.
+     * Evaluates Active scripts of the specified entries/replies in a batch.
      *
-     * @return true if the script returns -1 or 1, false otherwise
+     * @return true for every link that has no Active script, or whose script returns non-zero, false otherwise
      */
-    bool evaluateCondition(const std::string &scriptResRef);
+    std::vector<bool> evaluateConditions(const std::vector<Dialog::EntryReplyLink> &links, bool stopAtFirstTrue = false);
 
     /**
      * Replaces text in the message control.
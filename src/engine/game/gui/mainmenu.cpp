@@ -41,11 +41,6 @@ namespace game {
 
 static constexpr float kKotorModelSize = 1.4f;
 
-static const char kBlueprintResRefCarth[] = "p_carth";
-static const char kBlueprintResRefBastila[] = "p_bastilla";
-static const char kBlueprintResRefAtton[] = "p_atton";
-static const char kBlueprintResRefKreia[] = "p_kreia";
-
 MainMenu::MainMenu(Game *game) : GameGUI(game) {
     if (game->isTSL()) {
         _resRef = "mainmenu8x6_p";
@@ -190,51 +185,7 @@ void MainMenu::onListBoxItemClick(const string &control, const string &item) {
 }
 
 void MainMenu::onModuleSelected(const string &name) {
-    string member1Blueprint;
-    string member2Blueprint;
-    string member3Blueprint;
-
-    if (_game->isTSL()) {
-        member1Blueprint = kBlueprintResRefAtton;
-        member2Blueprint = kBlueprintResRefKreia;
-    } else {
-        member1Blueprint = kBlueprintResRefCarth;
-        member2Blueprint = kBlueprintResRefBastila;
-    }
-    shared_ptr<TwoDA> defaultParty(_game->services().resource().resources().get2DA("defaultparty"));
-    if (defaultParty) {
-        for (int row = 0; row < defaultParty->getRowCount(); ++row) {
-            if (defaultParty->getBool(row, "tsl") == _game->isTSL()) {
-                member1Blueprint = defaultParty->getString(row, "partymember0");
-                member2Blueprint = defaultParty->getString(row, "partymember1");
-                member3Blueprint = defaultParty->getString(row, "partymember2");
-                break;
-            }
-        }
-    }
-
-    Party &party = _game->services().party();
-    if (!member1Blueprint.empty()) {
-        shared_ptr<Creature> player(_game->services().objectFactory().newCreature());
-        player->loadFromBlueprint(member1Blueprint);
-        player->setTag(kObjectTagPlayer);
-        player->setImmortal(true);
-        party.addMember(kNpcPlayer, player);
-        party.setPlayer(player);
-    }
-    if (!member2Blueprint.empty()) {
-        shared_ptr<Creature> companion(_game->services().objectFactory().newCreature());
-        companion->loadFromBlueprint(member2Blueprint);
-        companion->setImmortal(true);
-        party.addMember(0, companion);
-    }
-    if (!member3Blueprint.empty()) {
-        shared_ptr<Creature> companion(_game->services().objectFactory().newCreature());
-        companion->loadFromBlueprint(member3Blueprint);
-        companion->setImmortal(true);
-        party.addMember(1, companion);
-    }
-
+    _game->services().party().createDefault();
     _game->loadModule(name);
 }
 
@@ -25,6 +25,8 @@
 #include "../../graphics/textutil.h"
 #include "../../graphics/window.h"
 
+#include "../script/scheduler.h"
+
 using namespace std;
 
 using namespace reone::graphics;
@@ -33,12 +35,14 @@ namespace reone {
 
 namespace game {
 
-static constexpr int kFrameWidth = 125;
+static constexpr int kFrameWidth = 200;
+static constexpr int kLineCount = 5;
 static constexpr char kFontResRef[] = "fnt_console";
 static constexpr float kRefreshInterval = 1.0f; // seconds
 
-ProfileOverlay::ProfileOverlay(GraphicsServices &graphics) :
+ProfileOverlay::ProfileOverlay(GraphicsServices &graphics, ScriptScheduler &scriptScheduler) :
     _graphics(graphics),
+    _scriptScheduler(scriptScheduler),
     _refreshTimer(kRefreshInterval) {
 }
 
@@ -106,7 +110,7 @@ void ProfileOverlay::draw() {
 
 void ProfileOverlay::drawBackground() {
     glm::mat4 transform(1.0f);
-    transform = glm::scale(transform, glm::vec3(kFrameWidth, 2.0f * _font->height(), 1.0f));
+    transform = glm::scale(transform, glm::vec3(kFrameWidth, kLineCount * _font->height(), 1.0f));
 
     ShaderUniforms uniforms(_graphics.shaders().defaultUniforms());
     uniforms.combined.general.projection = _graphics.window().getOrthoProjection();
@@ -123,6 +127,12 @@ void ProfileOverlay::drawText() {
     ss << "FPS: " << _fps.average << endl;
     ss << "1% Low: " << _fps.onePerLow << endl;
 
+    const ScriptScheduler::Stats &scriptStats = _scriptScheduler.stats();
+    ss << "Scripts: " << scriptStats.lastFrameRunCount << " run, " << scriptStats.pendingCount << " pending" << endl;
+    ss << "Script time: " << setprecision(2) << fixed << 1000.0f * scriptStats.lastFrameTime << " ms" << endl;
+    ss << "Script overruns: " << scriptStats.overrunCount << endl;
+    ss << "Scripts coalesced: " << scriptStats.coalescedCount << endl;
+
     vector<string> lines(breakText(ss.str(), *_font, kFrameWidth));
     glm::vec3 position(0.0f);
 
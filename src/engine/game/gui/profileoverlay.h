@@ -25,9 +25,11 @@ namespace reone {
 
 namespace game {
 
+class ScriptScheduler;
+
 class ProfileOverlay {
 public:
-    ProfileOverlay(graphics::GraphicsServices &graphics);
+    ProfileOverlay(graphics::GraphicsServices &graphics, ScriptScheduler &scriptScheduler);
 
     void init();
     bool handle(const SDL_Event &event);
@@ -41,6 +43,7 @@ private:
     };
 
     graphics::GraphicsServices &_graphics;
+    ScriptScheduler &_scriptScheduler;
 
     uint64_t _frequency { 0 };
     uint64_t _counter { 0 };
@@ -149,6 +149,7 @@ static SavedGame peekSavedGame(const fs::path &path) {
         TgaReader tga("screen", TextureUsage::GUI);
         tga.load(wrap(screenData));
         screen = tga.texture();
+        screen->init();
     }
 
     SavedGame result;
@@ -57,8 +57,8 @@ namespace reone {
 namespace game {
 
 static constexpr float kDefaultFieldOfView = 75.0f;
-static constexpr int kMaxSoundCount = 4;
 static constexpr float kGrassDensityFactor = 0.25f;
+static constexpr float kSpatialGridCellSize = 10.0f;
 
 static bool g_debugPath = false;
 
@@ -66,11 +66,16 @@ Area::Area(uint32_t id, Game *game) :
     Object(id, ObjectType::Area, game),
     _actionExecutor(game),
     _map(game),
-    _heartbeatTimer(kHeartbeatInterval) {
+    _heartbeatTimer(kHeartbeatInterval),
+    _grid(kSpatialGridCellSize) {
 
     init();
 }
 
+Area::~Area() {
+    _grid.clear();
+}
+
 void Area::init() {
     const GraphicsOptions &opts = _game->options().graphics;
     _cameraAspect = opts.width / static_cast<float>(opts.height);
@@ -101,8 +106,16 @@ void Area::loadLYT() {
     LytReader lyt;
     lyt.load(wrap(_game->services().resource().resources().getRaw(_name, ResourceType::Lyt)));
 
+    // Parse room models in parallel
+    vector<string> modelNames;
     for (auto &lytRoom : lyt.rooms()) {
-        shared_ptr<Model> model(_game->services().graphics().models().get(lytRoom.name));
+        modelNames.push_back(lytRoom.name);
+    }
+    vector<shared_ptr<Model>> models(_game->services().graphics().models().getMany(modelNames, _game->services().threadPool()));
+
+    for (size_t i = 0; i < lyt.rooms().size(); ++i) {
+        const LytReader::Room &lytRoom = lyt.rooms()[i];
+        shared_ptr<Model> model(models[i]);
         if (!model) continue;
 
         glm::vec3 position(lytRoom.position.x, lytRoom.position.y, lytRoom.position.z);
@@ -190,6 +203,11 @@ void Area::add(const shared_ptr<SpatialObject> &object) {
     _objects.push_back(object);
     _objectsByType[object->type()].push_back(object);
     _objectsByTag[object->tag()].push_back(object);
+    _grid.add(object);
+
+    if (object->type() == ObjectType::Sound) {
+        _maxSoundDistance = glm::max(_maxSoundDistance, static_cast<Sound &>(*object).maxDistance());
+    }
 
     determineObjectRoom(*object);
 }
@@ -226,6 +244,7 @@ void Area::doDestroyObject(uint32_t objectId) {
             _game->services().scene().graph().removeRoot(sceneNode);
         }
     }
+    _grid.remove(*object);
     {
         auto maybeObject = find_if(_objects.begin(), _objects.end(), [&object](auto &o) { return o.get() == object.get(); });
         if (maybeObject != _objects.end()) {
@@ -366,6 +385,9 @@ void Area::update(float dt) {
     if (!_game->isPaused()) {
         Object::update(dt);
 
+        auto objectsStart = chrono::steady_clock::now();
+
+        _game->updateDelayedActions(dt);
         _actionExecutor.executeActions(_game->module()->area(), dt);
 
         for (auto &room : _rooms) {
@@ -380,8 +402,41 @@ void Area::update(float dt) {
             }
         }
 
+        auto perceptionStart = chrono::steady_clock::now();
         updatePerception(dt);
+
+        auto heartbeatStart = chrono::steady_clock::now();
         updateHeartbeat(dt);
+
+        auto heartbeatEnd = chrono::steady_clock::now();
+        _updateTimings.objects += chrono::duration<float>(perceptionStart - objectsStart).count();
+        _updateTimings.perception += chrono::duration<float>(heartbeatStart - perceptionStart).count();
+        _updateTimings.heartbeat += chrono::duration<float>(heartbeatEnd - heartbeatStart).count();
+    }
+}
+
+void Area::resetUpdateTimings() {
+    _updateTimings = UpdateTimings();
+}
+
+void Area::savePreviousTransforms() {
+    for (auto &object : _objects) {
+        object->savePreviousTransform();
+    }
+}
+
+void Area::interpolateTransforms(float alpha) {
+    for (auto &object : _objects) {
+        object->interpolateTransform(alpha);
+    }
+    if (_game->cameraType() == CameraType::ThirdPerson) {
+        shared_ptr<SpatialObject> partyLeader(_game->services().party().getLeader());
+        if (partyLeader) {
+            glm::vec3 leaderPosition(partyLeader->getInterpolatedPosition(alpha));
+            if (leaderPosition != partyLeader->position()) {
+                update3rdPersonCameraTarget(leaderPosition);
+            }
+        }
     }
 }
 
@@ -634,7 +689,12 @@ void Area::update3rdPersonCameraTarget() {
     shared_ptr<SpatialObject> partyLeader(_game->services().party().getLeader());
     if (!partyLeader) return;
 
-    glm::vec3 position(partyLeader->position());
+    update3rdPersonCameraTarget(partyLeader->position());
+}
+
+void Area::update3rdPersonCameraTarget(const glm::vec3 &leaderPosition) {
+    shared_ptr<SpatialObject> partyLeader(_game->services().party().getLeader());
+    glm::vec3 position(leaderPosition);
 
     auto model = static_pointer_cast<ModelSceneNode>(partyLeader->sceneNode());
     shared_ptr<ModelNode> cameraHook(model->model()->getNodeByName("camerahook"));
@@ -659,12 +719,15 @@ void Area::updateSounds() {
         refPosition = _game->getActiveCamera()->sceneNode()->absoluteTransform()[3];
     }
 
-    vector<pair<Sound *, float>> soundDistances;
+    for (auto &sound : _audibleSounds) {
+        static_cast<Sound &>(*sound).setAudible(false);
+    }
+    _audibleSounds.clear();
 
-    for (auto &sound : _objectsByType[ObjectType::Sound]) {
-        Sound *soundPtr = static_cast<Sound *>(sound.get());
-        soundPtr->setAudible(false);
+    for (auto &object : _grid.getObjectsInRadius(refPosition, _maxSoundDistance)) {
+        if (object->type() != ObjectType::Sound) continue;
 
+        Sound *soundPtr = static_cast<Sound *>(object.get());
         if (!soundPtr->isActive()) continue;
 
         float maxDist2 = soundPtr->maxDistance();
@@ -673,32 +736,19 @@ void Area::updateSounds() {
         float dist2 = soundPtr->getDistanceTo2(refPosition);
         if (dist2 > maxDist2) continue;
 
-        soundDistances.push_back(make_pair(soundPtr, dist2));
-    }
-
-    sort(soundDistances.begin(), soundDistances.end(), [](auto &left, auto &right) {
-        int leftPriority = left.first->priority();
-        int rightPriority = right.first->priority();
-
-        if (leftPriority < rightPriority) return true;
-        if (leftPriority > rightPriority) return false;
-
-        return left.second < right.second;
-    });
-    if (soundDistances.size() > kMaxSoundCount) {
-        soundDistances.erase(soundDistances.begin() + kMaxSoundCount, soundDistances.end());
-    }
-    for (auto &sound : soundDistances) {
-        sound.first->setAudible(true);
+        // Sounds in range are all played, AudioPlayer decides which of them get a voice
+        soundPtr->setAudible(true);
+        _audibleSounds.push_back(object);
     }
 }
 
 void Area::checkTriggersIntersection(const shared_ptr<SpatialObject> &triggerrer) {
     glm::vec2 position2d(triggerrer->position());
 
-    for (auto &object : _objectsByType[ObjectType::Trigger]) {
+    for (auto &object : _grid.getObjectsInRadius(position2d, kDefaultRaycastDistance)) {
+        if (object->type() != ObjectType::Trigger) continue;
+
         auto trigger = static_pointer_cast<Trigger>(object);
-        if (trigger->getDistanceTo2(position2d) > kDefaultRaycastDistance * kDefaultRaycastDistance) continue;
         if (trigger->isTenant(triggerrer) || !trigger->isIn(position2d)) continue;
 
         debug(boost::format("Area: trigger '%s' triggerred by '%s'") % trigger->tag() % triggerrer->tag());
@@ -716,13 +766,15 @@ void Area::checkTriggersIntersection(const shared_ptr<SpatialObject> &triggerrer
 
 void Area::updateHeartbeat(float dt) {
     if (_heartbeatTimer.advance(dt)) {
+        // Heartbeat scripts are spread across frames by the script scheduler. A heartbeat still pending from the previous interval is not queued again
+        ScriptScheduler &scheduler = _game->services().scriptScheduler();
         if (!_onHeartbeat.empty()) {
-            _game->services().scriptRunner().run(_onHeartbeat, _id);
+            scheduler.enqueueUnique(_onHeartbeat, _id);
         }
         for (auto &object : _objects) {
-            string heartbeat(object->getOnHeartbeat());
+            const string &heartbeat = object->getOnHeartbeat();
             if (!heartbeat.empty()) {
-                _game->services().scriptRunner().run(heartbeat, object->id());
+                scheduler.enqueueUnique(heartbeat, object->id());
             }
         }
         _heartbeatTimer.reset(kHeartbeatInterval);
@@ -31,6 +31,7 @@
 #include "../camera/thirdperson.h"
 #include "../map.h"
 #include "../pathfinder.h"
+#include "../spatialgrid.h"
 #include "../types.h"
 
 #include "object.h"
@@ -42,7 +43,6 @@ namespace game {
 const float kHeartbeatInterval = 6.0f;
 
 typedef std::unordered_map<std::string, std::shared_ptr<Room>> RoomMap;
-typedef std::vector<std::shared_ptr<SpatialObject>> ObjectList;
 
 class Game;
 
@@ -51,6 +51,7 @@ public:
     typedef std::vector<std::pair<CreatureType, int>> SearchCriteriaList;
 
     Area(uint32_t id, Game *game);
+    ~Area();
 
     void load(std::string name, const resource::GffStruct &are, const resource::GffStruct &git, bool fromSave = false);
 
@@ -63,6 +64,23 @@ public:
 
     void onPartyLeaderMoved(bool roomChanged = false);
 
+    // Interpolation
+
+    /**
+     * Remembers transforms of all objects. Must be called before every fixed
+     * simulation step.
+     */
+    void savePreviousTransforms();
+
+    /**
+     * Blends transforms of all objects between the last two simulation steps.
+     *
+     * @param alpha fraction of the simulation step elapsed since the last update
+     */
+    void interpolateTransforms(float alpha);
+
+    // END Interpolation
+
     void startDialog(const std::shared_ptr<SpatialObject> &object, const std::string &resRef);
     void update3rdPersonCameraFacing();
     void update3rdPersonCameraTarget();
@@ -185,6 +203,23 @@ public:
 
     // END Scripts
 
+    // Profiling
+
+    /**
+     * Cumulative time spent in stages of the area update, in seconds.
+     */
+    struct UpdateTimings {
+        float objects { 0.0f }; /**< object updates and actions, including pathfinding */
+        float perception { 0.0f };
+        float heartbeat { 0.0f };
+    };
+
+    const UpdateTimings &updateTimings() const { return _updateTimings; }
+
+    void resetUpdateTimings();
+
+    // END Profiling
+
 private:
     struct Grass {
         std::shared_ptr<graphics::Texture> texture;
@@ -195,6 +230,13 @@ private:
         float probabilities[4];
     };
 
+    struct LineOfSight {
+        glm::vec3 subjectPosition { 0.0f };
+        glm::vec3 targetPosition { 0.0f };
+        bool visible { false };
+        uint32_t generation { 0 };
+    };
+
     ActionExecutor _actionExecutor;
     Pathfinder _pathfinder;
     std::string _localizedName;
@@ -209,6 +251,11 @@ private:
     Grass _grass;
     glm::vec3 _ambientColor { 0.0f };
     Timer _perceptionTimer;
+    std::unordered_map<uint64_t, LineOfSight> _lineOfSightCache;
+    uint32_t _perceptionGeneration { 0 };
+    float _maxSoundDistance { 0.0f };
+    ObjectList _audibleSounds;
+    UpdateTimings _updateTimings;
     std::shared_ptr<SpatialObject> _hilightedObject;
     std::shared_ptr<SpatialObject> _selectedObject;
 
@@ -237,6 +284,7 @@ private:
     std::unordered_map<ObjectType, ObjectList> _objectsByType;
     std::unordered_map<std::string, ObjectList> _objectsByTag;
     std::set<uint32_t> _objectsToDestroy;
+    SpatialGrid _grid;
 
     // END Objects
 
@@ -268,6 +316,7 @@ private:
     void doDestroyObject(uint32_t objectId);
     void doDestroyObjects();
     void updateVisibility();
+    void update3rdPersonCameraTarget(const glm::vec3 &leaderPosition);
     void updateSounds();
     void updateHeartbeat(float dt);
 
@@ -367,6 +416,12 @@ private:
 
     void doUpdatePerception();
 
+    /**
+     * @return cached line of sight between subject and target, or nullptr if
+     *         either of them has moved too far since it was last tested
+     */
+    LineOfSight *getCachedLineOfSight(const Creature &subject, const SpatialObject &target);
+
     // END Perception
 
     // Object Selection
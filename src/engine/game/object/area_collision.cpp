@@ -37,15 +37,12 @@ static constexpr float kLineOfSightTestHeight = 1.7f; // TODO: make it appearanc
 bool Area::testElevationAt(const glm::vec2 &point, float &z, int &material, Room *&room) const {
     static glm::vec3 down(0.0f, 0.0f, -1.0f);
 
-    // Test non-walkable faces of object walkmeshes
-    for (auto &o : _objects) {
+    // Test non-walkable faces of object walkmeshes within maximum collision distance
+    for (auto &o : _grid.getObjectsInRadius(point, kMaxCollisionDistance)) {
         auto model = static_pointer_cast<ModelSceneNode>(o->sceneNode());
         shared_ptr<Walkmesh> walkmesh(o->getWalkmesh());
         if (!model || !walkmesh) continue;
 
-        // Distance to object must not exceed maximum collision distance
-        if (o->getDistanceTo2(point) > kMaxCollisionDistance2) continue;
-
         // Test non-walkable faces beneath the specified point (object space)
         glm::vec2 objSpacePos(model->absoluteTransformInverse() * glm::vec4(point, 0.0f, 1.0f));
         float distance;
@@ -90,7 +87,7 @@ shared_ptr<SpatialObject> Area::getObjectAt(int x, int y) const {
 
     // Calculate distances to all selectable objects, return the closest object
     vector<pair<shared_ptr<SpatialObject>, float>> distances;
-    for (auto &o : _objects) {
+    for (auto &o : _grid.getObjectsInRadius(start, kMaxCollisionDistance)) {
         // Skip non-selectable objects and party leader
         if (!o->isSelectable() || o == partyLeader) continue;
 
@@ -121,7 +118,7 @@ bool Area::getCameraObstacle(const glm::vec3 &start, const glm::vec3 &end, glm::
     float maxDistance = glm::length(endToStart);
 
     // Test AABB of door objects
-    for (auto &o : _objects) {
+    for (auto &o : _grid.getObjectsInRadius(start, kMaxCollisionDistance)) {
         if (o->type() != ObjectType::Door) continue;
 
         auto model = static_pointer_cast<ModelSceneNode>(o->sceneNode());
@@ -199,7 +196,7 @@ bool Area::isInLineOfSight(const Creature &subject, const SpatialObject &target)
     glm::vec3 dir(glm::normalize(startToEnd));
     float maxDistance = glm::length(startToEnd);
 
-    for (auto &o : _objects) {
+    for (auto &o : _grid.getObjectsInRadius(start, kMaxCollisionDistance)) {
         if (o->type() != ObjectType::Door) continue;
 
         auto model = static_pointer_cast<ModelSceneNode>(o->sceneNode());
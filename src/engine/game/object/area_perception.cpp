@@ -19,6 +19,8 @@
 
 #include "../../common/log.h"
 
+#include "../game.h"
+
 using namespace std;
 
 namespace reone {
@@ -26,6 +28,8 @@ namespace reone {
 namespace game {
 
 static constexpr float kUpdatePerceptionInterval = 1.0f; // seconds
+static constexpr float kLineOfSightCacheThreshold = 0.5f; // meters
+static constexpr float kLineOfSightCacheThreshold2 = kLineOfSightCacheThreshold * kLineOfSightCacheThreshold;
 
 void Area::updatePerception(float dt) {
     if (_perceptionTimer.advance(dt)) {
@@ -35,54 +39,176 @@ void Area::updatePerception(float dt) {
 }
 
 void Area::doUpdatePerception() {
-    // For each creature, determine a list of creatures it sees
-    ObjectList &creatures = getObjectsByType(ObjectType::Creature);
-    for (auto &object : creatures) {
+    struct Perceived {
+        shared_ptr<SpatialObject> other;
+        bool heard { false };
+        bool seen { false };
+    };
+    struct Perceiver {
+        shared_ptr<Creature> creature;
+        int perceivedBegin { 0 };
+        int perceivedEnd { 0 };
+    };
+    struct LineOfSightTest {
+        const Creature *subject { nullptr };
+        int perceivedIndex { 0 };
+        LineOfSight *lineOfSight { nullptr };
+    };
+
+    ++_perceptionGeneration;
+
+    // For each creature, determine which creatures are within its hearing and sight ranges
+
+    vector<Perceiver> perceivers;
+    vector<Perceived> perceived;
+    vector<LineOfSightTest> lineOfSightTests;
+
+    for (auto &object : getObjectsByType(ObjectType::Creature)) {
         // Skip dead creatures
         if (object->isDead()) continue;
 
         auto creature = static_pointer_cast<Creature>(object);
         float hearingRange2 = creature->perception().hearingRange * creature->perception().hearingRange;
         float sightRange2 = creature->perception().sightRange * creature->perception().sightRange;
+        float maxRange = glm::max(creature->perception().hearingRange, creature->perception().sightRange);
 
-        for (auto &other : creatures) {
-            // Skip self
-            if (other == object) continue;
+        Perceiver perceiver;
+        perceiver.creature = creature;
+        perceiver.perceivedBegin = static_cast<int>(perceived.size());
 
-            bool heard = false;
-            bool seen = false;
+        for (auto &other : _grid.getObjectsInRadius(creature->position(), maxRange)) {
+            // Skip self and non-creatures
+            if (other == object || other->type() != ObjectType::Creature) continue;
 
             float distance2 = creature->getDistanceTo2(*other);
-            if (distance2 <= hearingRange2) {
-                heard = true;
+            bool heard = distance2 <= hearingRange2;
+            bool inSightRange = distance2 <= sightRange2;
+            if (!heard && !inSightRange) continue;
+
+            Perceived entry;
+            entry.other = other;
+            entry.heard = heard;
+            perceived.push_back(move(entry));
+
+            if (!inSightRange) continue;
+
+            // Reuse cached line of sight, unless either creature has moved too far
+            LineOfSight *lineOfSight = getCachedLineOfSight(*creature, *other);
+            if (lineOfSight) {
+                perceived.back().seen = lineOfSight->visible;
+            } else {
+                uint64_t key = (static_cast<uint64_t>(creature->id()) << 32) | other->id();
+                LineOfSightTest test;
+                test.subject = creature.get();
+                test.perceivedIndex = static_cast<int>(perceived.size()) - 1;
+                test.lineOfSight = &_lineOfSightCache[key];
+                test.lineOfSight->subjectPosition = creature->position();
+                test.lineOfSight->targetPosition = other->position();
+                test.lineOfSight->generation = _perceptionGeneration;
+                lineOfSightTests.push_back(move(test));
             }
-            if (distance2 <= sightRange2) {
-                seen = isInLineOfSight(*creature, *other);
+        }
+
+        perceiver.perceivedEnd = static_cast<int>(perceived.size());
+        perceivers.push_back(move(perceiver));
+    }
+
+    // Test line of sight in parallel: these tests only read area state
+
+    _game->services().threadPool().parallelFor(static_cast<int>(lineOfSightTests.size()), [this, &perceived, &lineOfSightTests](int i) {
+        LineOfSightTest &test = lineOfSightTests[i];
+        Perceived &entry = perceived[test.perceivedIndex];
+        test.lineOfSight->visible = isInLineOfSight(*test.subject, *entry.other);
+        entry.seen = test.lineOfSight->visible;
+    });
+
+    // Forget line of sight between creatures that are no longer in range
+
+    for (auto it = _lineOfSightCache.begin(); it != _lineOfSightCache.end();) {
+        if (it->second.generation != _perceptionGeneration) {
+            it = _lineOfSightCache.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    // Dispatch perception events serially, as they run scripts. Events are raised in creature list order, so that scripts run in the same order every time
+
+    ObjectList &creatures = getObjectsByType(ObjectType::Creature);
+    unordered_map<const SpatialObject *, int> creatureOrder;
+    for (auto &object : creatures) {
+        creatureOrder.insert(make_pair(object.get(), static_cast<int>(creatureOrder.size())));
+    }
+
+    vector<pair<int, Perceived>> changes;
+    unordered_set<const SpatialObject *> inRange;
+
+    for (auto &perceiver : perceivers) {
+        const shared_ptr<Creature> &creature = perceiver.creature;
+        changes.clear();
+        inRange.clear();
+
+        for (int i = perceiver.perceivedBegin; i < perceiver.perceivedEnd; ++i) {
+            const Perceived &entry = perceived[i];
+            inRange.insert(entry.other.get());
+            changes.push_back(make_pair(creatureOrder[entry.other.get()], entry));
+        }
+
+        // Creatures that were perceived before, but are out of range now
+        for (auto perceivedSet : { &creature->perception().heard, &creature->perception().seen }) {
+            for (auto &other : *perceivedSet) {
+                auto maybeOrder = creatureOrder.find(other.get());
+                if (maybeOrder == creatureOrder.end() || !inRange.insert(other.get()).second) continue;
+
+                Perceived entry;
+                entry.other = other;
+                changes.push_back(make_pair(maybeOrder->second, move(entry)));
             }
+        }
+
+        sort(changes.begin(), changes.end(), [](auto &left, auto &right) { return left.first < right.first; });
+
+        for (auto &change : changes) {
+            const Perceived &entry = change.second;
 
             // Hearing
-            bool wasHeard = creature->perception().heard.count(other) > 0;
-            if (!wasHeard && heard) {
-                debug(boost::format("Perception: %s heard by %s") % other->tag() % creature->tag(), 2);
-                creature->onObjectHeard(other);
-            } else if (wasHeard && !heard) {
-                debug(boost::format("Perception: %s inaudible to %s") % other->tag() % creature->tag(), 2);
-                creature->onObjectInaudible(other);
+            bool wasHeard = creature->perception().heard.count(entry.other) > 0;
+            if (!wasHeard && entry.heard) {
+                debug(boost::format("Perception: %s heard by %s") % entry.other->tag() % creature->tag(), 2);
+                creature->onObjectHeard(entry.other);
+            } else if (wasHeard && !entry.heard) {
+                debug(boost::format("Perception: %s inaudible to %s") % entry.other->tag() % creature->tag(), 2);
+                creature->onObjectInaudible(entry.other);
             }
 
             // Sight
-            bool wasSeen = creature->perception().seen.count(other) > 0;
-            if (!wasSeen && seen) {
-                debug(boost::format("Perception: %s seen by %s") % other->tag() % creature->tag(), 2);
-                creature->onObjectSeen(other);
-            } else if (wasSeen && !seen) {
-                debug(boost::format("Perception: %s vanished from %s") % other->tag() % creature->tag(), 2);
-                creature->onObjectVanished(other);
+            bool wasSeen = creature->perception().seen.count(entry.other) > 0;
+            if (!wasSeen && entry.seen) {
+                debug(boost::format("Perception: %s seen by %s") % entry.other->tag() % creature->tag(), 2);
+                creature->onObjectSeen(entry.other);
+            } else if (wasSeen && !entry.seen) {
+                debug(boost::format("Perception: %s vanished from %s") % entry.other->tag() % creature->tag(), 2);
+                creature->onObjectVanished(entry.other);
             }
         }
     }
 }
 
+Area::LineOfSight *Area::getCachedLineOfSight(const Creature &subject, const SpatialObject &target) {
+    uint64_t key = (static_cast<uint64_t>(subject.id()) << 32) | target.id();
+
+    auto maybeLineOfSight = _lineOfSightCache.find(key);
+    if (maybeLineOfSight == _lineOfSightCache.end()) return nullptr;
+
+    LineOfSight &lineOfSight = maybeLineOfSight->second;
+    if (glm::distance2(lineOfSight.subjectPosition, subject.position()) > kLineOfSightCacheThreshold2 ||
+        glm::distance2(lineOfSight.targetPosition, target.position()) > kLineOfSightCacheThreshold2) return nullptr;
+
+    lineOfSight.generation = _perceptionGeneration;
+
+    return &lineOfSight;
+}
+
 } // namespace game
 
 } // namespace reone
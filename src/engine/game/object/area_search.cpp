@@ -29,40 +29,23 @@ namespace reone {
 namespace game {
 
 shared_ptr<SpatialObject> Area::getNearestObject(const glm::vec3 &origin, int nth, const std::function<bool(const std::shared_ptr<SpatialObject> &)> &predicate) {
-    vector<pair<shared_ptr<SpatialObject>, float>> candidates;
-
-    for (auto &object : _objects) {
-        if (predicate(object)) {
-            candidates.push_back(make_pair(object, object->getDistanceTo2(origin)));
-        }
-    }
-    sort(candidates.begin(), candidates.end(), [](auto &left, auto &right) { return left.second < right.second; });
+    ObjectList candidates(_grid.getNearestObjects(origin, nth + 1, predicate));
 
     int candidateCount = static_cast<int>(candidates.size());
-    if (nth >= candidateCount) {
+    if (nth < 0 || nth >= candidateCount) {
         debug(boost::format("Area: getNearestObject: nth is out of bounds: %d/%d") % nth % candidateCount, 2);
         return nullptr;
     }
 
-    return candidates[nth].first;
+    return candidates[nth];
 }
 
 shared_ptr<Creature> Area::getNearestCreature(const std::shared_ptr<SpatialObject> &target, const SearchCriteriaList &criterias, int nth) {
-    vector<pair<shared_ptr<Creature>, float>> candidates;
-
-    for (auto &object : getObjectsByType(ObjectType::Creature)) {
-        auto creature = static_pointer_cast<Creature>(object);
-        if (matchesCriterias(*creature, criterias, target)) {
-            float distance2 = creature->getDistanceTo2(*target);
-            candidates.push_back(make_pair(move(creature), distance2));
-        }
-    }
+    ObjectList candidates(_grid.getNearestObjects(target->position(), nth + 1, [this, &target, &criterias](auto &object) {
+        return object->type() == ObjectType::Creature && matchesCriterias(static_cast<Creature &>(*object), criterias, target);
+    }));
 
-    sort(candidates.begin(), candidates.end(), [](auto &left, auto &right) {
-        return left.second < right.second;
-    });
-
-    return nth < candidates.size() ? candidates[nth].first : nullptr;
+    return nth < candidates.size() ? static_pointer_cast<Creature>(candidates[nth]) : nullptr;
 }
 
 bool Area::matchesCriterias(const Creature &creature, const SearchCriteriaList &criterias, std::shared_ptr<SpatialObject> target) const {
@@ -133,21 +116,11 @@ bool Area::matchesCriterias(const Creature &creature, const SearchCriteriaList &
 }
 
 shared_ptr<Creature> Area::getNearestCreatureToLocation(const Location &location, const SearchCriteriaList &criterias, int nth) {
-    vector<pair<shared_ptr<Creature>, float>> candidates;
-
-    for (auto &object : getObjectsByType(ObjectType::Creature)) {
-        auto creature = static_pointer_cast<Creature>(object);
-        if (matchesCriterias(*creature, criterias)) {
-            float distance2 = creature->getDistanceTo2(location.position());
-            candidates.push_back(make_pair(move(creature), distance2));
-        }
-    }
-
-    sort(candidates.begin(), candidates.end(), [](auto &left, auto &right) {
-        return left.second < right.second;
-    });
+    ObjectList candidates(_grid.getNearestObjects(location.position(), nth + 1, [this, &criterias](auto &object) {
+        return object->type() == ObjectType::Creature && matchesCriterias(static_cast<Creature &>(*object), criterias);
+    }));
 
-    return nth < candidates.size() ? candidates[nth].first : nullptr;
+    return nth < candidates.size() ? static_pointer_cast<Creature>(candidates[nth]) : nullptr;
 }
 
 } // namespace game
@@ -506,9 +506,16 @@ void Creature::onObjectSeen(const shared_ptr<SpatialObject> &object) {
 }
 
 void Creature::runOnNoticeScript() {
-    if (!_onNotice.empty()) {
-        _game->services().scriptRunner().run(_onNotice, _id, _perception.lastPerceived->id());
-    }
+    if (_onNotice.empty()) return;
+
+    // Perception state is restored right before the deferred script is run
+    PerceptionType perception = _perception.lastPerception;
+    shared_ptr<SpatialObject> perceived(_perception.lastPerceived);
+
+    _game->services().scriptScheduler().enqueue(_onNotice, _id, perceived->id(), -1, [this, perception, perceived]() {
+        _perception.lastPerception = perception;
+        _perception.lastPerceived = perceived;
+    });
 }
 
 void Creature::onObjectVanished(const shared_ptr<SpatialObject> &object) {
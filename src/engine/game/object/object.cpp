@@ -17,8 +17,10 @@
 
 #include "object.h"
 
-#include "../../common/collectionutil.h"
 #include "../../common/guardutil.h"
+#include "../../common/log.h"
+
+#include "../game.h"
 
 using namespace std;
 
@@ -35,19 +37,32 @@ void Object::update(float dt) {
 }
 
 bool Object::getLocalBoolean(int index) const {
-    return getFromLookupOrElse(_localBooleans, index, false);
+    return index >= 0 && index < kMaxLocalBooleans && _localBooleans[index];
 }
 
 int Object::getLocalNumber(int index) const {
-    return getFromLookupOrElse(_localNumbers, index, 0);
+    return index >= 0 && index < static_cast<int>(_localNumbers.size()) ? _localNumbers[index] : 0;
 }
 
 void Object::setLocalBoolean(int index, bool value) {
+    if (index < 0 || index >= kMaxLocalBooleans) {
+        warn("Object: local boolean index out of range: " + to_string(index));
+        return;
+    }
     _localBooleans[index] = value;
+    _game->globals().incrementVersion();
 }
 
 void Object::setLocalNumber(int index, int value) {
+    if (index < 0 || index >= kMaxLocalNumbers) {
+        warn("Object: local number index out of range: " + to_string(index));
+        return;
+    }
+    if (index >= static_cast<int>(_localNumbers.size())) {
+        _localNumbers.resize(index + 1, 0);
+    }
     _localNumbers[index] = value;
+    _game->globals().incrementVersion();
 }
 
 } // namespace game
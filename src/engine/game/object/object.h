@@ -71,7 +71,6 @@ public:
 
     void addAction(std::unique_ptr<Action> action);
     void addActionOnTop(std::unique_ptr<Action> action);
-    void delayAction(std::unique_ptr<Action> action, float seconds);
 
     bool hasUserActionsPending() const;
 
@@ -99,11 +98,6 @@ public:
     // END Scripts
 
 protected:
-    struct DelayedAction {
-        std::unique_ptr<Action> action;
-        Timer timer;
-    };
-
     Game *_game;
 
     uint32_t _id { 0 };
@@ -125,14 +119,13 @@ protected:
     // Actions
 
     std::deque<std::shared_ptr<Action>> _actions;
-    std::vector<DelayedAction> _delayed;
 
     // END Actions
 
     // Local variables
 
-    std::map<int, bool> _localBooleans;
-    std::map<int, int> _localNumbers;
+    std::bitset<kMaxLocalBooleans> _localBooleans;
+    std::vector<int> _localNumbers; /**< grows up to the highest index set */
 
     // END Local variables
 
@@ -151,7 +144,6 @@ protected:
     void updateActions(float dt);
 
     void removeCompletedActions();
-    void updateDelayedActions(float dt);
 
     // END Actions
 };
@@ -37,16 +37,8 @@ void Object::addActionOnTop(unique_ptr<Action> action) {
     _actions.push_front(move(action));
 }
 
-void Object::delayAction(unique_ptr<Action> action, float seconds) {
-    DelayedAction delayed;
-    delayed.action = move(action);
-    delayed.timer.reset(seconds);
-    _delayed.push_back(move(delayed));
-}
-
 void Object::updateActions(float dt) {
     removeCompletedActions();
-    updateDelayedActions(dt);
 }
 
 void Object::removeCompletedActions() {
@@ -58,20 +50,6 @@ void Object::removeCompletedActions() {
     }
 }
 
-void Object::updateDelayedActions(float dt) {
-    for (auto &delayed : _delayed) {
-        if (delayed.timer.advance(dt)) {
-            _actions.push_back(move(delayed.action));
-        }
-    }
-    auto delayedToRemove = remove_if(
-        _delayed.begin(),
-        _delayed.end(),
-        [](const DelayedAction &delayed) { return delayed.timer.isTimedOut(); });
-
-    _delayed.erase(delayedToRemove, _delayed.end());
-}
-
 bool Object::hasUserActionsPending() const {
     for (auto &action : _actions) {
         if (action->isUserAction()) return true;
@@ -102,7 +102,7 @@ void Sound::update(float dt) {
 
 void Sound::playSound(const string &resRef, bool loop) {
     float gain = _volume / 127.0f;
-    _sound = _game->services().audio().player().play(resRef, AudioType::Sound, loop, gain, _positional, getPosition());
+    _sound = _game->services().audio().player().play(resRef, AudioType::Sound, loop, gain, _positional, getPosition(), _priority);
 }
 
 void Sound::play() {
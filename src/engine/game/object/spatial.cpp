@@ -20,6 +20,7 @@
 #include "../../common/log.h"
 
 #include "../room.h"
+#include "../spatialgrid.h"
 
 #include "item.h"
 #include "objectfactory.h"
@@ -33,6 +34,8 @@ namespace reone {
 
 namespace game {
 
+static constexpr float kMaxInterpolationDistance = 2.0f;
+
 SpatialObject::SpatialObject(
     uint32_t id,
     ObjectType type,
@@ -239,9 +242,18 @@ void SpatialObject::setRoom(Room *room) {
     }
 }
 
+void SpatialObject::setGrid(SpatialGrid *grid) {
+    _grid = grid;
+}
+
 void SpatialObject::setPosition(const glm::vec3 &position) {
+    glm::vec3 oldPosition(_position);
     _position = position;
     updateTransform();
+
+    if (_grid) {
+        _grid->update(*this, oldPosition);
+    }
 }
 
 void SpatialObject::updateTransform() {
@@ -252,6 +264,30 @@ void SpatialObject::updateTransform() {
     }
 }
 
+void SpatialObject::savePreviousTransform() {
+    _previousPosition = _position;
+    _previousOrientation = _orientation;
+    _hasPreviousTransform = true;
+}
+
+void SpatialObject::interpolateTransform(float alpha) {
+    if (!_sceneNode || _stunt || !isInterpolatable()) return;
+
+    glm::mat4 transform(glm::translate(glm::mat4(1.0f), glm::mix(_previousPosition, _position, alpha)));
+    transform *= glm::mat4_cast(glm::slerp(_previousOrientation, _orientation, alpha));
+
+    _sceneNode->setLocalTransform(transform);
+}
+
+bool SpatialObject::isInterpolatable() const {
+    // Teleported objects must not slide across the area
+    return _hasPreviousTransform && glm::distance2(_previousPosition, _position) < kMaxInterpolationDistance * kMaxInterpolationDistance;
+}
+
+glm::vec3 SpatialObject::getInterpolatedPosition(float alpha) const {
+    return isInterpolatable() ? glm::mix(_previousPosition, _position, alpha) : _position;
+}
+
 void SpatialObject::setFacing(float facing) {
     _orientation = glm::quat(glm::vec3(0.0f, 0.0f, facing));
     updateTransform();
@@ -35,6 +35,7 @@ namespace game {
 class Item;
 class ObjectFactory;
 class Room;
+class SpatialGrid;
 
 class SpatialObject : public Object {
 public:
@@ -64,12 +65,14 @@ public:
     virtual std::shared_ptr<graphics::Walkmesh> getWalkmesh() const;
 
     Room *room() const { return _room; }
+    SpatialGrid *grid() const { return _grid; }
     const glm::vec3 &position() const { return _position; }
     const glm::mat4 &transform() const { return _transform; }
     bool visible() const { return _visible; }
     std::shared_ptr<scene::SceneNode> sceneNode() const { return _sceneNode; }
 
     void setRoom(Room *room);
+    void setGrid(SpatialGrid *grid);
     void setPosition(const glm::vec3 &position);
     void setFacing(float facing);
     void setVisible(bool visible);
@@ -118,6 +121,26 @@ public:
 
     // END Stunt mode
 
+    // Interpolation
+
+    /**
+     * Remembers the current position and orientation as the starting point of
+     * the next fixed simulation step.
+     */
+    void savePreviousTransform();
+
+    /**
+     * Sets the local transform of the scene node to a blend of transforms
+     * before and after the last simulation step.
+     *
+     * @param alpha blend factor, where 0 is the previous and 1 is the current transform
+     */
+    void interpolateTransform(float alpha);
+
+    glm::vec3 getInterpolatedPosition(float alpha) const;
+
+    // END Interpolation
+
 protected:
     struct AppliedEffect {
         std::shared_ptr<Effect> effect;
@@ -134,11 +157,20 @@ protected:
     bool _visible { true };
     std::shared_ptr<scene::SceneNode> _sceneNode;
     Room *_room { nullptr };
+    SpatialGrid *_grid { nullptr };
     std::vector<std::shared_ptr<Item>> _items;
     std::deque<AppliedEffect> _effects;
     bool _open { false };
     bool _stunt { false };
 
+    // Interpolation
+
+    glm::vec3 _previousPosition { 0.0f };
+    glm::quat _previousOrientation { 1.0f, 0.0f, 0.0f, 0.0f };
+    bool _hasPreviousTransform { false };
+
+    // END Interpolation
+
     SpatialObject(
         uint32_t id,
         ObjectType type,
@@ -153,6 +185,8 @@ private:
 
     void updateEffects(float dt);
     void applyInstantEffect(Effect &effect);
+
+    bool isInterpolatable() const;
 };
 
 } // namespace game
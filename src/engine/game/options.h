@@ -27,6 +27,18 @@ namespace game {
 struct Options {
     bool developer { false };
     std::string module;
+    int updateRate { 60 }; /**< simulation steps per second, 0 to step once per frame */
+    int maxFps { 0 }; /**< frame rate limit, 0 for unlimited */
+
+    // Headless mode
+
+    bool headless { false }; /**< simulate the module without rendering and audio */
+    std::string replay; /**< path to the input sequence to replay in headless mode */
+    int headlessSteps { 0 }; /**< number of simulation steps to run in headless mode */
+    uint32_t seed { 0 }; /**< random seed used in headless mode */
+    std::string profile; /**< path to export collapsed script stacks to in headless mode */
+
+    // END Headless mode
     graphics::GraphicsOptions graphics;
     audio::AudioOptions audio;
 };
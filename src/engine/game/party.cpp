@@ -19,6 +19,7 @@
 
 #include "../common/log.h"
 #include "../common/random.h"
+#include "../resource/resources.h"
 
 #include "action/follow.h"
 #include "game.h"
@@ -26,15 +27,68 @@
 
 using namespace std;
 
+using namespace reone::resource;
+
 namespace reone {
 
 namespace game {
 
 static constexpr int kMaxMemberCount = 3;
 
+static const char kBlueprintResRefCarth[] = "p_carth";
+static const char kBlueprintResRefBastila[] = "p_bastilla";
+static const char kBlueprintResRefAtton[] = "p_atton";
+static const char kBlueprintResRefKreia[] = "p_kreia";
+
 Party::Party(Game &game) : _game(game) {
 }
 
+void Party::createDefault() {
+    string member1Blueprint;
+    string member2Blueprint;
+    string member3Blueprint;
+
+    if (_game.isTSL()) {
+        member1Blueprint = kBlueprintResRefAtton;
+        member2Blueprint = kBlueprintResRefKreia;
+    } else {
+        member1Blueprint = kBlueprintResRefCarth;
+        member2Blueprint = kBlueprintResRefBastila;
+    }
+    shared_ptr<TwoDA> defaultParty(_game.services().resource().resources().get2DA("defaultparty"));
+    if (defaultParty) {
+        for (int row = 0; row < defaultParty->getRowCount(); ++row) {
+            if (defaultParty->getBool(row, "tsl") == _game.isTSL()) {
+                member1Blueprint = defaultParty->getString(row, "partymember0");
+                member2Blueprint = defaultParty->getString(row, "partymember1");
+                member3Blueprint = defaultParty->getString(row, "partymember2");
+                break;
+            }
+        }
+    }
+
+    if (!member1Blueprint.empty()) {
+        shared_ptr<Creature> player(_game.services().objectFactory().newCreature());
+        player->loadFromBlueprint(member1Blueprint);
+        player->setTag(kObjectTagPlayer);
+        player->setImmortal(true);
+        addMember(kNpcPlayer, player);
+        setPlayer(player);
+    }
+    if (!member2Blueprint.empty()) {
+        shared_ptr<Creature> companion(_game.services().objectFactory().newCreature());
+        companion->loadFromBlueprint(member2Blueprint);
+        companion->setImmortal(true);
+        addMember(0, companion);
+    }
+    if (!member3Blueprint.empty()) {
+        shared_ptr<Creature> companion(_game.services().objectFactory().newCreature());
+        companion->loadFromBlueprint(member3Blueprint);
+        companion->setImmortal(true);
+        addMember(1, companion);
+    }
+}
+
 bool Party::handle(const SDL_Event &event) {
     if (event.type == SDL_KEYDOWN) {
         return handleKeyDown(event.key);
@@ -37,6 +37,12 @@ public:
     void clear();
     void switchLeader();
 
+    /**
+     * Creates the player character and companions from the default party
+     * of the current game.
+     */
+    void createDefault();
+
     bool isEmpty() const;
     bool isSoloMode() const { return _solo; }
 
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2020-2021 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "replay.h"
+
+using namespace std;
+
+namespace fs = boost::filesystem;
+
+namespace reone {
+
+namespace game {
+
+void Replay::load(const fs::path &path) {
+    fs::ifstream stream(path);
+    if (!stream) {
+        throw runtime_error("Replay file not found: " + path.string());
+    }
+    load(stream);
+}
+
+void Replay::load(istream &stream) {
+    _commands.clear();
+    _commandIdx = 0;
+
+    string line;
+    int lineNumber = 0;
+    while (getline(stream, line)) {
+        ++lineNumber;
+        boost::trim(line);
+        if (line.empty() || line[0] == '#') continue;
+
+        vector<string> tokens;
+        boost::split(tokens, line, boost::is_space(), boost::token_compress_on);
+        if (tokens.size() < 2) {
+            throw runtime_error(str(boost::format("Replay: malformed command on line %d") % lineNumber));
+        }
+        Command command;
+        try {
+            command.step = stoi(tokens[0]);
+        } catch (const logic_error &) {
+            throw runtime_error(str(boost::format("Replay: invalid step on line %d") % lineNumber));
+        }
+        command.name = boost::to_lower_copy(tokens[1]);
+        command.arguments.insert(command.arguments.end(), tokens.begin() + 2, tokens.end());
+
+        _commands.push_back(move(command));
+    }
+
+    stable_sort(_commands.begin(), _commands.end(), [](auto &left, auto &right) { return left.step < right.step; });
+}
+
+vector<Replay::Command> Replay::getCommands(int step) {
+    vector<Command> result;
+
+    int commandCount = static_cast<int>(_commands.size());
+    while (_commandIdx < commandCount && _commands[_commandIdx].step <= step) {
+        result.push_back(_commands[_commandIdx++]);
+    }
+
+    return move(result);
+}
+
+} // namespace game
+
+} // namespace reone
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2020-2021 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+namespace reone {
+
+namespace game {
+
+/**
+ * Sequence of player inputs, scheduled by simulation step. Used to drive the
+ * headless simulation reproducibly.
+ *
+ * Each line of a replay file has the form "<step> <command> [arguments]".
+ * Supported commands are:
+ * - keydown <key name>: press a key, e.g. "keydown W"
+ * - keyup <key name>: release a key
+ * - moveto <x> <y> <z>: make the party leader walk to a point
+ * - attack <tag>: make the party leader attack an object with a tag
+ *
+ * Empty lines and lines starting with '#' are ignored.
+ */
+class Replay : boost::noncopyable {
+public:
+    struct Command {
+        int step { 0 };
+        std::string name;
+        std::vector<std::string> arguments;
+    };
+
+    void load(const boost::filesystem::path &path);
+    void load(std::istream &stream);
+
+    /**
+     * @return commands scheduled for the specified step, in file order
+     */
+    std::vector<Command> getCommands(int step);
+
+    const std::vector<Command> &commands() const { return _commands; }
+
+private:
+    std::vector<Command> _commands; /**< sorted by step */
+    int _commandIdx { 0 };
+};
+
+} // namespace game
+
+} // namespace reone
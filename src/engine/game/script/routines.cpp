@@ -66,6 +66,23 @@ const Routine &Routines::get(int index) {
     return _routines[index];
 }
 
+void Routines::resetStats() {
+    for (auto &routine : _routines) {
+        routine.resetStats();
+    }
+}
+
+vector<const Routine *> Routines::getRoutinesByTotalTime() const {
+    vector<const Routine *> result;
+    for (auto &routine : _routines) {
+        if (routine.callCount() > 0) {
+            result.push_back(&routine);
+        }
+    }
+    sort(result.begin(), result.end(), [](auto &left, auto &right) { return left->totalTime() > right->totalTime(); });
+    return move(result);
+}
+
 bool Routines::getBool(const VariablesList &args, int index, bool defValue) const {
     return isOutOfRange(args, index) ?
         defValue :
@@ -80,8 +97,17 @@ float Routines::getFloat(const VariablesList &args, int index, float defValue) c
     return isOutOfRange(args, index) ? defValue : args[index].floatValue;
 }
 
-string Routines::getString(const VariablesList &args, int index, string defValue) const {
-    return isOutOfRange(args, index) ? move(defValue) : args[index].strValue;
+const string &Routines::getString(const VariablesList &args, int index) const {
+    static string empty;
+    return isOutOfRange(args, index) ? empty : args[index].strValue();
+}
+
+int Routines::getGlobalIndex(const VariablesList &args, int index) const {
+    return isOutOfRange(args, index) ? _game.globals().getIndex(string()) : _game.globals().getIndex(args[index]);
+}
+
+int Routines::findGlobalIndex(const VariablesList &args, int index) const {
+    return isOutOfRange(args, index) ? _game.globals().findIndex(string()) : _game.globals().findIndex(args[index]);
 }
 
 glm::vec3 Routines::getVector(const VariablesList &args, int index, glm::vec3 defValue) const {
@@ -149,23 +175,23 @@ shared_ptr<Sound> Routines::getSound(const VariablesList &args, int index, Execu
 }
 
 shared_ptr<Effect> Routines::getEffect(const VariablesList &args, int index) const {
-    return dynamic_pointer_cast<Effect>(isOutOfRange(args, index) ? nullptr : args[index].engineType);
+    return dynamic_pointer_cast<Effect>(isOutOfRange(args, index) ? nullptr : args[index].engineType());
 }
 
 shared_ptr<Event> Routines::getEvent(const VariablesList &args, int index) const {
-    return dynamic_pointer_cast<Event>(isOutOfRange(args, index) ? nullptr : args[index].engineType);
+    return dynamic_pointer_cast<Event>(isOutOfRange(args, index) ? nullptr : args[index].engineType());
 }
 
 shared_ptr<Location> Routines::getLocationEngineType(const VariablesList &args, int index) const {
-    return dynamic_pointer_cast<Location>(isOutOfRange(args, index) ? nullptr : args[index].engineType);
+    return dynamic_pointer_cast<Location>(isOutOfRange(args, index) ? nullptr : args[index].engineType());
 }
 
 shared_ptr<Talent> Routines::getTalent(const VariablesList &args, int index) const {
-    return dynamic_pointer_cast<Talent>(isOutOfRange(args, index) ? nullptr : args[index].engineType);
+    return dynamic_pointer_cast<Talent>(isOutOfRange(args, index) ? nullptr : args[index].engineType());
 }
 
 shared_ptr<ExecutionContext> Routines::getAction(const VariablesList &args, int index) const {
-    return args[index].context;
+    return args[index].context();
 }
 
 } // namespace game
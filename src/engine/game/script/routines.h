@@ -19,6 +19,7 @@
 
 #include "../../common/collectionutil.h"
 #include "../../resource/types.h"
+#include "../../script/argumentlist.h"
 #include "../../script/routine.h"
 #include "../../script/routineprovider.h"
 #include "../../script/types.h"
@@ -52,9 +53,16 @@ public:
 
     const script::Routine &get(int index) override;
 
+    void resetStats();
+
+    /**
+     * @return routines that have been called at least once, ordered by total execution time, descending
+     */
+    std::vector<const script::Routine *> getRoutinesByTotalTime() const;
+
 private:
     typedef std::vector<script::VariableType> VariableTypesList;
-    typedef std::vector<script::Variable> VariablesList;
+    typedef script::ArgumentList VariablesList;
 
     Game &_game;
 
@@ -80,10 +88,22 @@ private:
     bool getBool(const VariablesList &args, int index, bool defValue = false) const;
     int getInt(const VariablesList &args, int index, int defValue = 0) const;
     float getFloat(const VariablesList &args, int index, float defValue = 0.0f) const;
-    std::string getString(const VariablesList &args, int index, std::string defValue = "") const;
+    const std::string &getString(const VariablesList &args, int index) const;
     glm::vec3 getVector(const VariablesList &args, int index, glm::vec3 defValue = glm::vec3(0.0f)) const;
     std::shared_ptr<script::ExecutionContext> getAction(const VariablesList &args, int index) const;
 
+    /**
+     * @return slot index of the global variable, whose name is the specified argument
+     */
+    int getGlobalIndex(const VariablesList &args, int index) const;
+
+    /**
+     * Same as getGlobalIndex, but does not allocate a slot for an unknown name.
+     *
+     * @return slot index of the global variable, or -1 if not found
+     */
+    int findGlobalIndex(const VariablesList &args, int index) const;
+
     std::shared_ptr<Object> getCaller(script::ExecutionContext &ctx) const;
     std::shared_ptr<SpatialObject> getCallerAsSpatial(script::ExecutionContext &ctx) const;
     std::shared_ptr<Creature> getCallerAsCreature(script::ExecutionContext &ctx) const;
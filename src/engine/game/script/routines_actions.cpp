@@ -45,8 +45,13 @@ Variable Routines::delayCommand(const VariablesList &args, ExecutionContext &ctx
     float seconds = getFloat(args, 0);
     auto action = getAction(args, 1);
 
+    auto caller = getCaller(ctx);
+    if (!caller) {
+        debug("Script: delayCommand: caller is invalid", 1, DebugChannels::script);
+        return Variable();
+    }
     auto objectAction = make_unique<CommandAction>(move(action));
-    getCaller(ctx)->delayAction(move(objectAction), seconds);
+    _game.delayAction(caller->id(), move(objectAction), seconds);
 
     return Variable();
 }
@@ -92,7 +97,7 @@ Variable Routines::actionMoveToObject(const VariablesList &args, ExecutionContex
 Variable Routines::actionStartConversation(const VariablesList &args, ExecutionContext &ctx) {
     // TODO: figure out all arguments
     auto objectToConverse = getObject(args, 0, ctx);
-    string dialogResRef(getString(args, 1, ""));
+    string dialogResRef(getString(args, 1));
     bool ignoreStartRange = getBool(args, 4, false);
 
     if (objectToConverse) {
@@ -128,7 +128,7 @@ Variable Routines::getStringByStrRef(const VariablesList &args, ExecutionContext
 
 Variable Routines::startNewModule(const VariablesList &args, ExecutionContext &ctx) {
     string moduleName(boost::to_lower_copy(getString(args, 0)));
-    string waypoint(boost::to_lower_copy(getString(args, 1, "")));
+    string waypoint(boost::to_lower_copy(getString(args, 1)));
 
     _game.scheduleModuleTransition(moduleName, waypoint);
 
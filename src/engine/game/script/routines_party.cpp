@@ -45,7 +45,7 @@ Variable Routines::addAvailableNPCByTemplate(const VariablesList &args, Executio
 }
 
 Variable Routines::showPartySelectionGUI(const VariablesList &args, ExecutionContext &ctx) {
-    string exitScript(boost::to_lower_copy(getString(args, 0, "")));
+    string exitScript(boost::to_lower_copy(getString(args, 0)));
     int forceNpc1 = getInt(args, 1);
     int forceNpc2 = getInt(args, 2);
 
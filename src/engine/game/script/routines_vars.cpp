@@ -35,43 +35,43 @@ namespace reone {
 namespace game {
 
 Variable Routines::getGlobalBoolean(const VariablesList &args, ExecutionContext &ctx) {
-    string id(getString(args, 0));
-    return Variable::ofInt(static_cast<int>(_game.getGlobalBoolean(id)));
+    int index = findGlobalIndex(args, 0);
+    return Variable::ofInt(static_cast<int>(index != -1 && _game.globals().getBoolean(index)));
 }
 
 Variable Routines::setGlobalBoolean(const VariablesList &args, ExecutionContext &ctx) {
-    string id(getString(args, 0));
+    int index = getGlobalIndex(args, 0);
     bool value = getBool(args, 1);
 
-    _game.setGlobalBoolean(id, value);
+    _game.globals().setBoolean(index, value);
 
     return Variable();
 }
 
 Variable Routines::getGlobalNumber(const VariablesList &args, ExecutionContext &ctx) {
-    string id(getString(args, 0));
-    return Variable::ofInt(_game.getGlobalNumber(id));
+    int index = findGlobalIndex(args, 0);
+    return Variable::ofInt(index != -1 ? _game.globals().getNumber(index) : 0);
 }
 
 Variable Routines::setGlobalNumber(const VariablesList &args, ExecutionContext &ctx) {
-    string id(getString(args, 0));
+    int index = getGlobalIndex(args, 0);
     int value = getInt(args, 1);
 
-    _game.setGlobalNumber(id, value);
+    _game.globals().setNumber(index, value);
 
     return Variable();
 }
 
 Variable Routines::getGlobalString(const VariablesList &args, ExecutionContext &ctx) {
-    string id(getString(args, 0));
-    return Variable::ofString(_game.getGlobalString(id));
+    int index = findGlobalIndex(args, 0);
+    return Variable::ofString(index != -1 ? _game.globals().getString(index) : string());
 }
 
 Variable Routines::setGlobalString(const VariablesList &args, ExecutionContext &ctx) {
-    string id(getString(args, 0));
+    int index = getGlobalIndex(args, 0);
     string value(getString(args, 1));
 
-    _game.setGlobalString(id, value);
+    _game.globals().setString(index, move(value));
 
     return Variable();
 }
@@ -133,16 +133,16 @@ Variable Routines::setLocalNumber(const VariablesList &args, ExecutionContext &c
 }
 
 Variable Routines::getGlobalLocation(const VariablesList &args, ExecutionContext &ctx) {
-    string id(getString(args, 0));
-    return Variable::ofLocation(_game.getGlobalLocation(id));
+    int index = findGlobalIndex(args, 0);
+    return Variable::ofLocation(index != -1 ? _game.globals().getLocation(index) : nullptr);
 }
 
 Variable Routines::setGlobalLocation(const VariablesList &args, ExecutionContext &ctx) {
-    string id(getString(args, 0));
+    int index = getGlobalIndex(args, 0);
     auto value = getLocationEngineType(args, 1);
 
     if (value) {
-        _game.setGlobalLocation(id, value);
+        _game.globals().setLocation(index, value);
     } else {
         debug("Script: setGlobalLocation: value is invalid", 1, DebugChannels::script);
     }
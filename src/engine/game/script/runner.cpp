@@ -21,6 +21,7 @@
 #include "../../script/executioncontext.h"
 
 #include "../game.h"
+#include "../globalvariables.h"
 
 using namespace std;
 
@@ -30,7 +31,19 @@ namespace reone {
 
 namespace game {
 
-ScriptRunner::ScriptRunner(Routines &routines, Scripts &scripts) : _routines(routines), _scripts(scripts) {
+static const unordered_set<string> g_pureRoutines {
+    "GetGlobalBoolean",
+    "GetGlobalNumber",
+    "GetGlobalString",
+    "GetLocalBoolean",
+    "GetLocalNumber"
+};
+
+ScriptRunner::ScriptRunner(Routines &routines, Scripts &scripts, ScriptProfiler &profiler, GlobalVariables &globals) :
+    _routines(routines),
+    _scripts(scripts),
+    _profiler(profiler),
+    _globals(globals) {
 }
 
 int ScriptRunner::run(const string &resRef, uint32_t callerId, uint32_t triggerrerId, int userDefinedEventNumber, int scriptVar) {
@@ -44,14 +57,109 @@ int ScriptRunner::run(const string &resRef, uint32_t callerId, uint32_t triggerr
     auto program = _scripts.get(resRef);
     if (!program) return -1;
 
+    auto start = chrono::steady_clock::now();
+    int result = ScriptExecution(program, newContext(callerId, triggerrerId, userDefinedEventNumber, scriptVar)).run();
+    updateStats(resRef, chrono::duration<float>(chrono::steady_clock::now() - start).count());
+
+    return result;
+}
+
+vector<bool> ScriptRunner::evaluateConditions(const vector<string> &resRefs, uint32_t callerId, bool stopAtFirstTrue) {
+    if (callerId == kObjectSelf) {
+        throw invalid_argument("Invalid callerId");
+    }
+    vector<bool> results(resRefs.size(), false);
+    unordered_map<string, bool> batchResults;
+    unique_ptr<ScriptExecution> execution; // created by the first script that has to be run
+
+    for (size_t i = 0; i < resRefs.size(); ++i) {
+        const string &resRef = resRefs[i];
+        bool result = true;
+
+        if (!resRef.empty()) {
+            auto maybeResult = batchResults.find(resRef);
+            if (maybeResult != batchResults.end()) {
+                result = maybeResult->second;
+            } else {
+                result = evaluateCondition(resRef, callerId, execution);
+                batchResults.insert(make_pair(resRef, result));
+            }
+        }
+        results[i] = result;
+
+        if (result && stopAtFirstTrue) break;
+    }
+
+    return move(results);
+}
+
+bool ScriptRunner::evaluateCondition(const string &resRef, uint32_t callerId, unique_ptr<ScriptExecution> &execution) {
+    auto program = _scripts.get(resRef);
+
+    // Missing scripts evaluate to -1, as in run
+    if (!program) return true;
+
+    ConditionResult &cached = _conditionResults[resRef];
+    if (cached.program != program) {
+        cached.program = program;
+        cached.pure = isPure(*program);
+    } else if (cached.pure && cached.callerId == callerId && cached.version == _globals.version()) {
+        return cached.value;
+    }
+
+    auto start = chrono::steady_clock::now();
+    int result;
+    if (execution) {
+        result = execution->run(program);
+    } else {
+        execution = make_unique<ScriptExecution>(program, newContext(callerId, kObjectInvalid, -1, -1));
+        result = execution->run();
+    }
+    updateStats(resRef, chrono::duration<float>(chrono::steady_clock::now() - start).count());
+
+    cached.callerId = callerId;
+    cached.version = _globals.version();
+    cached.value = result != 0;
+
+    return cached.value;
+}
+
+bool ScriptRunner::isPure(const ScriptProgram &program) {
+    for (auto &ins : program.instructions()) {
+        if (ins.byteCode != ByteCode::CallRoutine) continue;
+
+        const Routine &routine = _routines.get(ins.routine);
+        if (g_pureRoutines.count(routine.name()) == 0) return false;
+    }
+    return true;
+}
+
+unique_ptr<ExecutionContext> ScriptRunner::newContext(uint32_t callerId, uint32_t triggerrerId, int userDefinedEventNumber, int scriptVar) {
     auto ctx = make_unique<ExecutionContext>();
     ctx->routines = &_routines;
+    ctx->profiler = &_profiler;
     ctx->callerId = callerId;
     ctx->triggererId = triggerrerId;
     ctx->userDefinedEventNumber = userDefinedEventNumber;
     ctx->scriptVar = scriptVar;
+    return move(ctx);
+}
+
+void ScriptRunner::updateStats(const string &resRef, float time) {
+    ScriptStats &stats = _stats[resRef];
+    stats.runCount++;
+    stats.totalTime += time;
+    stats.maxTime = glm::max(stats.maxTime, time);
+}
+
+void ScriptRunner::resetStats() {
+    _stats.clear();
+}
 
-    return ScriptExecution(program, move(ctx)).run();
+vector<pair<string, ScriptRunner::ScriptStats>> ScriptRunner::getStatsByTotalTime() const {
+    vector<pair<string, ScriptStats>> result(_stats.begin(), _stats.end());
+    sort(result.begin(), result.end(), [](auto &left, auto &right) { return left.second.totalTime > right.second.totalTime; });
+    return move(result);
 }
 
 } // namespace game
@@ -17,17 +17,32 @@
 
 #pragma once
 
+#include "../../script/profiler.h"
 #include "../../script/scripts.h"
 
 #include "routines.h"
 
 namespace reone {
 
+namespace script {
+
+class ScriptExecution;
+
+}
+
 namespace game {
 
+class GlobalVariables;
+
 class ScriptRunner {
 public:
-    ScriptRunner(Routines &routines, script::Scripts &scripts);
+    struct ScriptStats {
+        int runCount { 0 };
+        float totalTime { 0.0f }; /**< seconds */
+        float maxTime { 0.0f }; /**< seconds */
+    };
+
+    ScriptRunner(Routines &routines, script::Scripts &scripts, script::ScriptProfiler &profiler, GlobalVariables &globals);
 
     int run(
         const std::string &resRef,
@@ -36,9 +51,52 @@ public:
         int userDefinedEventNumber = -1,
         int scriptVar = -1);
 
+    /**
+     * Evaluates conditional scripts, i.e. Active scripts of dialog links, on
+     * behalf of the caller in a single execution. A script evaluates to true
+     * if its ResRef is empty or its result is non-zero. Each script is run
+     * at most once per call. Results of pure scripts, that only read global
+     * and local variables, are memoized until a variable changes.
+     *
+     * @param stopAtFirstTrue if true, scripts following the first one that evaluates to true are not evaluated
+     * @return results of the scripts, false for scripts that were not evaluated
+     */
+    std::vector<bool> evaluateConditions(const std::vector<std::string> &resRefs, uint32_t callerId, bool stopAtFirstTrue = false);
+
+    void resetStats();
+
+    /**
+     * @return execution statistics of scripts, ordered by total execution time, descending
+     */
+    std::vector<std::pair<std::string, ScriptStats>> getStatsByTotalTime() const;
+
 private:
+    struct ConditionResult {
+        std::shared_ptr<script::ScriptProgram> program; /**< program that produced the result, kept to detect reloads */
+        bool pure { false };
+        uint32_t callerId { script::kObjectInvalid };
+        uint32_t version { 0 }; /**< version of variables at evaluation */
+        bool value { false };
+    };
+
     Routines &_routines;
     script::Scripts &_scripts;
+    script::ScriptProfiler &_profiler;
+    GlobalVariables &_globals;
+
+    std::unordered_map<std::string, ScriptStats> _stats;
+    std::unordered_map<std::string, ConditionResult> _conditionResults; /**< last result of each conditional script */
+
+    bool evaluateCondition(const std::string &resRef, uint32_t callerId, std::unique_ptr<script::ScriptExecution> &execution);
+
+    /**
+     * @return true if the program calls no routines, other than those reading global and local variables
+     */
+    bool isPure(const script::ScriptProgram &program);
+
+    std::unique_ptr<script::ExecutionContext> newContext(uint32_t callerId, uint32_t triggerrerId, int userDefinedEventNumber, int scriptVar);
+
+    void updateStats(const std::string &resRef, float time);
 };
 
 } // namespace game
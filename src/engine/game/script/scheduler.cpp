@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2020-2021 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "scheduler.h"
+
+#include "../game.h"
+
+#include "runner.h"
+
+using namespace std;
+
+using namespace reone::script;
+
+namespace reone {
+
+namespace game {
+
+static constexpr float kDefaultFrameBudget = 0.002f; // seconds
+
+ScriptScheduler::ScriptScheduler(Game &game, ScriptRunner &runner) :
+    _game(game),
+    _runner(runner),
+    _frameBudget(kDefaultFrameBudget) {
+}
+
+void ScriptScheduler::enqueue(string resRef, uint32_t callerId, uint32_t triggerrerId, int userDefinedEventNumber, function<void()> prepare) {
+    if (resRef.empty()) return;
+
+    ScheduledScript script;
+    script.resRef = move(resRef);
+    script.callerId = callerId;
+    script.triggerrerId = triggerrerId;
+    script.userDefinedEventNumber = userDefinedEventNumber;
+    script.prepare = move(prepare);
+    _queue.push(move(script));
+
+    _stats.pendingCount = static_cast<int>(_queue.size());
+}
+
+bool ScriptScheduler::enqueueUnique(string resRef, uint32_t callerId) {
+    if (resRef.empty()) return false;
+
+    if (!_uniquePending.insert(make_pair(resRef, callerId)).second) {
+        _stats.coalescedCount++;
+        return false;
+    }
+
+    ScheduledScript script;
+    script.resRef = move(resRef);
+    script.callerId = callerId;
+    script.unique = true;
+    _queue.push(move(script));
+
+    _stats.pendingCount = static_cast<int>(_queue.size());
+
+    return true;
+}
+
+void ScriptScheduler::update() {
+    auto start = chrono::steady_clock::now();
+    float time = 0.0f;
+    int runCount = 0;
+
+    while (!_queue.empty() && (runCount == 0 || time < _frameBudget)) {
+        ScheduledScript script(move(_queue.front()));
+        _queue.pop();
+
+        // Allow the script to be queued again, as soon as it is started
+        if (script.unique) {
+            _uniquePending.erase(make_pair(script.resRef, script.callerId));
+        }
+
+        run(script);
+
+        ++runCount;
+        time = chrono::duration<float>(chrono::steady_clock::now() - start).count();
+    }
+
+    if (time > _frameBudget) {
+        _stats.overrunCount++;
+    }
+    if (!_queue.empty()) {
+        _stats.deferredCount++;
+    }
+    _stats.pendingCount = static_cast<int>(_queue.size());
+    _stats.lastFrameRunCount = runCount;
+    _stats.lastFrameTime = time;
+}
+
+void ScriptScheduler::run(ScheduledScript &script) {
+    // Skip scripts of objects destroyed while the script was pending
+    if (!_game.getObjectById(script.callerId)) return;
+
+    if (script.prepare) {
+        script.prepare();
+    }
+    _runner.run(script.resRef, script.callerId, script.triggerrerId, script.userDefinedEventNumber);
+}
+
+void ScriptScheduler::clear() {
+    _queue = queue<ScheduledScript>();
+    _uniquePending.clear();
+    _stats.pendingCount = 0;
+}
+
+void ScriptScheduler::setFrameBudget(float budget) {
+    _frameBudget = budget;
+}
+
+} // namespace game
+
+} // namespace reone
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2020-2021 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "../../script/types.h"
+
+namespace reone {
+
+namespace game {
+
+class Game;
+class ScriptRunner;
+
+/**
+ * Defers execution of scripts, that do not need to run immediately, such as
+ * heartbeat, perception and user-defined event scripts. Queued scripts are
+ * executed in FIFO order, within a per-frame time budget.
+ */
+class ScriptScheduler : boost::noncopyable {
+public:
+    struct Stats {
+        int pendingCount { 0 }; /**< number of scripts waiting to be run */
+        int lastFrameRunCount { 0 }; /**< number of scripts run in the last frame */
+        float lastFrameTime { 0.0f }; /**< time spent running scripts in the last frame, in seconds */
+        int overrunCount { 0 }; /**< number of frames in which time budget was exceeded */
+        int deferredCount { 0 }; /**< number of frames that ended with scripts still pending */
+        int coalescedCount { 0 }; /**< number of scripts not queued, because an identical one was pending */
+    };
+
+    ScriptScheduler(Game &game, ScriptRunner &runner);
+    virtual ~ScriptScheduler() = default;
+
+    /**
+     * Queues a script for execution.
+     *
+     * @param prepare optional function to call right before running the script, only if caller still exists
+     */
+    void enqueue(
+        std::string resRef,
+        uint32_t callerId,
+        uint32_t triggerrerId = script::kObjectInvalid,
+        int userDefinedEventNumber = -1,
+        std::function<void()> prepare = nullptr);
+
+    /**
+     * Queues a script for execution, unless the same script is already
+     * pending for the same caller. Used for periodic scripts, such as
+     * heartbeats, so that they do not pile up when the budget is exceeded.
+     *
+     * @return true if the script was queued, false otherwise
+     */
+    bool enqueueUnique(std::string resRef, uint32_t callerId);
+
+    /**
+     * Runs queued scripts, until either the queue is empty or the time budget
+     * is exhausted. At least one script is run per call.
+     */
+    void update();
+
+    void clear();
+
+    const Stats &stats() const { return _stats; }
+
+    void setFrameBudget(float budget);
+
+protected:
+    struct ScheduledScript {
+        std::string resRef;
+        uint32_t callerId { script::kObjectInvalid };
+        uint32_t triggerrerId { script::kObjectInvalid };
+        int userDefinedEventNumber { -1 };
+        std::function<void()> prepare;
+        bool unique { false };
+    };
+
+    /**
+     * Runs the script, unless its caller was destroyed while the script was
+     * pending.
+     */
+    virtual void run(ScheduledScript &script);
+
+private:
+    Game &_game;
+    ScriptRunner &_runner;
+
+    std::queue<ScheduledScript> _queue;
+    std::set<std::pair<std::string, uint32_t>> _uniquePending; /**< resRef and caller of pending unique scripts */
+    float _frameBudget; /**< seconds */
+    Stats _stats;
+};
+
+} // namespace game
+
+} // namespace reone
@@ -48,6 +48,8 @@ GameServices::GameServices(
 }
 
 void GameServices::init() {
+    _threadPool = make_unique<ThreadPool>();
+
     _surfaces = make_unique<Surfaces>(_resource.resources());
     _surfaces->init();
 
@@ -61,7 +63,8 @@ void GameServices::init() {
     _routines = make_unique<Routines>(_game);
     _routines->init();
 
-    _scriptRunner = make_unique<ScriptRunner>(*_routines, _script.scripts());
+    _scriptRunner = make_unique<ScriptRunner>(*_routines, _script.scripts(), _script.profiler(), _game.globals());
+    _scriptScheduler = make_unique<ScriptScheduler>(_game, *_scriptRunner);
 
     _reputes = make_unique<Reputes>(_resource.resources());
     _reputes->init();
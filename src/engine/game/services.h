@@ -18,6 +18,7 @@
 #pragma once
 
 #include "../audio/services.h"
+#include "../common/threadpool.h"
 #include "../graphics/services.h"
 #include "../resource/services.h"
 #include "../scene/services.h"
@@ -37,6 +38,7 @@
 #include "reputes.h"
 #include "script/routines.h"
 #include "script/runner.h"
+#include "script/scheduler.h"
 #include "soundsets.h"
 #include "surfaces.h"
 
@@ -76,10 +78,12 @@ public:
     Reputes &reputes() { return *_reputes; }
     Routines &routines() { return *_routines; }
     ScriptRunner &scriptRunner() { return *_scriptRunner; }
+    ScriptScheduler &scriptScheduler() { return *_scriptScheduler; }
     SoundSets &soundSets() { return *_soundSets; }
     Skills &skills() { return *_skills; }
     Spells &spells() { return *_spells; }
     Surfaces &surfaces() { return *_surfaces; }
+    ThreadPool &threadPool() { return *_threadPool; }
 
 private:
     Game &_game;
@@ -101,10 +105,12 @@ private:
     std::unique_ptr<Reputes> _reputes;
     std::unique_ptr<Routines> _routines;
     std::unique_ptr<ScriptRunner> _scriptRunner;
+    std::unique_ptr<ScriptScheduler> _scriptScheduler;
     std::unique_ptr<SoundSets> _soundSets;
     std::unique_ptr<Skills> _skills;
     std::unique_ptr<Spells> _spells;
     std::unique_ptr<Surfaces> _surfaces;
+    std::unique_ptr<ThreadPool> _threadPool;
 };
 
 } // namespace game
@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2020-2021 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "spatialgrid.h"
+
+#include "object/spatial.h"
+
+using namespace std;
+
+namespace reone {
+
+namespace game {
+
+SpatialGrid::SpatialGrid(float cellSize) : _cellSize(cellSize) {
+    if (cellSize <= 0.0f) {
+        throw invalid_argument("cellSize must be greater than zero");
+    }
+}
+
+void SpatialGrid::add(const shared_ptr<SpatialObject> &object) {
+    addToCell(getCellCoords(object->position()), object);
+    object->setGrid(this);
+}
+
+void SpatialGrid::remove(const SpatialObject &object) {
+    shared_ptr<SpatialObject> removed(removeFromCell(getCellCoords(object.position()), object));
+    if (removed) {
+        removed->setGrid(nullptr);
+    }
+}
+
+void SpatialGrid::clear() {
+    for (auto &cell : _cells) {
+        for (auto &object : cell.second) {
+            object->setGrid(nullptr);
+        }
+    }
+    _cells.clear();
+    _minCoords = make_pair(numeric_limits<int>::max(), numeric_limits<int>::max());
+    _maxCoords = make_pair(numeric_limits<int>::min(), numeric_limits<int>::min());
+}
+
+void SpatialGrid::update(const SpatialObject &object, const glm::vec3 &oldPosition) {
+    CellCoords oldCoords(getCellCoords(oldPosition));
+    CellCoords newCoords(getCellCoords(object.position()));
+    if (oldCoords == newCoords) return;
+
+    shared_ptr<SpatialObject> removed(removeFromCell(oldCoords, object));
+    if (removed) {
+        addToCell(newCoords, move(removed));
+    }
+}
+
+ObjectList SpatialGrid::getObjectsInRadius(const glm::vec2 &center, float radius) const {
+    ObjectList result;
+
+    CellCoords minCoords(getCellCoords(center - radius));
+    CellCoords maxCoords(getCellCoords(center + radius));
+    minCoords.first = glm::max(minCoords.first, _minCoords.first);
+    minCoords.second = glm::max(minCoords.second, _minCoords.second);
+    maxCoords.first = glm::min(maxCoords.first, _maxCoords.first);
+    maxCoords.second = glm::min(maxCoords.second, _maxCoords.second);
+
+    float radius2 = radius * radius;
+
+    for (int y = minCoords.second; y <= maxCoords.second; ++y) {
+        for (int x = minCoords.first; x <= maxCoords.first; ++x) {
+            auto maybeCell = _cells.find(getCellKey(make_pair(x, y)));
+            if (maybeCell == _cells.end()) continue;
+
+            for (auto &object : maybeCell->second) {
+                if (object->getDistanceTo2(center) <= radius2) {
+                    result.push_back(object);
+                }
+            }
+        }
+    }
+
+    return move(result);
+}
+
+ObjectList SpatialGrid::getNearestObjects(const glm::vec3 &origin, int count, const Predicate &predicate) const {
+    if (count <= 0 || _cells.empty()) return ObjectList();
+
+    typedef pair<float, shared_ptr<SpatialObject>> Candidate;
+
+    auto compareCandidates = [](auto &left, auto &right) { return left.first < right.first; };
+
+    // Max-heap of the best candidates found so far, its top being the farthest of them
+    vector<Candidate> candidates;
+
+    CellCoords center(getCellCoords(origin));
+    int maxRing = glm::max(
+        glm::max(center.first - _minCoords.first, _maxCoords.first - center.first),
+        glm::max(center.second - _minCoords.second, _maxCoords.second - center.second));
+
+    auto visitCell = [&](int x, int y) {
+        if (x < _minCoords.first || x > _maxCoords.first || y < _minCoords.second || y > _maxCoords.second) return;
+
+        auto maybeCell = _cells.find(getCellKey(make_pair(x, y)));
+        if (maybeCell == _cells.end()) return;
+
+        for (auto &object : maybeCell->second) {
+            if (!predicate(object)) continue;
+
+            float distance2 = object->getDistanceTo2(origin);
+            if (candidates.size() < static_cast<size_t>(count)) {
+                candidates.push_back(make_pair(distance2, object));
+                push_heap(candidates.begin(), candidates.end(), compareCandidates);
+            } else if (distance2 < candidates.front().first) {
+                pop_heap(candidates.begin(), candidates.end(), compareCandidates);
+                candidates.back() = make_pair(distance2, object);
+                push_heap(candidates.begin(), candidates.end(), compareCandidates);
+            }
+        }
+    };
+
+    for (int ring = 0; ring <= maxRing; ++ring) {
+        // Objects in this ring are at least (ring - 1) cells away from the origin
+        if (ring > 0 && candidates.size() == static_cast<size_t>(count)) {
+            float minRingDistance = (ring - 1) * _cellSize;
+            if (candidates.front().first <= minRingDistance * minRingDistance) break;
+        }
+        if (ring == 0) {
+            visitCell(center.first, center.second);
+            continue;
+        }
+        for (int x = center.first - ring; x <= center.first + ring; ++x) {
+            visitCell(x, center.second - ring);
+            visitCell(x, center.second + ring);
+        }
+        for (int y = center.second - ring + 1; y <= center.second + ring - 1; ++y) {
+            visitCell(center.first - ring, y);
+            visitCell(center.first + ring, y);
+        }
+    }
+
+    sort_heap(candidates.begin(), candidates.end(), compareCandidates);
+
+    ObjectList result;
+    result.reserve(candidates.size());
+    for (auto &candidate : candidates) {
+        result.push_back(move(candidate.second));
+    }
+
+    return move(result);
+}
+
+SpatialGrid::CellCoords SpatialGrid::getCellCoords(const glm::vec2 &position) const {
+    return make_pair(
+        static_cast<int>(glm::floor(position.x / _cellSize)),
+        static_cast<int>(glm::floor(position.y / _cellSize)));
+}
+
+uint64_t SpatialGrid::getCellKey(const CellCoords &coords) const {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(coords.first)) << 32) | static_cast<uint32_t>(coords.second);
+}
+
+void SpatialGrid::addToCell(const CellCoords &coords, shared_ptr<SpatialObject> object) {
+    _cells[getCellKey(coords)].push_back(move(object));
+
+    _minCoords.first = glm::min(_minCoords.first, coords.first);
+    _minCoords.second = glm::min(_minCoords.second, coords.second);
+    _maxCoords.first = glm::max(_maxCoords.first, coords.first);
+    _maxCoords.second = glm::max(_maxCoords.second, coords.second);
+}
+
+shared_ptr<SpatialObject> SpatialGrid::removeFromCell(const CellCoords &coords, const SpatialObject &object) {
+    auto maybeCell = _cells.find(getCellKey(coords));
+    if (maybeCell == _cells.end()) return nullptr;
+
+    ObjectList &cellObjects = maybeCell->second;
+    auto maybeObject = find_if(cellObjects.begin(), cellObjects.end(), [&object](auto &o) { return o.get() == &object; });
+    if (maybeObject == cellObjects.end()) return nullptr;
+
+    shared_ptr<SpatialObject> result(move(*maybeObject));
+    cellObjects.erase(maybeObject);
+    if (cellObjects.empty()) {
+        _cells.erase(maybeCell);
+    }
+
+    return move(result);
+}
+
+} // namespace game
+
+} // namespace reone
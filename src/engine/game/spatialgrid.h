@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2020-2021 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+namespace reone {
+
+namespace game {
+
+class SpatialObject;
+
+typedef std::vector<std::shared_ptr<SpatialObject>> ObjectList;
+
+/**
+ * Uniform 2D grid of spatial objects, used to accelerate proximity queries
+ * within an area. Objects are bucketed by their XY position and moved between
+ * cells by SpatialObject::setPosition.
+ */
+class SpatialGrid : boost::noncopyable {
+public:
+    typedef std::function<bool(const std::shared_ptr<SpatialObject> &)> Predicate;
+
+    SpatialGrid(float cellSize);
+
+    void add(const std::shared_ptr<SpatialObject> &object);
+    void remove(const SpatialObject &object);
+
+    /**
+     * Removes all objects from this grid.
+     */
+    void clear();
+
+    /**
+     * Moves the object into another cell, if its new position requires it.
+     *
+     * @param oldPosition position of the object prior to the change
+     */
+    void update(const SpatialObject &object, const glm::vec3 &oldPosition);
+
+    /**
+     * @return all objects, whose 2D distance to center does not exceed radius
+     */
+    ObjectList getObjectsInRadius(const glm::vec2 &center, float radius) const;
+
+    /**
+     * Find at most count nearest objects for which the specified predicate
+     * returns true. Cells are visited in rings of increasing size around the
+     * origin, stopping as soon as no closer objects can be found.
+     *
+     * @return objects ordered by 3D distance to origin
+     */
+    ObjectList getNearestObjects(const glm::vec3 &origin, int count, const Predicate &predicate) const;
+
+    float cellSize() const { return _cellSize; }
+
+private:
+    typedef std::pair<int, int> CellCoords;
+
+    float _cellSize;
+    std::unordered_map<uint64_t, ObjectList> _cells;
+
+    // Bounds of cells that were ever occupied
+
+    CellCoords _minCoords { std::numeric_limits<int>::max(), std::numeric_limits<int>::max() };
+    CellCoords _maxCoords { std::numeric_limits<int>::min(), std::numeric_limits<int>::min() };
+
+    // END Bounds of cells that were ever occupied
+
+    CellCoords getCellCoords(const glm::vec2 &position) const;
+    uint64_t getCellKey(const CellCoords &coords) const;
+
+    void addToCell(const CellCoords &coords, std::shared_ptr<SpatialObject> object);
+    std::shared_ptr<SpatialObject> removeFromCell(const CellCoords &coords, const SpatialObject &object);
+};
+
+} // namespace game
+
+} // namespace reone
@@ -33,6 +33,8 @@ constexpr float kDefaultFollowDistance = 5.0f;
 constexpr char kObjectTagPlayer[] = "player";
 constexpr float kDefaultRaycastDistance = 8.0f;
 constexpr float kSelectionDistance = 8.0f;
+constexpr int kMaxLocalBooleans = 256; /**< local variable indices used by game scripts are small */
+constexpr int kMaxLocalNumbers = 256;
 
 enum class GameID {
     KotOR,
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2020-2021 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "voiceovercache.h"
+
+#include "../audio/files.h"
+#include "../common/log.h"
+#include "../common/streamutil.h"
+#include "../graphics/lip/lipreader.h"
+
+using namespace std;
+
+using namespace reone::audio;
+using namespace reone::graphics;
+using namespace reone::resource;
+
+namespace reone {
+
+namespace game {
+
+VoiceOverCache::VoiceOverCache(Resources &resources, ThreadPool &threadPool, size_t maxSize) :
+    _resources(resources),
+    _threadPool(threadPool),
+    _maxSize(maxSize) {
+}
+
+void VoiceOverCache::prefetch(const vector<string> &resRefs) {
+    ++_useCounter;
+
+    for (auto &resRef : resRefs) {
+        auto maybeEntry = _entries.find(resRef);
+        if (maybeEntry != _entries.end()) {
+            maybeEntry->second.lastUsed = _useCounter;
+            continue;
+        }
+        Resources &resources = _resources;
+        Entry entry;
+        entry.voiceOver = _threadPool.enqueue([&resources, resRef]() { return load(resources, resRef); }).share();
+        entry.lastUsed = _useCounter;
+        _entries.insert(make_pair(resRef, move(entry)));
+    }
+
+    evict();
+}
+
+shared_ptr<VoiceOverCache::VoiceOver> VoiceOverCache::load(Resources &resources, const string &resRef) {
+    auto voiceOver = make_shared<VoiceOver>();
+
+    shared_ptr<ByteArray> data(resources.getRawUncached(resRef, ResourceType::Mp3, false));
+    ResourceType type = ResourceType::Mp3;
+    if (!data) {
+        data = resources.getRawUncached(resRef, ResourceType::Wav, false);
+        type = ResourceType::Wav;
+    }
+    if (data) {
+        voiceOver->size = data->size();
+        voiceOver->stream = AudioFiles::load(move(data), type);
+    }
+
+    shared_ptr<ByteArray> lipData(resources.getRawUncached(resRef, ResourceType::Lip, false));
+    if (lipData) {
+        LipReader lip;
+        lip.load(wrap(lipData));
+        voiceOver->lipAnimation = lip.animation();
+        voiceOver->size += lipData->size();
+    }
+
+    return move(voiceOver);
+}
+
+void VoiceOverCache::evict() {
+    // Entries being loaded are not evicted, as their size is yet unknown
+    size_t size = 0;
+    vector<pair<uint32_t, string>> candidates;
+    for (auto &entry : _entries) {
+        if (entry.second.voiceOver.wait_for(chrono::seconds(0)) != future_status::ready) continue;
+
+        shared_ptr<VoiceOver> voiceOver;
+        try {
+            voiceOver = entry.second.voiceOver.get();
+        } catch (const exception &) {
+        }
+        size += voiceOver ? voiceOver->size : 0;
+        if (entry.second.lastUsed != _useCounter) {
+            candidates.push_back(make_pair(entry.second.lastUsed, entry.first));
+        }
+    }
+    if (size <= _maxSize) return;
+
+    sort(candidates.begin(), candidates.end());
+    for (auto &candidate : candidates) {
+        auto maybeEntry = _entries.find(candidate.second);
+        shared_ptr<VoiceOver> voiceOver;
+        try {
+            voiceOver = maybeEntry->second.voiceOver.get();
+        } catch (const exception &) {
+        }
+        size -= voiceOver ? voiceOver->size : 0;
+        _entries.erase(maybeEntry);
+
+        if (size <= _maxSize) break;
+    }
+}
+
+shared_ptr<VoiceOverCache::VoiceOver> VoiceOverCache::get(const string &resRef) {
+    auto maybeEntry = _entries.find(resRef);
+    if (maybeEntry == _entries.end()) return nullptr;
+
+    maybeEntry->second.lastUsed = ++_useCounter;
+    try {
+        return maybeEntry->second.voiceOver.get();
+    } catch (const exception &ex) {
+        warn(boost::format("VoiceOverCache: %s: loading failed: %s") % resRef % ex.what());
+        _entries.erase(maybeEntry);
+        return nullptr;
+    }
+}
+
+void VoiceOverCache::clear() {
+    _entries.clear();
+}
+
+} // namespace game
+
+} // namespace reone
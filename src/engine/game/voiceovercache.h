@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2020-2021 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <future>
+
+#include "../audio/stream.h"
+#include "../common/threadpool.h"
+#include "../graphics/lip/animation.h"
+#include "../resource/resources.h"
+
+namespace reone {
+
+namespace game {
+
+/**
+ * Bounded cache of dialog voice-overs, loaded in the background. While an
+ * entry is being played, voice-overs of entries that might follow it are
+ * read and prepared for playback on worker threads.
+ */
+class VoiceOverCache : boost::noncopyable {
+public:
+    struct VoiceOver {
+        std::shared_ptr<audio::AudioStream> stream;
+        std::shared_ptr<graphics::LipAnimation> lipAnimation;
+        size_t size { 0 }; /**< size of the audio data in bytes */
+    };
+
+    /**
+     * @param maxSize maximum total size of cached voice-overs in bytes
+     */
+    VoiceOverCache(resource::Resources &resources, ThreadPool &threadPool, size_t maxSize);
+
+    /**
+     * Starts loading the specified voice-overs, unless they are already
+     * cached. Evicts least recently used voice-overs, that are not among the
+     * specified ones, to keep the cache within its size limit.
+     */
+    void prefetch(const std::vector<std::string> &resRefs);
+
+    /**
+     * Blocks until the specified voice-over is loaded, if it is being loaded.
+     *
+     * @return cached voice-over, or nullptr if it was not prefetched or failed to load
+     */
+    std::shared_ptr<VoiceOver> get(const std::string &resRef);
+
+    void clear();
+
+private:
+    struct Entry {
+        std::shared_future<std::shared_ptr<VoiceOver>> voiceOver;
+        uint32_t lastUsed { 0 };
+    };
+
+    resource::Resources &_resources;
+    ThreadPool &_threadPool;
+    size_t _maxSize;
+
+    std::unordered_map<std::string, Entry> _entries;
+    uint32_t _useCounter { 0 };
+
+    void evict();
+
+    static std::shared_ptr<VoiceOver> load(resource::Resources &resources, const std::string &resRef);
+};
+
+} // namespace game
+
+} // namespace reone
@@ -28,29 +28,45 @@ LipAnimation::LipAnimation(float length, vector<Keyframe> keyframes) :
 }
 
 bool LipAnimation::getKeyframes(float time, uint8_t &leftShape, uint8_t &rightShape, float &factor) const {
+    int cursor = 0;
+    Sample result;
+    if (!sample(time, cursor, result)) return false;
+
+    leftShape = result.leftShape;
+    rightShape = result.rightShape;
+    factor = result.factor;
+
+    return true;
+}
+
+bool LipAnimation::sample(float time, int &cursor, Sample &sample) const {
     if (_keyframes.empty()) return false;
 
-    const Keyframe *left = &_keyframes[0];
-    const Keyframe *right = &_keyframes[0];
-
-    for (auto &frame : _keyframes) {
-        if (time > frame.time) {
-            left = &frame;
-        }
-        if (time <= frame.time) {
-            right = &frame;
-            break;
-        }
-    }
+    int lastIdx = static_cast<int>(_keyframes.size()) - 1;
 
-    leftShape = left->shape;
-    rightShape = right->shape;
+    // Before the first keyframe or after the last one, hold the shape
+    if (time <= _keyframes[0].time || time > _keyframes[lastIdx].time) {
+        const Keyframe &frame = _keyframes[time <= _keyframes[0].time ? 0 : lastIdx];
+        sample.leftShape = frame.shape;
+        sample.rightShape = frame.shape;
+        sample.factor = 0.0f;
+        cursor = 0;
+        return true;
+    }
 
-    if (&left == &right) {
-        factor = 0.0f;
-    } else {
-        factor = (time - left->time) / (right->time - left->time);
+    // Find the first keyframe, such that left.time < time <= right.time
+    if (cursor < 1 || cursor > lastIdx || _keyframes[cursor - 1].time >= time) {
+        cursor = 1;
     }
+    while (_keyframes[cursor].time < time) {
+        ++cursor;
+    }
+    const Keyframe &left = _keyframes[cursor - 1];
+    const Keyframe &right = _keyframes[cursor];
+
+    sample.leftShape = left.shape;
+    sample.rightShape = right.shape;
+    sample.factor = (time - left.time) / (right.time - left.time);
 
     return true;
 }
@@ -28,10 +28,29 @@ public:
         uint8_t shape { 0 }; /**< an index into the keyframes of the "talk" animation  */
     };
 
+    /**
+     * Pair of shapes to blend between at a point in time.
+     */
+    struct Sample {
+        uint8_t leftShape { 0 };
+        uint8_t rightShape { 0 };
+        float factor { 0.0f };
+    };
+
     LipAnimation(float length, std::vector<Keyframe> keyframes);
 
     bool getKeyframes(float time, uint8_t &leftShape, uint8_t &rightShape, float &factor) const;
 
+    /**
+     * Samples this animation at the specified time. As animations are
+     * usually sampled with increasing time, lookup starts from the keyframe
+     * found by the previous call.
+     *
+     * @param cursor index of the keyframe found by the previous call, updated in place
+     * @return false if this animation has no keyframes, true otherwise
+     */
+    bool sample(float time, int &cursor, Sample &sample) const;
+
     float length() const { return _length; }
     const std::vector<Keyframe> &keyframes() const { return _keyframes; }
 
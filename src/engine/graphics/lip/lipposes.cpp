@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2020-2021 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "lipposes.h"
+
+#include "../model/animation.h"
+#include "../model/modelnode.h"
+
+using namespace std;
+
+namespace reone {
+
+namespace graphics {
+
+LipPoses::LipPoses(const ModelNode &rootNode, const Animation &animation) {
+    bake(rootNode, animation);
+}
+
+void LipPoses::bake(const ModelNode &modelNode, const Animation &animation) {
+    shared_ptr<ModelNode> animNode(animation.getNodeByName(modelNode.name()));
+    if (animNode) {
+        Node node;
+        node.modelNode = &modelNode;
+        node.animNode = animNode.get();
+        for (int i = 0; i < animNode->position().getNumFrames(); ++i) {
+            node.positions.push_back(animNode->position().getByFrame(i));
+        }
+        for (int i = 0; i < animNode->orientation().getNumFrames(); ++i) {
+            node.orientations.push_back(animNode->orientation().getByFrame(i));
+        }
+        for (int i = 0; i < animNode->scale().getNumFrames(); ++i) {
+            node.scales.push_back(animNode->scale().getByFrame(i));
+        }
+        _nodes.push_back(move(node));
+    }
+    for (auto &child : modelNode.children()) {
+        bake(*child, animation);
+    }
+}
+
+template <class T, class Blend>
+static bool getPose(const vector<T> &poses, const LipAnimation::Sample &sample, const Blend &blend, T &value) {
+    if (sample.leftShape >= poses.size() || sample.rightShape >= poses.size()) return false;
+
+    if (sample.leftShape == sample.rightShape) {
+        value = poses[sample.leftShape];
+    } else {
+        value = blend(poses[sample.leftShape], poses[sample.rightShape], sample.factor);
+    }
+
+    return true;
+}
+
+bool LipPoses::Node::getPosition(const LipAnimation::Sample &sample, glm::vec3 &position) const {
+    return getPose(positions, sample, [](auto &left, auto &right, float factor) { return glm::mix(left, right, factor); }, position);
+}
+
+bool LipPoses::Node::getOrientation(const LipAnimation::Sample &sample, glm::quat &orientation) const {
+    return getPose(orientations, sample, [](auto &left, auto &right, float factor) { return glm::slerp(left, right, factor); }, orientation);
+}
+
+bool LipPoses::Node::getScale(const LipAnimation::Sample &sample, float &scale) const {
+    return getPose(scales, sample, [](auto &left, auto &right, float factor) { return glm::mix(left, right, factor); }, scale);
+}
+
+} // namespace graphics
+
+} // namespace reone
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2020-2021 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "animation.h"
+
+namespace reone {
+
+namespace graphics {
+
+class Animation;
+class ModelNode;
+
+/**
+ * Poses of a model for every lip shape, baked from its talk animation.
+ * Poses are shared by all instances of the model, and allow sampling lip
+ * animations without looking up animation nodes by name.
+ */
+class LipPoses : boost::noncopyable {
+public:
+    struct Node {
+        const ModelNode *modelNode { nullptr };
+        const ModelNode *animNode { nullptr }; /**< node of the talk animation, for properties not driven by lip shapes */
+        std::vector<glm::vec3> positions; /**< indexed by lip shape */
+        std::vector<glm::quat> orientations; /**< indexed by lip shape */
+        std::vector<float> scales; /**< indexed by lip shape */
+
+        bool getPosition(const LipAnimation::Sample &sample, glm::vec3 &position) const;
+        bool getOrientation(const LipAnimation::Sample &sample, glm::quat &orientation) const;
+        bool getScale(const LipAnimation::Sample &sample, float &scale) const;
+    };
+
+    /**
+     * @param rootNode root node of the model
+     * @param animation talk animation of the model
+     */
+    LipPoses(const ModelNode &rootNode, const Animation &animation);
+
+    /**
+     * @return animated nodes in the depth-first order
+     */
+    const std::vector<Node> &nodes() const { return _nodes; }
+
+private:
+    std::vector<Node> _nodes;
+
+    void bake(const ModelNode &modelNode, const Animation &animation);
+};
+
+} // namespace graphics
+
+} // namespace reone
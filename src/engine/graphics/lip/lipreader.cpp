@@ -35,6 +35,7 @@ void LipReader::doLoad() {
     uint32_t entryCount = readUint32();
 
     vector<LipAnimation::Keyframe> keyframes;
+    keyframes.reserve(entryCount);
     for (uint32_t i = 0; i < entryCount; ++i) {
         LipAnimation::Keyframe keyframe;
         keyframe.time = readFloat();
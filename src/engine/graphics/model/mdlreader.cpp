@@ -30,13 +30,13 @@
 
 using namespace std;
 
-using namespace reone::resource;
-
 namespace reone {
 
 namespace graphics {
 
 static constexpr int kMdlDataOffset = 12;
+static constexpr int kFaceSize = 32;
+static constexpr int kFaceMaterialIndex = 4; /**< index of the material in a face, as an array of 32-bit words */
 static constexpr uint32_t kFunctionPtrTslPC = 4285200;
 static constexpr uint32_t kFunctionPtrTslXbox = 4285872;
 
@@ -76,17 +76,22 @@ static Model::Classification getClassification(uint8_t ordinal) {
 // END Classification
 
 MdlReader::MdlReader(Models &models, Textures &textures) :
-    BinaryReader(4, "\000\000\000\000"),
     _models(models),
     _textures(textures) {
 
     initControllerFn();
 }
 
-void MdlReader::load(const shared_ptr<istream> &mdl, const shared_ptr<istream> &mdx) {
-    _mdxReader = make_unique<StreamReader>(mdx);
+void MdlReader::load(const ByteArray &mdl, const ByteArray &mdx) {
+    _mdl = SpanReader(mdl);
+    _mdx = SpanReader(mdx);
+
+    // Signature
+    if (_mdl.getUint32() != 0) {
+        throw runtime_error("Invalid MDL signature");
+    }
 
-    BinaryReader::load(mdl);
+    doLoad();
 }
 
 static bool isTSLFunctionPointer(uint32_t ptr) {
@@ -95,42 +100,43 @@ static bool isTSLFunctionPointer(uint32_t ptr) {
 
 void MdlReader::doLoad() {
     // File Header
-    uint32_t mdlSize = readUint32();
-    uint32_t mdxSize = readUint32();
+    uint32_t mdlSize = _mdl.getUint32();
+    uint32_t mdxSize = _mdl.getUint32();
 
     // Geometry Header
-    uint32_t funcPtr1 = readUint32();
-    uint32_t funcPtr2 = readUint32();
-    string name(readCString(32));
-    uint32_t offRootNode = readUint32();
-    uint32_t numNodes = readUint32();
-    ignore(6 * 4); // unknown
-    uint32_t refCount = readUint32();
-    uint8_t modelType = readByte();
-    ignore(3); // padding
+    uint32_t funcPtr1 = _mdl.getUint32();
+    uint32_t funcPtr2 = _mdl.getUint32();
+    string name(_mdl.getCString(32));
+    uint32_t offRootNode = _mdl.getUint32();
+    uint32_t numNodes = _mdl.getUint32();
+    _mdl.ignore(6 * 4); // unknown
+    uint32_t refCount = _mdl.getUint32();
+    uint8_t modelType = _mdl.getByte();
+    _mdl.ignore(3); // padding
 
     // Model Header
-    uint8_t classification = readByte();
-    uint8_t subclassification = readByte();
-    ignore(1); // unknown
-    uint8_t affectedByFog = readByte();
-    uint32_t numChildModels = readUint32();
+    uint8_t classification = _mdl.getByte();
+    uint8_t subclassification = _mdl.getByte();
+    _mdl.ignore(1); // unknown
+    uint8_t affectedByFog = _mdl.getByte();
+    uint32_t numChildModels = _mdl.getUint32();
     ArrayDefinition animationArrayDef(readArrayDefinition());
-    uint32_t superModelRef = readUint32();
-    vector<float> boundingBox(readFloatArray(6));
-    float radius = readFloat();
-    float animationScale = readFloat();
-    string superModelName(boost::to_lower_copy(readCString(32)));
-    uint32_t offHeadRootNode = readUint32();
-    ignore(4); // unknown
-    uint32_t mdxSize2 = readUint32();
-    uint32_t mdxOffset = readUint32();
+    uint32_t superModelRef = _mdl.getUint32();
+    float boundingBox[6];
+    _mdl.getArray(6, boundingBox);
+    float radius = _mdl.getFloat();
+    float animationScale = _mdl.getFloat();
+    string superModelName(boost::to_lower_copy(_mdl.getCString(32)));
+    uint32_t offHeadRootNode = _mdl.getUint32();
+    _mdl.ignore(4); // unknown
+    uint32_t mdxSize2 = _mdl.getUint32();
+    uint32_t mdxOffset = _mdl.getUint32();
     ArrayDefinition nameArrayDef(readArrayDefinition());
 
     _tsl = isTSLFunctionPointer(funcPtr1);
 
     // Read node names
-    vector<uint32_t> nameOffsets(readUint32Array(kMdlDataOffset + nameArrayDef.offset, nameArrayDef.count));
+    vector<uint32_t> nameOffsets(_mdl.getArrayAt<uint32_t>(kMdlDataOffset + nameArrayDef.offset, nameArrayDef.count));
     readNodeNames(nameOffsets);
 
     // Read nodes
@@ -140,11 +146,11 @@ void MdlReader::doLoad() {
     // Load supermodel
     shared_ptr<Model> superModel;
     if (!superModelName.empty() && superModelName != "null") {
-        superModel = _models.get(superModelName);
+        superModel = _models.load(superModelName);
     }
 
     // Read animations
-    vector<uint32_t> animOffsets(readUint32Array(kMdlDataOffset + animationArrayDef.offset, animationArrayDef.count));
+    vector<uint32_t> animOffsets(_mdl.getArrayAt<uint32_t>(kMdlDataOffset + animationArrayDef.offset, animationArrayDef.count));
     vector<shared_ptr<Animation>> animations(readAnimations(animOffsets));
 
     _model = make_unique<Model>(
@@ -160,16 +166,16 @@ void MdlReader::doLoad() {
 
 MdlReader::ArrayDefinition MdlReader::readArrayDefinition() {
     ArrayDefinition result;
-    result.offset = readUint32();
-    result.count = readUint32();
-    result.count2 = readUint32();
+    result.offset = _mdl.getUint32();
+    result.count = _mdl.getUint32();
+    result.count2 = _mdl.getUint32();
     return move(result);
 }
 
 void MdlReader::readNodeNames(const vector<uint32_t> &offsets) {
     map<string, int> nameOccurences;
     for (uint32_t offset : offsets) {
-        string name(boost::to_lower_copy(readCStringAt(kMdlDataOffset + offset)));
+        string name(boost::to_lower_copy(_mdl.getCStringAt(kMdlDataOffset + offset)));
         int numOccurances = nameOccurences[name]++;
         if (numOccurances > 0) {
             debug("Duplicate model node name: " + name);
@@ -180,16 +186,17 @@ void MdlReader::readNodeNames(const vector<uint32_t> &offsets) {
 }
 
 shared_ptr<ModelNode> MdlReader::readNode(uint32_t offset, const ModelNode *parent, bool anim) {
-    seek(kMdlDataOffset + offset);
-
-    uint16_t flags = readUint16();
-    uint16_t nodeId = readUint16();
-    uint16_t nameIndex = readUint16();
-    ignore(2); // padding
-    uint32_t offRootNode = readUint32();
-    uint32_t offParentNode = readUint32();
-    vector<float> positionValues(readFloatArray(3));
-    vector<float> orientationValues(readFloatArray(4));
+    _mdl.seek(kMdlDataOffset + offset);
+
+    uint16_t flags = _mdl.getUint16();
+    uint16_t nodeId = _mdl.getUint16();
+    uint16_t nameIndex = _mdl.getUint16();
+    _mdl.ignore(2); // padding
+    uint32_t offRootNode = _mdl.getUint32();
+    uint32_t offParentNode = _mdl.getUint32();
+    float positionValues[3], orientationValues[4];
+    _mdl.getArray(3, positionValues);
+    _mdl.getArray(4, orientationValues);
     ArrayDefinition childArrayDef(readArrayDefinition());
     ArrayDefinition controllerArrayDef(readArrayDefinition());
     ArrayDefinition controllerDataArrayDef(readArrayDefinition());
@@ -198,7 +205,7 @@ shared_ptr<ModelNode> MdlReader::readNode(uint32_t offset, const ModelNode *pare
         throw runtime_error("Unsupported MDL node flags: " + to_string(flags));
     }
     string name(_nodeNames[nameIndex]);
-    glm::vec3 restPosition(glm::make_vec3(&positionValues[0]));
+    glm::vec3 restPosition(glm::make_vec3(positionValues));
     glm::quat restOrientation(orientationValues[0], orientationValues[1], orientationValues[2], orientationValues[3]);
 
     auto node = make_shared<ModelNode>(
@@ -226,10 +233,10 @@ shared_ptr<ModelNode> MdlReader::readNode(uint32_t offset, const ModelNode *pare
         _nodeFlags.insert(make_pair(name, flags));
     }
 
-    vector<float> controllerData(readFloatArray(kMdlDataOffset + controllerDataArrayDef.offset, controllerDataArrayDef.count));
+    vector<float> controllerData(_mdl.getArrayAt<float>(kMdlDataOffset + controllerDataArrayDef.offset, controllerDataArrayDef.count));
     readControllers(controllerArrayDef.offset, controllerArrayDef.count, controllerData, anim, *node);
 
-    vector<uint32_t> childOffsets(readUint32Array(kMdlDataOffset + childArrayDef.offset, childArrayDef.count));
+    vector<uint32_t> childOffsets(_mdl.getArrayAt<uint32_t>(kMdlDataOffset + childArrayDef.offset, childArrayDef.count));
     for (uint32_t offset : childOffsets) {
         node->addChild(readNode(offset, node.get(), anim));
     }
@@ -239,53 +246,54 @@ shared_ptr<ModelNode> MdlReader::readNode(uint32_t offset, const ModelNode *pare
 
 shared_ptr<ModelNode::TriangleMesh> MdlReader::readMesh(int flags) {
     // Common Mesh Header
-    uint32_t funcPtr1 = readUint32();
-    uint32_t funcPtr2 = readUint32();
+    uint32_t funcPtr1 = _mdl.getUint32();
+    uint32_t funcPtr2 = _mdl.getUint32();
     ArrayDefinition faceArrayDef(readArrayDefinition());
-    vector<float> boundingBox(readFloatArray(6));
-    float radius = readFloat();
-    vector<float> average(readFloatArray(3));
-    vector<float> diffuse(readFloatArray(3));
-    vector<float> ambient(readFloatArray(3));
-    uint32_t transprencyHint = readUint32();
-    string texture1(boost::to_lower_copy(readCString(32)));
-    string texture2(boost::to_lower_copy(readCString(32)));
-    string texture3(boost::to_lower_copy(readCString(12)));
-    string texture4(boost::to_lower_copy(readCString(12)));
+    float boundingBox[6], average[3], diffuse[3], ambient[3];
+    _mdl.getArray(6, boundingBox);
+    float radius = _mdl.getFloat();
+    _mdl.getArray(3, average);
+    _mdl.getArray(3, diffuse);
+    _mdl.getArray(3, ambient);
+    uint32_t transprencyHint = _mdl.getUint32();
+    string texture1(boost::to_lower_copy(_mdl.getCString(32)));
+    string texture2(boost::to_lower_copy(_mdl.getCString(32)));
+    string texture3(boost::to_lower_copy(_mdl.getCString(12)));
+    string texture4(boost::to_lower_copy(_mdl.getCString(12)));
     ArrayDefinition indicesCountArrayDef(readArrayDefinition());
     ArrayDefinition indicesOffsetArrayDef(readArrayDefinition());
     ArrayDefinition invCounterArrayDef(readArrayDefinition());
-    ignore(3 * 4 + 8); // unknown
-    uint32_t animateUV = readUint32();
-    float uvDirectionX = readFloat();
-    float uvDirectionY = readFloat();
-    float uvJitter = readFloat();
-    float uvJitterSpeed = readFloat();
-    uint32_t mdxVertexSize = readUint32();
-    uint32_t mdxDataFlags = readUint32();
-    int offMdxVertices = readInt32();
-    int offMdxNormals = readInt32();
-    int offMdxVertexColors = readInt32();
-    int offMdxTexCoords1 = readInt32();
-    int offMdxTexCoords2 = readInt32();
-    int offMdxTexCoords3 = readInt32();
-    int offMdxTexCoords4 = readInt32();
-    int offMdxTanSpace = readInt32();
-    ignore(3 * 4); // unknown
-    uint16_t numVertices = readUint16();
-    uint16_t numTextures = readUint16();
-    uint8_t lightmapped = readByte();
-    uint8_t rotateTexture = readByte();
-    uint8_t backgroundGeometry = readByte();
-    uint8_t shadow = readByte();
-    uint8_t beaming = readByte();
-    uint8_t render = readByte();
-    ignore(2); // unknown
-    float totalArea = readFloat();
-    ignore(4); // unknown
-    if (_tsl) ignore(8);
-    uint32_t offMdxData = readUint32();
-    uint32_t offVertices = readUint32();
+    _mdl.ignore(3 * 4 + 8); // unknown
+    uint32_t animateUV = _mdl.getUint32();
+    float uvDirectionX = _mdl.getFloat();
+    float uvDirectionY = _mdl.getFloat();
+    float uvJitter = _mdl.getFloat();
+    float uvJitterSpeed = _mdl.getFloat();
+    uint32_t mdxVertexSize = _mdl.getUint32();
+    uint32_t mdxDataFlags = _mdl.getUint32();
+    int offMdxVertices = _mdl.getInt32();
+    int offMdxNormals = _mdl.getInt32();
+    int offMdxVertexColors = _mdl.getInt32();
+    int offMdxTexCoords1 = _mdl.getInt32();
+    int offMdxTexCoords2 = _mdl.getInt32();
+    int offMdxTexCoords3 = _mdl.getInt32();
+    int offMdxTexCoords4 = _mdl.getInt32();
+    int offMdxTanSpace = _mdl.getInt32();
+    _mdl.ignore(3 * 4); // unknown
+    uint16_t numVertices = _mdl.getUint16();
+    uint16_t numTextures = _mdl.getUint16();
+    uint8_t lightmapped = _mdl.getByte();
+    uint8_t rotateTexture = _mdl.getByte();
+    uint8_t backgroundGeometry = _mdl.getByte();
+    uint8_t shadow = _mdl.getByte();
+    uint8_t beaming = _mdl.getByte();
+    uint8_t render = _mdl.getByte();
+    _mdl.ignore(2); // unknown
+    float totalArea = _mdl.getFloat();
+    _mdl.ignore(4); // unknown
+    if (_tsl) _mdl.ignore(8);
+    uint32_t offMdxData = _mdl.getUint32();
+    uint32_t offVertices = _mdl.getUint32();
 
     vector<float> vertices;
     vector<uint16_t> indices;
@@ -308,18 +316,19 @@ shared_ptr<ModelNode::TriangleMesh> MdlReader::readMesh(int flags) {
 
     if (flags & NodeFlags::skin) {
         // Skin Mesh Header
-        ignore(3 * 4); // unknown
-        uint32_t offMdxBoneWeights = readUint32();
-        uint32_t offMdxBoneIndices = readUint32();
-        uint32_t offBones = readUint32();
-        uint32_t numBones = readUint32();
+        _mdl.ignore(3 * 4); // unknown
+        uint32_t offMdxBoneWeights = _mdl.getUint32();
+        uint32_t offMdxBoneIndices = _mdl.getUint32();
+        uint32_t offBones = _mdl.getUint32();
+        uint32_t numBones = _mdl.getUint32();
         ArrayDefinition qBoneArrayDef(readArrayDefinition());
         ArrayDefinition tBoneArrayDef(readArrayDefinition());
-        ignore(3 * 4); // unknown
-        vector<uint16_t> boneNodeSerial(readUint16Array(16));
-        ignore(4); // padding
+        _mdl.ignore(3 * 4); // unknown
+        uint16_t boneNodeSerial[16];
+        _mdl.getArray(16, boneNodeSerial);
+        _mdl.ignore(4); // padding
 
-        vector<float> boneMap(readFloatArray(kMdlDataOffset + offBones, numBones));
+        vector<float> boneMap(_mdl.getArrayAt<float>(kMdlDataOffset + offBones, numBones));
 
         skin = make_shared<ModelNode::Skin>();
         skin->boneMap = move(boneMap);
@@ -329,31 +338,28 @@ shared_ptr<ModelNode::TriangleMesh> MdlReader::readMesh(int flags) {
     } else if (flags & NodeFlags::dangly) {
         // Dangly Mesh Header
         ArrayDefinition constraintArrayDef(readArrayDefinition());
-        float displacement = readFloat();
-        float tightness = readFloat();
-        float period = readFloat();
-        uint32_t offDanglyVertices = readUint32();
+        float displacement = _mdl.getFloat();
+        float tightness = _mdl.getFloat();
+        float period = _mdl.getFloat();
+        uint32_t offDanglyVertices = _mdl.getUint32();
 
         danglyMesh = make_shared<ModelNode::DanglyMesh>();
         danglyMesh->displacement = 0.5f * displacement;  // displacement is allegedly 1/2 meters per unit
         danglyMesh->tightness = tightness;
         danglyMesh->period = period;
 
+        vector<float> multipliers(_mdl.getArrayAt<float>(kMdlDataOffset + constraintArrayDef.offset, constraintArrayDef.count));
+        vector<float> positions(_mdl.getArrayAt<float>(kMdlDataOffset + offDanglyVertices, 3 * constraintArrayDef.count));
+
         danglyMesh->constraints.resize(constraintArrayDef.count);
-        seek(kMdlDataOffset + constraintArrayDef.offset);
         for (uint32_t i = 0; i < constraintArrayDef.count; ++i) {
-            float multiplier = readFloat();
-            danglyMesh->constraints[i].multiplier = glm::clamp(multiplier / 255.0f, 0.0f, 1.0f);
-        }
-        seek(kMdlDataOffset + offDanglyVertices);
-        for (uint32_t i = 0; i < constraintArrayDef.count; ++i) {
-            vector<float> positionValues(readFloatArray(3));
-            danglyMesh->constraints[i].position = glm::make_vec3(&positionValues[0]);
+            danglyMesh->constraints[i].multiplier = glm::clamp(multipliers[i] / 255.0f, 0.0f, 1.0f);
+            danglyMesh->constraints[i].position = glm::make_vec3(&positions[3ll * i]);
         }
 
     } else if (flags & NodeFlags::aabb) {
         // AABB Mesh Header
-        uint32_t offTree = readUint32();
+        uint32_t offTree = _mdl.getUint32();
         aabbTree = readAABBTree(offTree);
 
     } else if (flags & NodeFlags::saber) {
@@ -366,21 +372,16 @@ shared_ptr<ModelNode::TriangleMesh> MdlReader::readMesh(int flags) {
         // procedurally generated based on vertices 0-7 and 88-95.
 
         // Saber Mesh Header
-        uint32_t offSaberVertices = readUint32();
-        uint32_t offTexCoords = readUint32();
-        uint32_t offNormals = readUint32();
-        ignore(2 * 4); // unknown
+        uint32_t offSaberVertices = _mdl.getUint32();
+        uint32_t offTexCoords = _mdl.getUint32();
+        uint32_t offNormals = _mdl.getUint32();
+        _mdl.ignore(2 * 4); // unknown
 
         static int referenceIndices[] { 0, 1, 2, 3, 4, 5, 6, 7, 88, 89, 90, 91, 92, 93, 94, 95 };
 
-        seek(static_cast<size_t>(kMdlDataOffset) + offSaberVertices);
-        vector<float> saberVertices(readFloatArray(3 * numVertices));
-
-        seek(static_cast<size_t>(kMdlDataOffset) + offTexCoords);
-        vector<float> texCoords(readFloatArray(2 * numVertices));
-
-        seek(static_cast<size_t>(kMdlDataOffset) + offNormals);
-        vector<float> normals(readFloatArray(3 * numVertices));
+        vector<float> saberVertices(_mdl.getArrayAt<float>(static_cast<size_t>(kMdlDataOffset) + offSaberVertices, 3 * numVertices));
+        vector<float> texCoords(_mdl.getArrayAt<float>(static_cast<size_t>(kMdlDataOffset) + offTexCoords, 2 * numVertices));
+        vector<float> normals(_mdl.getArrayAt<float>(static_cast<size_t>(kMdlDataOffset) + offNormals, 3 * numVertices));
 
         int numVertices = 16;
         vertices.resize(8ll * numVertices);
@@ -424,27 +425,28 @@ shared_ptr<ModelNode::TriangleMesh> MdlReader::readMesh(int flags) {
 
     // Read vertices
     if (!(flags & NodeFlags::saber) && mdxVertexSize > 0) {
-        _mdxReader->seek(offMdxData);
-        vertices = _mdxReader->getFloatArray(numVertices * mdxVertexSize / sizeof(float));
+        vertices = _mdx.getArrayAt<float>(offMdxData, numVertices * mdxVertexSize / sizeof(float));
     }
 
     if (!(flags & NodeFlags::saber) && faceArrayDef.count > 0) {
-        // Faces
-        seek(kMdlDataOffset + faceArrayDef.offset);
+        // Faces. Of every face, only the material is used: plane normal and
+        // distance, adjacent faces and vertex indices are skipped.
+        vector<uint32_t> faces(_mdl.getArrayAt<uint32_t>(kMdlDataOffset + faceArrayDef.offset, kFaceSize / sizeof(uint32_t) * faceArrayDef.count));
+        vector<uint32_t> *faceGroup = nullptr;
+        uint32_t faceGroupMaterial = 0;
         for (uint32_t i = 0; i < faceArrayDef.count; ++i) {
-            vector<float> normalValues(readFloatArray(3));
-            float distance = readFloat();
-            uint32_t material = readUint32();
-            vector<uint16_t> adjacentFaces(readUint16Array(3));
-            vector<uint16_t> faceIndices(readUint16Array(3));
-            materialFaces[material].push_back(i);
+            uint32_t material = faces[kFaceSize / sizeof(uint32_t) * i + kFaceMaterialIndex];
+            // Consecutive faces usually share a material
+            if (!faceGroup || material != faceGroupMaterial) {
+                faceGroup = &materialFaces[material];
+                faceGroupMaterial = material;
+            }
+            faceGroup->push_back(i);
         }
 
         // Indices
-        seek(kMdlDataOffset + indicesOffsetArrayDef.offset);
-        uint32_t offIndices = readUint32();
-        seek(kMdlDataOffset + offIndices);
-        indices = readUint16Array(3 * faceArrayDef.count);
+        uint32_t offIndices = _mdl.getArrayAt<uint32_t>(kMdlDataOffset + indicesOffsetArrayDef.offset, 1).front();
+        indices = _mdl.getArrayAt<uint16_t>(kMdlDataOffset + offIndices, 3 * faceArrayDef.count);
     }
 
     auto mesh = make_unique<Mesh>(vertices, indices, attributes);
@@ -455,19 +457,19 @@ shared_ptr<ModelNode::TriangleMesh> MdlReader::readMesh(int flags) {
     }
     shared_ptr<Texture> diffuseMap;
     if (!texture1.empty() && texture1 != "null") {
-        diffuseMap = _textures.get(texture1, TextureUsage::Diffuse);
+        diffuseMap = _textures.load(texture1, TextureUsage::Diffuse);
     }
     shared_ptr<Texture> lightmap;
     if (!texture2.empty()) {
-        lightmap = _textures.get(texture2, TextureUsage::Lightmap);
+        lightmap = _textures.load(texture2, TextureUsage::Lightmap);
     }
 
     auto nodeMesh = make_unique<ModelNode::TriangleMesh>();
     nodeMesh->mesh = move(mesh);
     nodeMesh->materialFaces = move(materialFaces);
     nodeMesh->uvAnimation = move(uvAnimation);
-    nodeMesh->diffuse = glm::make_vec3(&diffuse[0]);
-    nodeMesh->ambient = glm::make_vec3(&ambient[0]);
+    nodeMesh->diffuse = glm::make_vec3(diffuse);
+    nodeMesh->ambient = glm::make_vec3(ambient);
     nodeMesh->transparency = static_cast<int>(transprencyHint);
     nodeMesh->render = static_cast<bool>(render);
     nodeMesh->shadow = static_cast<bool>(shadow);
@@ -483,18 +485,19 @@ shared_ptr<ModelNode::TriangleMesh> MdlReader::readMesh(int flags) {
 }
 
 shared_ptr<ModelNode::AABBTree> MdlReader::readAABBTree(uint32_t offset) {
-    seek(kMdlDataOffset + offset);
+    _mdl.seek(kMdlDataOffset + offset);
 
-    vector<float> boundingBox(readFloatArray(6));
-    uint32_t offChildLeft = readUint32();
-    uint32_t offChildRight = readUint32();
-    int faceIndex = readInt32();
-    uint32_t mostSignificantPlane = readUint32();
+    float boundingBox[6];
+    _mdl.getArray(6, boundingBox);
+    uint32_t offChildLeft = _mdl.getUint32();
+    uint32_t offChildRight = _mdl.getUint32();
+    int faceIndex = _mdl.getInt32();
+    uint32_t mostSignificantPlane = _mdl.getUint32();
 
     auto node = make_shared<ModelNode::AABBTree>();
     node->faceIndex = faceIndex;
     node->mostSignificantPlane = static_cast<ModelNode::AABBTree::Plane>(mostSignificantPlane);
-    node->aabb.expand(glm::make_vec3(&boundingBox[0]));
+    node->aabb.expand(glm::make_vec3(boundingBox));
     node->aabb.expand(glm::make_vec3(&boundingBox[3]));
 
     if (faceIndex == -1) {
@@ -506,19 +509,19 @@ shared_ptr<ModelNode::AABBTree> MdlReader::readAABBTree(uint32_t offset) {
 }
 
 shared_ptr<ModelNode::Light> MdlReader::readLight() {
-    float flareRadius  = readFloat();
-    ignore(3 * 4); // unknown
+    float flareRadius  = _mdl.getFloat();
+    _mdl.ignore(3 * 4); // unknown
     ArrayDefinition flareSizesArrayDef(readArrayDefinition());
     ArrayDefinition flarePositionsArrayDef(readArrayDefinition());
     ArrayDefinition flareColorShiftsArrayDef(readArrayDefinition());
     ArrayDefinition flareTexturesArrayDef(readArrayDefinition());
-    uint32_t priority = readUint32();
-    uint32_t ambientOnly = readUint32();
-    uint32_t dynamicType = readUint32();
-    uint32_t affectDynamic = readUint32();
-    uint32_t shadow = readUint32();
-    uint32_t flare = readUint32();
-    uint32_t fading = readUint32();
+    uint32_t priority = _mdl.getUint32();
+    uint32_t ambientOnly = _mdl.getUint32();
+    uint32_t dynamicType = _mdl.getUint32();
+    uint32_t affectDynamic = _mdl.getUint32();
+    uint32_t shadow = _mdl.getUint32();
+    uint32_t flare = _mdl.getUint32();
+    uint32_t fading = _mdl.getUint32();
 
     auto light = make_shared<ModelNode::Light>();
     light->priority = priority;
@@ -531,22 +534,23 @@ shared_ptr<ModelNode::Light> MdlReader::readLight() {
 
     int numFlares = static_cast<int>(flareTexturesArrayDef.count);
     if (numFlares > 0) {
-        vector<float> flareSizes(readFloatArray(kMdlDataOffset + flareSizesArrayDef.offset, flareSizesArrayDef.count));
-        vector<float> flarePositions(readFloatArray(kMdlDataOffset + flarePositionsArrayDef.offset, flarePositionsArrayDef.count));
-        vector<uint32_t> texNameOffsets(readUint32Array(kMdlDataOffset + flareTexturesArrayDef.offset, flareTexturesArrayDef.count));
+        vector<float> flareSizes(_mdl.getArrayAt<float>(kMdlDataOffset + flareSizesArrayDef.offset, flareSizesArrayDef.count));
+        vector<float> flarePositions(_mdl.getArrayAt<float>(kMdlDataOffset + flarePositionsArrayDef.offset, flarePositionsArrayDef.count));
+        vector<uint32_t> texNameOffsets(_mdl.getArrayAt<uint32_t>(kMdlDataOffset + flareTexturesArrayDef.offset, flareTexturesArrayDef.count));
 
         vector<glm::vec3> colorShifts;
         for (int i = 0; i < numFlares; ++i) {
-            seek(kMdlDataOffset + flareColorShiftsArrayDef.offset + 12 * i);
-            glm::vec3 colorShift(readFloat(), readFloat(), readFloat());
-            colorShifts.push_back(move(colorShift));
+            _mdl.seek(kMdlDataOffset + flareColorShiftsArrayDef.offset + 12 * i);
+            float colorShift[3];
+            _mdl.getArray(3, colorShift);
+            colorShifts.push_back(glm::make_vec3(colorShift));
         }
 
         vector<shared_ptr<Texture>> flareTextures;
         for (int i = 0; i < numFlares; ++i) {
-            seek(kMdlDataOffset + texNameOffsets[i]);
-            string textureName(boost::to_lower_copy(readCString(12)));
-            shared_ptr<Texture> texture(_textures.get(textureName));
+            _mdl.seek(kMdlDataOffset + texNameOffsets[i]);
+            string textureName(boost::to_lower_copy(_mdl.getCString(12)));
+            shared_ptr<Texture> texture(_textures.load(textureName));
             flareTextures.push_back(move(texture));
         }
 
@@ -610,32 +614,32 @@ static ModelNode::Emitter::BlendMode parseEmitterBlend(const string &str) {
 }
 
 shared_ptr<ModelNode::Emitter> MdlReader::readEmitter() {
-    float deadSpace = readFloat();
-    float blastRadius = readFloat();
-    float blastLength = readFloat();
-    uint32_t branchCount = readUint32();
-    float controlPointSmoothing = readFloat();
-    uint32_t xGrid = readUint32();
-    uint32_t yGrid = readUint32();
-    ignore(4); // unknown
-    string update(boost::to_lower_copy(readCString(32)));
-    string render(boost::to_lower_copy(readCString(32)));
-    string blend(boost::to_lower_copy(readCString(32)));
-    string texture(boost::to_lower_copy(readCString(32)));
-    string chunkName(boost::to_lower_copy(readCString(16)));
-    uint32_t twosided = readUint32();
-    uint32_t loop = readUint32();
-    uint32_t renderOrder = readUint32();
-    uint32_t frameBlending = readUint32();
-    string depthTexture(boost::to_lower_copy(readCString(32)));
-    ignore(1); // padding
-    uint32_t flags = readUint32();
+    float deadSpace = _mdl.getFloat();
+    float blastRadius = _mdl.getFloat();
+    float blastLength = _mdl.getFloat();
+    uint32_t branchCount = _mdl.getUint32();
+    float controlPointSmoothing = _mdl.getFloat();
+    uint32_t xGrid = _mdl.getUint32();
+    uint32_t yGrid = _mdl.getUint32();
+    _mdl.ignore(4); // unknown
+    string update(boost::to_lower_copy(_mdl.getCString(32)));
+    string render(boost::to_lower_copy(_mdl.getCString(32)));
+    string blend(boost::to_lower_copy(_mdl.getCString(32)));
+    string texture(boost::to_lower_copy(_mdl.getCString(32)));
+    string chunkName(boost::to_lower_copy(_mdl.getCString(16)));
+    uint32_t twosided = _mdl.getUint32();
+    uint32_t loop = _mdl.getUint32();
+    uint32_t renderOrder = _mdl.getUint32();
+    uint32_t frameBlending = _mdl.getUint32();
+    string depthTexture(boost::to_lower_copy(_mdl.getCString(32)));
+    _mdl.ignore(1); // padding
+    uint32_t flags = _mdl.getUint32();
 
     auto emitter = make_shared<ModelNode::Emitter>();
     emitter->updateMode = parseEmitterUpdate(update);
     emitter->renderMode = parseEmitterRender(render);
     emitter->blendMode = parseEmitterBlend(blend);
-    emitter->texture = _textures.get(texture, TextureUsage::Diffuse);
+    emitter->texture = _textures.load(texture, TextureUsage::Diffuse);
     emitter->gridSize = glm::ivec2(glm::max(xGrid, 1u), glm::max(yGrid, 1u));
     emitter->renderOrder = renderOrder;
     emitter->loop = static_cast<bool>(loop);
@@ -646,11 +650,11 @@ shared_ptr<ModelNode::Emitter> MdlReader::readEmitter() {
 }
 
 shared_ptr<ModelNode::Reference> MdlReader::readReference() {
-    string modelResRef(boost::to_lower_copy(readCString(32)));
-    uint32_t reattachable = readUint32();
+    string modelResRef(boost::to_lower_copy(_mdl.getCString(32)));
+    uint32_t reattachable = _mdl.getUint32();
 
     auto reference = make_shared<ModelNode::Reference>();
-    reference->model = _models.get(modelResRef);
+    reference->model = _models.load(modelResRef);
     reference->reattachable = static_cast<bool>(reattachable);
 
     return move(reference);
@@ -664,15 +668,15 @@ void MdlReader::readControllers(uint32_t keyOffset, uint32_t keyCount, const vec
         nodeFlags = node.flags();
     }
 
-    seek(kMdlDataOffset + keyOffset);
+    _mdl.seek(kMdlDataOffset + keyOffset);
     for (uint32_t i = 0; i < keyCount; ++i) {
-        uint32_t type = readUint32();
-        ignore(2); // unknown
-        uint16_t numRows = readUint16();
-        uint16_t timeIndex = readUint16();
-        uint16_t dataIndex = readUint16();
-        uint8_t numColumns = readByte();
-        ignore(3); // padding
+        uint32_t type = _mdl.getUint32();
+        _mdl.ignore(2); // unknown
+        uint16_t numRows = _mdl.getUint16();
+        uint16_t timeIndex = _mdl.getUint16();
+        uint16_t dataIndex = _mdl.getUint16();
+        uint8_t numColumns = _mdl.getByte();
+        _mdl.ignore(3); // padding
 
         ControllerKey key;
         key.type = type;
@@ -720,36 +724,36 @@ vector<shared_ptr<Animation>> MdlReader::readAnimations(const vector<uint32_t> &
 }
 
 unique_ptr<Animation> MdlReader::readAnimation(uint32_t offset) {
-    seek(kMdlDataOffset + offset);
+    _mdl.seek(kMdlDataOffset + offset);
 
     // Geometry Header
-    uint32_t funcPtr1 = readUint32();
-    uint32_t funcPtr2 = readUint32();
-    string name(boost::to_lower_copy(readCString(32)));
-    uint32_t offRootNode = readUint32();
-    uint32_t numNodes = readUint32();
-    ignore(6 * 4); // unknown
-    uint32_t refCount = readUint32();
-    uint8_t modelType = readByte();
-    ignore(3); // padding
+    uint32_t funcPtr1 = _mdl.getUint32();
+    uint32_t funcPtr2 = _mdl.getUint32();
+    string name(boost::to_lower_copy(_mdl.getCString(32)));
+    uint32_t offRootNode = _mdl.getUint32();
+    uint32_t numNodes = _mdl.getUint32();
+    _mdl.ignore(6 * 4); // unknown
+    uint32_t refCount = _mdl.getUint32();
+    uint8_t modelType = _mdl.getByte();
+    _mdl.ignore(3); // padding
 
     // Animation Header
-    float length = readFloat();
-    float transitionTime = readFloat();
-    string root(readCString(32));
+    float length = _mdl.getFloat();
+    float transitionTime = _mdl.getFloat();
+    string root(_mdl.getCString(32));
     ArrayDefinition eventArrayDef(readArrayDefinition());
-    ignore(4); // unknown
+    _mdl.ignore(4); // unknown
 
     shared_ptr<ModelNode> rootNode(readNode(offRootNode, nullptr, true));
 
     // Events
     vector<Animation::Event> events;
     if (eventArrayDef.count > 0) {
-        seek(kMdlDataOffset + eventArrayDef.offset);
+        _mdl.seek(kMdlDataOffset + eventArrayDef.offset);
         for (uint32_t i = 0; i < eventArrayDef.count; ++i) {
             Animation::Event event;
-            event.time = readFloat();
-            event.name = boost::to_lower_copy(readCString(32));
+            event.time = _mdl.getFloat();
+            event.name = boost::to_lower_copy(_mdl.getCString(32));
             events.push_back(move(event));
         }
         sort(events.begin(), events.end(), [](auto &left, auto &right) { return left.time < right.time; });
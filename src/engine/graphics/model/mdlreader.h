@@ -17,7 +17,7 @@
 
 #pragma once
 
-#include "../../resource/format/binreader.h"
+#include "../../common/spanreader.h"
 
 #include "modelnode.h"
 
@@ -30,11 +30,19 @@ class Model;
 class Models;
 class Textures;
 
-class MdlReader : public resource::BinaryReader {
+/**
+ * Parses MDL and MDX files. Both files are read directly from memory through
+ * bounds-checked spans, with geometry and controller arrays copied in bulk.
+ */
+class MdlReader : boost::noncopyable {
 public:
     MdlReader(Models &models, Textures &textures);
 
-    void load(const std::shared_ptr<std::istream> &mdl, const std::shared_ptr<std::istream> &mdx);
+    /**
+     * @param mdl MDL file contents, must outlive this call
+     * @param mdx MDX file contents, must outlive this call
+     */
+    void load(const ByteArray &mdl, const ByteArray &mdx);
 
     std::shared_ptr<graphics::Model> model() const { return _model; }
 
@@ -78,14 +86,15 @@ private:
     std::unordered_map<uint32_t, ControllerFn> _lightControllers;
     std::unordered_map<uint32_t, ControllerFn> _emitterControllers;
 
-    std::unique_ptr<StreamReader> _mdxReader;
+    SpanReader _mdl;
+    SpanReader _mdx;
     bool _tsl { false }; /**< is this a TSL model? */
     std::vector<std::string> _nodeNames;
     std::vector<std::shared_ptr<ModelNode>> _nodes; /**< loaded model nodes (DFS ordering) */
     std::map<std::string, uint16_t> _nodeFlags;
     std::shared_ptr<graphics::Model> _model;
 
-    void doLoad() override;
+    void doLoad();
 
     ArrayDefinition readArrayDefinition();
     void readNodeNames(const std::vector<uint32_t> &offsets);
@@ -21,8 +21,6 @@
 
 using namespace std;
 
-using namespace reone::resource;
-
 namespace reone {
 
 namespace graphics {
@@ -21,6 +21,7 @@
 #include "../../common/guardutil.h"
 #include "../../common/log.h"
 
+#include "../lip/lipposes.h"
 #include "../mesh/mesh.h"
 
 #include "animation.h"
@@ -139,6 +140,16 @@ shared_ptr<Animation> Model::getAnimation(const string &name) const {
     return move(anim);
 }
 
+shared_ptr<LipPoses> Model::getLipPoses(const shared_ptr<Animation> &animation) {
+    auto maybePoses = _lipPoses.find(animation.get());
+    if (maybePoses != _lipPoses.end()) return maybePoses->second;
+
+    auto poses = make_shared<LipPoses>(*_rootNode, *animation);
+    _lipPoses.insert(make_pair(animation.get(), poses));
+
+    return move(poses);
+}
+
 } // namespace graphics
 
 } // namespace reone
@@ -24,6 +24,7 @@ namespace reone {
 namespace graphics {
 
 class Animation;
+class LipPoses;
 class ModelNode;
 
 /**
@@ -80,6 +81,12 @@ public:
     std::vector<std::string> getAnimationNames() const;
     std::shared_ptr<Animation> getAnimation(const std::string &name) const;
 
+    /**
+     * @param animation talk animation of this model, or of its supermodel
+     * @return poses of this model for every lip shape, baked on first use
+     */
+    std::shared_ptr<LipPoses> getLipPoses(const std::shared_ptr<Animation> &animation);
+
     // END Animations
 
 private:
@@ -93,6 +100,7 @@ private:
     AABB _aabb;
     bool _affectedByFog;
     std::unordered_map<std::string, std::shared_ptr<ModelNode>> _nodeByName;
+    std::unordered_map<const Animation *, std::shared_ptr<LipPoses>> _lipPoses;
 
     void fillNodeByName(const std::shared_ptr<ModelNode> &node);
     void computeAABB();
@@ -18,7 +18,7 @@
 #include "models.h"
 
 #include "../../common/log.h"
-#include "../../common/streamutil.h"
+#include "../../common/threadpool.h"
 #include "../../resource/resources.h"
 
 #include "../texture/textures.h"
@@ -34,21 +34,93 @@ namespace reone {
 
 namespace graphics {
 
-Models::Models(Textures &textures, Resources &resources) : _textures(textures), _resources(resources) {
+Models::Models(Textures &textures, Resources &resources, bool headless) :
+    _textures(textures),
+    _resources(resources),
+    _headless(headless) {
 }
 
 void Models::invalidateCache() {
+    lock_guard<mutex> lock(_mutex);
     _cache.clear();
 }
 
 shared_ptr<Model> Models::get(const string &resRef) {
+    shared_ptr<Model> model(load(resRef));
+    initPending();
+    return move(model);
+}
+
+vector<shared_ptr<Model>> Models::getMany(const vector<string> &resRefs, ThreadPool &threadPool) {
+    vector<shared_ptr<Model>> models(resRefs.size());
+
+    threadPool.parallelFor(static_cast<int>(resRefs.size()), [this, &resRefs, &models](int i) {
+        models[i] = load(resRefs[i]);
+    });
+    initPending();
+
+    return move(models);
+}
+
+shared_ptr<Model> Models::load(const string &resRef) {
     if (resRef.empty()) return nullptr;
 
-    auto maybeModel = _cache.find(resRef);
-    if (maybeModel != _cache.end()) return maybeModel->second;
+    promise<shared_ptr<Model>> loader;
+    shared_future<shared_ptr<Model>> model;
+    bool loading = false;
+    {
+        lock_guard<mutex> lock(_mutex);
+        auto maybeModel = _cache.find(resRef);
+        if (maybeModel != _cache.end()) {
+            model = maybeModel->second;
+        } else {
+            model = loader.get_future().share();
+            _cache.insert(make_pair(resRef, model));
+            loading = true;
+        }
+    }
+    if (loading) {
+        try {
+            loader.set_value(doGet(resRef));
+        } catch (...) {
+            // Do not cache failures, so that the next request retries loading
+            {
+                lock_guard<mutex> lock(_mutex);
+                _cache.erase(resRef);
+            }
+            loader.set_exception(current_exception());
+        }
+    }
+
+    return model.get();
+}
+
+shared_future<shared_ptr<Model>> Models::loadAsync(const string &resRef, ThreadPool &threadPool) {
+    {
+        lock_guard<mutex> lock(_mutex);
+        auto maybeModel = _cache.find(resRef);
+        if (maybeModel != _cache.end()) return maybeModel->second;
+    }
+    return threadPool.enqueue([this, resRef]() { return load(resRef); }).share();
+}
+
+void Models::initPending() {
+    _textures.initPending();
+
+    vector<shared_ptr<Model>> pending;
+    {
+        lock_guard<mutex> lock(_mutex);
+        if (_pending.empty()) return;
+        swap(pending, _pending);
+    }
+    for (auto &model : pending) {
+        model->init();
+    }
+}
 
-    auto inserted = _cache.insert(make_pair(resRef, doGet(resRef)));
-    return inserted.first->second;
+int Models::getPendingCount() const {
+    lock_guard<mutex> lock(_mutex);
+    return static_cast<int>(_pending.size());
 }
 
 shared_ptr<Model> Models::doGet(const string &resRef) {
@@ -60,10 +132,11 @@ shared_ptr<Model> Models::doGet(const string &resRef) {
 
     if (mdlData && mdxData) {
         MdlReader mdl(*this, _textures);
-        mdl.load(wrap(mdlData), wrap(mdxData));
+        mdl.load(*mdlData, *mdxData);
         model = mdl.model();
-        if (model) {
-            model->init();
+        if (model && !_headless) {
+            lock_guard<mutex> lock(_mutex);
+            _pending.push_back(model);
         }
     }
 
@@ -17,10 +17,14 @@
 
 #pragma once
 
+#include <future>
+
 #include "../types.h"
 
 namespace reone {
 
+class ThreadPool;
+
 namespace resource {
 
 class Resources;
@@ -34,17 +38,67 @@ class Textures;
 
 class Models : boost::noncopyable {
 public:
-    Models(Textures &textures, resource::Resources &resources);
+    /**
+     * @param headless true if models will not be used for rendering
+     */
+    Models(Textures &textures, resource::Resources &resources, bool headless = false);
 
     void invalidateCache();
 
+    /**
+     * Loads the specified model, or returns a cached one, and initializes all
+     * pending models. Must be called on the main thread.
+     */
     std::shared_ptr<Model> get(const std::string &resRef);
 
+    /**
+     * Loads the specified models, parsing them on worker threads of the
+     * thread pool and the calling thread, and initializes them on the calling
+     * thread. Parsing does not wait for jobs queued on the thread pool before,
+     * e.g. script precompilation. Must be called on the main thread.
+     *
+     * @return models in the order of resRefs, nullptr for models that were not found
+     */
+    std::vector<std::shared_ptr<Model>> getMany(const std::vector<std::string> &resRefs, ThreadPool &threadPool);
+
+    /**
+     * Loads the specified model, or returns a cached one, without creating
+     * OpenGL objects. Thread-safe. Loaded models are initialized by the next
+     * call to get, getMany or initPending.
+     */
+    std::shared_ptr<Model> load(const std::string &resRef);
+
+    /**
+     * Loads the specified model on a worker thread of the thread pool.
+     * Returned model is not initialized until the next call to get, getMany
+     * or initPending.
+     */
+    std::shared_future<std::shared_ptr<Model>> loadAsync(const std::string &resRef, ThreadPool &threadPool);
+
+    /**
+     * Initializes models and textures loaded by load. Must be called on the main thread.
+     */
+    void initPending();
+
+    /**
+     * @return number of loaded models, that are waiting to be initialized
+     */
+    int getPendingCount() const;
+
 private:
     Textures &_textures;
     resource::Resources &_resources;
+    bool _headless;
+
+    /**
+     * Models are cached as shared futures, so that a thread requesting a
+     * model, that is being loaded by another thread, waits for it instead
+     * of loading it twice.
+     */
+    std::unordered_map<std::string, std::shared_future<std::shared_ptr<Model>>> _cache;
 
-    std::unordered_map<std::string, std::shared_ptr<Model>> _cache;
+    std::vector<std::shared_ptr<Model>> _pending;
+    mutable std::mutex _mutex; /**< guards _cache and _pending */
 
     std::shared_ptr<Model> doGet(const std::string &resRef);
 };
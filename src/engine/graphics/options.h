@@ -27,6 +27,7 @@ struct GraphicsOptions {
     int shadowResolution { 0 };
     bool fullscreen { false };
     bool pbr { false };
+    bool headless { false }; /**< must a window and an OpenGL context be created? */
 };
 
 } // namespace graphics
@@ -48,34 +48,49 @@ GraphicsServices::GraphicsServices(GraphicsOptions options, ResourceServices &re
 }
 
 void GraphicsServices::init() {
+    bool headless = _options.headless;
+
     _features = make_unique<Features>(_options);
     _features->init();
 
+    // In headless mode, services are created but OpenGL objects are not
     _window = make_unique<Window>(_options);
-    _window->init();
+    if (!headless) {
+        _window->init();
+    }
 
     _context = make_unique<Context>();
-    _context->init();
+    if (!headless) {
+        _context->init();
+    }
 
     _meshes = make_unique<Meshes>();
-    _meshes->init();
+    if (!headless) {
+        _meshes->init();
+    }
 
-    _textures = make_unique<Textures>(*_context, _resource.resources());
+    _textures = make_unique<Textures>(*_context, _resource.resources(), headless);
     _textures->init();
-    _textures->bindDefaults();
+    if (!headless) {
+        _textures->bindDefaults();
+    }
 
     _materials = make_unique<Materials>(_resource.resources());
     _materials->init();
 
-    _models = make_unique<Models>(*_textures, _resource.resources());
+    _models = make_unique<Models>(*_textures, _resource.resources(), headless);
     _walkmeshes = make_unique<Walkmeshes>(_resource.resources());
     _lips = make_unique<Lips>(_resource.resources());
 
     _shaders = make_unique<Shaders>();
-    _shaders->init();
+    if (!headless) {
+        _shaders->init();
+    }
 
     _pbrIbl = make_unique<PBRIBL>(*_context, *_meshes, *_shaders);
-    _pbrIbl->init();
+    if (!headless) {
+        _pbrIbl->init();
+    }
 
     _fonts = make_unique<Fonts>(*_window, *_context, *_meshes, *_textures, *_shaders);
 }
@@ -48,6 +48,8 @@ public:
 
     void init();
 
+    const GraphicsOptions &options() const { return _options; }
+
     Context &context() { return *_context; }
     Features &features() { return *_features; }
     Fonts &fonts() { return *_fonts; }
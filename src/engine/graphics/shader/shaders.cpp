@@ -47,6 +47,7 @@ extern char g_shaderFragmentParticle[];
 extern char g_shaderFragmentGrass[];
 extern char g_shaderFragmentBlur[];
 extern char g_shaderFragmentPresentWorld[];
+extern char g_shaderFragmentVideo[];
 extern char g_shaderFragmentBlinnPhong[];
 extern char g_shaderFragmentBlinnPhongDiffuseless[];
 extern char g_shaderFragmentIrradiance[];
@@ -80,6 +81,7 @@ void Shaders::init() {
     initShader(ShaderName::FragmentGrass, GL_FRAGMENT_SHADER, { g_shaderBaseHeader, g_shaderFragmentGrass });
     initShader(ShaderName::FragmentBlur, GL_FRAGMENT_SHADER, { g_shaderBaseHeader, g_shaderFragmentBlur });
     initShader(ShaderName::FragmentPresentWorld, GL_FRAGMENT_SHADER, { g_shaderBaseHeader, g_shaderFragmentPresentWorld });
+    initShader(ShaderName::FragmentVideo, GL_FRAGMENT_SHADER, { g_shaderBaseHeader, g_shaderFragmentVideo });
     initShader(ShaderName::FragmentBlinnPhong, GL_FRAGMENT_SHADER, { g_shaderBaseHeader, g_shaderBaseModel, g_shaderBaseNormals, g_shaderBaseShadows, g_shaderBaseBlinnPhong, g_shaderFragmentBlinnPhong });
     initShader(ShaderName::FragmentBlinnPhongDiffuseless, GL_FRAGMENT_SHADER, { g_shaderBaseHeader, g_shaderBaseModel, g_shaderBaseNormals, g_shaderBaseShadows, g_shaderBaseBlinnPhong, g_shaderFragmentBlinnPhongDiffuseless });
     initShader(ShaderName::FragmentIrradiance, GL_FRAGMENT_SHADER, { g_shaderBaseHeader, g_shaderFragmentIrradiance });
@@ -95,6 +97,7 @@ void Shaders::init() {
     initProgram(ShaderProgram::SimpleBRDF, { ShaderName::VertexSimple, ShaderName::FragmentBRDF });
     initProgram(ShaderProgram::SimpleBlur, { ShaderName::VertexSimple, ShaderName::FragmentBlur });
     initProgram(ShaderProgram::SimplePresentWorld, { ShaderName::VertexSimple, ShaderName::FragmentPresentWorld });
+    initProgram(ShaderProgram::SimpleVideo, { ShaderName::VertexSimple, ShaderName::FragmentVideo });
     initProgram(ShaderProgram::ModelColor, { ShaderName::VertexModel, ShaderName::FragmentColor });
     initProgram(ShaderProgram::ModelBlinnPhong, { ShaderName::VertexModel, ShaderName::FragmentBlinnPhong });
     initProgram(ShaderProgram::ModelBlinnPhongDiffuseless, { ShaderName::VertexModel, ShaderName::FragmentBlinnPhongDiffuseless });
@@ -212,6 +215,8 @@ void Shaders::initTextureUniforms() {
     setUniform("sBRDFLookup", TextureUnits::brdfLookup);
     setUniform("sShadowMap", TextureUnits::shadowMap);
     setUniform("sShadowMapCube", TextureUnits::shadowMapCube);
+    setUniform("sVideoU", TextureUnits::videoU);
+    setUniform("sVideoV", TextureUnits::videoV);
 }
 
 Shaders::~Shaders() {
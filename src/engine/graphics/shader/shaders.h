@@ -40,7 +40,8 @@ enum class ShaderProgram {
     ParticleParticle,
     GrassGrass,
     TextText,
-    BillboardGUI
+    BillboardGUI,
+    SimpleVideo
 };
 
 struct UniformFeatureFlags {
@@ -227,6 +228,7 @@ private:
         FragmentGrass,
         FragmentBlur,
         FragmentPresentWorld,
+        FragmentVideo,
 
         // Blinn-Phong
         FragmentBlinnPhong,
@@ -720,6 +720,31 @@ void main() {
 }
 )END";
 
+char g_shaderFragmentVideo[] = R"END(
+uniform sampler2D sDiffuseMap;
+uniform sampler2D sVideoU;
+uniform sampler2D sVideoV;
+
+in vec2 fragTexCoords;
+
+layout(location = 0) out vec4 fragColor;
+layout(location = 1) out vec4 fragColorBright;
+
+void main() {
+    float y = 1.164 * (texture(sDiffuseMap, fragTexCoords).r - 16.0 / 255.0);
+    float u = texture(sVideoU, fragTexCoords).r - 0.5;
+    float v = texture(sVideoV, fragTexCoords).r - 0.5;
+
+    vec3 color = vec3(
+        y + 1.596 * v,
+        y - 0.391 * u - 0.813 * v,
+        y + 2.018 * u);
+
+    fragColor = vec4(uGeneral.color.rgb * clamp(color, 0.0, 1.0), uGeneral.alpha);
+    fragColorBright = vec4(vec3(0.0), 1.0);
+}
+)END";
+
 } // namespace graphics
 
 } // namespace reone
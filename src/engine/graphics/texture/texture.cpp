@@ -43,8 +43,14 @@ void Texture::init() {
             configure2D();
         }
 
-        unbind();
         _inited = true;
+
+        // Upload pixels that were set before initialization
+        if (_width > 0 && _height > 0) {
+            refresh();
+        }
+
+        unbind();
     }
 }
 
@@ -126,15 +132,12 @@ void Texture::deinit() {
 }
 
 void Texture::clearPixels(int w, int h, PixelFormat format) {
-    if (!_properties.headless && !_inited) {
-        throw logic_error("Texture has not been initialized: " + _name);
-    }
     _width = w;
     _height = h;
     _pixelFormat = format;
     _layers.clear();
 
-    if (!_properties.headless) {
+    if (_inited) {
         refresh();
     }
 }
@@ -170,6 +173,11 @@ void Texture::fillTarget(uint32_t target, int level, int width, int height, cons
             glCompressedTexImage2D(target, level, getInternalPixelFormatGL(_pixelFormat), width, height, 0, size, pixels);
             break;
         case PixelFormat::Grayscale:
+            // Rows of single channel images are not necessarily 4-byte aligned
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+            glTexImage2D(target, level, getInternalPixelFormatGL(_pixelFormat), width, height, 0, getPixelFormatGL(), getPixelTypeGL(), pixels);
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+            break;
         case PixelFormat::RGB:
         case PixelFormat::RGBA:
         case PixelFormat::BGR:
@@ -298,9 +306,6 @@ void Texture::setPixels(int w, int h, PixelFormat format, shared_ptr<ByteArray>
 }
 
 void Texture::setPixels(int w, int h, PixelFormat format, vector<Layer> layers) {
-    if (!_properties.headless && !_inited) {
-        throw logic_error("Texture has not been initialized: " + _name);
-    }
     if (layers.empty()) {
         throw invalid_argument("layers is empty");
     }
@@ -309,7 +314,7 @@ void Texture::setPixels(int w, int h, PixelFormat format, vector<Layer> layers)
     _pixelFormat = format;
     _layers = move(layers);
 
-    if (!_properties.headless) {
+    if (_inited) {
         refresh();
     }
 }
@@ -98,7 +98,11 @@ public:
 
     ~Texture();
 
+    /**
+     * Creates an OpenGL texture and uploads pixels, if any have been set. Must be called on the main thread.
+     */
     void init();
+
     void deinit();
 
     void bind() const;
@@ -107,7 +111,7 @@ public:
     void flushGPUToCPU();
 
     /**
-     * Clears this texture pixels. Texture must be bound, unless it is headless.
+     * Clears this texture pixels. Texture must be bound, unless it has not been initialized yet.
      */
     void clearPixels(int w, int h, PixelFormat format);
 
@@ -128,12 +132,12 @@ public:
     PixelFormat pixelFormat() const { return _pixelFormat; }
 
     /**
-     * Sets this texture pixels from a single image. Texture must be bound, unless it is headless.
+     * Sets this texture pixels from a single image. Texture must be bound, unless it has not been initialized yet.
      */
     void setPixels(int w, int h, PixelFormat format, std::shared_ptr<ByteArray> pixels);
 
     /**
-     * Sets this texture pixels from multiple images. Texture must be bound, unless it is headless.
+     * Sets this texture pixels from multiple images. Texture must be bound, unless it has not been initialized yet.
      */
     void setPixels(int w, int h, PixelFormat format, std::vector<Layer> layers);
 
@@ -40,24 +40,32 @@ namespace reone {
 
 namespace graphics {
 
-Textures::Textures(Context &context, Resources &resources) : _context(context), _resources(resources) {
+Textures::Textures(Context &context, Resources &resources, bool headless) :
+    _context(context),
+    _resources(resources),
+    _headless(headless) {
 }
 
 void Textures::init() {
     // Initialize default texture
-    _default = make_shared<Texture>("default", getTextureProperties(TextureUsage::Default));
-    _default->init();
-    _default->bind();
+    _default = make_shared<Texture>("default", getTextureProperties(TextureUsage::Default, _headless));
+    if (!_headless) {
+        _default->init();
+        _default->bind();
+    }
     _default->clearPixels(1, 1, PixelFormat::RGB);
 
     // Initialize default cubemap texture
-    _defaultCubemap = make_shared<Texture>("default_cubemap", getTextureProperties(TextureUsage::CubeMapDefault));
-    _defaultCubemap->init();
-    _defaultCubemap->bind();
+    _defaultCubemap = make_shared<Texture>("default_cubemap", getTextureProperties(TextureUsage::CubeMapDefault, _headless));
+    if (!_headless) {
+        _defaultCubemap->init();
+        _defaultCubemap->bind();
+    }
     _defaultCubemap->clearPixels(1, 1, PixelFormat::RGB);
 }
 
 void Textures::invalidateCache() {
+    lock_guard<mutex> lock(_mutex);
     _cache.clear();
 }
 
@@ -94,24 +102,55 @@ void Textures::bindDefaults() {
 }
 
 shared_ptr<Texture> Textures::get(const string &resRef, TextureUsage usage) {
+    shared_ptr<Texture> texture(load(resRef, usage));
+    initPending();
+    return move(texture);
+}
+
+shared_ptr<Texture> Textures::load(const string &resRef, TextureUsage usage) {
     if (resRef.empty()) return nullptr;
 
-    auto maybeTexture = _cache.find(resRef);
-    if (maybeTexture != _cache.end()) {
-        return maybeTexture->second;
-    }
     string lcResRef(boost::to_lower_copy(resRef));
-    auto inserted = _cache.insert(make_pair(lcResRef, doGet(lcResRef, usage)));
+    {
+        lock_guard<mutex> lock(_mutex);
+        auto maybeTexture = _cache.find(lcResRef);
+        if (maybeTexture != _cache.end()) {
+            return maybeTexture->second;
+        }
+    }
+
+    // Texture is decoded outside of the lock, so that multiple threads can
+    // decode textures simultaneously. If two threads decode the same texture,
+    // the first one to finish wins.
+    shared_ptr<Texture> texture(doGet(lcResRef, usage));
+
+    lock_guard<mutex> lock(_mutex);
+    auto inserted = _cache.insert(make_pair(lcResRef, texture));
+    if (inserted.second && texture && !_headless) {
+        _pending.push_back(texture);
+    }
 
     return inserted.first->second;
 }
 
+void Textures::initPending() {
+    vector<shared_ptr<Texture>> pending;
+    {
+        lock_guard<mutex> lock(_mutex);
+        if (_pending.empty()) return;
+        swap(pending, _pending);
+    }
+    for (auto &texture : pending) {
+        texture->init();
+    }
+}
+
 shared_ptr<Texture> Textures::doGet(const string &resRef, TextureUsage usage) {
     shared_ptr<Texture> texture;
 
     shared_ptr<ByteArray> tgaData(_resources.getRaw(resRef, ResourceType::Tga, false));
     if (tgaData) {
-        TgaReader tga(resRef, usage);
+        TgaReader tga(resRef, usage, _headless);
         tga.load(wrap(tgaData));
         texture = tga.texture();
 
@@ -128,7 +167,7 @@ shared_ptr<Texture> Textures::doGet(const string &resRef, TextureUsage usage) {
     if (!texture) {
         shared_ptr<ByteArray> tpcData(_resources.getRaw(resRef, ResourceType::Tpc, false));
         if (tpcData) {
-            TpcReader tpc(resRef, usage);
+            TpcReader tpc(resRef, usage, _headless);
             tpc.load(wrap(tpcData));
             texture = tpc.texture();
         }
@@ -34,7 +34,10 @@ class Texture;
 
 class Textures : boost::noncopyable {
 public:
-    Textures(Context &context, resource::Resources &resources);
+    /**
+     * @param headless true if textures will not be used for rendering
+     */
+    Textures(Context &context, resource::Resources &resources, bool headless = false);
 
     void init();
     void invalidateCache();
@@ -44,15 +47,34 @@ public:
      */
     void bindDefaults();
 
+    /**
+     * Loads the specified texture, or returns a cached one, and initializes
+     * all pending textures. Must be called on the main thread.
+     */
     std::shared_ptr<Texture> get(const std::string &resRef, TextureUsage usage = TextureUsage::Default);
 
+    /**
+     * Loads the specified texture, or returns a cached one, without creating
+     * an OpenGL texture. Thread-safe. Loaded textures are initialized by the
+     * next call to get or initPending.
+     */
+    std::shared_ptr<Texture> load(const std::string &resRef, TextureUsage usage = TextureUsage::Default);
+
+    /**
+     * Initializes textures loaded by load. Must be called on the main thread.
+     */
+    void initPending();
+
 private:
     Context &_context;
     resource::Resources &_resources;
+    bool _headless;
 
     std::shared_ptr<graphics::Texture> _default;
     std::shared_ptr<graphics::Texture> _defaultCubemap;
     std::unordered_map<std::string, std::shared_ptr<Texture>> _cache;
+    std::vector<std::shared_ptr<Texture>> _pending;
+    std::mutex _mutex; /**< guards _cache and _pending */
 
     std::shared_ptr<Texture> doGet(const std::string &resRef, TextureUsage usage);
 };
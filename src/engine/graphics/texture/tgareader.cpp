@@ -28,7 +28,8 @@ namespace reone {
 
 namespace graphics {
 
-TgaReader::TgaReader(const string &resRef, TextureUsage usage) : BinaryReader(0), _resRef(resRef), _usage(usage) {
+TgaReader::TgaReader(const string &resRef, TextureUsage usage, bool headless) :
+    BinaryReader(0), _resRef(resRef), _usage(usage), _headless(headless) {
 }
 
 void TgaReader::doLoad() {
@@ -110,9 +111,7 @@ void TgaReader::loadTexture() {
         prepareCubeMap(layers, format, format);
     }
 
-    _texture = make_shared<Texture>(_resRef, getTextureProperties(_usage));
-    _texture->init();
-    _texture->bind();
+    _texture = make_shared<Texture>(_resRef, getTextureProperties(_usage, _headless));
     _texture->setPixels(_width, _height, format, move(layers));
 }
 
@@ -29,13 +29,17 @@ class Texture;
 
 class TgaReader : public resource::BinaryReader {
 public:
-    TgaReader(const std::string &resRef, TextureUsage usage);
+    /**
+     * @param headless true if texture will not be used for rendering
+     */
+    TgaReader(const std::string &resRef, TextureUsage usage, bool headless = false);
 
     std::shared_ptr<graphics::Texture> texture() const { return _texture; }
 
 private:
     std::string _resRef;
     TextureUsage _usage;
+    bool _headless;
 
     TGADataType _dataType { TGADataType::RGBA };
     int _width { 0 };
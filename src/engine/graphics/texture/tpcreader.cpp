@@ -143,10 +143,6 @@ void TpcReader::loadFeatures() {
 
 void TpcReader::makeTexture() {
     _texture = make_shared<Texture>(_resRef, getTextureProperties(_usage, _headless));
-    if (!_headless) {
-        _texture->init();
-        _texture->bind();
-    }
     _texture->setPixels(_width, _height, getPixelFormat(), move(_pixels));
     _texture->setFeatures(move(_features));
 }
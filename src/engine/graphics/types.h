@@ -117,6 +117,8 @@ struct TextureUnits {
     static constexpr int brdfLookup { 7 };
     static constexpr int shadowMap { 8 };
     static constexpr int shadowMapCube { 9 };
+    static constexpr int videoU { 10 };
+    static constexpr int videoV { 11 };
 };
 
 } // namespace graphics
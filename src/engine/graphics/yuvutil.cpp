@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2020-2021 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "yuvutil.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define REONE_GRAPHICS_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define REONE_GRAPHICS_NEON
+#include <arm_neon.h>
+#endif
+
+using namespace std;
+
+namespace reone {
+
+namespace graphics {
+
+// Chroma coefficients have 6 fraction bits, small enough for products to
+// fit into 16-bit lanes. Luma is scaled with a high multiply, which allows
+// for a more precise coefficient.
+
+static constexpr int kCoeffY = 19071; // 1.164, 14 fraction bits
+static constexpr int kOffsetY = 1192; // 16 * 1.164
+static constexpr int kCoeffRV = 102; // 1.596
+static constexpr int kCoeffGU = 25;  // 0.391
+static constexpr int kCoeffGV = 52;  // 0.813
+static constexpr int kCoeffBU = 129; // 2.018
+static constexpr int kFracBits = 6;
+static constexpr int kRound = 1 << (kFracBits - 1);
+
+static inline uint8_t clampToByte(int value) {
+    return static_cast<uint8_t>(max(0, min(255, value)));
+}
+
+static inline void convertPixel(int y, int u, int v, uint8_t *out) {
+    int luma = ((y * kCoeffY) >> 8) - kOffsetY + kRound;
+    int d = u - 128;
+    int e = v - 128;
+    out[0] = clampToByte((luma + kCoeffRV * e) >> kFracBits);
+    out[1] = clampToByte((luma - kCoeffGU * d - kCoeffGV * e) >> kFracBits);
+    out[2] = clampToByte((luma + kCoeffBU * d) >> kFracBits);
+    out[3] = 255;
+}
+
+// Vectorized variants convert 16 pixels of a row at a time. Only the blue
+// term may exceed the 16-bit range, in which case saturation yields the
+// same clamped result.
+
+#if defined(REONE_GRAPHICS_SSE2)
+
+static inline void convertPixelsx8(__m128i y, __m128i u, __m128i v, __m128i &r, __m128i &g, __m128i &b) {
+    __m128i luma = _mm_mulhi_epu16(_mm_slli_epi16(y, 8), _mm_set1_epi16(kCoeffY));
+    luma = _mm_add_epi16(luma, _mm_set1_epi16(kRound - kOffsetY));
+    __m128i d = _mm_sub_epi16(u, _mm_set1_epi16(128));
+    __m128i e = _mm_sub_epi16(v, _mm_set1_epi16(128));
+    r = _mm_srai_epi16(_mm_add_epi16(luma, _mm_mullo_epi16(e, _mm_set1_epi16(kCoeffRV))), kFracBits);
+    g = _mm_srai_epi16(_mm_sub_epi16(_mm_sub_epi16(luma, _mm_mullo_epi16(d, _mm_set1_epi16(kCoeffGU))), _mm_mullo_epi16(e, _mm_set1_epi16(kCoeffGV))), kFracBits);
+    b = _mm_srai_epi16(_mm_adds_epi16(luma, _mm_mullo_epi16(d, _mm_set1_epi16(kCoeffBU))), kFracBits);
+}
+
+static int convertRowVectorized(const uint8_t *y, const uint8_t *u, const uint8_t *v, int width, uint8_t *out) {
+    __m128i zero = _mm_setzero_si128();
+    __m128i alpha = _mm_set1_epi8(static_cast<char>(255));
+    int i = 0;
+    for (; i + 16 <= width; i += 16) {
+        __m128i ys = _mm_loadu_si128(reinterpret_cast<const __m128i *>(y + i));
+        __m128i us = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(u + i / 2)), zero);
+        __m128i vs = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(v + i / 2)), zero);
+
+        __m128i rLo, gLo, bLo, rHi, gHi, bHi;
+        convertPixelsx8(_mm_unpacklo_epi8(ys, zero), _mm_unpacklo_epi16(us, us), _mm_unpacklo_epi16(vs, vs), rLo, gLo, bLo);
+        convertPixelsx8(_mm_unpackhi_epi8(ys, zero), _mm_unpackhi_epi16(us, us), _mm_unpackhi_epi16(vs, vs), rHi, gHi, bHi);
+
+        __m128i r = _mm_packus_epi16(rLo, rHi);
+        __m128i g = _mm_packus_epi16(gLo, gHi);
+        __m128i b = _mm_packus_epi16(bLo, bHi);
+        __m128i rg0 = _mm_unpacklo_epi8(r, g);
+        __m128i rg1 = _mm_unpackhi_epi8(r, g);
+        __m128i ba0 = _mm_unpacklo_epi8(b, alpha);
+        __m128i ba1 = _mm_unpackhi_epi8(b, alpha);
+
+        __m128i *dst = reinterpret_cast<__m128i *>(out + 4 * i);
+        _mm_storeu_si128(dst + 0, _mm_unpacklo_epi16(rg0, ba0));
+        _mm_storeu_si128(dst + 1, _mm_unpackhi_epi16(rg0, ba0));
+        _mm_storeu_si128(dst + 2, _mm_unpacklo_epi16(rg1, ba1));
+        _mm_storeu_si128(dst + 3, _mm_unpackhi_epi16(rg1, ba1));
+    }
+    return i;
+}
+
+#elif defined(REONE_GRAPHICS_NEON)
+
+static inline void convertPixelsx8(uint8x8_t y, int16x8_t u, int16x8_t v, uint8x8_t &r, uint8x8_t &g, uint8x8_t &b) {
+    uint16x8_t yScaled = vcombine_u16(
+        vshrn_n_u32(vmull_n_u16(vget_low_u16(vmovl_u8(y)), kCoeffY), 8),
+        vshrn_n_u32(vmull_n_u16(vget_high_u16(vmovl_u8(y)), kCoeffY), 8));
+    int16x8_t luma = vaddq_s16(vreinterpretq_s16_u16(yScaled), vdupq_n_s16(kRound - kOffsetY));
+    int16x8_t d = vsubq_s16(u, vdupq_n_s16(128));
+    int16x8_t e = vsubq_s16(v, vdupq_n_s16(128));
+    r = vqmovun_s16(vshrq_n_s16(vaddq_s16(luma, vmulq_n_s16(e, kCoeffRV)), kFracBits));
+    g = vqmovun_s16(vshrq_n_s16(vsubq_s16(vsubq_s16(luma, vmulq_n_s16(d, kCoeffGU)), vmulq_n_s16(e, kCoeffGV)), kFracBits));
+    b = vqmovun_s16(vshrq_n_s16(vqaddq_s16(luma, vmulq_n_s16(d, kCoeffBU)), kFracBits));
+}
+
+static inline int16x8_t widen(uint8x8_t values) {
+    return vreinterpretq_s16_u16(vmovl_u8(values));
+}
+
+static int convertRowVectorized(const uint8_t *y, const uint8_t *u, const uint8_t *v, int width, uint8_t *out) {
+    int i = 0;
+    for (; i + 16 <= width; i += 16) {
+        uint8x16_t ys = vld1q_u8(y + i);
+        uint8x8x2_t us = vzip_u8(vld1_u8(u + i / 2), vld1_u8(u + i / 2));
+        uint8x8x2_t vs = vzip_u8(vld1_u8(v + i / 2), vld1_u8(v + i / 2));
+
+        uint8x8_t rLo, gLo, bLo, rHi, gHi, bHi;
+        convertPixelsx8(vget_low_u8(ys), widen(us.val[0]), widen(vs.val[0]), rLo, gLo, bLo);
+        convertPixelsx8(vget_high_u8(ys), widen(us.val[1]), widen(vs.val[1]), rHi, gHi, bHi);
+
+        uint8x16x4_t rgba;
+        rgba.val[0] = vcombine_u8(rLo, rHi);
+        rgba.val[1] = vcombine_u8(gLo, gHi);
+        rgba.val[2] = vcombine_u8(bLo, bHi);
+        rgba.val[3] = vdupq_n_u8(255);
+        vst4q_u8(out + 4 * i, rgba);
+    }
+    return i;
+}
+
+#else
+
+static int convertRowVectorized(const uint8_t *y, const uint8_t *u, const uint8_t *v, int width, uint8_t *out) {
+    return 0;
+}
+
+#endif
+
+void convertYUV420ToRGBA(const uint8_t *y, const uint8_t *u, const uint8_t *v, int width, int height, uint8_t *out) {
+    int chromaWidth = (width + 1) / 2;
+    for (int row = 0; row < height; ++row) {
+        const uint8_t *yRow = y + row * width;
+        const uint8_t *uRow = u + (row / 2) * chromaWidth;
+        const uint8_t *vRow = v + (row / 2) * chromaWidth;
+        uint8_t *outRow = out + 4 * row * width;
+
+        int i = convertRowVectorized(yRow, uRow, vRow, width, outRow);
+        for (; i < width; ++i) {
+            convertPixel(yRow[i], uRow[i / 2], vRow[i / 2], outRow + 4 * i);
+        }
+    }
+}
+
+} // namespace graphics
+
+} // namespace reone
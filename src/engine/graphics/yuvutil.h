@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2020-2021 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  YUV to RGB conversion routines, vectorized where SSE2 or NEON is available.
+ */
+
+#pragma once
+
+namespace reone {
+
+namespace graphics {
+
+/**
+ * Converts an image from planar YUV 4:2:0 (BT.601, limited range) to RGBA.
+ * Chroma planes are upsampled by replication. Planes must be tightly packed,
+ * i.e. with a row stride equal to their width.
+ *
+ * @param y luma plane, width * height samples
+ * @param u blue-difference chroma plane, (width + 1) / 2 * (height + 1) / 2 samples
+ * @param v red-difference chroma plane, same size as u
+ * @param out output buffer, must hold 4 * width * height bytes
+ */
+void convertYUV420ToRGBA(const uint8_t *y, const uint8_t *u, const uint8_t *v, int width, int height, uint8_t *out);
+
+} // namespace graphics
+
+} // namespace reone
@@ -19,6 +19,8 @@
 
 #include <algorithm>
 #include <atomic>
+#include <bitset>
+#include <chrono>
 #include <climits>
 #include <cstdarg>
 #include <cstdint>
@@ -36,6 +36,8 @@ namespace reone {
 
 static const char kConfigFilename[] = "reone.cfg";
 
+static constexpr int kDefaultUpdateRate = 60;
+static constexpr int kDefaultHeadlessSteps = 3600;
 static constexpr int kDefaultShadowResolution = 2;
 static constexpr int kDefaultMusicVolume = 85;
 static constexpr int kDefaultVoiceVolume = 85;
@@ -63,6 +65,13 @@ void Program::initOptions() {
         ("game", po::value<string>(), "path to game directory")
         ("dev", po::value<bool>()->default_value(false), "enable developer mode")
         ("module", po::value<string>(), "name of a module to load")
+        ("updaterate", po::value<int>()->default_value(kDefaultUpdateRate), "simulation update rate in Hz, 0 to update once per frame")
+        ("maxfps", po::value<int>()->default_value(0), "frame rate limit, 0 for unlimited")
+        ("headless", po::value<bool>()->default_value(false), "simulate a module without rendering and audio, then report timings")
+        ("replay", po::value<string>(), "path to an input sequence to replay in headless mode")
+        ("steps", po::value<int>()->default_value(kDefaultHeadlessSteps), "number of simulation steps in headless mode")
+        ("seed", po::value<uint32_t>()->default_value(0), "random seed in headless mode")
+        ("profile", po::value<string>(), "path to export collapsed script stacks to in headless mode")
         ("width", po::value<int>()->default_value(800), "window width")
         ("height", po::value<int>()->default_value(600), "window height")
         ("fullscreen", po::value<bool>()->default_value(false), "enable fullscreen")
@@ -96,6 +105,13 @@ void Program::loadOptions() {
     _gamePath = vars.count("game") > 0 ? vars["game"].as<string>() : fs::current_path();
     _options.developer = vars["dev"].as<bool>();
     _options.module = vars.count("module") > 0 ? vars["module"].as<string>() : "";
+    _options.updateRate = vars["updaterate"].as<int>();
+    _options.maxFps = vars["maxfps"].as<int>();
+    _options.headless = vars["headless"].as<bool>();
+    _options.replay = vars.count("replay") > 0 ? vars["replay"].as<string>() : "";
+    _options.headlessSteps = vars["steps"].as<int>();
+    _options.seed = vars["seed"].as<uint32_t>();
+    _options.profile = vars.count("profile") > 0 ? vars["profile"].as<string>() : "";
     _options.graphics.width = vars["width"].as<int>();
     _options.graphics.height = vars["height"].as<int>();
     _options.graphics.shadowResolution = vars["shadowres"].as<int>();
@@ -105,6 +121,8 @@ void Program::loadOptions() {
     _options.audio.voiceVolume = vars["voicevol"].as<int>();
     _options.audio.soundVolume = vars["soundvol"].as<int>();
     _options.audio.movieVolume = vars["movievol"].as<int>();
+    _options.graphics.headless = _options.headless;
+    _options.audio.headless = _options.headless;
 
     setDebugLogLevel(vars["debug"].as<int>());
     setLogToFile(vars["logfile"].as<bool>());
@@ -84,6 +84,16 @@ shared_ptr<ByteArray> Folder::find(const string &resRef, ResourceType type) {
     return make_shared<ByteArray>(move(data));
 }
 
+vector<string> Folder::getResRefs(ResourceType type) const {
+    vector<string> result;
+    for (auto &res : _resources) {
+        if (res.second.type == type) {
+            result.push_back(res.first);
+        }
+    }
+    return move(result);
+}
+
 } // namespace resource
 
 } // namespace reone
@@ -32,6 +32,7 @@ public:
 
     bool supports(ResourceType type) const override;
     std::shared_ptr<ByteArray> find(const std::string &resRef, ResourceType type) override;
+    std::vector<std::string> getResRefs(ResourceType type) const override;
 
 private:
     struct Resource {
@@ -125,6 +125,16 @@ shared_ptr<ByteArray> ErfReader::find(const string &resRef, ResourceType type) {
     return make_shared<ByteArray>(getResourceData(res));
 }
 
+vector<string> ErfReader::getResRefs(ResourceType type) const {
+    vector<string> result;
+    for (auto &key : _keys) {
+        if (key.resType == type) {
+            result.push_back(key.resRef);
+        }
+    }
+    return move(result);
+}
+
 ByteArray ErfReader::getResourceData(const Resource &res) {
     return readBytes(res.offset, res.size);
 }
@@ -82,6 +82,16 @@ shared_ptr<ByteArray> RimReader::find(const string &resRef, ResourceType type) {
     return make_shared<ByteArray>(getResourceData(*it));
 }
 
+vector<string> RimReader::getResRefs(ResourceType type) const {
+    vector<string> result;
+    for (auto &res : _resources) {
+        if (res.resType == type) {
+            result.push_back(res.resRef);
+        }
+    }
+    return move(result);
+}
+
 ByteArray RimReader::getResourceData(const Resource &res) {
     return readBytes(res.offset, res.size);
 }
@@ -39,6 +39,7 @@ public:
 
     bool supports(ResourceType type) const override;
     std::shared_ptr<ByteArray> find(const std::string &resRef, ResourceType resType) override;
+    std::vector<std::string> getResRefs(ResourceType type) const override;
     ByteArray getResourceData(int idx);
 
     const std::vector<Resource> &resources() const { return _resources; }
@@ -64,6 +64,16 @@ shared_ptr<ByteArray> KeyBifResourceProvider::find(const std::string &resRef, Re
     return move(result);
 }
 
+vector<string> KeyBifResourceProvider::getResRefs(ResourceType type) const {
+    vector<string> result;
+    for (auto &key : _keyFile.keys()) {
+        if (key.resType == type) {
+            result.push_back(key.resRef);
+        }
+    }
+    return move(result);
+}
+
 bool KeyBifResourceProvider::supports(ResourceType type) const {
     return true;
 }
@@ -31,6 +31,7 @@ public:
     void init(const boost::filesystem::path &keyPath);
 
     std::shared_ptr<ByteArray> find(const std::string &resRef, ResourceType type) override;
+    std::vector<std::string> getResRefs(ResourceType type) const override;
 
     bool supports(ResourceType type) const override;
 
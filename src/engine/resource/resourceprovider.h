@@ -35,6 +35,11 @@ public:
 
     virtual std::shared_ptr<ByteArray> find(const std::string &resRef, ResourceType type) = 0;
 
+    /**
+     * @return ResRefs of all resources of the specified ResType in this resource provider
+     */
+    virtual std::vector<std::string> getResRefs(ResourceType type) const = 0;
+
     /**
      * @return true if this resource provider supports the specified ResType,
      *         false otherwise
@@ -46,8 +46,7 @@ void Resources::indexKeyFile(const fs::path &path) {
 
     auto keyBif = make_unique<KeyBifResourceProvider>();
     keyBif->init(path);
-
-    _providers.push_back(move(keyBif));
+    addProvider(move(keyBif), false);
 
     debug("Indexed " + path.string());
 }
@@ -57,12 +56,7 @@ void Resources::indexErfFile(const fs::path &path, bool transient) {
 
     auto erf = make_unique<ErfReader>();
     erf->load(path);
-
-    if (transient) {
-        _transientProviders.push_back(move(erf));
-    } else {
-        _providers.push_back(move(erf));
-    }
+    addProvider(move(erf), transient);
 
     debug("Indexed " + path.string());
 }
@@ -72,12 +66,7 @@ void Resources::indexRimFile(const fs::path &path, bool transient) {
 
     auto rim = make_unique<RimReader>();
     rim->load(path);
-
-    if (transient) {
-        _transientProviders.push_back(move(rim));
-    } else {
-        _providers.push_back(move(rim));
-    }
+    addProvider(move(rim), transient);
 
     debug("Indexed " + path.string());
 }
@@ -87,12 +76,24 @@ void Resources::indexDirectory(const fs::path &path) {
 
     auto folder = make_unique<Folder>();
     folder->load(path);
-
-    _providers.push_back(move(folder));
+    addProvider(move(folder), false);
 
     debug("Indexed " + path.string());
 }
 
+void Resources::addProvider(unique_ptr<IResourceProvider> provider, bool transient) {
+    auto entry = make_shared<Provider>();
+    entry->provider = move(provider);
+
+    lock_guard<mutex> lock(_rawMutex);
+    if (transient) {
+        _transientProviders.push_back(move(entry));
+    } else {
+        _providers.push_back(move(entry));
+    }
+    ++_rawGeneration;
+}
+
 void Resources::indexExeFile(const fs::path &path) {
     if (!fs::exists(path)) return;
 
@@ -102,13 +103,19 @@ void Resources::indexExeFile(const fs::path &path) {
 }
 
 void Resources::invalidateCache() {
-    _rawCache.clear();
+    {
+        lock_guard<mutex> lock(_rawMutex);
+        _rawCache.clear();
+        ++_rawGeneration;
+    }
     _2daCache.clear();
     _gffCache.clear();
 }
 
 void Resources::clearTransientProviders() {
+    lock_guard<mutex> lock(_rawMutex);
     _transientProviders.clear();
+    ++_rawGeneration;
 }
 
 template <class T>
@@ -124,19 +131,80 @@ shared_ptr<ByteArray> Resources::getRaw(const string &resRef, ResourceType type,
     if (resRef.empty()) return nullptr;
 
     string cacheKey(getCacheKey(resRef, type));
+    shared_ptr<ByteArray> data;
+    ProviderList providers;
+    int generation = 0;
+    if (findCachedRaw(cacheKey, data, providers, generation)) return move(data);
+
+    data = doGetRaw(providers, resRef, type, logNotFound);
+
+    lock_guard<mutex> lock(_rawMutex);
+    // Do not cache resources read from providers, that have since been replaced
+    if (generation != _rawGeneration) return move(data);
+
+    // Another thread might have read the same resource in the meantime
+    auto pair = _rawCache.insert(make_pair(cacheKey, move(data)));
+
+    return pair.first->second;
+}
+
+shared_ptr<ByteArray> Resources::getRawUncached(const string &resRef, ResourceType type, bool logNotFound) {
+    if (resRef.empty()) return nullptr;
+
+    string cacheKey(getCacheKey(resRef, type));
+    shared_ptr<ByteArray> data;
+    ProviderList providers;
+    int generation = 0;
+    if (findCachedRaw(cacheKey, data, providers, generation)) return move(data);
+
+    return doGetRaw(providers, resRef, type, logNotFound);
+}
+
+bool Resources::findCachedRaw(const string &cacheKey, shared_ptr<ByteArray> &data, ProviderList &providers, int &generation) {
+    lock_guard<mutex> lock(_rawMutex);
+
     auto res = _rawCache.find(cacheKey);
-    if (res != _rawCache.end()) return res->second;
+    if (res != _rawCache.end()) {
+        data = res->second;
+        return true;
+    }
+
+    // Transient providers take precedence, and are queried last to first, same as regular providers
+    providers.reserve(_providers.size() + _transientProviders.size());
+    providers.insert(providers.end(), _providers.begin(), _providers.end());
+    providers.insert(providers.end(), _transientProviders.begin(), _transientProviders.end());
+    generation = _rawGeneration;
+
+    return false;
+}
 
-    shared_ptr<ByteArray> data = doGetRaw(_transientProviders, resRef, type);
-    if (!data) {
-        data = doGetRaw(_providers, resRef, type);
+shared_ptr<ByteArray> Resources::doGetRaw(const ProviderList &providers, const string &resRef, ResourceType type, bool logNotFound) {
+    shared_ptr<ByteArray> data;
+    for (auto entry = providers.rbegin(); entry != providers.rend(); ++entry) {
+        if (!(*entry)->provider->supports(type)) continue;
+
+        lock_guard<mutex> lock((*entry)->mutex);
+        data = (*entry)->provider->find(resRef, type);
+        if (data) break;
     }
     if (!data && logNotFound) {
-        warn("Resource not found: " + cacheKey);
+        warn("Resource not found: " + getCacheKey(resRef, type));
     }
-    auto pair = _rawCache.insert(make_pair(cacheKey, move(data)));
+    return move(data);
+}
 
-    return pair.first->second;
+vector<string> Resources::getTransientResRefs(ResourceType type) const {
+    vector<string> result;
+    for (auto &entry : _transientProviders) {
+        if (!entry->provider->supports(type)) continue;
+
+        vector<string> resRefs(entry->provider->getResRefs(type));
+        result.insert(result.end(), resRefs.begin(), resRefs.end());
+    }
+    sort(result.begin(), result.end());
+    result.erase(unique(result.begin(), result.end()), result.end());
+
+    return move(result);
 }
 
 string Resources::getCacheKey(const string &resRef, ResourceType type) const {
@@ -158,17 +226,6 @@ shared_ptr<TwoDA> Resources::get2DA(const string &resRef, bool logNotFound) {
     });
 }
 
-shared_ptr<ByteArray> Resources::doGetRaw(const vector<unique_ptr<IResourceProvider>> &providers, const string &resRef, ResourceType type) {
-    for (auto provider = providers.rbegin(); provider != providers.rend(); ++provider) {
-        if (!(*provider)->supports(type)) continue;
-
-        shared_ptr<ByteArray> data((*provider)->find(resRef, type));
-        if (data) return data;
-    }
-
-    return nullptr;
-}
-
 shared_ptr<GffStruct> Resources::getGFF(const string &resRef, ResourceType type) {
     string cacheKey(getCacheKey(resRef, type));
 
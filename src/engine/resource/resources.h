@@ -34,6 +34,9 @@ class TwoDA;
  * Encapsulates game resource management. Contains a prioritized list of
  * resource providers, that it queries for resources by ResRef and ResType.
  * Caches found resources.
+ *
+ * Raw resources may be read from any thread. Other functions must be called
+ * on the main thread.
  */
 class Resources : boost::noncopyable {
 public:
@@ -49,22 +52,45 @@ public:
     void clearTransientProviders();
 
     std::shared_ptr<ByteArray> getRaw(const std::string &resRef, ResourceType type, bool logNotFound = true);
+
+    /**
+     * Same as getRaw, but does not cache the resource. Used to load resources
+     * ahead of time, that might never be needed.
+     */
+    std::shared_ptr<ByteArray> getRawUncached(const std::string &resRef, ResourceType type, bool logNotFound = true);
     std::shared_ptr<TwoDA> get2DA(const std::string &resRef, bool logNotFound = true);
     std::shared_ptr<GffStruct> getGFF(const std::string &resRef, ResourceType type);
     std::shared_ptr<ByteArray> getFromExe(uint32_t name, PEResourceType type);
 
+    /**
+     * @return sorted ResRefs of all resources of the specified ResType in transient providers, i.e. in the current module
+     */
+    std::vector<std::string> getTransientResRefs(ResourceType type) const;
+
 private:
+    /**
+     * Resource provider, that may be queried from multiple threads.
+     */
+    struct Provider {
+        std::unique_ptr<IResourceProvider> provider;
+        std::mutex mutex; /**< serializes reads, as providers share a single file stream */
+    };
+
+    typedef std::vector<std::shared_ptr<Provider>> ProviderList;
+
     // Providers
 
     PEReader _exeFile;
-    std::vector<std::unique_ptr<IResourceProvider>> _providers;
-    std::vector<std::unique_ptr<IResourceProvider>> _transientProviders; /**< transient providers are replaced when switching between modules */
+    ProviderList _providers;
+    ProviderList _transientProviders; /**< transient providers are replaced when switching between modules */
 
     // END Providers
 
     // Caches
 
+    std::mutex _rawMutex; /**< guards provider lists and the raw cache, but not reads from providers */
     std::unordered_map<std::string, std::shared_ptr<ByteArray>> _rawCache;
+    int _rawGeneration { 0 }; /**< incremented whenever cached raw resources may become stale */
     std::unordered_map<std::string, std::shared_ptr<TwoDA>> _2daCache;
     std::unordered_map<std::string, std::shared_ptr<GffStruct>> _gffCache;
 
@@ -72,7 +98,17 @@ private:
 
     std::string getCacheKey(const std::string &resRef, ResourceType type) const;
 
-    std::shared_ptr<ByteArray> doGetRaw(const std::vector<std::unique_ptr<IResourceProvider>> &providers, const std::string &resRef, ResourceType type);
+    void addProvider(std::unique_ptr<IResourceProvider> provider, bool transient);
+
+    /**
+     * Looks up a raw resource in the cache. On a cache miss, copies provider
+     * lists, so that providers can be queried without holding the lock.
+     *
+     * @return true if the resource was found in the cache, false otherwise
+     */
+    bool findCachedRaw(const std::string &cacheKey, std::shared_ptr<ByteArray> &data, ProviderList &providers, int &generation);
+
+    std::shared_ptr<ByteArray> doGetRaw(const ProviderList &providers, const std::string &resRef, ResourceType type, bool logNotFound);
 };
 
 } // namespace resource
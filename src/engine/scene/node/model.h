@@ -18,6 +18,7 @@
 #pragma once
 
 #include "../../graphics/lip/animation.h"
+#include "../../graphics/lip/lipposes.h"
 #include "../../graphics/model/model.h"
 
 #include "../animeventlistener.h"
@@ -100,6 +101,8 @@ private:
     struct AnimationChannel {
         std::shared_ptr<graphics::Animation> anim;
         std::shared_ptr<graphics::LipAnimation> lipAnim;
+        std::shared_ptr<graphics::LipPoses> lipPoses; /**< baked on first use */
+        int lipCursor { 0 }; /**< keyframe of the lip animation, sampled last */
         AnimationProperties properties;
         float time { 0.0f };
         std::unordered_map<std::string, AnimationState> stateByName;
@@ -147,6 +150,7 @@ private:
     void updateAnimations(float dt);
     void updateAnimationChannel(AnimationChannel &channel, float dt);
     void computeAnimationStates(AnimationChannel &channel, float time, const graphics::ModelNode &modelNode);
+    void computeLipAnimationStates(AnimationChannel &channel, float time);
     void applyAnimationStates(const graphics::ModelNode &modelNode);
     void computeBoneTransforms();
 
@@ -176,7 +176,11 @@ void ModelSceneNode::updateAnimationChannel(AnimationChannel &channel, float dt)
     if (!_culled) {
         float time = channel.transition ? channel.anim->transitionTime() : channel.time;
         channel.stateByName.clear();
-        computeAnimationStates(channel, time, *_model->rootNode());
+        if (channel.lipAnim) {
+            computeLipAnimationStates(channel, time);
+        } else {
+            computeAnimationStates(channel, time, *_model->rootNode());
+        }
     }
 }
 
@@ -190,39 +194,79 @@ void ModelSceneNode::computeAnimationStates(AnimationChannel &channel, float tim
         glm::quat orientation(modelNode.restOrientation());
         float scale = 1.0f;
 
-        if (channel.lipAnim) {
-            uint8_t leftShape, rightShape;
-            float factor;
-            if (channel.lipAnim->getKeyframes(time, leftShape, rightShape, factor)) {
-                glm::vec3 animPosition;
-                if (animNode->getPosition(leftShape, rightShape, factor, animPosition)) {
-                    position += channel.properties.scale * animPosition;
-                    state.flags |= AnimationStateFlags::transform;
-                }
-                glm::quat animOrientation;
-                if (animNode->getOrientation(leftShape, rightShape, factor, animOrientation)) {
-                    orientation = move(animOrientation);
-                    state.flags |= AnimationStateFlags::transform;
-                }
-                float animScale;
-                if (animNode->getScale(leftShape, rightShape, factor, animScale)) {
-                    scale = animScale;
-                    state.flags |= AnimationStateFlags::transform;
-                }
-            }
-        } else {
+        glm::vec3 animPosition;
+        if (animNode->position().getByTime(time, animPosition)) {
+            position += channel.properties.scale * animPosition;
+            state.flags |= AnimationStateFlags::transform;
+        }
+        glm::quat animOrientation;
+        if (animNode->orientation().getByTime(time, animOrientation)) {
+            orientation = move(animOrientation);
+            state.flags |= AnimationStateFlags::transform;
+        }
+        float animScale;
+        if (animNode->scale().getByTime(time, animScale)) {
+            scale = animScale;
+            state.flags |= AnimationStateFlags::transform;
+        }
+
+        if (state.flags & AnimationStateFlags::transform) {
+            state.transform *= glm::scale(glm::vec3(scale));
+            state.transform *= glm::translate(position);
+            state.transform *= glm::mat4_cast(orientation);
+        }
+
+        float animAlpha;
+        if (animNode->alpha().getByTime(time, animAlpha)) {
+            state.flags |= AnimationStateFlags::alpha;
+            state.alpha = animAlpha;
+        }
+
+        glm::vec3 animSelfIllum;
+        if (animNode->selfIllumColor().getByTime(time, animSelfIllum)) {
+            state.flags |= AnimationStateFlags::selfIllumColor;
+            state.selfIllumColor = move(animSelfIllum);
+        }
+
+        channel.stateByName.insert(make_pair(modelNode.name(), move(state)));
+    }
+
+    for (auto &child : modelNode.children()) {
+        computeAnimationStates(channel, time, *child);
+    }
+}
+
+void ModelSceneNode::computeLipAnimationStates(AnimationChannel &channel, float time) {
+    if (!channel.lipPoses) {
+        channel.lipPoses = _model->getLipPoses(channel.anim);
+    }
+    LipAnimation::Sample sample;
+    bool sampled = channel.lipAnim->sample(time, channel.lipCursor, sample);
+
+    for (auto &node : channel.lipPoses->nodes()) {
+        const string &name = node.modelNode->name();
+        if (!_inanimateNodes.empty() && _inanimateNodes.count(name) > 0) continue;
+
+        AnimationState state;
+        state.flags = 0;
+
+        glm::vec3 position(node.modelNode->restPosition());
+        glm::quat orientation(node.modelNode->restOrientation());
+        float scale = 1.0f;
+
+        if (sampled) {
             glm::vec3 animPosition;
-            if (animNode->position().getByTime(time, animPosition)) {
+            if (node.getPosition(sample, animPosition)) {
                 position += channel.properties.scale * animPosition;
                 state.flags |= AnimationStateFlags::transform;
             }
             glm::quat animOrientation;
-            if (animNode->orientation().getByTime(time, animOrientation)) {
+            if (node.getOrientation(sample, animOrientation)) {
                 orientation = move(animOrientation);
                 state.flags |= AnimationStateFlags::transform;
             }
             float animScale;
-            if (animNode->scale().getByTime(time, animScale)) {
+            if (node.getScale(sample, animScale)) {
                 scale = animScale;
                 state.flags |= AnimationStateFlags::transform;
             }
@@ -235,22 +279,18 @@ void ModelSceneNode::computeAnimationStates(AnimationChannel &channel, float tim
         }
 
         float animAlpha;
-        if (animNode->alpha().getByTime(time, animAlpha)) {
+        if (node.animNode->alpha().getByTime(time, animAlpha)) {
             state.flags |= AnimationStateFlags::alpha;
             state.alpha = animAlpha;
         }
 
         glm::vec3 animSelfIllum;
-        if (animNode->selfIllumColor().getByTime(time, animSelfIllum)) {
+        if (node.animNode->selfIllumColor().getByTime(time, animSelfIllum)) {
             state.flags |= AnimationStateFlags::selfIllumColor;
             state.selfIllumColor = move(animSelfIllum);
         }
 
-        channel.stateByName.insert(make_pair(modelNode.name(), move(state)));
-    }
-
-    for (auto &child : modelNode.children()) {
-        computeAnimationStates(channel, time, *child);
+        channel.stateByName.insert(make_pair(name, move(state)));
     }
 }
 
@@ -40,7 +40,9 @@ void SceneServices::init() {
     _graph = make_unique<SceneGraph>(_options, _graphics);
 
     _worldRenderPipeline = make_unique<WorldRenderPipeline>(_options, _graphics, *_graph);
-    _worldRenderPipeline->init();
+    if (!_options.headless) {
+        _worldRenderPipeline->init();
+    }
 }
 
 } // namespace scene
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2020-2021 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "variable.h"
+
+namespace reone {
+
+namespace script {
+
+/**
+ * Non-owning view of routine arguments. Arguments are laid out in reverse
+ * order, as they are pushed onto the script execution stack, so that
+ * routines can read them from the stack without copying.
+ */
+class ArgumentList {
+public:
+    ArgumentList() = default;
+
+    /**
+     * @param first pointer to the first argument, subsequent arguments are at lower addresses
+     * @param size number of arguments
+     */
+    ArgumentList(const Variable *first, int size) : _first(first), _size(size) {
+    }
+
+    bool empty() const { return _size == 0; }
+
+    int size() const { return _size; }
+
+    const Variable &operator[](int index) const { return *(_first - index); }
+
+private:
+    const Variable *_first { nullptr };
+    int _size { 0 };
+};
+
+inline bool isOutOfRange(const ArgumentList &args, int index) {
+    return index < 0 || index >= args.size();
+}
+
+} // namespace script
+
+} // namespace reone
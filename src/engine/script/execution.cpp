@@ -20,106 +20,146 @@
 #include "../common/guardutil.h"
 #include "../common/log.h"
 
+#include "argumentlist.h"
 #include "executioncontext.h"
 #include "instrutil.h"
+#include "profiler.h"
 #include "program.h"
 #include "routine.h"
 #include "routineprovider.h"
 #include "variable.h"
 
 using namespace std;
-using namespace std::placeholders;
 
 namespace reone {
 
 namespace script {
 
 static constexpr int kStartInstructionOffset = 13;
+static constexpr int kInitialStackCapacity = 64;
+static constexpr int kMaxPooledStackCount = 16;
+static constexpr size_t kMaxPooledStackCapacity = 4096;
+
+struct ExecutionStacks {
+    vector<Variable> stack;
+    vector<int> returnIndices;
+    vector<Variable> arguments;
+};
+
+/**
+ * Stacks released by finished executions. Nested executions (e.g. scripts
+ * run from routines) take further stacks from the pool.
+ */
+static thread_local vector<ExecutionStacks> g_stacksPool;
 
 ScriptExecution::ScriptExecution(shared_ptr<ScriptProgram> program, unique_ptr<ExecutionContext> context) : _context(move(context)), _program(program) {
     ensureNotNull(program, "program");
 
-    static unordered_map<ByteCode, function<void(ScriptExecution *, const Instruction &)>> handlers {
-        { ByteCode::CopyDownSP, &ScriptExecution::executeCopyDownSP },
-        { ByteCode::Reserve, &ScriptExecution::executeReserve },
-        { ByteCode::CopyTopSP, &ScriptExecution::executeCopyTopSP },
-        { ByteCode::PushConstant, &ScriptExecution::executePushConstant },
-        { ByteCode::CallRoutine, &ScriptExecution::executeCallRoutine },
-        { ByteCode::LogicalAnd, &ScriptExecution::executeLogicalAnd },
-        { ByteCode::LogicalOr, &ScriptExecution::executeLogicalOr },
-        { ByteCode::InclusiveBitwiseOr, &ScriptExecution::executeInclusiveBitwiseOr },
-        { ByteCode::ExclusiveBitwiseOr, &ScriptExecution::executeExclusiveBitwiseOr },
-        { ByteCode::BitwiseAnd, &ScriptExecution::executeBitwiseAnd },
-        { ByteCode::Equal, &ScriptExecution::executeEqual },
-        { ByteCode::NotEqual, &ScriptExecution::executeNotEqual },
-        { ByteCode::GreaterThanOrEqual, &ScriptExecution::executeGreaterThanOrEqual },
-        { ByteCode::GreaterThan, &ScriptExecution::executeGreaterThan },
-        { ByteCode::LessThan, &ScriptExecution::executeLessThan },
-        { ByteCode::LessThanOrEqual, &ScriptExecution::executeLessThanOrEqual },
-        { ByteCode::ShiftLeft, &ScriptExecution::executeShiftLeft },
-        { ByteCode::ShiftRight, &ScriptExecution::executeShiftRight },
-        { ByteCode::UnsignedShiftRight, &ScriptExecution::executeUnsignedShiftRight },
-        { ByteCode::Add, &ScriptExecution::executeAdd },
-        { ByteCode::Subtract, &ScriptExecution::executeSubtract },
-        { ByteCode::Multiply, &ScriptExecution::executeMultiply },
-        { ByteCode::Divide, &ScriptExecution::executeDivide },
-        { ByteCode::Mod, &ScriptExecution::executeMod },
-        { ByteCode::Negate, &ScriptExecution::executeNegate },
-        { ByteCode::AdjustSP, &ScriptExecution::executeAdjustSP },
-        { ByteCode::Jump, &ScriptExecution::executeJump },
-        { ByteCode::JumpToSubroutine, &ScriptExecution::executeJumpToSubroutine },
-        { ByteCode::JumpIfZero, &ScriptExecution::executeJumpIfZero },
-        { ByteCode::Return, &ScriptExecution::executeReturn },
-        { ByteCode::Destruct, &ScriptExecution::executeDestruct },
-        { ByteCode::LogicalNot, &ScriptExecution::executeLogicalNot },
-        { ByteCode::DecRelToSP, &ScriptExecution::executeDecRelToSP },
-        { ByteCode::IncRelToSP, &ScriptExecution::executeIncRelToSP },
-        { ByteCode::JumpIfNonZero, &ScriptExecution::executeJumpIfNonZero },
-        { ByteCode::CopyDownBP, &ScriptExecution::executeCopyDownBP },
-        { ByteCode::CopyTopBP, &ScriptExecution::executeCopyTopBP },
-        { ByteCode::DecRelToBP, &ScriptExecution::executeDecRelToBP },
-        { ByteCode::IncRelToBP, &ScriptExecution::executeIncRelToBP },
-        { ByteCode::SaveBP, &ScriptExecution::executeSaveBP },
-        { ByteCode::RestoreBP, &ScriptExecution::executeRestoreBP },
-        { ByteCode::StoreState, &ScriptExecution::executeStoreState }
-    };
-    for (auto &pair : handlers) {
-        registerHandler(pair.first, pair.second);
-    }
-    _handlers.insert(make_pair(ByteCode::Noop, [](const Instruction &) {}));
+    if (!g_stacksPool.empty()) {
+        _stack.swap(g_stacksPool.back().stack);
+        _returnIndices.swap(g_stacksPool.back().returnIndices);
+        _arguments.swap(g_stacksPool.back().arguments);
+        g_stacksPool.pop_back();
+    } else {
+        _stack.reserve(kInitialStackCapacity);
+    }
+}
+
+ScriptExecution::~ScriptExecution() {
+    // Do not let a single deep script hold on to a large stack
+    if (g_stacksPool.size() >= kMaxPooledStackCount || _stack.capacity() > kMaxPooledStackCapacity) return;
+
+    _stack.clear();
+    _returnIndices.clear();
+    _arguments.clear();
+
+    ExecutionStacks stacks;
+    stacks.stack.swap(_stack);
+    stacks.returnIndices.swap(_returnIndices);
+    stacks.arguments.swap(_arguments);
+    g_stacksPool.push_back(move(stacks));
 }
 
 int ScriptExecution::run() {
-    debug(boost::format("Script: run %s as %u") % _program->name() % _context->callerId, 1, DebugChannels::script);
-    uint32_t insOff = kStartInstructionOffset;
+    if (getDebugLogLevel() >= 1) {
+        debug(boost::format("Script: run %s as %u") % _program->name() % _context->callerId, 1, DebugChannels::script);
+    }
+
+    // Programs built by hand are linked lazily
+    if (!_program->isLinked()) {
+        _program->link();
+    }
+    int insCount = static_cast<int>(_program->instructions().size());
+    int insIdx = _program->getInstructionIndex(kStartInstructionOffset);
 
     if (_context->savedState) {
-        vector<Variable> globals(_context->savedState->globals);
-        copy(globals.begin(), globals.end(), back_inserter(_stack));
+        const ExecutionState &state = *_context->savedState;
+        _stack.insert(_stack.end(), state.globals.begin(), state.globals.end());
         _globalCount = static_cast<int>(_stack.size());
+        _stack.insert(_stack.end(), state.locals.begin(), state.locals.end());
 
-        vector<Variable> locals(_context->savedState->locals);
-        copy(locals.begin(), locals.end(), back_inserter(_stack));
+        insIdx = _program->getInstructionIndex(_context->savedState->insOffset);
+    }
+    if (insIdx == -1) {
+        insIdx = insCount;
+    }
 
-        insOff = _context->savedState->insOffset;
+    if (_context->profiler && _context->profiler->isEnabled()) {
+        startProfiling();
+        try {
+            int result = runInstructions(insIdx);
+            stopProfiling();
+            return result;
+        } catch (...) {
+            stopProfiling();
+            throw;
+        }
     }
 
-    while (insOff < _program->length()) {
-        const Instruction &ins = _program->getInstruction(insOff);
-        auto handler = _handlers.find(ins.byteCode);
+    return runInstructions(insIdx);
+}
 
-        if (handler == _handlers.end()) {
-            debug("Script: byte code not implemented: " + describeByteCode(ins.byteCode), 1, DebugChannels::script);
-            return -1;
-        }
-        _nextInstruction = ins.nextOffset;
+int ScriptExecution::run(shared_ptr<ScriptProgram> program) {
+    ensureNotNull(program, "program");
 
-        if (getDebugLogLevel() >= 2) {
+    _program = move(program);
+    _stack.clear();
+    _returnIndices.clear();
+    _globalCount = 0;
+    _savedState.reset();
+    _subroutineFrameIds.clear();
+
+    return run();
+}
+
+int ScriptExecution::resume(const ExecutionContext &closure, uint32_t callerId) {
+    if (!closure.savedState) return -1;
+
+    auto context = make_unique<ExecutionContext>(closure);
+    context->callerId = callerId;
+
+    return ScriptExecution(closure.savedState->program, move(context)).run();
+}
+
+int ScriptExecution::runInstructions(int insIdx) {
+    const vector<Instruction> &instructions = _program->instructions();
+    int insCount = static_cast<int>(instructions.size());
+    bool debugInstructions = getDebugLogLevel() >= 2;
+
+    while (insIdx < insCount) {
+        const Instruction &ins = instructions[insIdx];
+        _nextInstruction = insIdx + 1;
+        ++_instructionCount;
+
+        if (debugInstructions) {
             debug(boost::format("Script: instruction: %s") % describeInstruction(ins), 3, DebugChannels::script);
         }
-        handler->second(ins);
+        if (!execute(ins)) {
+            debug("Script: byte code not implemented: " + describeByteCode(ins.byteCode), 1, DebugChannels::script);
+            return -1;
+        }
 
-        insOff = _nextInstruction;
+        insIdx = _nextInstruction;
     }
 
     if (!_stack.empty() && _stack.back().type == VariableType::Int) {
@@ -129,6 +169,180 @@ int ScriptExecution::run() {
     return -1;
 }
 
+void ScriptExecution::startProfiling() {
+    _profiler = _context->profiler;
+    _profilerParentNode = _profiler->currentNode();
+    _profiledInstructionCount = _instructionCount;
+    _profiler->enterFrame(_profiler->getFrameId(_program->name()), 0);
+}
+
+void ScriptExecution::stopProfiling() {
+    _profiler->exitToNode(_profilerParentNode, takeProfiledInstructions());
+    _profiler = nullptr;
+}
+
+int ScriptExecution::takeProfiledInstructions() {
+    int result = _instructionCount - _profiledInstructionCount;
+    _profiledInstructionCount = _instructionCount;
+    return result;
+}
+
+uint32_t ScriptExecution::getSubroutineFrameId(int insIdx) {
+    auto maybeId = _subroutineFrameIds.find(insIdx);
+    if (maybeId != _subroutineFrameIds.end()) return maybeId->second;
+
+    const Instruction &ins = _program->instructions()[insIdx];
+    uint32_t id = _profiler->getFrameId(str(boost::format("%s:sub_%04x") % _program->name() % ins.offset));
+    _subroutineFrameIds.insert(make_pair(insIdx, id));
+
+    return id;
+}
+
+bool ScriptExecution::execute(const Instruction &ins) {
+    switch (ins.byteCode) {
+        case ByteCode::CopyDownSP:
+            executeCopyDownSP(ins);
+            break;
+        case ByteCode::Reserve:
+            executeReserve(ins);
+            break;
+        case ByteCode::CopyTopSP:
+            executeCopyTopSP(ins);
+            break;
+        case ByteCode::PushConstant:
+            executePushConstant(ins);
+            break;
+        case ByteCode::CallRoutine:
+            executeCallRoutine(ins);
+            break;
+        case ByteCode::LogicalAnd:
+            executeLogicalAnd(ins);
+            break;
+        case ByteCode::LogicalOr:
+            executeLogicalOr(ins);
+            break;
+        case ByteCode::InclusiveBitwiseOr:
+            executeInclusiveBitwiseOr(ins);
+            break;
+        case ByteCode::ExclusiveBitwiseOr:
+            executeExclusiveBitwiseOr(ins);
+            break;
+        case ByteCode::BitwiseAnd:
+            executeBitwiseAnd(ins);
+            break;
+        case ByteCode::Equal:
+            executeEqual(ins);
+            break;
+        case ByteCode::NotEqual:
+            executeNotEqual(ins);
+            break;
+        case ByteCode::GreaterThanOrEqual:
+            executeGreaterThanOrEqual(ins);
+            break;
+        case ByteCode::GreaterThan:
+            executeGreaterThan(ins);
+            break;
+        case ByteCode::LessThan:
+            executeLessThan(ins);
+            break;
+        case ByteCode::LessThanOrEqual:
+            executeLessThanOrEqual(ins);
+            break;
+        case ByteCode::ShiftLeft:
+            executeShiftLeft(ins);
+            break;
+        case ByteCode::ShiftRight:
+            executeShiftRight(ins);
+            break;
+        case ByteCode::UnsignedShiftRight:
+            executeUnsignedShiftRight(ins);
+            break;
+        case ByteCode::Add:
+            executeAdd(ins);
+            break;
+        case ByteCode::Subtract:
+            executeSubtract(ins);
+            break;
+        case ByteCode::Multiply:
+            executeMultiply(ins);
+            break;
+        case ByteCode::Divide:
+            executeDivide(ins);
+            break;
+        case ByteCode::Mod:
+            executeMod(ins);
+            break;
+        case ByteCode::Negate:
+            executeNegate(ins);
+            break;
+        case ByteCode::AdjustSP:
+            executeAdjustSP(ins);
+            break;
+        case ByteCode::Jump:
+            executeJump(ins);
+            break;
+        case ByteCode::JumpToSubroutine:
+            executeJumpToSubroutine(ins);
+            break;
+        case ByteCode::JumpIfZero:
+            executeJumpIfZero(ins);
+            break;
+        case ByteCode::Return:
+            executeReturn(ins);
+            break;
+        case ByteCode::Destruct:
+            executeDestruct(ins);
+            break;
+        case ByteCode::LogicalNot:
+            executeLogicalNot(ins);
+            break;
+        case ByteCode::DecRelToSP:
+            executeDecRelToSP(ins);
+            break;
+        case ByteCode::IncRelToSP:
+            executeIncRelToSP(ins);
+            break;
+        case ByteCode::JumpIfNonZero:
+            executeJumpIfNonZero(ins);
+            break;
+        case ByteCode::CopyDownBP:
+            executeCopyDownBP(ins);
+            break;
+        case ByteCode::CopyTopBP:
+            executeCopyTopBP(ins);
+            break;
+        case ByteCode::DecRelToBP:
+            executeDecRelToBP(ins);
+            break;
+        case ByteCode::IncRelToBP:
+            executeIncRelToBP(ins);
+            break;
+        case ByteCode::SaveBP:
+            executeSaveBP(ins);
+            break;
+        case ByteCode::RestoreBP:
+            executeRestoreBP(ins);
+            break;
+        case ByteCode::StoreState:
+            executeStoreState(ins);
+            break;
+        case ByteCode::Noop:
+            break;
+        case ByteCode::CopyDownSPAdjustSP:
+            executeCopyDownSPAdjustSP(ins);
+            break;
+        case ByteCode::CompareJumpIfZero:
+            executeCompareJumpIfZero(ins);
+            break;
+        case ByteCode::ConstantCompareJumpIfZero:
+            executeConstantCompareJumpIfZero(ins);
+            break;
+        default:
+            return false;
+    }
+    return true;
+}
+
 void ScriptExecution::executeCopyDownSP(const Instruction &ins) {
     int count = ins.size / 4;
     int srcIdx = static_cast<int>(_stack.size()) - count;
@@ -196,7 +410,11 @@ void ScriptExecution::executePushConstant(const Instruction &ins) {
             break;
         }
         case InstructionType::String:
-            _stack.push_back(Variable::ofString(ins.strValue));
+            if (ins.strConstant.type == VariableType::String) {
+                _stack.push_back(ins.strConstant);
+            } else {
+                _stack.push_back(Variable::ofString(ins.strValue));
+            }
             break;
         default:
             throw invalid_argument("Script: invalid instruction type: " + to_string(static_cast<int>(ins.type)));
@@ -209,43 +427,65 @@ void ScriptExecution::executeCallRoutine(const Instruction &ins) {
     if (ins.argCount > routine.getArgumentCount()) {
         throw runtime_error("Script: too many routine arguments");
     }
-    vector<Variable> args;
+    Variable retValue;
 
-    for (int i = 0; i < ins.argCount; ++i) {
-        VariableType type = routine.getArgumentType(i);
-
-        switch (type) {
-            case VariableType::Vector:
-                args.push_back(getVectorFromStack());
-                break;
-
-            case VariableType::Action: {
-                auto ctx = make_shared<ExecutionContext>(*_context);
-                ctx->savedState = make_shared<ExecutionState>(_savedState);
-                args.push_back(Variable::ofAction(move(ctx)));
-                break;
+    if (routine.hasScalarArguments()) {
+        // Arguments occupy a single stack slot each, pass them in place
+        if (ins.argCount > static_cast<int>(_stack.size())) {
+            throw runtime_error("Script: not enough routine arguments on the stack");
+        }
+        const Variable *first = _stack.data() + _stack.size() - 1;
+        for (int i = 0; i < ins.argCount; ++i) {
+            if (first[-i].type != routine.getArgumentType(i)) {
+                throw runtime_error("Script: invalid argument variable type");
             }
-            default:
-                Variable var(_stack.back());
+        }
+        ArgumentList args(first, ins.argCount);
+        retValue = invokeRoutine(routine, args);
 
-                if (var.type != type) {
-                    throw runtime_error("Script: invalid argument variable type");
+        if (getDebugLogLevel() >= 2) {
+            debugCallRoutine(ins, routine, args, retValue);
+        }
+        _stack.erase(_stack.end() - ins.argCount, _stack.end());
+
+    } else {
+        // Vectors occupy three stack slots and actions none, collect arguments
+        _arguments.clear();
+
+        for (int i = 0; i < ins.argCount; ++i) {
+            VariableType type = routine.getArgumentType(i);
+
+            switch (type) {
+                case VariableType::Vector:
+                    _arguments.push_back(getVectorFromStack());
+                    break;
+
+                case VariableType::Action: {
+                    auto ctx = make_shared<ExecutionContext>(*_context);
+                    ctx->savedState = _savedState;
+                    _arguments.push_back(Variable::ofAction(move(ctx)));
+                    break;
                 }
-                args.push_back(move(var));
-                _stack.pop_back();
-                break;
+                default:
+                    if (_stack.back().type != type) {
+                        throw runtime_error("Script: invalid argument variable type");
+                    }
+                    _arguments.push_back(move(_stack.back()));
+                    _stack.pop_back();
+                    break;
+            }
         }
-    }
-    Variable retValue = routine.invoke(args, *_context);
+        reverse(_arguments.begin(), _arguments.end());
+
+        ArgumentList args(_arguments.empty() ? nullptr : &_arguments.back(), ins.argCount);
+        retValue = invokeRoutine(routine, args);
 
-    if (getDebugLogLevel() >= 2) {
-        vector<string> argStrings;
-        for (auto &arg : args) {
-            argStrings.push_back(arg.toString());
+        if (getDebugLogLevel() >= 2) {
+            debugCallRoutine(ins, routine, args, retValue);
         }
-        string argsString(boost::join(argStrings, ", "));
-        debug(boost::format("Script: action: %04x %s(%s) -> %s") % ins.offset % routine.name() % argsString % retValue.toString(), 2, DebugChannels::script);
+        _arguments.clear();
     }
+
     switch (routine.returnType()) {
         case VariableType::Void:
             break;
@@ -255,11 +495,35 @@ void ScriptExecution::executeCallRoutine(const Instruction &ins) {
             _stack.push_back(Variable::ofFloat(retValue.vecValue.x));
             break;
         default:
-            _stack.push_back(retValue);
+            _stack.push_back(move(retValue));
             break;
     }
 }
 
+Variable ScriptExecution::invokeRoutine(const Routine &routine, const ArgumentList &args) {
+    if (!_profiler) {
+        return routine.invoke(args, *_context);
+    }
+    _profiler->enterFrame(_profiler->getFrameId(routine.name()), takeProfiledInstructions());
+    try {
+        Variable result(routine.invoke(args, *_context));
+        _profiler->exitFrame(0);
+        return move(result);
+    } catch (...) {
+        _profiler->exitFrame(0);
+        throw;
+    }
+}
+
+void ScriptExecution::debugCallRoutine(const Instruction &ins, const Routine &routine, const ArgumentList &args, const Variable &retValue) const {
+    vector<string> argStrings;
+    for (int i = 0; i < args.size(); ++i) {
+        argStrings.push_back(args[i].toString());
+    }
+    string argsString(boost::join(argStrings, ", "));
+    debug(boost::format("Script: action: %04x %s(%s) -> %s") % ins.offset % routine.name() % argsString % retValue.toString(), 2, DebugChannels::script);
+}
+
 Variable ScriptExecution::getVectorFromStack() {
     float x = getFloatFromStack().floatValue;
     float y = getFloatFromStack().floatValue;
@@ -462,12 +726,16 @@ void ScriptExecution::executeAdjustSP(const Instruction &ins) {
 }
 
 void ScriptExecution::executeJump(const Instruction &ins) {
-    _nextInstruction = ins.jumpOffset;
+    _nextInstruction = ins.jumpIndex;
 }
 
 void ScriptExecution::executeJumpToSubroutine(const Instruction &ins) {
-    _returnOffsets.push_back(ins.nextOffset);
-    _nextInstruction = ins.jumpOffset;
+    _returnIndices.push_back(_nextInstruction);
+    _nextInstruction = ins.jumpIndex;
+
+    if (_profiler) {
+        _profiler->enterFrame(getSubroutineFrameId(ins.jumpIndex), takeProfiledInstructions());
+    }
 }
 
 void ScriptExecution::executeJumpIfZero(const Instruction &ins) {
@@ -475,16 +743,20 @@ void ScriptExecution::executeJumpIfZero(const Instruction &ins) {
     _stack.pop_back();
 
     if (zero) {
-        _nextInstruction = ins.jumpOffset;
+        _nextInstruction = ins.jumpIndex;
     }
 }
 
 void ScriptExecution::executeReturn(const Instruction &ins) {
-    if (_returnOffsets.empty()) {
-        _nextInstruction = _program->length();
+    if (_returnIndices.empty()) {
+        _nextInstruction = static_cast<int>(_program->instructions().size());
     } else {
-        _nextInstruction = _returnOffsets.back();
-        _returnOffsets.pop_back();
+        _nextInstruction = _returnIndices.back();
+        _returnIndices.pop_back();
+
+        if (_profiler) {
+            _profiler->exitFrame(takeProfiledInstructions());
+        }
     }
 }
 
@@ -521,7 +793,7 @@ void ScriptExecution::executeJumpIfNonZero(const Instruction &ins) {
     _stack.pop_back();
 
     if (!zero) {
-        _nextInstruction = ins.jumpOffset;
+        _nextInstruction = ins.jumpIndex;
     }
 }
 
@@ -565,24 +837,95 @@ void ScriptExecution::executeRestoreBP(const Instruction &ins) {
 }
 
 void ScriptExecution::executeStoreState(const Instruction &ins) {
+    auto state = make_shared<ExecutionState>();
+
     int count = ins.size / 4;
     int srcIdx = _globalCount - count;
-
-    _savedState.globals.clear();
-    for (int i = 0; i < count; ++i) {
-        _savedState.globals.push_back(_stack[srcIdx++]);
-    }
+    state->globals.assign(_stack.begin() + srcIdx, _stack.begin() + srcIdx + count);
 
     count = ins.sizeLocals / 4;
     srcIdx = static_cast<int>(_stack.size()) - count;
+    state->locals.assign(_stack.begin() + srcIdx, _stack.end());
 
-    _savedState.locals.clear();
-    for (int i = 0; i < count; ++i) {
-        _savedState.locals.push_back(_stack[srcIdx++]);
+    state->program = _program;
+    state->insOffset = ins.offset + static_cast<int>(ins.type);
+
+    _savedState = move(state);
+}
+
+void ScriptExecution::executeCopyDownSPAdjustSP(const Instruction &ins) {
+    executeCopyDownSP(ins);
+    _stack.erase(_stack.end() - ins.size / 4, _stack.end());
+}
+
+static bool compareIntegers(ByteCode operation, int left, int right) {
+    switch (operation) {
+        case ByteCode::Equal:
+            return left == right;
+        case ByteCode::NotEqual:
+            return left != right;
+        case ByteCode::GreaterThanOrEqual:
+            return left >= right;
+        case ByteCode::GreaterThan:
+            return left > right;
+        case ByteCode::LessThan:
+            return left < right;
+        case ByteCode::LessThanOrEqual:
+            return left <= right;
+        default:
+            throw logic_error("Script: unsupported comparison: " + to_string(static_cast<int>(operation)));
+    }
+}
+
+/**
+ * Compares two variables the same way the unfused comparison instruction
+ * would, taking a shortcut when both are integers.
+ */
+static bool compareVariables(ByteCode operation, const Variable &left, const Variable &right) {
+    if (left.type == VariableType::Int && right.type == VariableType::Int) {
+        return compareIntegers(operation, left.intValue, right.intValue);
+    }
+    switch (operation) {
+        case ByteCode::Equal:
+            return left == right;
+        case ByteCode::NotEqual:
+            return left != right;
+        case ByteCode::GreaterThanOrEqual:
+            return left >= right;
+        case ByteCode::GreaterThan:
+            return left > right;
+        case ByteCode::LessThan:
+            return left < right;
+        case ByteCode::LessThanOrEqual:
+            return left <= right;
+        default:
+            throw logic_error("Script: unsupported comparison: " + to_string(static_cast<int>(operation)));
+    }
+}
+
+void ScriptExecution::executeCompareJumpIfZero(const Instruction &ins) {
+    size_t stackSize = _stack.size();
+    bool result = compareVariables(ins.operation, _stack[stackSize - 2], _stack[stackSize - 1]);
+
+    _stack.pop_back();
+    _stack.pop_back();
+
+    if (!result) {
+        _nextInstruction = ins.jumpIndex;
     }
+}
 
-    _savedState.program = _program;
-    _savedState.insOffset = ins.offset + static_cast<int>(ins.type);
+void ScriptExecution::executeConstantCompareJumpIfZero(const Instruction &ins) {
+    const Variable &left = _stack.back();
+    bool result = left.type == VariableType::Int ?
+        compareIntegers(ins.operation, left.intValue, ins.intValue) :
+        compareVariables(ins.operation, left, Variable::ofInt(ins.intValue));
+
+    _stack.pop_back();
+
+    if (!result) {
+        _nextInstruction = ins.jumpIndex;
+    }
 }
 
 int ScriptExecution::getStackSize() const {
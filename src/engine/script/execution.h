@@ -28,36 +28,91 @@ struct ExecutionContext;
 struct Instruction;
 struct Variable;
 
+class ArgumentList;
+class Routine;
+class ScriptProfiler;
 class ScriptProgram;
 
+/**
+ * Executes a script program. Stacks of finished executions are pooled per
+ * thread, so that starting a script normally does not allocate.
+ */
 class ScriptExecution : boost::noncopyable {
 public:
     ScriptExecution(std::shared_ptr<ScriptProgram> program, std::unique_ptr<ExecutionContext> context);
+    ~ScriptExecution();
 
     int run();
 
+    /**
+     * Runs another program in this execution, reusing its stacks and
+     * context, i.e. to evaluate a batch of scripts on behalf of the same
+     * caller.
+     */
+    int run(std::shared_ptr<ScriptProgram> program);
+
+    /**
+     * Resumes a closure, i.e. an action argument, on behalf of the specified
+     * caller. Frame of the closure is shared, not copied.
+     *
+     * @return result of the script, or -1 if the closure has no saved state
+     */
+    static int resume(const ExecutionContext &closure, uint32_t callerId);
+
     int getStackSize() const;
     const Variable &getStackVariable(int index) const;
 
 private:
     std::shared_ptr<ScriptProgram> _program;
     std::unique_ptr<ExecutionContext> _context;
-    std::unordered_map<ByteCode, std::function<void(const Instruction &)>> _handlers;
     std::vector<Variable> _stack;
-    std::vector<uint32_t> _returnOffsets;
-    uint32_t _nextInstruction { 0 };
+    std::vector<int> _returnIndices;
+    std::vector<Variable> _arguments; /**< arguments of routines that cannot be read from the stack directly */
+    int _nextInstruction { 0 }; /**< index of the next instruction to execute */
     int _globalCount { 0 };
-    ExecutionState _savedState;
+    std::shared_ptr<const ExecutionState> _savedState; /**< frame captured by the last STORE_STATE */
+    int _instructionCount { 0 }; /**< number of executed instructions */
+
+    // Profiling
+
+    ScriptProfiler *_profiler { nullptr }; /**< profiler, if enabled when the execution started */
+    uint32_t _profilerParentNode { 0 };
+    int _profiledInstructionCount { 0 };
+    std::unordered_map<int, uint32_t> _subroutineFrameIds;
 
-    template <class T>
-    void registerHandler(ByteCode code, T handler) {
-        _handlers.insert(std::make_pair(code, std::bind(handler, this, std::placeholders::_1)));
-    }
+    // END Profiling
+
+    int runInstructions(int insIdx);
+
+    /**
+     * Executes a single instruction.
+     *
+     * @return false if the byte code is not implemented, true otherwise
+     */
+    bool execute(const Instruction &ins);
 
     Variable getVectorFromStack();
     Variable getFloatFromStack();
     void getTwoIntegersFromStack(Variable &left, Variable &right);
 
+    // Profiling
+
+    void startProfiling();
+    void stopProfiling();
+
+    /**
+     * @return number of instructions executed since the last profiler transition
+     */
+    int takeProfiledInstructions();
+
+    uint32_t getSubroutineFrameId(int insIdx);
+
+    // END Profiling
+
+    Variable invokeRoutine(const Routine &routine, const ArgumentList &args);
+
+    void debugCallRoutine(const Instruction &ins, const Routine &routine, const ArgumentList &args, const Variable &retValue) const;
+
     // Handlers
 
     void executeCopyDownSP(const Instruction &ins);
@@ -104,6 +159,14 @@ private:
     void executeStoreState(const Instruction &ins);
 
     // END Handlers
+
+    // Superinstruction handlers
+
+    void executeCopyDownSPAdjustSP(const Instruction &ins);
+    void executeCompareJumpIfZero(const Instruction &ins);
+    void executeConstantCompareJumpIfZero(const Instruction &ins);
+
+    // END Superinstruction handlers
 };
 
 } // namespace script
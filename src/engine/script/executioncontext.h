@@ -26,10 +26,12 @@ namespace script {
 struct ExecutionState;
 
 class IRoutineProvider;
+class ScriptProfiler;
 
 struct ExecutionContext {
     IRoutineProvider *routines { nullptr };
-    std::shared_ptr<ExecutionState> savedState;
+    ScriptProfiler *profiler { nullptr };
+    std::shared_ptr<const ExecutionState> savedState; /**< immutable frame of a closure, captured by STORE_STATE */
     uint32_t callerId { kObjectInvalid };
     uint32_t triggererId { kObjectInvalid };
     int userDefinedEventNumber { -1 };
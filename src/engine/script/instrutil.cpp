@@ -70,6 +70,9 @@ static map<ByteCode, string> g_codeDesc = {
     { ByteCode::RestoreBP, "RESTOREBP" },
     { ByteCode::StoreState, "STORE_STATE" },
     { ByteCode::Noop, "NOP" },
+    { ByteCode::CopyDownSPAdjustSP, "CPDOWNSP_MOVSP" },
+    { ByteCode::CompareJumpIfZero, "CMPII_JZ" },
+    { ByteCode::ConstantCompareJumpIfZero, "CONSTI_CMPII_JZ" },
     { ByteCode::Invalid, "[invalid]" }
 };
 
@@ -85,6 +88,14 @@ string describeInstruction(const Instruction &ins) {
             desc += str(boost::format(" %08x") % ins.jumpOffset);
             break;
 
+        case ByteCode::CompareJumpIfZero:
+            desc += str(boost::format(" %s %08x") % describeByteCode(ins.operation) % ins.jumpOffset);
+            break;
+
+        case ByteCode::ConstantCompareJumpIfZero:
+            desc += str(boost::format(" %d %s %08x") % ins.intValue % describeByteCode(ins.operation) % ins.jumpOffset);
+            break;
+
         case ByteCode::PushConstant:
             switch (ins.type) {
                 case InstructionType::Int:
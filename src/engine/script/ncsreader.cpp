@@ -42,6 +42,8 @@ void NcsReader::doLoad() {
     while (off < length) {
         readInstruction(off);
     }
+
+    _program->link();
 }
 
 void NcsReader::readInstruction(size_t &offset) {
@@ -155,7 +157,7 @@ void NcsReader::readInstruction(size_t &offset) {
     size_t pos = tell();
     ins.nextOffset = static_cast<uint32_t>(pos);
 
-    _program->_instructions.insert(make_pair(static_cast<uint32_t>(offset), move(ins)));
+    _program->add(move(ins));
 
     offset = pos;
 }
@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2020-2021 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "optimizer.h"
+
+#include "program.h"
+
+using namespace std;
+
+namespace reone {
+
+namespace script {
+
+static constexpr int kMaxPassCount = 4;
+
+static bool isIntegerComparison(const Instruction &ins) {
+    if (ins.type != InstructionType::IntInt) return false;
+
+    switch (ins.byteCode) {
+        case ByteCode::Equal:
+        case ByteCode::NotEqual:
+        case ByteCode::GreaterThanOrEqual:
+        case ByteCode::GreaterThan:
+        case ByteCode::LessThan:
+        case ByteCode::LessThanOrEqual:
+            return true;
+        default:
+            return false;
+    }
+}
+
+int ScriptOptimizer::optimize(ScriptProgram &program) {
+    int removedCount = 0;
+
+    for (int pass = 0; pass < kMaxPassCount; ++pass) {
+        const vector<Instruction> &instructions = program.instructions();
+        int insCount = static_cast<int>(instructions.size());
+        collectTargets(instructions);
+
+        vector<Instruction> optimized;
+        optimized.reserve(insCount);
+
+        for (int i = 0; i < insCount;) {
+            Instruction fused;
+            int fusedCount = fuse(instructions, i, fused);
+            if (fusedCount > 0) {
+                optimized.push_back(move(fused));
+                i += fusedCount;
+            } else {
+                optimized.push_back(instructions[i++]);
+            }
+        }
+
+        int passRemovedCount = insCount - static_cast<int>(optimized.size());
+        if (passRemovedCount == 0) break;
+
+        program.setInstructions(move(optimized));
+        removedCount += passRemovedCount;
+    }
+
+    program.link();
+
+    return removedCount;
+}
+
+void ScriptOptimizer::collectTargets(const vector<Instruction> &instructions) {
+    _targets.clear();
+
+    for (auto &ins : instructions) {
+        switch (ins.byteCode) {
+            case ByteCode::Jump:
+            case ByteCode::JumpToSubroutine:
+            case ByteCode::JumpIfZero:
+            case ByteCode::JumpIfNonZero:
+            case ByteCode::CompareJumpIfZero:
+            case ByteCode::ConstantCompareJumpIfZero:
+                _targets.insert(static_cast<uint32_t>(ins.jumpOffset));
+                break;
+            case ByteCode::StoreState:
+                // Actions resume execution at this offset
+                _targets.insert(ins.offset + static_cast<uint32_t>(ins.type));
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+int ScriptOptimizer::fuse(const vector<Instruction> &instructions, int index, Instruction &fused) const {
+    int insCount = static_cast<int>(instructions.size());
+    const Instruction &first = instructions[index];
+
+    // RSADDx, CONSTx, CPDOWNSP -8 4, MOVSP -4 => CONSTx
+    if (first.byteCode == ByteCode::Reserve && index + 3 < insCount) {
+        const Instruction &push = instructions[index + 1];
+        const Instruction &copy = instructions[index + 2];
+        const Instruction &adjust = instructions[index + 3];
+        if (push.byteCode == ByteCode::PushConstant && push.type == first.type &&
+            copy.byteCode == ByteCode::CopyDownSP && copy.stackOffset == -8 && copy.size == 4 &&
+            adjust.byteCode == ByteCode::AdjustSP && adjust.stackOffset == -4 &&
+            isFusable(instructions, index, 4)) {
+
+            fused = push;
+            fused.offset = first.offset;
+            fused.nextOffset = adjust.nextOffset;
+            return 4;
+        }
+    }
+
+    // CPDOWNSP x n, MOVSP -n => CPDOWNSP_MOVSP x n
+    if (first.byteCode == ByteCode::CopyDownSP && index + 1 < insCount) {
+        const Instruction &adjust = instructions[index + 1];
+        if (adjust.byteCode == ByteCode::AdjustSP && adjust.stackOffset == -first.size && isFusable(instructions, index, 2)) {
+            fused = first;
+            fused.byteCode = ByteCode::CopyDownSPAdjustSP;
+            fused.nextOffset = adjust.nextOffset;
+            return 2;
+        }
+    }
+
+    // CONSTI c, CMPII, JZ x => CONSTI_CMPII_JZ c x
+    if (first.byteCode == ByteCode::PushConstant && first.type == InstructionType::Int && index + 2 < insCount) {
+        const Instruction &compare = instructions[index + 1];
+        const Instruction &jump = instructions[index + 2];
+        if (isIntegerComparison(compare) && jump.byteCode == ByteCode::JumpIfZero && isFusable(instructions, index, 3)) {
+            fused = jump;
+            fused.offset = first.offset;
+            fused.byteCode = ByteCode::ConstantCompareJumpIfZero;
+            fused.type = InstructionType::IntInt;
+            fused.operation = compare.byteCode;
+            fused.intValue = first.intValue;
+            return 3;
+        }
+    }
+
+    // CMPII, JZ x => CMPII_JZ x
+    if (isIntegerComparison(first) && index + 1 < insCount) {
+        const Instruction &jump = instructions[index + 1];
+        if (jump.byteCode == ByteCode::JumpIfZero && isFusable(instructions, index, 2)) {
+            fused = jump;
+            fused.offset = first.offset;
+            fused.byteCode = ByteCode::CompareJumpIfZero;
+            fused.type = InstructionType::IntInt;
+            fused.operation = first.byteCode;
+            return 2;
+        }
+    }
+
+    // CPTOPBP x n, CPTOPBP x+n m => CPTOPBP x n+m
+    if (first.byteCode == ByteCode::CopyTopBP && index + 1 < insCount) {
+        const Instruction &second = instructions[index + 1];
+        if (second.byteCode == ByteCode::CopyTopBP && second.stackOffset == first.stackOffset + first.size && isFusable(instructions, index, 2)) {
+            fused = first;
+            fused.size = first.size + second.size;
+            fused.nextOffset = second.nextOffset;
+            return 2;
+        }
+    }
+
+    // MOVSP x, MOVSP y => MOVSP x+y
+    if (first.byteCode == ByteCode::AdjustSP && index + 1 < insCount) {
+        const Instruction &second = instructions[index + 1];
+        if (second.byteCode == ByteCode::AdjustSP && isFusable(instructions, index, 2)) {
+            fused = first;
+            fused.stackOffset = first.stackOffset + second.stackOffset;
+            fused.nextOffset = second.nextOffset;
+            return 2;
+        }
+    }
+
+    return 0;
+}
+
+bool ScriptOptimizer::isFusable(const vector<Instruction> &instructions, int index, int count) const {
+    for (int i = index + 1; i < index + count; ++i) {
+        if (_targets.count(instructions[i].offset) > 0) return false;
+    }
+    return true;
+}
+
+} // namespace script
+
+} // namespace reone
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2020-2021 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+namespace reone {
+
+namespace script {
+
+class ScriptProgram;
+struct Instruction;
+
+/**
+ * Load-time peephole optimizer of script programs. Fuses common sequences
+ * of compiler output into superinstructions and removes redundant stack
+ * manipulation. Sequences that contain a jump target, other than at their
+ * start, are left intact.
+ */
+class ScriptOptimizer : boost::noncopyable {
+public:
+    /**
+     * Optimizes and links the program.
+     *
+     * @return number of removed instructions
+     */
+    int optimize(ScriptProgram &program);
+
+private:
+    std::unordered_set<uint32_t> _targets; /**< offsets of instructions that control can be transferred to */
+
+    void collectTargets(const std::vector<Instruction> &instructions);
+
+    /**
+     * Fuses instructions at the specified index.
+     *
+     * @return number of fused instructions, or 0 if none of the patterns matches
+     */
+    int fuse(const std::vector<Instruction> &instructions, int index, Instruction &fused) const;
+
+    /**
+     * @return true if none of the instructions in [index + 1, index + count) is a jump target
+     */
+    bool isFusable(const std::vector<Instruction> &instructions, int index, int count) const;
+};
+
+} // namespace script
+
+} // namespace reone
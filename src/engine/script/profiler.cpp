@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2020-2021 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "profiler.h"
+
+using namespace std;
+
+namespace reone {
+
+namespace script {
+
+ScriptProfiler::ScriptProfiler(int capacity) : _capacity(capacity) {
+    if (capacity <= 0) {
+        throw invalid_argument("capacity must be a positive number");
+    }
+    _nodes.push_back(Node());
+}
+
+void ScriptProfiler::setEnabled(bool enabled) {
+    if (_enabled == enabled) return;
+
+    // Ring buffer is only allocated when profiling is requested
+    if (enabled && _records.empty()) {
+        _records.resize(_capacity);
+    }
+    _currentNode = 0;
+    _enabled = enabled;
+}
+
+void ScriptProfiler::clear() {
+    _frameNames.clear();
+    _frameIdByName.clear();
+    _nodes.clear();
+    _nodes.push_back(Node());
+    _nodeByKey.clear();
+    _currentNode = 0;
+    _recordsWritten = 0;
+}
+
+uint32_t ScriptProfiler::getFrameId(const string &name) {
+    auto maybeId = _frameIdByName.find(name);
+    if (maybeId != _frameIdByName.end()) return maybeId->second;
+
+    auto id = static_cast<uint32_t>(_frameNames.size());
+    _frameNames.push_back(name);
+    _frameIdByName.insert(make_pair(name, id));
+
+    return id;
+}
+
+void ScriptProfiler::enterFrame(uint32_t frameId, int instructionCount) {
+    flush(instructionCount);
+
+    uint64_t key = (static_cast<uint64_t>(_currentNode) << 32) | frameId;
+    auto maybeNode = _nodeByKey.find(key);
+    if (maybeNode != _nodeByKey.end()) {
+        _currentNode = maybeNode->second;
+        return;
+    }
+    Node node;
+    node.parent = _currentNode;
+    node.frameId = frameId;
+
+    _currentNode = static_cast<uint32_t>(_nodes.size());
+    _nodes.push_back(move(node));
+    _nodeByKey.insert(make_pair(key, _currentNode));
+}
+
+void ScriptProfiler::exitFrame(int instructionCount) {
+    flush(instructionCount);
+    _currentNode = _nodes[_currentNode].parent;
+}
+
+void ScriptProfiler::exitToNode(uint32_t node, int instructionCount) {
+    flush(instructionCount);
+    _currentNode = node < _nodes.size() ? node : 0;
+}
+
+void ScriptProfiler::flush(int instructionCount) {
+    auto now = chrono::steady_clock::now();
+
+    // Time spent outside of scripts is not recorded
+    if (_currentNode != 0 && !_records.empty()) {
+        Record &record = _records[_recordsWritten % _records.size()];
+        record.node = _currentNode;
+        record.instructionCount = instructionCount;
+        record.time = now - _segmentStart;
+        ++_recordsWritten;
+    }
+    _segmentStart = now;
+}
+
+int ScriptProfiler::getRecordCount() const {
+    return static_cast<int>(min(_recordsWritten, _records.size()));
+}
+
+void ScriptProfiler::exportCollapsedStacks(ostream &out, bool byInstructions) const {
+    map<uint32_t, Record> totalByNode;
+    for (int i = 0; i < getRecordCount(); ++i) {
+        const Record &record = _records[i];
+        Record &total = totalByNode[record.node];
+        total.instructionCount += record.instructionCount;
+        total.time += record.time;
+    }
+    for (auto &total : totalByNode) {
+        int64_t weight = byInstructions ?
+            total.second.instructionCount :
+            chrono::duration_cast<chrono::microseconds>(total.second.time).count();
+
+        if (weight > 0) {
+            out << getStackName(total.first) << " " << weight << endl;
+        }
+    }
+}
+
+string ScriptProfiler::getStackName(uint32_t node) const {
+    vector<const string *> frames;
+    for (uint32_t n = node; n != 0; n = _nodes[n].parent) {
+        frames.push_back(&_frameNames[_nodes[n].frameId]);
+    }
+    string result;
+    for (auto it = frames.rbegin(); it != frames.rend(); ++it) {
+        if (!result.empty()) {
+            result += ";";
+        }
+        result += **it;
+    }
+    return move(result);
+}
+
+vector<ScriptProfiler::FrameStats> ScriptProfiler::getFrameStatsBySelfTime() const {
+    vector<FrameStats> result(_frameNames.size());
+    for (size_t i = 0; i < _frameNames.size(); ++i) {
+        result[i].name = _frameNames[i];
+    }
+    for (int i = 0; i < getRecordCount(); ++i) {
+        const Record &record = _records[i];
+        FrameStats &stats = result[_nodes[record.node].frameId];
+        stats.selfTime += chrono::duration<float>(record.time).count();
+        stats.instructionCount += record.instructionCount;
+    }
+    result.erase(remove_if(result.begin(), result.end(), [](auto &stats) { return stats.selfTime == 0.0f && stats.instructionCount == 0; }), result.end());
+    sort(result.begin(), result.end(), [](auto &left, auto &right) { return left.selfTime > right.selfTime; });
+
+    return move(result);
+}
+
+} // namespace script
+
+} // namespace reone
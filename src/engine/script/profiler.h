@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2020-2021 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+namespace reone {
+
+namespace script {
+
+constexpr int kDefaultProfilerCapacity = 65536;
+
+/**
+ * Opt-in profiler of script executions. Time spent in scripts, their
+ * subroutines and engine routines is attributed to call stacks, which are
+ * recorded into a ring buffer and can be exported as collapsed stacks,
+ * suitable for flame graph tools.
+ *
+ * Call stacks are kept as a tree of nodes, so that recording a frame
+ * transition does not allocate once the tree is built.
+ */
+class ScriptProfiler : boost::noncopyable {
+public:
+    struct FrameStats {
+        std::string name;
+        float selfTime { 0.0f }; /**< seconds */
+        int instructionCount { 0 };
+    };
+
+    ScriptProfiler(int capacity = kDefaultProfilerCapacity);
+
+    void clear();
+
+    /**
+     * Writes aggregated collapsed stacks, one per line, weighted by self time
+     * in microseconds, or by instruction count.
+     */
+    void exportCollapsedStacks(std::ostream &out, bool byInstructions = false) const;
+
+    /**
+     * @return frame statistics aggregated over the ring buffer, ordered by self time, descending
+     */
+    std::vector<FrameStats> getFrameStatsBySelfTime() const;
+
+    bool isEnabled() const { return _enabled; }
+
+    int getRecordCount() const;
+
+    void setEnabled(bool enabled);
+
+    // Frames
+
+    /**
+     * @return unique identifier of a frame with the specified name
+     */
+    uint32_t getFrameId(const std::string &name);
+
+    /**
+     * Enters a frame, called from the current one.
+     *
+     * @param instructionCount number of instructions executed in the current frame since the last transition
+     */
+    void enterFrame(uint32_t frameId, int instructionCount);
+
+    /**
+     * Returns to the calling frame.
+     *
+     * @param instructionCount number of instructions executed in the current frame since the last transition
+     */
+    void exitFrame(int instructionCount);
+
+    /**
+     * Returns to the specified call stack node, i.e. when a script execution
+     * is interrupted.
+     */
+    void exitToNode(uint32_t node, int instructionCount);
+
+    uint32_t currentNode() const { return _currentNode; }
+
+    // END Frames
+
+private:
+    struct Node {
+        uint32_t parent { 0 };
+        uint32_t frameId { 0 };
+    };
+
+    struct Record {
+        uint32_t node { 0 };
+        int instructionCount { 0 };
+        std::chrono::steady_clock::duration time { 0 };
+    };
+
+    int _capacity;
+    bool _enabled { false };
+
+    std::vector<std::string> _frameNames;
+    std::unordered_map<std::string, uint32_t> _frameIdByName;
+
+    std::vector<Node> _nodes; /**< node 0 is the root, which is outside of any script */
+    std::unordered_map<uint64_t, uint32_t> _nodeByKey;
+    uint32_t _currentNode { 0 };
+    std::chrono::steady_clock::time_point _segmentStart;
+
+    std::vector<Record> _records;
+    size_t _recordsWritten { 0 };
+
+    /**
+     * Records time and instructions since the last transition to the current node.
+     */
+    void flush(int instructionCount);
+
+    std::string getStackName(uint32_t node) const;
+};
+
+} // namespace script
+
+} // namespace reone
@@ -27,11 +27,57 @@ ScriptProgram::ScriptProgram(const string &name) : _name(name) {
 }
 
 void ScriptProgram::add(Instruction instr) {
-    _instructions.insert(make_pair(instr.offset, instr));
+    _indexByOffset.insert(make_pair(instr.offset, static_cast<int>(_instructions.size())));
+    _instructions.push_back(move(instr));
+    _linked = false;
+}
+
+void ScriptProgram::link() {
+    for (auto &instr : _instructions) {
+        switch (instr.byteCode) {
+            case ByteCode::Jump:
+            case ByteCode::JumpToSubroutine:
+            case ByteCode::JumpIfZero:
+            case ByteCode::JumpIfNonZero:
+            case ByteCode::CompareJumpIfZero:
+            case ByteCode::ConstantCompareJumpIfZero:
+                instr.jumpIndex = getInstructionIndex(static_cast<uint32_t>(instr.jumpOffset));
+                if (instr.jumpIndex == -1) {
+                    throw runtime_error(str(boost::format("Script: %s: invalid jump target %08x at %08x") % _name % instr.jumpOffset % instr.offset));
+                }
+                break;
+            default:
+                break;
+        }
+    }
+    _linked = true;
+}
+
+void ScriptProgram::internStrings() {
+    for (auto &instr : _instructions) {
+        if (instr.byteCode == ByteCode::PushConstant && instr.type == InstructionType::String) {
+            instr.strConstant = Variable::ofString(instr.strValue);
+        }
+    }
+}
+
+void ScriptProgram::setInstructions(vector<Instruction> instructions) {
+    _instructions.clear();
+    _indexByOffset.clear();
+    _linked = false;
+
+    for (auto &instr : instructions) {
+        add(move(instr));
+    }
+}
+
+int ScriptProgram::getInstructionIndex(uint32_t offset) const {
+    auto maybeIndex = _indexByOffset.find(offset);
+    return maybeIndex != _indexByOffset.end() ? maybeIndex->second : -1;
 }
 
 const Instruction &ScriptProgram::getInstruction(uint32_t offset) const {
-    return _instructions.find(offset)->second;
+    return _instructions[getInstructionIndex(offset)];
 }
 
 void ScriptProgram::setLength(uint32_t length) {
@@ -18,6 +18,7 @@
 #pragma once
 
 #include "types.h"
+#include "variable.h"
 
 namespace reone {
 
@@ -30,7 +31,10 @@ struct Instruction {
     ByteCode byteCode { ByteCode::Invalid };
     InstructionType type { InstructionType::None };
     uint32_t nextOffset { 0 };
+    int jumpIndex { -1 }; /**< index of the jump target instruction, resolved by ScriptProgram::link */
+    ByteCode operation { ByteCode::Invalid }; /**< comparison performed by a compare-and-jump superinstruction */
     std::string strValue;
+    Variable strConstant; /**< interned strValue, set by ScriptProgram::internStrings */
 
     union {
         int jumpOffset { 0 };
@@ -52,23 +56,63 @@ struct Instruction {
     };
 };
 
+/**
+ * Compiled script program. Instructions are stored in a dense array, ordered
+ * by offset, so that the interpreter can address them by index.
+ */
 class ScriptProgram : boost::noncopyable {
 public:
     ScriptProgram(const std::string &name);
 
+    /**
+     * Appends the instruction to this program. Instructions must be added in
+     * the order of their offsets.
+     */
     void add(Instruction instr);
 
+    /**
+     * Resolves jump targets of all instructions to instruction indices. Must
+     * be called after all instructions have been added.
+     *
+     * @throws std::runtime_error if a jump target is not an instruction offset
+     */
+    void link();
+
+    /**
+     * Replaces instructions of this program, i.e. with optimized ones. Jump
+     * targets must be offsets of the new instructions. Program must be
+     * linked again afterwards.
+     */
+    void setInstructions(std::vector<Instruction> instructions);
+
+    /**
+     * Interns string constants of this program, so that pushing them does
+     * not require a lookup. Must be called on the thread that runs scripts,
+     * as is destruction of the program afterwards.
+     */
+    void internStrings();
+
+    bool isLinked() const { return _linked; }
+
+    /**
+     * @return index of the instruction at the specified offset, or -1 if not found
+     */
+    int getInstructionIndex(uint32_t offset) const;
+
     const Instruction &getInstruction(uint32_t offset) const;
 
     const std::string &name() const { return _name; }
     uint32_t length() const { return _length; }
+    const std::vector<Instruction> &instructions() const { return _instructions; }
 
     void setLength(uint32_t length);
 
 private:
     std::string _name;
     uint32_t _length { 0 };
-    std::unordered_map<uint32_t, Instruction> _instructions;
+    std::vector<Instruction> _instructions;
+    std::unordered_map<uint32_t, int> _indexByOffset;
+    bool _linked { false };
 
     friend class NcsReader;
 };
@@ -19,6 +19,7 @@
 
 #include "../common/log.h"
 
+#include "argumentlist.h"
 #include "variable.h"
 
 using namespace std;
@@ -31,35 +32,62 @@ Routine::Routine(string name, VariableType retType, vector<VariableType> argType
     _name(move(name)),
     _returnType(retType),
     _argumentTypes(move(argTypes)) {
+
+    initScalarArguments();
 }
 
 Routine::Routine(
     string name,
     VariableType retType,
     vector<VariableType> argTypes,
-    const function<Variable(const vector<Variable> &, ExecutionContext &ctx)> &fn
+    const Function &fn
 ) :
     _name(move(name)),
     _returnType(retType),
     _argumentTypes(move(argTypes)),
     _func(fn) {
+
+    initScalarArguments();
+}
+
+void Routine::initScalarArguments() {
+    _scalarArguments = none_of(_argumentTypes.begin(), _argumentTypes.end(), [](VariableType type) {
+        return type == VariableType::Vector || type == VariableType::Action;
+    });
 }
 
-Variable Routine::invoke(const vector<Variable> &args, ExecutionContext &ctx) const {
+Variable Routine::invoke(const ArgumentList &args, ExecutionContext &ctx) const {
+    auto start = chrono::steady_clock::now();
+
     auto result = Variable::notImplemented();
     if (_func) {
         result = _func(args, ctx);
     }
     if (result.type == VariableType::NotImplemented) {
-        debug("Routine not implemented: " + _name, 2, DebugChannels::script);
+        if (getDebugLogLevel() >= 2) {
+            debug("Routine not implemented: " + _name, 2, DebugChannels::script);
+        }
         result.type = _returnType;
         if (_returnType == VariableType::Object) {
             result.objectId = kObjectInvalid;
         }
     }
+
+    ++_callCount;
+    _totalTime += chrono::steady_clock::now() - start;
+
     return move(result);
 }
 
+void Routine::resetStats() const {
+    _callCount = 0;
+    _totalTime = chrono::steady_clock::duration::zero();
+}
+
+float Routine::totalTime() const {
+    return chrono::duration<float>(_totalTime).count();
+}
+
 int Routine::getArgumentCount() const {
     return static_cast<int>(_argumentTypes.size());
 }
@@ -23,28 +23,56 @@ namespace reone {
 
 namespace script {
 
+class ArgumentList;
+
 struct ExecutionContext;
 struct Variable;
 
 class Routine {
 public:
+    typedef std::function<Variable(const ArgumentList &, ExecutionContext &ctx)> Function;
+
     Routine() = default;
     Routine(std::string name, VariableType retType, std::vector<VariableType> argTypes);
-    Routine(std::string name, VariableType retType, std::vector<VariableType> argTypes, const std::function<Variable(const std::vector<Variable> &, ExecutionContext &ctx)> &fn);
+    Routine(std::string name, VariableType retType, std::vector<VariableType> argTypes, const Function &fn);
+
+    Variable invoke(const ArgumentList &args, ExecutionContext &ctx) const;
 
-    Variable invoke(const std::vector<Variable> &args, ExecutionContext &ctx) const;
+    void resetStats() const;
 
     int getArgumentCount() const;
     VariableType getArgumentType(int index) const;
 
+    /**
+     * @return true if all arguments occupy a single stack slot, i.e. are neither vectors nor actions
+     */
+    bool hasScalarArguments() const { return _scalarArguments; }
+
     const std::string &name() const { return _name; }
     VariableType returnType() const { return _returnType; }
 
+    int callCount() const { return _callCount; }
+
+    /**
+     * @return cumulative execution time of this routine in seconds
+     */
+    float totalTime() const;
+
 private:
     std::string _name;
     VariableType _returnType { VariableType::Void };
     std::vector<VariableType> _argumentTypes;
-    std::function<Variable(const std::vector<Variable> &, ExecutionContext &ctx)> _func;
+    Function _func;
+    bool _scalarArguments { true };
+
+    // Statistics
+
+    mutable int _callCount { 0 };
+    mutable std::chrono::steady_clock::duration _totalTime { 0 };
+
+    // END Statistics
+
+    void initScalarArguments();
 };
 
 } // namespace script
@@ -17,9 +17,12 @@
 
 #include "scripts.h"
 
+#include "../common/log.h"
 #include "../common/streamutil.h"
 
 #include "ncsreader.h"
+#include "optimizer.h"
+#include "validator.h"
 
 using namespace std;
 using namespace std::placeholders;
@@ -35,6 +38,13 @@ Scripts::Scripts(Resources &resources) :
     _resources(resources) {
 }
 
+Scripts::~Scripts() {
+    // Pending jobs reference this instance
+    unique_lock<mutex> lock(_jobsMutex);
+    _queue.clear();
+    _jobsCondVar.wait(lock, [this]() { return _jobCount == 0; });
+}
+
 shared_ptr<ScriptProgram> Scripts::doGet(string resRef) {
     shared_ptr<ByteArray> data(_resources.getRaw(resRef, ResourceType::Ncs));
     if (!data) return nullptr;
@@ -42,7 +52,124 @@ shared_ptr<ScriptProgram> Scripts::doGet(string resRef) {
     NcsReader ncs(resRef);
     ncs.load(wrap(data));
 
-    return ncs.program();
+    shared_ptr<ScriptProgram> program(ncs.program());
+    ScriptOptimizer().optimize(*program);
+    program->internStrings();
+
+    return move(program);
+}
+
+void Scripts::precompile(const vector<string> &resRefs, ThreadPool &threadPool, IRoutineProvider *routines) {
+    int maxJobCount = glm::max(1, threadPool.threadCount() / 2);
+
+    for (auto &resRef : resRefs) {
+        if (_pending.count(resRef) > 0) continue;
+
+        auto precompilation = make_shared<Precompilation>();
+        precompilation->resRef = resRef;
+        precompilation->routines = routines;
+
+        PendingScript pending;
+        pending.precompilation = precompilation;
+        pending.done = precompilation->done.get_future();
+        _pending.insert(make_pair(resRef, move(pending)));
+
+        lock_guard<mutex> lock(_jobsMutex);
+        if (_jobCount < maxJobCount) {
+            ++_jobCount;
+            threadPool.enqueue(bind(&Scripts::runPrecompilation, this, ref(threadPool), precompilation));
+        } else {
+            _queue.push_back(move(precompilation));
+        }
+    }
+}
+
+void Scripts::runPrecompilation(ThreadPool &threadPool, shared_ptr<Precompilation> precompilation) {
+    // Skip scripts, that were requested before this job started
+    if (!precompilation->started.exchange(true)) {
+        shared_ptr<ByteArray> data(_resources.getRaw(precompilation->resRef, ResourceType::Ncs, false));
+        if (data) {
+            try {
+                precompilation->program = compile(precompilation->resRef, data, precompilation->routines);
+            } catch (const exception &ex) {
+                precompilation->error = ex.what();
+            }
+        }
+    }
+
+    // Queue the next script behind jobs queued in the meantime, rather than precompiling it right away
+    {
+        lock_guard<mutex> lock(_jobsMutex);
+        if (!_queue.empty()) {
+            shared_ptr<Precompilation> next(move(_queue.front()));
+            _queue.pop_front();
+            threadPool.enqueue(bind(&Scripts::runPrecompilation, this, ref(threadPool), move(next)));
+        } else {
+            --_jobCount;
+            _jobsCondVar.notify_all();
+        }
+    }
+
+    // This instance might be destroyed at this point
+    precompilation->done.set_value();
+}
+
+int Scripts::waitPrecompiled() {
+    int precompiledCount = 0;
+    for (auto &pending : _pending) {
+        pending.second.done.wait();
+        if (cachePrecompiled(pending.first, *pending.second.precompilation)) {
+            ++precompiledCount;
+        }
+    }
+    _pending.clear();
+
+    return precompiledCount;
+}
+
+shared_ptr<ScriptProgram> Scripts::get(const string &resRef) {
+    auto maybePending = _pending.find(resRef);
+    if (maybePending != _pending.end()) {
+        PendingScript pending(move(maybePending->second));
+        _pending.erase(maybePending);
+
+        // Wait for the worker thread, unless it has not started compiling this script yet
+        if (pending.precompilation->started.exchange(true)) {
+            pending.done.wait();
+            cachePrecompiled(resRef, *pending.precompilation);
+        }
+    }
+
+    return MemoryCache::get(resRef);
+}
+
+void Scripts::invalidate() {
+    waitPrecompiled();
+    MemoryCache::invalidate();
+}
+
+bool Scripts::cachePrecompiled(const string &resRef, Precompilation &precompilation) {
+    if (!precompilation.error.empty()) {
+        warn(boost::format("Script: %s: precompilation failed: %s") % resRef % precompilation.error);
+    }
+    if (!precompilation.program) return false;
+
+    // Strings are interned on the calling thread, as the heap is not thread-safe
+    precompilation.program->internStrings();
+    put(resRef, move(precompilation.program));
+
+    return true;
+}
+
+shared_ptr<ScriptProgram> Scripts::compile(const string &resRef, const shared_ptr<ByteArray> &data, IRoutineProvider *routines) {
+    NcsReader ncs(resRef);
+    ncs.load(wrap(data));
+
+    shared_ptr<ScriptProgram> program(ncs.program());
+    ScriptOptimizer().optimize(*program);
+    ScriptValidator(routines).validate(*program);
+
+    return move(program);
 }
 
 } // namespace script
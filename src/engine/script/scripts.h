@@ -18,6 +18,7 @@
 #pragma once
 
 #include "../common/cache.h"
+#include "../common/threadpool.h"
 #include "../resource/resources.h"
 
 #include "program.h"
@@ -26,14 +27,91 @@ namespace reone {
 
 namespace script {
 
+class IRoutineProvider;
+
 class Scripts : public MemoryCache<std::string, ScriptProgram> {
 public:
     Scripts(resource::Resources &resources);
+    ~Scripts();
+
+    /**
+     * Waits for pending precompilation, then clears the cache.
+     */
+    void invalidate();
+
+    /**
+     * Returns a cached script, or loads it. Waits for a script, that is being
+     * precompiled on a worker thread. A script, whose precompilation has not
+     * started yet, is loaded on the calling thread instead.
+     */
+    std::shared_ptr<ScriptProgram> get(const std::string &resRef);
+
+    /**
+     * Starts decoding, optimizing and validating the specified scripts on the
+     * thread pool, and returns immediately. Valid scripts are cached as soon
+     * as they are requested. Invalid scripts are reported and left to be
+     * loaded lazily.
+     *
+     * To leave worker threads to other jobs, at most half of them (but at
+     * least one) precompile scripts at any time: every job precompiles a
+     * single script, then queues a job for the next one.
+     */
+    void precompile(const std::vector<std::string> &resRefs, ThreadPool &threadPool, IRoutineProvider *routines = nullptr);
+
+    /**
+     * Waits for all pending precompilation and caches its results.
+     *
+     * @return number of cached scripts
+     */
+    int waitPrecompiled();
+
+    /**
+     * Decodes, optimizes and validates a script program.
+     *
+     * @throws std::runtime_error if the program is invalid
+     */
+    static std::shared_ptr<ScriptProgram> compile(const std::string &resRef, const std::shared_ptr<ByteArray> &data, IRoutineProvider *routines = nullptr);
 
 private:
+    struct Precompilation {
+        std::string resRef;
+        IRoutineProvider *routines { nullptr };
+        std::atomic_bool started { false }; /**< set by whichever thread claims the script first */
+        std::shared_ptr<ScriptProgram> program;
+        std::string error;
+        std::promise<void> done;
+    };
+
+    struct PendingScript {
+        std::shared_ptr<Precompilation> precompilation;
+        std::future<void> done;
+    };
+
     resource::Resources &_resources;
 
+    std::unordered_map<std::string, PendingScript> _pending; /**< scripts queued for precompilation, accessed on the calling thread only */
+
+    // Precompilation jobs
+
+    std::deque<std::shared_ptr<Precompilation>> _queue; /**< scripts waiting for a precompilation job */
+    int _jobCount { 0 };                                 /**< precompilation jobs queued on or running on a thread pool */
+    std::mutex _jobsMutex;
+    std::condition_variable _jobsCondVar;
+
+    // END Precompilation jobs
+
     std::shared_ptr<ScriptProgram> doGet(std::string resRef);
+
+    /**
+     * Precompiles a single script, then queues a job for the next script
+     * waiting in the queue, if any. Must be called on a worker thread.
+     */
+    void runPrecompilation(ThreadPool &threadPool, std::shared_ptr<Precompilation> precompilation);
+
+    /**
+     * @return true if a valid program was cached, false otherwise
+     */
+    bool cachePrecompiled(const std::string &resRef, Precompilation &precompilation);
 };
 
 } // namespace script
@@ -30,6 +30,7 @@ ScriptServices::ScriptServices(ResourceServices &resource) : _resource(resource)
 
 void ScriptServices::init() {
     _scripts = make_unique<Scripts>(_resource.resources());
+    _profiler = make_unique<ScriptProfiler>();
 }
 
 } // namespace script
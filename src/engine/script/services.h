@@ -19,6 +19,7 @@
 
 #include "../resource/services.h"
 
+#include "profiler.h"
 #include "scripts.h"
 
 namespace reone {
@@ -32,11 +33,13 @@ public:
     void init();
 
     Scripts &scripts() { return *_scripts; }
+    ScriptProfiler &profiler() { return *_profiler; }
 
 private:
     resource::ResourceServices &_resource;
 
     std::unique_ptr<Scripts> _scripts;
+    std::unique_ptr<ScriptProfiler> _profiler;
 };
 
 } // namespace script
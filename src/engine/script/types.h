@@ -69,6 +69,15 @@ enum class ByteCode {
     RestoreBP = 0x2b,
     StoreState = 0x2c,
     Noop = 0x2d,
+
+    // Superinstructions, produced by ScriptOptimizer
+
+    CopyDownSPAdjustSP = 0x80, /**< CPDOWNSP followed by MOVSP of the same size */
+    CompareJumpIfZero = 0x81, /**< integer comparison followed by JZ */
+    ConstantCompareJumpIfZero = 0x82, /**< CONSTI followed by an integer comparison and JZ */
+
+    // END Superinstructions
+
     Invalid = 0xff
 };
 
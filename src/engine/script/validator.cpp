@@ -0,0 +1,314 @@
+/*
+ * Copyright (c) 2020-2021 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "validator.h"
+
+#include "program.h"
+#include "routine.h"
+#include "routineprovider.h"
+
+using namespace std;
+
+namespace reone {
+
+namespace script {
+
+static constexpr int kSlotSize = 4;
+
+ScriptValidator::ScriptValidator(IRoutineProvider *routines) : _routines(routines) {
+}
+
+static runtime_error validationError(const ScriptProgram &program, const Instruction &ins, const string &message) {
+    return runtime_error(str(boost::format("Script: %s: %s at %08x") % program.name() % message % ins.offset));
+}
+
+static bool isTerminal(const Instruction &ins) {
+    return ins.byteCode == ByteCode::Jump || ins.byteCode == ByteCode::Return;
+}
+
+static bool isConditionalJump(const Instruction &ins) {
+    switch (ins.byteCode) {
+        case ByteCode::JumpIfZero:
+        case ByteCode::JumpIfNonZero:
+        case ByteCode::CompareJumpIfZero:
+        case ByteCode::ConstantCompareJumpIfZero:
+            return true;
+        default:
+            return false;
+    }
+}
+
+static int getSlotCount(VariableType type) {
+    switch (type) {
+        case VariableType::Void:
+        case VariableType::Action:
+            return 0;
+        case VariableType::Vector:
+            return 3;
+        default:
+            return 1;
+    }
+}
+
+void ScriptValidator::validate(const ScriptProgram &program) {
+    if (!program.isLinked()) {
+        throw logic_error("Script: program must be linked: " + program.name());
+    }
+    if (program.instructions().empty()) return;
+
+    _program = &program;
+    _subroutines.clear();
+
+    map<int, int> resumeDepths(checkControlFlow());
+
+    checkStackBalance(0, 0);
+    for (auto &resume : resumeDepths) {
+        checkStackBalance(resume.first, resume.second);
+    }
+
+    _program = nullptr;
+}
+
+map<int, int> ScriptValidator::checkControlFlow() {
+    const vector<Instruction> &instructions = _program->instructions();
+    int insCount = static_cast<int>(instructions.size());
+
+    map<int, int> resumeDepths;
+    vector<bool> visited(insCount, false);
+    vector<int> pending { 0 };
+
+    while (!pending.empty()) {
+        int idx = pending.back();
+        pending.pop_back();
+        if (visited[idx]) continue;
+
+        visited[idx] = true;
+        const Instruction &ins = instructions[idx];
+
+        if (ins.jumpIndex != -1) {
+            pending.push_back(ins.jumpIndex);
+        }
+        if (ins.byteCode == ByteCode::StoreState) {
+            int resumeIdx = _program->getInstructionIndex(ins.offset + static_cast<uint32_t>(ins.type));
+            if (resumeIdx == -1) {
+                throw validationError(*_program, ins, "invalid action offset");
+            }
+            resumeDepths.insert(make_pair(resumeIdx, (ins.size + ins.sizeLocals) / kSlotSize));
+            pending.push_back(resumeIdx);
+        }
+        if (isTerminal(ins)) continue;
+
+        if (idx + 1 >= insCount) {
+            throw validationError(*_program, ins, "control falls off the end of program");
+        }
+        pending.push_back(idx + 1);
+    }
+
+    return move(resumeDepths);
+}
+
+void ScriptValidator::checkStackBalance(int entryIdx, int entryDepth) {
+    const Subroutine &subroutine = analyzeSubroutine(entryIdx);
+    if (subroutine.known && entryDepth + subroutine.minDepth < 0) {
+        throw validationError(*_program, _program->instructions()[entryIdx], "stack underflow in code starting");
+    }
+}
+
+const ScriptValidator::Subroutine &ScriptValidator::analyzeSubroutine(int entryIdx) {
+    auto maybeSubroutine = _subroutines.find(entryIdx);
+    if (maybeSubroutine != _subroutines.end()) return maybeSubroutine->second;
+
+    // Until analysis completes, recursive calls find this subroutine unknown
+    _subroutines.insert(make_pair(entryIdx, Subroutine()));
+
+    const vector<Instruction> &instructions = _program->instructions();
+    unordered_map<int, int> depths;
+    vector<pair<int, int>> pending { make_pair(entryIdx, 0) };
+    bool known = true;
+    bool returns = false;
+    int delta = 0;
+    int minDepth = 0;
+
+    while (known && !pending.empty()) {
+        int idx = pending.back().first;
+        int depth = pending.back().second;
+        pending.pop_back();
+
+        auto maybeDepth = depths.find(idx);
+        if (maybeDepth != depths.end()) {
+            if (maybeDepth->second != depth) {
+                throw validationError(*_program, instructions[idx], str(boost::format("inconsistent stack depth %d and %d") % maybeDepth->second % depth));
+            }
+            continue;
+        }
+        depths.insert(make_pair(idx, depth));
+
+        const Instruction &ins = instructions[idx];
+
+        if (ins.byteCode == ByteCode::JumpToSubroutine) {
+            const Subroutine &callee = analyzeSubroutine(ins.jumpIndex);
+            if (!callee.known) {
+                known = false;
+                break;
+            }
+            minDepth = min(minDepth, depth + callee.minDepth);
+            depth += callee.delta;
+            minDepth = min(minDepth, depth);
+
+        } else if (!applyStackEffect(ins, depth, minDepth)) {
+            known = false;
+            break;
+        }
+
+        switch (ins.byteCode) {
+            case ByteCode::Return:
+                if (returns && depth != delta) {
+                    throw validationError(*_program, ins, str(boost::format("inconsistent stack depth on return %d and %d") % delta % depth));
+                }
+                returns = true;
+                delta = depth;
+                break;
+            case ByteCode::Jump:
+                pending.push_back(make_pair(ins.jumpIndex, depth));
+                break;
+            default:
+                if (isConditionalJump(ins)) {
+                    pending.push_back(make_pair(ins.jumpIndex, depth));
+                }
+                pending.push_back(make_pair(idx + 1, depth));
+                break;
+        }
+    }
+
+    Subroutine &subroutine = _subroutines[entryIdx];
+    subroutine.known = known && returns;
+    subroutine.delta = delta;
+    subroutine.minDepth = minDepth;
+
+    return subroutine;
+}
+
+bool ScriptValidator::applyStackEffect(const Instruction &ins, int &depth, int &minDepth) {
+    int slotCount = ins.size / kSlotSize;
+    int stackOffset = ins.stackOffset / kSlotSize;
+
+    switch (ins.byteCode) {
+        case ByteCode::CopyDownSP:
+        case ByteCode::DecRelToSP:
+        case ByteCode::IncRelToSP:
+            minDepth = min(minDepth, depth + stackOffset);
+            break;
+        case ByteCode::CopyDownSPAdjustSP:
+            minDepth = min(minDepth, depth + stackOffset);
+            depth -= slotCount;
+            break;
+        case ByteCode::CopyTopSP:
+            minDepth = min(minDepth, depth + stackOffset);
+            depth += slotCount;
+            break;
+        case ByteCode::Reserve:
+        case ByteCode::PushConstant:
+        case ByteCode::SaveBP:
+            ++depth;
+            break;
+        case ByteCode::CopyTopBP:
+            depth += slotCount;
+            break;
+        case ByteCode::CallRoutine: {
+            if (!_routines) return false;
+
+            const Routine &routine = _routines->get(ins.routine);
+            if (ins.argCount > routine.getArgumentCount()) {
+                throw validationError(*_program, ins, "too many routine arguments");
+            }
+            for (int i = 0; i < ins.argCount; ++i) {
+                depth -= getSlotCount(routine.getArgumentType(i));
+            }
+            minDepth = min(minDepth, depth);
+            depth += getSlotCount(routine.returnType());
+            break;
+        }
+        case ByteCode::Equal:
+        case ByteCode::NotEqual:
+            if (ins.type == InstructionType::StructStruct) {
+                depth -= 2 * slotCount - 1;
+            } else if (ins.type == InstructionType::VectorVector) {
+                depth -= 5;
+            } else {
+                depth -= 1;
+            }
+            break;
+        case ByteCode::Add:
+        case ByteCode::Subtract:
+            depth -= ins.type == InstructionType::VectorVector ? 3 : 1;
+            break;
+        case ByteCode::LogicalAnd:
+        case ByteCode::LogicalOr:
+        case ByteCode::InclusiveBitwiseOr:
+        case ByteCode::ExclusiveBitwiseOr:
+        case ByteCode::BitwiseAnd:
+        case ByteCode::GreaterThanOrEqual:
+        case ByteCode::GreaterThan:
+        case ByteCode::LessThan:
+        case ByteCode::LessThanOrEqual:
+        case ByteCode::ShiftLeft:
+        case ByteCode::ShiftRight:
+        case ByteCode::UnsignedShiftRight:
+        case ByteCode::Multiply:
+        case ByteCode::Divide:
+        case ByteCode::Mod:
+        case ByteCode::JumpIfZero:
+        case ByteCode::JumpIfNonZero:
+        case ByteCode::RestoreBP:
+        case ByteCode::ConstantCompareJumpIfZero:
+            depth -= 1;
+            break;
+        case ByteCode::CompareJumpIfZero:
+            depth -= 2;
+            break;
+        case ByteCode::AdjustSP:
+            depth += stackOffset;
+            break;
+        case ByteCode::Destruct:
+            depth -= slotCount;
+            minDepth = min(minDepth, depth);
+            depth += ins.sizeNoDestroy / kSlotSize;
+            break;
+        case ByteCode::Negate:
+        case ByteCode::OnesComplement:
+        case ByteCode::LogicalNot:
+            minDepth = min(minDepth, depth - 1);
+            break;
+        case ByteCode::Jump:
+        case ByteCode::Return:
+        case ByteCode::CopyDownBP:
+        case ByteCode::DecRelToBP:
+        case ByteCode::IncRelToBP:
+        case ByteCode::StoreState:
+        case ByteCode::Noop:
+            break;
+        default:
+            throw validationError(*_program, ins, "unsupported instruction " + to_string(static_cast<int>(ins.byteCode)));
+    }
+    minDepth = min(minDepth, depth);
+
+    return true;
+}
+
+} // namespace script
+
+} // namespace reone
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2020-2021 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+namespace reone {
+
+namespace script {
+
+class IRoutineProvider;
+class ScriptProgram;
+struct Instruction;
+
+/**
+ * Load-time verifier of linked script programs. Checks that control never
+ * falls off the end of a program, and that every subroutine leaves the
+ * stack balanced: stack depth must be the same on all paths merging into
+ * an instruction and on all returns from a subroutine, and no instruction
+ * may address the stack below its bottom.
+ *
+ * Stack effect of routine calls is only known given routine signatures.
+ * Without a routine provider, or when a subroutine is recursive, stack
+ * balance of the affected subroutines is not checked.
+ */
+class ScriptValidator : boost::noncopyable {
+public:
+    ScriptValidator(IRoutineProvider *routines = nullptr);
+
+    /**
+     * @throws std::runtime_error if the program is invalid
+     */
+    void validate(const ScriptProgram &program);
+
+private:
+    struct Subroutine {
+        bool known { false }; /**< false if stack effect of this subroutine could not be determined */
+        int delta { 0 }; /**< stack depth change on return, in slots */
+        int minDepth { 0 }; /**< lowest stack slot addressed, relative to the entry depth */
+    };
+
+    IRoutineProvider *_routines;
+
+    const ScriptProgram *_program { nullptr };
+    std::unordered_map<int, Subroutine> _subroutines; /**< subroutines by index of the entry instruction */
+
+    /**
+     * @return indices of instructions that actions, created by STORE_STATE, resume execution at, mapped to the initial stack depth
+     */
+    std::map<int, int> checkControlFlow();
+
+    void checkStackBalance(int entryIdx, int entryDepth);
+
+    const Subroutine &analyzeSubroutine(int entryIdx);
+
+    /**
+     * Applies stack effect of the instruction to the depth.
+     *
+     * @return false if stack effect of the instruction is unknown
+     */
+    bool applyStackEffect(const Instruction &ins, int &depth, int &minDepth);
+};
+
+} // namespace script
+
+} // namespace reone
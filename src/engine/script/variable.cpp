@@ -25,6 +25,214 @@ namespace reone {
 
 namespace script {
 
+static_assert(sizeof(Variable) == 16, "Variable must be 16 bytes in size");
+
+// Heap
+
+namespace {
+
+/**
+ * Reference-counted storage of strings, engine types and actions, indexed by
+ * handle. Handle 0 is reserved for empty values. Slots are stored in a deque,
+ * so that references to them survive allocation of new slots.
+ */
+class VariableHeap : boost::noncopyable {
+public:
+    VariableHeap() {
+        _slots.emplace_back();
+    }
+
+    uint32_t addString(const string &value) {
+        if (value.empty()) return 0;
+
+        auto maybeHandle = _handleByString.find(value);
+        if (maybeHandle != _handleByString.end()) {
+            ++_slots[maybeHandle->second].refCount;
+            return maybeHandle->second;
+        }
+        uint32_t handle = allocate();
+        auto inserted = _handleByString.insert(make_pair(value, handle));
+        _slots[handle].strValue = &inserted.first->first;
+
+        return handle;
+    }
+
+    uint32_t addEngineType(shared_ptr<EngineType> engineType) {
+        if (!engineType) return 0;
+
+        uint32_t handle = allocate();
+        _slots[handle].engineType = move(engineType);
+
+        return handle;
+    }
+
+    uint32_t addContext(shared_ptr<ExecutionContext> context) {
+        if (!context) return 0;
+
+        uint32_t handle = allocate();
+        _slots[handle].context = move(context);
+
+        return handle;
+    }
+
+    void retain(uint32_t handle) {
+        ++_slots[handle].refCount;
+    }
+
+    void release(uint32_t handle) {
+        Slot &slot = _slots[handle];
+        if (--slot.refCount > 0) return;
+
+        if (slot.strValue) {
+            _handleByString.erase(*slot.strValue);
+            slot.strValue = nullptr;
+            slot.indexOwner = 0;
+            slot.index = -1;
+        }
+        _freeHandles.push_back(handle);
+
+        // Releasing an engine type or an action might release other variables
+        shared_ptr<EngineType> engineType(move(slot.engineType));
+        shared_ptr<ExecutionContext> context(move(slot.context));
+    }
+
+    const string &getString(uint32_t handle) const {
+        static string empty;
+        const string *value = _slots[handle].strValue;
+        return value ? *value : empty;
+    }
+
+    int getIndex(uint32_t handle, uint32_t owner) const {
+        const Slot &slot = _slots[handle];
+        return slot.indexOwner == owner ? slot.index : -1;
+    }
+
+    void setIndex(uint32_t handle, uint32_t owner, int index) {
+        Slot &slot = _slots[handle];
+        slot.indexOwner = owner;
+        slot.index = index;
+    }
+
+    const shared_ptr<EngineType> &getEngineType(uint32_t handle) const {
+        return _slots[handle].engineType;
+    }
+
+    const shared_ptr<ExecutionContext> &getContext(uint32_t handle) const {
+        return _slots[handle].context;
+    }
+
+private:
+    struct Slot {
+        const string *strValue { nullptr };
+        shared_ptr<EngineType> engineType;
+        shared_ptr<ExecutionContext> context;
+        int refCount { 0 };
+        uint32_t indexOwner { 0 }; /**< owner of the cached index of a string, 0 if none */
+        int index { -1 };
+    };
+
+    deque<Slot> _slots;
+    vector<uint32_t> _freeHandles;
+    unordered_map<string, uint32_t> _handleByString;
+
+    uint32_t allocate() {
+        uint32_t handle;
+        if (_freeHandles.empty()) {
+            handle = static_cast<uint32_t>(_slots.size());
+            _slots.emplace_back();
+        } else {
+            handle = _freeHandles.back();
+            _freeHandles.pop_back();
+        }
+        _slots[handle].refCount = 1;
+
+        return handle;
+    }
+};
+
+} // namespace
+
+static VariableHeap &heap() {
+    // Never destroyed, so that variables in static storage can outlive it
+    static VariableHeap *heap = new VariableHeap();
+    return *heap;
+}
+
+Variable::Variable(const Variable &other) {
+    copyFrom(other);
+    if (hasHandle()) {
+        retainHandle();
+    }
+}
+
+Variable::Variable(Variable &&other) noexcept {
+    copyFrom(other);
+    other.type = VariableType::Void;
+    other.intValue = 0;
+}
+
+Variable &Variable::operator=(const Variable &other) {
+    if (other.hasHandle()) {
+        other.retainHandle();
+    }
+    if (hasHandle()) {
+        releaseHandle();
+    }
+    copyFrom(other);
+
+    return *this;
+}
+
+Variable &Variable::operator=(Variable &&other) noexcept {
+    if (this == &other) return *this;
+
+    if (hasHandle()) {
+        releaseHandle();
+    }
+    copyFrom(other);
+    other.type = VariableType::Void;
+    other.intValue = 0;
+
+    return *this;
+}
+
+void Variable::copyFrom(const Variable &other) {
+    type = other.type;
+    memcpy(&vecValue, &other.vecValue, sizeof(glm::vec3));
+}
+
+void Variable::retainHandle() const {
+    heap().retain(handle);
+}
+
+void Variable::releaseHandle() {
+    heap().release(handle);
+}
+
+int Variable::getCachedIndex(uint32_t owner) const {
+    return type == VariableType::String && handle != 0 ? heap().getIndex(handle, owner) : -1;
+}
+
+void Variable::setCachedIndex(uint32_t owner, int index) const {
+    if (type == VariableType::String && handle != 0) {
+        heap().setIndex(handle, owner, index);
+    }
+}
+
+const string &Variable::strValue() const {
+    return type == VariableType::String ? heap().getString(handle) : heap().getString(0);
+}
+
+shared_ptr<EngineType> Variable::engineType() const {
+    return hasHandle() ? heap().getEngineType(handle) : nullptr;
+}
+
+shared_ptr<ExecutionContext> Variable::context() const {
+    return type == VariableType::Action ? heap().getContext(handle) : nullptr;
+}
+
+// END Heap
+
 Variable Variable::operator+(const Variable &other) const {
     if (type == VariableType::Int && other.type == VariableType::Int) {
         return Variable::ofInt(intValue + other.intValue);
@@ -39,7 +247,7 @@ Variable Variable::operator+(const Variable &other) const {
         return Variable::ofFloat(floatValue + other.floatValue);
     }
     if (type == VariableType::String && other.type == VariableType::String) {
-        return Variable::ofString(strValue + other.strValue);
+        return Variable::ofString(strValue() + other.strValue());
     }
 
     throw logic_error(str(boost::format("Unsupported variable types: %02x %02x") % static_cast<int>(type) % static_cast<int>(other.type)));
@@ -110,10 +318,10 @@ Variable Variable::ofFloat(float value) {
     return move(result);
 }
 
-Variable Variable::ofString(string value) {
+Variable Variable::ofString(const string &value) {
     Variable result;
     result.type = VariableType::String;
-    result.strValue = move(value);
+    result.handle = heap().addString(value);
     return move(result);
 }
 
@@ -134,35 +342,35 @@ Variable Variable::ofObject(uint32_t objectId) {
 Variable Variable::ofEffect(shared_ptr<EngineType> engineType) {
     Variable result;
     result.type = VariableType::Effect;
-    result.engineType = move(engineType);
+    result.handle = heap().addEngineType(move(engineType));
     return move(result);
 }
 
 Variable Variable::ofEvent(shared_ptr<EngineType> engineType) {
     Variable result;
     result.type = VariableType::Event;
-    result.engineType = move(engineType);
+    result.handle = heap().addEngineType(move(engineType));
     return move(result);
 }
 
 Variable Variable::ofLocation(shared_ptr<EngineType> engineType) {
     Variable result;
     result.type = VariableType::Location;
-    result.engineType = move(engineType);
+    result.handle = heap().addEngineType(move(engineType));
     return move(result);
 }
 
 Variable Variable::ofTalent(shared_ptr<EngineType> engineType) {
     Variable result;
     result.type = VariableType::Talent;
-    result.engineType = move(engineType);
+    result.handle = heap().addEngineType(move(engineType));
     return move(result);
 }
 
 Variable Variable::ofAction(shared_ptr<ExecutionContext> context) {
     Variable result;
     result.type = VariableType::Action;
-    result.context = move(context);
+    result.handle = heap().addContext(move(context));
     return move(result);
 }
 
@@ -181,14 +389,15 @@ bool Variable::operator==(const Variable &other) const {
         case VariableType::Float:
             return floatValue == other.floatValue;
         case VariableType::String:
-            return strValue == other.strValue;
+            // Strings are interned
+            return handle == other.handle;
         case VariableType::Object:
             return objectId == other.objectId;
         case VariableType::Effect:
         case VariableType::Event:
         case VariableType::Location:
         case VariableType::Talent:
-            return engineType == other.engineType;
+            return engineType() == other.engineType();
         default:
             throw logic_error("Unsupported variable type: " + to_string(static_cast<int>(type)));
     }
@@ -255,7 +464,7 @@ const string Variable::toString() const {
         case VariableType::Float:
             return to_string(floatValue);
         case VariableType::String:
-            return str(boost::format("\"%s\"") % strValue);
+            return str(boost::format("\"%s\"") % strValue());
         case VariableType::Object:
             return to_string(objectId);
         case VariableType::Vector:
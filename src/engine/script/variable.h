@@ -28,24 +28,42 @@ struct ExecutionContext;
 class EngineType;
 class ScriptObject;
 
+/**
+ * Tagged value of a script variable, 16 bytes in size. Integers, floats,
+ * object ids and vectors are stored inline. Strings, engine types and
+ * actions are stored in a shared reference-counted heap and referenced by
+ * handle. Strings are interned, so equal strings share a handle.
+ *
+ * The heap is not synchronized: variables holding heap values must only be
+ * used by the thread that runs scripts.
+ */
 struct Variable {
     VariableType type { VariableType::Void };
-    std::string strValue;
-    glm::vec3 vecValue { 0.0f };
-    std::shared_ptr<EngineType> engineType;
-    std::shared_ptr<ExecutionContext> context;
 
     union {
         int32_t intValue { 0 };
         uint32_t objectId;
         float floatValue;
+        uint32_t handle; /**< heap handle of a string, engine type or action, 0 if empty */
+        glm::vec3 vecValue;
     };
 
     Variable() = default;
+    Variable(const Variable &other);
+    Variable(Variable &&other) noexcept;
+
+    ~Variable() {
+        if (hasHandle()) {
+            releaseHandle();
+        }
+    }
+
+    Variable &operator=(const Variable &other);
+    Variable &operator=(Variable &&other) noexcept;
 
     static Variable ofInt(int value);
     static Variable ofFloat(float value);
-    static Variable ofString(std::string value);
+    static Variable ofString(const std::string &value);
     static Variable ofVector(glm::vec3 value);
     static Variable ofObject(uint32_t objectId);
     static Variable ofEffect(std::shared_ptr<EngineType> engineType);
@@ -68,6 +86,37 @@ struct Variable {
     bool operator>=(const Variable &other) const;
 
     const std::string toString() const;
+
+    /**
+     * @return true if this variable references a heap value
+     */
+    bool hasHandle() const {
+        return handle != 0 && (type == VariableType::String || (type >= VariableType::Effect && type <= VariableType::Action));
+    }
+
+    /**
+     * @return index of this string, cached by the specified owner, or -1 if not cached
+     */
+    int getCachedIndex(uint32_t owner) const;
+
+    /**
+     * Caches an index, that the specified owner has resolved this string to,
+     * on the interned string. The index is shared by all variables holding
+     * this string, e.g. a string constant of a script program and its copies
+     * on the stack, and is dropped when the string is released.
+     *
+     * @param owner non-zero id of the owner, e.g. GlobalVariables
+     */
+    void setCachedIndex(uint32_t owner, int index) const;
+
+    const std::string &strValue() const;
+    std::shared_ptr<EngineType> engineType() const;
+    std::shared_ptr<ExecutionContext> context() const;
+
+private:
+    void copyFrom(const Variable &other);
+    void retainHandle() const;
+    void releaseHandle();
 };
 
 } // namespace script
@@ -17,6 +17,8 @@
 
 #include "bikreader.h"
 
+#include <condition_variable>
+
 #include "../audio/stream.h"
 #include "../common/log.h"
 #include "../common/guardutil.h"
@@ -47,6 +49,66 @@ namespace video {
 
 static const char kSignature[] = "BIKi";
 
+static constexpr int kFrameQueueSize = 8;
+static constexpr int kMaxQueuedVideoPackets = 64;
+
+/**
+ * PCM frames of the movie audio track, passed from the decoding thread to
+ * the audio thread.
+ */
+struct BinkAudioQueue {
+    std::mutex mutex;
+    std::deque<AudioStream::Frame> frames;
+    float time { 0.0f }; /**< playback time of the first queued frame in seconds */
+    bool ended { false };
+};
+
+class BinkAudioDecoder : public IAudioDecoder {
+public:
+    BinkAudioDecoder(shared_ptr<BinkAudioQueue> queue) : _queue(move(queue)) {
+    }
+
+    bool decode(AudioStream::Frame &frame) override {
+        lock_guard<mutex> lock(_queue->mutex);
+        if (_queue->frames.empty()) {
+            if (_queue->ended) return false;
+
+            // Decoding thread fell behind - leave the frame empty, never block the audio thread
+            frame.samples.clear();
+            return true;
+        }
+        frame = move(_queue->frames.front());
+        _queue->frames.pop_front();
+        _queue->time += frame.duration();
+
+        return true;
+    }
+
+    void rewind() override {
+        // Movie audio is a live stream, see AudioStream::isLive
+    }
+
+    void seek(float time) override {
+        // Resynchronize with the video by dropping samples, that should have been played by now
+        lock_guard<mutex> lock(_queue->mutex);
+        while (!_queue->frames.empty()) {
+            float frameDuration = _queue->frames.front().duration();
+            if (_queue->time + frameDuration > time) break;
+            _queue->time += frameDuration;
+            _queue->frames.pop_front();
+        }
+    }
+
+private:
+    shared_ptr<BinkAudioQueue> _queue;
+};
+
+/**
+ * Decodes a Bink video on a separate thread. Demuxed video packets are
+ * queued, and decoded into a bounded ring of reusable frames ahead of
+ * presentation. Audio packets are decoded as soon as they are demuxed and
+ * streamed to the audio player.
+ */
 class BinkVideoDecoder : public MediaStream<Video::Frame> {
 public:
     BinkVideoDecoder(fs::path path, GraphicsServices &graphics) :
@@ -59,17 +121,28 @@ public:
     }
 
     void deinit() {
-        if (_videoBuffer) {
-            av_free(_videoBuffer);
-            _videoBuffer = nullptr;
+        {
+            lock_guard<mutex> lock(_framesMutex);
+            _quit = true;
+        }
+        _framesCondVar.notify_all();
+        if (_thread.joinable()) {
+            _thread.join();
+        }
+        if (_audioQueue) {
+            lock_guard<mutex> lock(_audioQueue->mutex);
+            _audioQueue->ended = true;
         }
-        if (_frameRgb) {
-            av_free(_frameRgb);
-            _frameRgb = nullptr;
+        for (auto packet : _videoPackets) {
+            av_packet_free(&packet);
+        }
+        _videoPackets.clear();
+
+        if (_audioFrame) {
+            av_frame_free(&_audioFrame);
         }
         if (_frame) {
-            av_free(_frame);
-            _frame = nullptr;
+            av_frame_free(&_frame);
         }
         if (_swrContext) {
             swr_free(&_swrContext);
@@ -79,26 +152,16 @@ public:
             _swsContext = nullptr;
         }
         if (_audioCodecCtx) {
-            avcodec_close(_audioCodecCtx);
-            _audioCodecCtx = nullptr;
+            avcodec_free_context(&_audioCodecCtx);
         }
         if (_videoCodecCtx) {
-            avcodec_close(_videoCodecCtx);
-            _videoCodecCtx = nullptr;
+            avcodec_free_context(&_videoCodecCtx);
         }
         if (_formatCtx) {
             avformat_close_input(&_formatCtx);
         }
     }
 
-    void ignoreFrames(int count) override {
-        readVideoFrames(count, true);
-    }
-
-    void fetchFrames(int count) override {
-        readVideoFrames(count);
-    }
-
     void load() {
         openInput(_path);
         findStreams();
@@ -110,11 +173,42 @@ public:
         initConverters();
         initFrames();
         initVideo();
-        readAudioFrames();
+
+        _thread = thread(bind(&BinkVideoDecoder::threadStart, this));
     }
 
-    shared_ptr<Video> video() const {
-        return _video;
+    shared_ptr<Video::Frame> get(int frame) override {
+        _presentedFrame = frame;
+
+        lock_guard<mutex> lock(_framesMutex);
+
+        // Skip to the latest ready frame that is due, recycling the rest
+        bool recycled = false;
+        while (!_readyFrames.empty() && _readyFrames.front().first <= frame) {
+            if (_currentFrame) {
+                _freeFrames.push_back(move(_currentFrame));
+                recycled = true;
+            }
+            _currentFrame = move(_readyFrames.front().second);
+            _readyFrames.pop_front();
+        }
+        if (recycled) {
+            _framesCondVar.notify_one();
+        }
+
+        return _currentFrame;
+    }
+
+    bool isEnded() const override {
+        lock_guard<mutex> lock(_framesMutex);
+        return _decodeEnded && _readyFrames.empty();
+    }
+
+    /**
+     * Transfers ownership of the video to the caller. Video owns this decoder.
+     */
+    shared_ptr<Video> releaseVideo() {
+        return move(_video);
     }
 
 private:
@@ -129,9 +223,31 @@ private:
     SwsContext *_swsContext { nullptr };
     SwrContext *_swrContext { nullptr };
     AVFrame *_frame { nullptr };
-    AVFrame *_frameRgb { nullptr };
-    uint8_t *_videoBuffer { nullptr };
+    AVFrame *_audioFrame { nullptr };
     shared_ptr<Video> _video;
+    shared_ptr<BinkAudioQueue> _audioQueue;
+
+    // Decoding thread
+
+    thread _thread;
+    deque<AVPacket *> _videoPackets;
+    bool _demuxEnded { false };
+    int _nextFrame { 0 };
+
+    // END Decoding thread
+
+    // Frame queue
+
+    mutable mutex _framesMutex;
+    condition_variable _framesCondVar;
+    deque<shared_ptr<Video::Frame>> _freeFrames;
+    deque<pair<int, shared_ptr<Video::Frame>>> _readyFrames;
+    shared_ptr<Video::Frame> _currentFrame;
+    bool _decodeEnded { false };
+    bool _quit { false };
+    atomic_int _presentedFrame { 0 };
+
+    // END Frame queue
 
     void openInput(const fs::path &path) {
         if (avformat_open_input(&_formatCtx, path.string().c_str(), nullptr, nullptr) != 0) {
@@ -196,13 +312,16 @@ private:
     }
 
     void initConverters() {
-        _swsContext = sws_getContext(
-            _videoCodecCtx->width, _videoCodecCtx->height,
-            _videoCodecCtx->pix_fmt,
-            _videoCodecCtx->width, _videoCodecCtx->height,
-            AV_PIX_FMT_RGB24,
-            SWS_BILINEAR,
-            nullptr, nullptr, nullptr);
+        // Bink frames are normally planar YUV 4:2:0 already and are copied as is
+        if (!isYUV420(_videoCodecCtx->pix_fmt)) {
+            _swsContext = sws_getContext(
+                _videoCodecCtx->width, _videoCodecCtx->height,
+                _videoCodecCtx->pix_fmt,
+                _videoCodecCtx->width, _videoCodecCtx->height,
+                AV_PIX_FMT_YUV420P,
+                SWS_BILINEAR,
+                nullptr, nullptr, nullptr);
+        }
 
         if (hasAudio()) {
             _swrContext = swr_alloc_set_opts(
@@ -215,13 +334,32 @@ private:
         }
     }
 
+    static bool isYUV420(AVPixelFormat format) {
+        // Alpha plane of YUVA is ignored
+        return format == AV_PIX_FMT_YUV420P || format == AV_PIX_FMT_YUVJ420P || format == AV_PIX_FMT_YUVA420P;
+    }
+
     void initFrames() {
         _frame = av_frame_alloc();
-        _frameRgb = av_frame_alloc();
+        _audioFrame = av_frame_alloc();
+
+        size_t lumaSize = static_cast<size_t>(_videoCodecCtx->width) * _videoCodecCtx->height;
+        size_t chromaSize = static_cast<size_t>(getChromaWidth()) * getChromaHeight();
+        for (int i = 0; i < kFrameQueueSize; ++i) {
+            auto frame = make_shared<Video::Frame>();
+            frame->yPlane = make_shared<ByteArray>(lumaSize);
+            frame->uPlane = make_shared<ByteArray>(chromaSize);
+            frame->vPlane = make_shared<ByteArray>(chromaSize);
+            _freeFrames.push_back(move(frame));
+        }
+    }
+
+    int getChromaWidth() const {
+        return (_videoCodecCtx->width + 1) / 2;
+    }
 
-        int bufSize = av_image_get_buffer_size(AV_PIX_FMT_RGB24, _videoCodecCtx->width, _videoCodecCtx->height, 32);
-        _videoBuffer = static_cast<uint8_t *>(av_malloc(bufSize));
-        av_image_fill_arrays(_frameRgb->data, _frameRgb->linesize, _videoBuffer, AV_PIX_FMT_RGB24, _videoCodecCtx->width, _videoCodecCtx->height, 32);
+    int getChromaHeight() const {
+        return (_videoCodecCtx->height + 1) / 2;
     }
 
     void initVideo() {
@@ -233,88 +371,173 @@ private:
         _video->_fps = frameRate.num / static_cast<float>(frameRate.den);
 
         if (hasAudio()) {
-            _video->_audio = make_shared<AudioStream>();
+            _audioQueue = make_shared<BinkAudioQueue>();
+
+            float duration = 0.0f;
+            AVStream *stream = _formatCtx->streams[_audioStreamIdx];
+            if (stream->duration != AV_NOPTS_VALUE) {
+                duration = static_cast<float>(stream->duration * av_q2d(stream->time_base));
+            } else if (_formatCtx->duration != AV_NOPTS_VALUE) {
+                duration = _formatCtx->duration / static_cast<float>(AV_TIME_BASE);
+            }
+            shared_ptr<BinkAudioQueue> queue(_audioQueue);
+            _video->_audio = make_shared<AudioStream>(
+                [queue]() { return make_unique<BinkAudioDecoder>(queue); },
+                duration,
+                true);
         }
     }
 
-    void readVideoFrames(int count, bool ignore = false) {
-        if (count == 0 || _ended) return;
-
-        AVPacket packet;
-
-        while (count > 0) {
-            if (av_read_frame(_formatCtx, &packet) < 0) {
-                _ended = true;
+    void threadStart() {
+        while (true) {
+            {
+                unique_lock<mutex> lock(_framesMutex);
+                _framesCondVar.wait(lock, [this]() { return _quit || canDecodeVideo() || canDemux(); });
+                if (_quit) break;
+                if (!canDecodeVideo()) {
+                    lock.unlock();
+                    demux();
+                    continue;
+                }
+            }
+            if (_videoPackets.empty()) {
+                // All packets have been demuxed and decoded - drain the decoder
+                decodeVideoPacket(nullptr);
+                endDecoding();
                 break;
             }
-            if (packet.stream_index != _videoStreamIdx) continue;
+            AVPacket *packet = _videoPackets.front();
+            _videoPackets.pop_front();
+            decodeVideoPacket(packet);
+            av_packet_free(&packet);
+        }
+    }
+
+    /**
+     * Must be called with the frames mutex locked.
+     */
+    bool canDecodeVideo() const {
+        return !_freeFrames.empty() && (!_videoPackets.empty() || _demuxEnded);
+    }
+
+    bool canDemux() const {
+        return !_demuxEnded && static_cast<int>(_videoPackets.size()) < kMaxQueuedVideoPackets;
+    }
 
-            int retVal = avcodec_receive_frame(_videoCodecCtx, _frame);
-            if (retVal == 0 || retVal == AVERROR(EAGAIN)) {
-                avcodec_send_packet(_videoCodecCtx, &packet);
-                if (retVal == AVERROR(EAGAIN)) continue;
+    void demux() {
+        AVPacket *packet = av_packet_alloc();
+        if (av_read_frame(_formatCtx, packet) < 0) {
+            av_packet_free(&packet);
+            _demuxEnded = true;
+            if (hasAudio()) {
+                decodeAudioPacket(nullptr);
             }
+            return;
+        }
+        if (packet->stream_index == _videoStreamIdx) {
+            _videoPackets.push_back(packet);
+            return;
+        }
+        if (packet->stream_index == _audioStreamIdx) {
+            decodeAudioPacket(packet);
+        }
+        av_packet_free(&packet);
+    }
 
-            --count;
+    void decodeVideoPacket(AVPacket *packet) {
+        if (avcodec_send_packet(_videoCodecCtx, packet) < 0) return;
 
-            if (ignore) continue;
+        while (avcodec_receive_frame(_videoCodecCtx, _frame) == 0) {
+            int frameIdx = _nextFrame++;
 
-            sws_scale(
-                _swsContext,
-                _frame->data, _frame->linesize, 0, _videoCodecCtx->height,
-                _frameRgb->data, _frameRgb->linesize);
-
-            auto pixels = make_shared<ByteArray>(3ll * _videoCodecCtx->width * _videoCodecCtx->height);
-            for (int y = 0; y < _videoCodecCtx->height; ++y) {
-                int dstIdx = 3 * _videoCodecCtx->width * y;
-                uint8_t *src = _frameRgb->data[0] + static_cast<long long>(y) * _frameRgb->linesize[0];
-                memcpy(pixels->data() + dstIdx, src, 3ll * _videoCodecCtx->width);
-            }
+            // Late frames are decoded, as subsequent frames depend on them, but never copied
+            if (frameIdx < _presentedFrame) continue;
 
-            auto frame = make_shared<Video::Frame>();
-            frame->pixels = move(pixels);
-            _frames.push_back(move(frame));
+            shared_ptr<Video::Frame> frame(acquireFreeFrame());
+            if (!frame) return;
+
+            copyPlanes(*frame);
+
+            {
+                lock_guard<mutex> lock(_framesMutex);
+                _readyFrames.push_back(make_pair(frameIdx, move(frame)));
+            }
         }
+    }
+
+    void copyPlanes(Video::Frame &frame) {
+        int width = _videoCodecCtx->width;
+        int height = _videoCodecCtx->height;
+        uint8_t *dstData[] = {
+            reinterpret_cast<uint8_t *>(frame.yPlane->data()),
+            reinterpret_cast<uint8_t *>(frame.uPlane->data()),
+            reinterpret_cast<uint8_t *>(frame.vPlane->data())
+        };
+        int dstLinesize[] = { width, getChromaWidth(), getChromaWidth() };
 
-        av_packet_unref(&packet);
+        if (_swsContext) {
+            sws_scale(
+                _swsContext,
+                _frame->data, _frame->linesize, 0, height,
+                dstData, dstLinesize);
+            return;
+        }
+        av_image_copy_plane(dstData[0], dstLinesize[0], _frame->data[0], _frame->linesize[0], width, height);
+        av_image_copy_plane(dstData[1], dstLinesize[1], _frame->data[1], _frame->linesize[1], getChromaWidth(), getChromaHeight());
+        av_image_copy_plane(dstData[2], dstLinesize[2], _frame->data[2], _frame->linesize[2], getChromaWidth(), getChromaHeight());
     }
 
-    void readAudioFrames() {
-        if (!hasAudio()) return;
+    /**
+     * Blocks until a frame is free.
+     *
+     * @return free frame, or nullptr if decoding was interrupted
+     */
+    shared_ptr<Video::Frame> acquireFreeFrame() {
+        unique_lock<mutex> lock(_framesMutex);
+        _framesCondVar.wait(lock, [this]() { return _quit || !_freeFrames.empty(); });
+        if (_quit) return nullptr;
 
-        AVPacket packet;
+        shared_ptr<Video::Frame> frame(move(_freeFrames.front()));
+        _freeFrames.pop_front();
 
-        while (av_read_frame(_formatCtx, &packet) >= 0) {
-            if (packet.stream_index != _audioStreamIdx) continue;
+        return move(frame);
+    }
 
-            avcodec_send_packet(_audioCodecCtx, &packet);
-            avcodec_receive_frame(_audioCodecCtx, _frame);
+    void decodeAudioPacket(AVPacket *packet) {
+        if (avcodec_send_packet(_audioCodecCtx, packet) < 0) return;
 
-            int sampleCount = swr_get_out_samples(_swrContext, _frame->nb_samples);
+        while (avcodec_receive_frame(_audioCodecCtx, _audioFrame) == 0) {
+            int sampleCount = swr_get_out_samples(_swrContext, _audioFrame->nb_samples);
             int bufSize = av_samples_get_buffer_size(nullptr, 1, sampleCount, AV_SAMPLE_FMT_S16, 1);
-            ByteArray samples(bufSize);
-            uint8_t *samplesPtr = reinterpret_cast<uint8_t *>(&samples[0]);
-
-            swr_convert(
-                _swrContext,
-                &samplesPtr, sampleCount,
-                const_cast<const uint8_t **>(&_frame->extended_data[0]), _frame->nb_samples);
 
             AudioStream::Frame frame;
             frame.format = AudioFormat::Mono16;
             frame.sampleRate = _audioCodecCtx->sample_rate;
-            frame.samples = move(samples);
-            _video->_audio->add(move(frame));
-        }
+            frame.samples.resize(bufSize);
 
-        av_packet_unref(&packet);
+            uint8_t *samplesPtr = reinterpret_cast<uint8_t *>(&frame.samples[0]);
+            int convertedCount = swr_convert(
+                _swrContext,
+                &samplesPtr, sampleCount,
+                const_cast<const uint8_t **>(&_audioFrame->extended_data[0]), _audioFrame->nb_samples);
+
+            if (convertedCount <= 0) continue;
+            frame.samples.resize(convertedCount * sizeof(int16_t));
 
-        seekBeginning();
+            lock_guard<mutex> lock(_audioQueue->mutex);
+            _audioQueue->frames.push_back(move(frame));
+        }
     }
 
-    void seekBeginning() {
-        int64_t pos = av_rescale_q(0ll, { 1, AV_TIME_BASE }, _formatCtx->streams[_audioStreamIdx]->time_base);
-        av_seek_frame(_formatCtx, _audioStreamIdx, pos, AVSEEK_FLAG_ANY);
+    void endDecoding() {
+        {
+            lock_guard<mutex> lock(_framesMutex);
+            _decodeEnded = true;
+        }
+        if (_audioQueue) {
+            lock_guard<mutex> lock(_audioQueue->mutex);
+            _audioQueue->ended = true;
+        }
     }
 };
 
@@ -331,7 +554,7 @@ void BikReader::load() {
     auto decoder = make_shared<BinkVideoDecoder>(_path, _graphics);
     decoder->load();
 
-    _video = decoder->video();
+    _video = decoder->releaseVideo();
     _video->setMediaStream(decoder);
     _video->init();
 }
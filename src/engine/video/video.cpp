@@ -23,7 +23,9 @@
 #include "../graphics/mesh/meshes.h"
 #include "../graphics/services.h"
 #include "../graphics/shader/shaders.h"
+#include "../graphics/texture/texture.h"
 #include "../graphics/texture/textureutil.h"
+#include "../graphics/yuvutil.h"
 
 using namespace std;
 
@@ -39,15 +41,34 @@ Video::Video(GraphicsServices &graphics) : _graphics(graphics) {
 
 void Video::init() {
     if (!_inited) {
-        _texture = make_shared<Texture>("video", getTextureProperties(TextureUsage::Video));
-        _texture->init();
+        _headless = _graphics.options().headless;
+        if (_headless) {
+            Texture::Properties properties(getTextureProperties(TextureUsage::Video));
+            properties.headless = true;
+            _rgbaTexture = make_shared<Texture>("video", move(properties));
+            _rgbaPixels = make_shared<ByteArray>(4ll * _width * _height);
+        } else {
+            _yTexture = newPlaneTexture("video_y");
+            _uTexture = newPlaneTexture("video_u");
+            _vTexture = newPlaneTexture("video_v");
+        }
         _inited = true;
     }
 }
 
+shared_ptr<Texture> Video::newPlaneTexture(const string &name) {
+    auto texture = make_shared<Texture>(name, getTextureProperties(TextureUsage::Video));
+    texture->init();
+    return move(texture);
+}
+
 void Video::deinit() {
     if (_inited) {
-        _texture.reset();
+        _yTexture.reset();
+        _uTexture.reset();
+        _vTexture.reset();
+        _rgbaTexture.reset();
+        _rgbaPixels.reset();
         _inited = false;
     }
 }
@@ -63,29 +84,61 @@ void Video::updateFrame(float dt) {
     _time += dt;
 
     int frame = static_cast<int>(_fps * _time);
-    _frame = _stream->get(frame);
+    shared_ptr<Frame> nextFrame(_stream->get(frame));
 
-    if (!_frame) {
+    if (_stream->isEnded()) {
         _finished = true;
+        return;
     }
+    _frameChanged = nextFrame != _frame;
+    _frame = move(nextFrame);
 }
 
 void Video::updateFrameTexture() {
-    if (!_frame) return;
+    if (!_frame || !_frameChanged) return;
+
+    if (_headless) {
+        convertYUV420ToRGBA(
+            reinterpret_cast<const uint8_t *>(_frame->yPlane->data()),
+            reinterpret_cast<const uint8_t *>(_frame->uPlane->data()),
+            reinterpret_cast<const uint8_t *>(_frame->vPlane->data()),
+            _width, _height,
+            reinterpret_cast<uint8_t *>(_rgbaPixels->data()));
+
+        _rgbaTexture->setPixels(_width, _height, PixelFormat::RGBA, _rgbaPixels);
+        return;
+    }
+
+    int chromaWidth = (_width + 1) / 2;
+    int chromaHeight = (_height + 1) / 2;
+
+    _graphics.context().setActiveTextureUnit(TextureUnits::videoV);
+    _vTexture->bind();
+    _vTexture->setPixels(chromaWidth, chromaHeight, PixelFormat::Grayscale, _frame->vPlane);
+
+    _graphics.context().setActiveTextureUnit(TextureUnits::videoU);
+    _uTexture->bind();
+    _uTexture->setPixels(chromaWidth, chromaHeight, PixelFormat::Grayscale, _frame->uPlane);
 
     _graphics.context().setActiveTextureUnit(TextureUnits::diffuseMap);
-    _texture->bind();
-    _texture->setPixels(_width, _height, PixelFormat::RGB, _frame->pixels);
+    _yTexture->bind();
+    _yTexture->setPixels(_width, _height, PixelFormat::Grayscale, _frame->yPlane);
 }
 
 void Video::draw() {
-    if (!_inited) return;
+    if (!_inited || _headless) return;
+
+    _graphics.context().setActiveTextureUnit(TextureUnits::videoV);
+    _vTexture->bind();
+
+    _graphics.context().setActiveTextureUnit(TextureUnits::videoU);
+    _uTexture->bind();
 
     _graphics.context().setActiveTextureUnit(TextureUnits::diffuseMap);
-    _texture->bind();
+    _yTexture->bind();
 
     ShaderUniforms uniforms;
-    _graphics.shaders().activate(ShaderProgram::SimpleGUI, uniforms);
+    _graphics.shaders().activate(ShaderProgram::SimpleVideo, uniforms);
     _graphics.meshes().quadNDCFlipY().draw();
 }
 
@@ -41,8 +41,13 @@ class BikReader;
 
 class Video {
 public:
+    /**
+     * Planar YUV 4:2:0 image. Planes are tightly packed.
+     */
     struct Frame {
-        std::shared_ptr<ByteArray> pixels;
+        std::shared_ptr<ByteArray> yPlane;
+        std::shared_ptr<ByteArray> uPlane;
+        std::shared_ptr<ByteArray> vPlane;
     };
 
     Video(graphics::GraphicsServices &graphics);
@@ -70,16 +75,30 @@ private:
     std::shared_ptr<MediaStream<Frame>> _stream;
 
     bool _inited { false };
+    bool _headless { false };
     float _time { 0.0f };
     std::shared_ptr<Frame> _frame;
+    bool _frameChanged { false };
     bool _finished { false };
 
-    std::shared_ptr<graphics::Texture> _texture;
+    // Textures
+
+    std::shared_ptr<graphics::Texture> _yTexture;
+    std::shared_ptr<graphics::Texture> _uTexture;
+    std::shared_ptr<graphics::Texture> _vTexture;
+
+    std::shared_ptr<graphics::Texture> _rgbaTexture; /**< converted on the CPU, in headless mode */
+    std::shared_ptr<ByteArray> _rgbaPixels;
+
+    // END Textures
+
     std::shared_ptr<audio::AudioStream> _audio;
 
     void updateFrame(float dt);
     void updateFrameTexture();
 
+    std::shared_ptr<graphics::Texture> newPlaneTexture(const std::string &name);
+
     friend class BinkVideoDecoder;
 };
 
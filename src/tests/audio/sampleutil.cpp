@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2020-2021 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  Tests for audio sample conversion routines.
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include "../../engine/audio/sampleutil.h"
+
+using namespace std;
+
+using namespace reone::audio;
+
+static int16_t fixedToInt16Reference(int32_t sample) {
+    sample += 1 << 12;
+    sample = max(min(sample, (1 << 28) - 1), -(1 << 28));
+    return static_cast<int16_t>(sample >> 13);
+}
+
+BOOST_AUTO_TEST_CASE(ConvertFixedToInt16_MatchesReference) {
+    // Odd sample count exercises both vectorized and scalar paths
+    static constexpr int kSampleCount = 1027;
+
+    mt19937 rng(42);
+    uniform_int_distribution<int32_t> dist(-(1 << 29), 1 << 29);
+
+    vector<int32_t> left(kSampleCount);
+    vector<int32_t> right(kSampleCount);
+    for (int i = 0; i < kSampleCount; ++i) {
+        left[i] = dist(rng);
+        right[i] = dist(rng);
+    }
+    left[0] = (1 << 28) - 1;
+    left[1] = -(1 << 28);
+    right[0] = 1 << 28;
+    right[1] = -(1 << 28) - 1;
+
+    vector<int16_t> mono(kSampleCount);
+    convertFixedToInt16(&left[0], nullptr, kSampleCount, &mono[0]);
+
+    vector<int16_t> stereo(2 * kSampleCount);
+    convertFixedToInt16(&left[0], &right[0], kSampleCount, &stereo[0]);
+
+    for (int i = 0; i < kSampleCount; ++i) {
+        BOOST_TEST(mono[i] == fixedToInt16Reference(left[i]));
+        BOOST_TEST(stereo[2 * i + 0] == fixedToInt16Reference(left[i]));
+        BOOST_TEST(stereo[2 * i + 1] == fixedToInt16Reference(right[i]));
+    }
+}
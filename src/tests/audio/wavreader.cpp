@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2020-2021 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  Tests for WavReader and WavDecoder classes.
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include "../../engine/audio/format/wavreader.h"
+#include "../../engine/audio/stream.h"
+
+using namespace std;
+
+using namespace reone;
+using namespace reone::audio;
+
+static void putUint16(ByteArray &data, uint16_t value) {
+    data.push_back(value & 0xff);
+    data.push_back((value >> 8) & 0xff);
+}
+
+static void putUint32(ByteArray &data, uint32_t value) {
+    putUint16(data, value & 0xffff);
+    putUint16(data, (value >> 16) & 0xffff);
+}
+
+static shared_ptr<ByteArray> makeWav(WavAudioFormat audioFormat, uint16_t channelCount, uint16_t blockAlign, uint16_t bitsPerSample, const ByteArray &samples) {
+    auto data = make_shared<ByteArray>();
+    data->insert(data->end(), { 'R', 'I', 'F', 'F' });
+    putUint32(*data, static_cast<uint32_t>(36 + samples.size()));
+    data->insert(data->end(), { 'W', 'A', 'V', 'E', 'f', 'm', 't', ' ' });
+    putUint32(*data, 16);
+    putUint16(*data, static_cast<uint16_t>(audioFormat));
+    putUint16(*data, channelCount);
+    putUint32(*data, 22050);
+    putUint32(*data, 22050 * blockAlign);
+    putUint16(*data, blockAlign);
+    putUint16(*data, bitsPerSample);
+    data->insert(data->end(), { 'd', 'a', 't', 'a' });
+    putUint32(*data, static_cast<uint32_t>(samples.size()));
+    data->insert(data->end(), samples.begin(), samples.end());
+    return move(data);
+}
+
+static ByteArray decodeAll(IAudioDecoder &decoder, int &frameCount) {
+    ByteArray result;
+    AudioStream::Frame frame;
+    frameCount = 0;
+    while (decoder.decode(frame)) {
+        result.insert(result.end(), frame.samples.begin(), frame.samples.end());
+        ++frameCount;
+    }
+    return move(result);
+}
+
+BOOST_AUTO_TEST_CASE(WavReader_StreamPCM) {
+    ByteArray samples(100000);
+    for (size_t i = 0; i < samples.size(); ++i) {
+        samples[i] = static_cast<char>(i * 7);
+    }
+    WavReader wav;
+    wav.load(makeWav(WavAudioFormat::PCM, 1, 2, 16, samples));
+
+    shared_ptr<AudioStream> stream(wav.stream());
+    BOOST_TEST(stream->isStreaming());
+    BOOST_TEST(abs(stream->duration() - 50000 / 22050.0f) < 1e-4f);
+
+    unique_ptr<IAudioDecoder> decoder(stream->createDecoder());
+    int frameCount = 0;
+    ByteArray decoded(decodeAll(*decoder, frameCount));
+    BOOST_TEST((decoded == samples));
+    BOOST_TEST(frameCount > 1);
+
+    decoder->rewind();
+    BOOST_TEST((decodeAll(*decoder, frameCount) == samples));
+}
+
+BOOST_AUTO_TEST_CASE(WavReader_StreamIMAADPCM) {
+    // 10 stereo blocks of 36 bytes: 8 bytes of headers, followed by a single group of 8 samples per channel
+    static constexpr int kBlockAlign = 36;
+    ByteArray samples;
+    for (int block = 0; block < 10; ++block) {
+        for (int channel = 0; channel < 2; ++channel) {
+            putUint16(samples, static_cast<uint16_t>(100 * block));
+            putUint16(samples, 10);
+        }
+        for (int i = 0; i < kBlockAlign - 8; ++i) {
+            samples.push_back(static_cast<char>(block + i));
+        }
+    }
+    WavReader wav;
+    wav.load(makeWav(WavAudioFormat::IMAADPCM, 2, kBlockAlign, 4, samples));
+
+    shared_ptr<AudioStream> stream(wav.stream());
+    BOOST_TEST(abs(stream->duration() - 10 * 3 * 8 / 22050.0f) < 1e-4f);
+
+    unique_ptr<IAudioDecoder> decoder(stream->createDecoder());
+    int frameCount = 0;
+    ByteArray decoded(decodeAll(*decoder, frameCount));
+    BOOST_TEST(decoded.size() == 10 * 3 * 8 * 2 * sizeof(int16_t));
+
+    // Decoding must not depend on state left over from the previous pass
+    decoder->rewind();
+    BOOST_TEST((decodeAll(*decoder, frameCount) == decoded));
+}
+
+BOOST_AUTO_TEST_CASE(WavReader_SeekPCM) {
+    ByteArray samples(100000);
+    for (size_t i = 0; i < samples.size(); ++i) {
+        samples[i] = static_cast<char>(i * 7);
+    }
+    WavReader wav;
+    wav.load(makeWav(WavAudioFormat::PCM, 1, 2, 16, samples));
+
+    unique_ptr<IAudioDecoder> decoder(wav.stream()->createDecoder());
+    decoder->seek(1.0f);
+
+    AudioStream::Frame frame;
+    BOOST_TEST(decoder->decode(frame));
+    BOOST_TEST((ByteArray(frame.samples.begin(), frame.samples.begin() + 16) == ByteArray(samples.begin() + 44100, samples.begin() + 44116)));
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2020-2021 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  Tests for MpscQueue class.
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include "../../engine/common/mpscqueue.h"
+
+using namespace std;
+
+using namespace reone;
+
+BOOST_AUTO_TEST_CASE(MpscQueue_ConsumesInPushOrder) {
+    MpscQueue<int> queue;
+    BOOST_TEST(queue.empty());
+
+    queue.push(1);
+    queue.push(2);
+    queue.push(3);
+    BOOST_TEST(!queue.empty());
+
+    vector<int> values;
+    queue.consume([&values](int value) { values.push_back(value); });
+
+    BOOST_TEST((values == vector<int> { 1, 2, 3 }));
+    BOOST_TEST(queue.empty());
+}
+
+BOOST_AUTO_TEST_CASE(MpscQueue_MultipleProducers) {
+    static constexpr int kProducerCount = 4;
+    static constexpr int kValueCount = 10000;
+
+    MpscQueue<int> queue;
+    vector<thread> producers;
+    for (int i = 0; i < kProducerCount; ++i) {
+        producers.push_back(thread([&queue, i]() {
+            for (int j = 0; j < kValueCount; ++j) {
+                queue.push(i * kValueCount + j);
+            }
+        }));
+    }
+
+    // Values of every producer must be consumed exactly once and in order
+    vector<int> lastValues(kProducerCount, -1);
+    int count = 0;
+    auto consume = [&](int value) {
+        int producer = value / kValueCount;
+        BOOST_TEST(value > lastValues[producer]);
+        lastValues[producer] = value;
+        ++count;
+    };
+    while (count < kProducerCount * kValueCount) {
+        queue.consume(consume);
+    }
+    for (auto &producer : producers) {
+        producer.join();
+    }
+    queue.consume(consume);
+
+    BOOST_TEST(count == kProducerCount * kValueCount);
+}
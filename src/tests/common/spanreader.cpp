@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2020-2021 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  Tests for SpanReader class.
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include "../../engine/common/spanreader.h"
+#include "../../engine/common/streamreader.h"
+
+using namespace std;
+
+using namespace reone;
+
+BOOST_AUTO_TEST_CASE(SpanReader_GetLE) {
+    string data("\x01" "\xe8\x03" "\xa0\x86\x01\x00" "\x60\x79\xfe\xff" "\x00\x00\x80\x3f" "abc\0defgh", 24);
+    SpanReader reader(data.c_str(), data.size());
+    BOOST_TEST((reader.getByte() == 0x01));
+    BOOST_TEST((reader.getUint16() == 1000u));
+    BOOST_TEST((reader.getUint32() == 100000u));
+    BOOST_TEST((reader.getInt32() == -100000));
+    BOOST_TEST((reader.getFloat() == 1.0f));
+    BOOST_TEST((reader.getCStringAt(reader.tell()) == "abc"));
+    BOOST_TEST((reader.getCString(6) == "abc"));
+    BOOST_TEST((reader.getCString(3) == "fgh"));
+    BOOST_TEST((reader.tell() == data.size()));
+}
+
+BOOST_AUTO_TEST_CASE(SpanReader_GetArray_MatchesStreamReader) {
+    ByteArray data(64);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<char>(i * 37 + 11);
+    }
+    auto stream = make_shared<istringstream>(string(data.begin(), data.end()));
+    StreamReader streamReader(stream);
+    SpanReader spanReader(data);
+
+    streamReader.seek(2);
+    BOOST_TEST((spanReader.getArrayAt<uint16_t>(2, 5) == streamReader.getUint16Array(5)));
+    BOOST_TEST((spanReader.getArrayAt<uint32_t>(12, 4) == streamReader.getUint32Array(12, 4)));
+
+    // Floats are compared bitwise, as some of the patterns are NaNs
+    vector<float> expected(streamReader.getFloatArray(28, 9));
+    vector<float> actual(spanReader.getArrayAt<float>(28, 9));
+    BOOST_TEST((memcmp(&expected[0], &actual[0], 9 * sizeof(float)) == 0));
+}
+
+BOOST_AUTO_TEST_CASE(SpanReader_ThrowsOutOfBounds) {
+    ByteArray data(8);
+    SpanReader reader(data);
+    reader.seek(6);
+    BOOST_CHECK_THROW(reader.getUint32(), out_of_range);
+    BOOST_CHECK_THROW(reader.getArrayAt<float>(4, 2), out_of_range);
+    BOOST_CHECK_THROW(reader.getArrayAt<uint16_t>(SIZE_MAX - 1, 2), out_of_range);
+    BOOST_CHECK_THROW(reader.seek(9), out_of_range);
+    BOOST_TEST((reader.getArrayAt<uint32_t>(8, 0).empty()));
+    BOOST_TEST((reader.getUint16() == 0));
+}
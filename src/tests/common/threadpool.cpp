@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2020-2021 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  Tests for ThreadPool class.
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include "../../engine/common/threadpool.h"
+
+using namespace std;
+
+using namespace reone;
+
+BOOST_AUTO_TEST_CASE(ThreadPool_Enqueue) {
+    ThreadPool pool(2);
+
+    future<int> result(pool.enqueue([]() { return 42; }));
+
+    BOOST_TEST(result.get() == 42);
+}
+
+BOOST_AUTO_TEST_CASE(ThreadPool_ParallelFor) {
+    ThreadPool pool(3);
+    vector<int> values(100, 0);
+
+    pool.parallelFor(static_cast<int>(values.size()), [&values](int i) { values[i] = i * 2; });
+
+    for (int i = 0; i < static_cast<int>(values.size()); ++i) {
+        BOOST_TEST(values[i] == i * 2);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(ThreadPool_ParallelForDoesNotWaitForQueuedJobs) {
+    ThreadPool pool(1);
+    promise<void> release;
+    shared_future<void> released(release.get_future());
+    future<void> busy(pool.enqueue([released]() { released.wait(); }));
+    future<void> queued(pool.enqueue([]() {}));
+    vector<int> values(10, 0);
+
+    pool.parallelFor(static_cast<int>(values.size()), [&values](int i) { values[i] = i * 2; });
+
+    for (int i = 0; i < static_cast<int>(values.size()); ++i) {
+        BOOST_TEST(values[i] == i * 2);
+    }
+
+    release.set_value();
+    busy.get();
+    queued.get();
+}
+
+BOOST_AUTO_TEST_CASE(ThreadPool_ParallelForFromWorkerThrows) {
+    ThreadPool pool(1);
+
+    future<void> result(pool.enqueue([&pool]() { pool.parallelFor(2, [](int) {}); }));
+
+    BOOST_CHECK_THROW(result.get(), logic_error);
+}
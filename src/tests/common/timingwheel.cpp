@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2020-2021 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  Tests for TimingWheel class.
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include "../../engine/common/timingwheel.h"
+
+using namespace std;
+
+using namespace reone;
+
+BOOST_AUTO_TEST_CASE(TimingWheel_ReleasesDueValues) {
+    TimingWheel<int> wheel(0.1f, 8);
+    vector<int> released;
+    auto release = [&released](int &value) { released.push_back(value); };
+
+    wheel.schedule(0.5f, 2);
+    wheel.schedule(0.05f, 1);
+    wheel.schedule(2.0f, 3); // more than a revolution away
+
+    wheel.update(0.04f, release);
+    BOOST_TEST((released.empty()));
+
+    wheel.update(0.02f, release);
+    BOOST_TEST((released == vector<int> { 1 }));
+
+    wheel.update(0.5f, release);
+    BOOST_TEST((released == vector<int> { 1, 2 }));
+    BOOST_TEST((wheel.size() == 1));
+
+    wheel.update(1.0f, release);
+    BOOST_TEST((released == vector<int> { 1, 2 }));
+
+    wheel.update(0.5f, release);
+    BOOST_TEST((released == vector<int> { 1, 2, 3 }));
+    BOOST_TEST((wheel.size() == 0));
+}
+
+BOOST_AUTO_TEST_CASE(TimingWheel_ReleasedValueCanScheduleAnother) {
+    TimingWheel<int> wheel(0.1f, 8);
+    vector<int> released;
+    function<void(int &)> release = [&](int &value) {
+        released.push_back(value);
+        if (value < 3) {
+            wheel.schedule(0.0f, value + 1);
+        }
+    };
+
+    wheel.schedule(0.0f, 1);
+    wheel.update(0.01f, release);
+    wheel.update(0.01f, release);
+    wheel.update(0.01f, release);
+
+    BOOST_TEST((released == vector<int> { 1, 2, 3 }));
+}
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2020-2021 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "../../engine/audio/player.h"
+#include "../../engine/audio/services.h"
+#include "../../engine/game/game.h"
+#include "../../engine/game/object/objectfactory.h"
+#include "../../engine/graphics/context.h"
+#include "../../engine/graphics/features.h"
+#include "../../engine/graphics/fonts.h"
+#include "../../engine/graphics/lip/lips.h"
+#include "../../engine/graphics/materials.h"
+#include "../../engine/graphics/mesh/meshes.h"
+#include "../../engine/graphics/model/models.h"
+#include "../../engine/graphics/pbribl.h"
+#include "../../engine/graphics/services.h"
+#include "../../engine/graphics/walkmesh/walkmeshes.h"
+#include "../../engine/graphics/window.h"
+#include "../../engine/resource/resourceprovider.h"
+#include "../../engine/resource/services.h"
+#include "../../engine/scene/pipeline/world.h"
+#include "../../engine/scene/scenegraph.h"
+#include "../../engine/scene/services.h"
+#include "../../engine/script/services.h"
+
+namespace reone {
+
+namespace game {
+
+/**
+ * Game with uninitialized services, sufficient to construct game objects
+ * without loading any game data.
+ */
+struct GameFixture {
+    resource::ResourceServices resource { boost::filesystem::path() };
+    graphics::GraphicsServices graphics { graphics::GraphicsOptions(), resource };
+    audio::AudioServices audio { audio::AudioOptions(), resource };
+    scene::SceneServices scene { graphics::GraphicsOptions(), graphics };
+    script::ScriptServices script { resource };
+    Game game { boost::filesystem::path(), Options(), resource, graphics, audio, scene, script };
+    scene::SceneGraph sceneGraph { graphics::GraphicsOptions(), graphics };
+    ObjectFactory objectFactory { game, sceneGraph };
+};
+
+} // namespace game
+
+} // namespace reone
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2020-2021 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  Tests for GlobalVariables class.
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include "../../engine/game/globalvariables.h"
+#include "../../engine/script/variable.h"
+
+using namespace std;
+
+using namespace reone::game;
+using namespace reone::script;
+
+BOOST_AUTO_TEST_CASE(GlobalVariables_ResolveByHandle) {
+    GlobalVariables globals;
+
+    int index = globals.getIndex("K_PLOT_FLAG");
+    globals.setNumber(index, 5);
+
+    {
+        Variable name(Variable::ofString("K_PLOT_FLAG"));
+        BOOST_TEST((globals.getIndex(name) == index));
+
+        // Copies of the string share the cached index
+        Variable copy(name);
+        BOOST_TEST((globals.findIndex(copy) == index));
+        BOOST_TEST((globals.getNumber(globals.getIndex(copy)) == 5));
+    }
+
+    // Handle of the released string is reused for a different name
+    Variable other(Variable::ofString("K_OTHER_FLAG"));
+    BOOST_TEST((globals.findIndex(other) == -1));
+    BOOST_TEST((globals.findIndex("K_OTHER_FLAG") == -1));
+    int otherIndex = globals.getIndex(other);
+    BOOST_TEST((otherIndex != index));
+    BOOST_TEST((globals.findIndex("K_OTHER_FLAG") == otherIndex));
+    BOOST_TEST((globals.getNumber(otherIndex) == 0));
+}
+
+BOOST_AUTO_TEST_CASE(GlobalVariables_ResolveByHandle_SeparateInstances) {
+    GlobalVariables first;
+    GlobalVariables second;
+    first.getIndex("a");
+    second.getIndex("b");
+
+    Variable name(Variable::ofString("b"));
+    BOOST_TEST((second.getIndex(name) == 0));
+    BOOST_TEST((first.findIndex(name) == -1));
+    BOOST_TEST((first.getIndex(name) == 1));
+    BOOST_TEST((second.getIndex(name) == 0));
+}
+
+BOOST_AUTO_TEST_CASE(GlobalVariables_ForEachSet) {
+    GlobalVariables globals;
+    globals.setBoolean(globals.getIndex("a"), true);
+    globals.setNumber(globals.getIndex("b"), 2);
+    globals.getIndex("c");
+
+    vector<string> names;
+    globals.forEachBoolean([&names](const string &name, bool value) { names.push_back(name); });
+    globals.forEachNumber([&names](const string &name, int value) { names.push_back(name); });
+
+    BOOST_TEST((names == vector<string> { "a", "b" }));
+    BOOST_TEST((globals.findIndex("d") == -1));
+}
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2020-2021 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  Tests for ScriptRunner class.
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include "../../engine/game/object/waypoint.h"
+#include "../../engine/game/script/routines.h"
+#include "../../engine/game/script/runner.h"
+#include "../../engine/resource/resources.h"
+#include "../../engine/script/profiler.h"
+#include "../../engine/script/scripts.h"
+
+#include "../script/programbuilder.h"
+
+#include "gamefixture.h"
+
+using namespace std;
+
+using namespace reone::game;
+using namespace reone::resource;
+using namespace reone::script;
+
+// Indices of KotOR routines
+static constexpr int kRoutineRandom = 0;
+static constexpr int kRoutineGetGlobalNumber = 580;
+
+struct ScriptRunnerFixture : GameFixture {
+    Routines routines { game };
+    Resources resources;
+    Scripts scripts { resources };
+    ScriptProfiler profiler;
+    ScriptRunner runner { routines, scripts, profiler, game.globals() };
+
+    ScriptRunnerFixture() {
+        routines.init();
+
+        // return GetGlobalNumber("K_FLAG") == 1;
+        ProgramBuilder pure("pure");
+        pure.addStringConstant("K_FLAG");
+        pure.addCallRoutine(kRoutineGetGlobalNumber, 1);
+        pure.addConstant(1);
+        pure.add(ByteCode::Equal, InstructionType::IntInt, 2);
+        pure.add(ByteCode::Return, InstructionType::None, 2);
+        put("pure", pure);
+
+        // return Random(1) == 0;
+        ProgramBuilder impure("impure");
+        impure.addConstant(1);
+        impure.addCallRoutine(kRoutineRandom, 1);
+        impure.addConstant(0);
+        impure.add(ByteCode::Equal, InstructionType::IntInt, 2);
+        impure.add(ByteCode::Return, InstructionType::None, 2);
+        put("impure", impure);
+    }
+
+    void put(const string &resRef, ProgramBuilder &builder) {
+        auto program = builder.build();
+        program->internStrings();
+        scripts.put(resRef, move(program));
+    }
+
+    int getRunCount(const string &resRef) const {
+        for (auto &stats : runner.getStatsByTotalTime()) {
+            if (stats.first == resRef) return stats.second.runCount;
+        }
+        return 0;
+    }
+};
+
+BOOST_FIXTURE_TEST_CASE(ScriptRunner_EvaluateConditions_Batch, ScriptRunnerFixture) {
+    // Empty ResRef evaluates to true, duplicates are run once per batch
+    vector<bool> results(runner.evaluateConditions({ "impure", "", "pure", "impure", "pure" }, 2));
+
+    BOOST_TEST((results == vector<bool> { true, true, false, true, false }));
+    BOOST_TEST((getRunCount("impure") == 1));
+    BOOST_TEST((getRunCount("pure") == 1));
+
+    // Scripts following the first true one are not evaluated
+    results = runner.evaluateConditions({ "pure", "", "impure" }, 2, true);
+
+    BOOST_TEST((results == vector<bool> { false, true, false }));
+    BOOST_TEST((getRunCount("impure") == 1));
+}
+
+BOOST_FIXTURE_TEST_CASE(ScriptRunner_EvaluateConditions_MemoizesPure, ScriptRunnerFixture) {
+    runner.evaluateConditions({ "pure", "impure" }, 2);
+    runner.evaluateConditions({ "pure", "impure" }, 2);
+
+    BOOST_TEST((getRunCount("pure") == 1));
+    BOOST_TEST((getRunCount("impure") == 2));
+
+    // Memoized results are per caller
+    runner.evaluateConditions({ "pure" }, 3);
+    BOOST_TEST((getRunCount("pure") == 2));
+    runner.evaluateConditions({ "pure" }, 3);
+    BOOST_TEST((getRunCount("pure") == 2));
+}
+
+BOOST_FIXTURE_TEST_CASE(ScriptRunner_EvaluateConditions_InvalidatedByVariables, ScriptRunnerFixture) {
+    BOOST_TEST((runner.evaluateConditions({ "pure" }, 2) == vector<bool> { false }));
+
+    // Global changes
+    game.globals().setNumber(game.globals().getIndex("K_FLAG"), 1);
+
+    BOOST_TEST((runner.evaluateConditions({ "pure" }, 2) == vector<bool> { true }));
+    BOOST_TEST((getRunCount("pure") == 2));
+
+    // Local changes
+    auto waypoint = make_shared<Waypoint>(2, &game, &objectFactory, &sceneGraph);
+    waypoint->setLocalNumber(0, 1);
+
+    BOOST_TEST((runner.evaluateConditions({ "pure" }, 2) == vector<bool> { true }));
+    BOOST_TEST((getRunCount("pure") == 3));
+
+    // Program is reloaded
+    ProgramBuilder reloaded("pure");
+    reloaded.addConstant(0);
+    reloaded.add(ByteCode::Return, InstructionType::None, 2);
+    put("pure", reloaded);
+
+    BOOST_TEST((runner.evaluateConditions({ "pure" }, 2) == vector<bool> { false }));
+    BOOST_TEST((getRunCount("pure") == 4));
+    BOOST_TEST((runner.evaluateConditions({ "pure" }, 2) == vector<bool> { false }));
+    BOOST_TEST((getRunCount("pure") == 4));
+}
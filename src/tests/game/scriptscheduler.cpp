@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2020-2021 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  Tests for ScriptScheduler class.
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include "../../engine/game/script/routines.h"
+#include "../../engine/game/script/runner.h"
+#include "../../engine/game/script/scheduler.h"
+#include "../../engine/resource/resources.h"
+#include "../../engine/script/profiler.h"
+#include "../../engine/script/scripts.h"
+
+#include "gamefixture.h"
+
+using namespace std;
+
+using namespace reone::game;
+using namespace reone::resource;
+using namespace reone::script;
+
+/**
+ * Records scripts instead of running them, each taking the specified time.
+ */
+class TestScriptScheduler : public ScriptScheduler {
+public:
+    vector<pair<string, uint32_t>> runScripts;
+    chrono::milliseconds scriptTime { 0 };
+
+    TestScriptScheduler(Game &game, ScriptRunner &runner) : ScriptScheduler(game, runner) {
+    }
+
+protected:
+    void run(ScheduledScript &script) override {
+        runScripts.push_back(make_pair(script.resRef, script.callerId));
+        this_thread::sleep_for(scriptTime);
+    }
+};
+
+struct ScriptSchedulerFixture : GameFixture {
+    Routines routines { game };
+    Resources resources;
+    Scripts scripts { resources };
+    ScriptProfiler profiler;
+    ScriptRunner runner { routines, scripts, profiler, game.globals() };
+    TestScriptScheduler scheduler { game, runner };
+};
+
+BOOST_FIXTURE_TEST_CASE(ScriptScheduler_Update_WithinBudget, ScriptSchedulerFixture) {
+    scheduler.setFrameBudget(10.0f);
+    scheduler.enqueue("a", 2);
+    scheduler.enqueue("b", 3);
+    scheduler.enqueue("c", 2);
+    BOOST_TEST(scheduler.stats().pendingCount == 3);
+
+    scheduler.update();
+
+    vector<pair<string, uint32_t>> expectedScripts { { "a", 2 }, { "b", 3 }, { "c", 2 } };
+    BOOST_TEST((scheduler.runScripts == expectedScripts));
+    BOOST_TEST(scheduler.stats().lastFrameRunCount == 3);
+    BOOST_TEST(scheduler.stats().pendingCount == 0);
+    BOOST_TEST(scheduler.stats().overrunCount == 0);
+    BOOST_TEST(scheduler.stats().deferredCount == 0);
+}
+
+BOOST_FIXTURE_TEST_CASE(ScriptScheduler_Update_Overrun, ScriptSchedulerFixture) {
+    // First script alone exceeds the budget, but is run nonetheless
+    scheduler.setFrameBudget(0.001f);
+    scheduler.scriptTime = chrono::milliseconds(5);
+    scheduler.enqueue("a", 2);
+    scheduler.enqueue("b", 2);
+    scheduler.enqueue("c", 2);
+
+    scheduler.update();
+
+    BOOST_TEST((scheduler.runScripts.size() == 1));
+    BOOST_TEST(scheduler.stats().lastFrameRunCount == 1);
+    BOOST_TEST(scheduler.stats().lastFrameTime >= 0.005f);
+    BOOST_TEST(scheduler.stats().pendingCount == 2);
+    BOOST_TEST(scheduler.stats().overrunCount == 1);
+    BOOST_TEST(scheduler.stats().deferredCount == 1);
+
+    scheduler.update();
+    scheduler.setFrameBudget(10.0f);
+    scheduler.update();
+
+    BOOST_TEST((scheduler.runScripts.size() == 3));
+    BOOST_TEST(scheduler.stats().pendingCount == 0);
+    BOOST_TEST(scheduler.stats().overrunCount == 2);
+    BOOST_TEST(scheduler.stats().deferredCount == 2);
+}
+
+BOOST_FIXTURE_TEST_CASE(ScriptScheduler_EnqueueUnique_CoalescesPending, ScriptSchedulerFixture) {
+    scheduler.setFrameBudget(10.0f);
+
+    BOOST_TEST(scheduler.enqueueUnique("heartbeat", 2));
+    BOOST_TEST(!scheduler.enqueueUnique("heartbeat", 2));
+    BOOST_TEST(scheduler.enqueueUnique("heartbeat", 3));
+    BOOST_TEST(scheduler.enqueueUnique("other", 2));
+    BOOST_TEST(!scheduler.enqueueUnique("", 2));
+    BOOST_TEST(scheduler.stats().pendingCount == 3);
+    BOOST_TEST(scheduler.stats().coalescedCount == 1);
+
+    scheduler.update();
+
+    // Once run, the script can be queued again
+    BOOST_TEST((scheduler.runScripts.size() == 3));
+    BOOST_TEST(scheduler.enqueueUnique("heartbeat", 2));
+
+    scheduler.clear();
+
+    BOOST_TEST(scheduler.stats().pendingCount == 0);
+    BOOST_TEST(scheduler.enqueueUnique("heartbeat", 2));
+}
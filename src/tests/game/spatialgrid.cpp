@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2020-2021 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  Tests for SpatialGrid class.
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include "../../engine/game/object/waypoint.h"
+#include "../../engine/game/spatialgrid.h"
+
+#include "gamefixture.h"
+
+using namespace std;
+
+using namespace reone::game;
+
+static constexpr float kCellSize = 10.0f;
+
+struct SpatialGridFixture : GameFixture {
+    SpatialGrid grid { kCellSize };
+    uint32_t nextId { 2 };
+
+    shared_ptr<SpatialObject> addWaypoint(const glm::vec3 &position) {
+        auto waypoint = make_shared<Waypoint>(nextId++, &game, &objectFactory, &sceneGraph);
+        waypoint->setPosition(position);
+        grid.add(waypoint);
+        return move(waypoint);
+    }
+};
+
+static bool containsExactly(ObjectList objects, ObjectList expected) {
+    auto compareIds = [](auto &left, auto &right) { return left->id() < right->id(); };
+    sort(objects.begin(), objects.end(), compareIds);
+    sort(expected.begin(), expected.end(), compareIds);
+    return objects == expected;
+}
+
+static bool acceptAll(const shared_ptr<SpatialObject> &) {
+    return true;
+}
+
+BOOST_FIXTURE_TEST_CASE(SpatialGrid_GetObjectsInRadius_EmptyGrid, SpatialGridFixture) {
+    BOOST_TEST(grid.getObjectsInRadius(glm::vec2(0.0f), 100.0f).empty());
+    BOOST_TEST(grid.getNearestObjects(glm::vec3(0.0f), 1, acceptAll).empty());
+}
+
+BOOST_FIXTURE_TEST_CASE(SpatialGrid_GetObjectsInRadius_AcrossCellBoundaries, SpatialGridFixture) {
+    auto left = addWaypoint(glm::vec3(9.9f, 0.0f, 0.0f));
+    auto right = addWaypoint(glm::vec3(10.1f, 0.0f, 0.0f));
+    auto below = addWaypoint(glm::vec3(10.0f, -0.1f, 0.0f));
+    auto onRadius = addWaypoint(glm::vec3(0.0f, 0.0f, 0.0f));
+    auto distant = addWaypoint(glm::vec3(25.0f, 0.0f, 0.0f));
+
+    BOOST_TEST(containsExactly(grid.getObjectsInRadius(glm::vec2(10.0f, 0.0f), 0.5f), ObjectList { left, right, below }));
+    BOOST_TEST(containsExactly(grid.getObjectsInRadius(glm::vec2(10.0f, 0.0f), 10.0f), ObjectList { left, right, below, onRadius }));
+    BOOST_TEST(containsExactly(grid.getObjectsInRadius(glm::vec2(-20.0f, 0.0f), 5.0f), ObjectList()));
+}
+
+BOOST_FIXTURE_TEST_CASE(SpatialGrid_GetNearestObjects_OrderedByDistance, SpatialGridFixture) {
+    // Nearest object lies in a neighbouring cell, farther one in the origin cell
+    auto sameCell = addWaypoint(glm::vec3(0.5f, 0.0f, 0.0f));
+    auto nextCell = addWaypoint(glm::vec3(11.0f, 0.0f, 0.0f));
+    auto farCell = addWaypoint(glm::vec3(59.0f, 0.0f, 0.0f));
+    auto above = addWaypoint(glm::vec3(9.0f, 0.0f, 9.5f));
+
+    glm::vec3 origin(9.0f, 0.0f, 0.0f);
+
+    BOOST_TEST((grid.getNearestObjects(origin, 1, acceptAll) == ObjectList { nextCell }));
+    BOOST_TEST((grid.getNearestObjects(origin, 3, acceptAll) == ObjectList { nextCell, sameCell, above }));
+
+    auto notNextCell = [&nextCell](auto &object) { return object != nextCell; };
+    BOOST_TEST((grid.getNearestObjects(origin, 1, notNextCell) == ObjectList { sameCell }));
+}
+
+BOOST_FIXTURE_TEST_CASE(SpatialGrid_GetNearestObjects_FewerCandidatesThanCount, SpatialGridFixture) {
+    auto closest = addWaypoint(glm::vec3(1.0f, 1.0f, 0.0f));
+    auto distant = addWaypoint(glm::vec3(-35.0f, 42.0f, 0.0f));
+    addWaypoint(glm::vec3(2.0f, 2.0f, 0.0f));
+
+    auto notAtTwo = [](auto &object) { return object->position().x != 2.0f; };
+
+    BOOST_TEST((grid.getNearestObjects(glm::vec3(0.0f), 5, notAtTwo) == ObjectList { closest, distant }));
+    BOOST_TEST(grid.getNearestObjects(glm::vec3(0.0f), 0, acceptAll).empty());
+}
+
+BOOST_FIXTURE_TEST_CASE(SpatialGrid_SetPosition_MovesObjectAcrossCells, SpatialGridFixture) {
+    auto moving = addWaypoint(glm::vec3(1.0f, 1.0f, 0.0f));
+    auto fixed = addWaypoint(glm::vec3(36.0f, 1.0f, 0.0f));
+
+    moving->setPosition(glm::vec3(35.0f, 1.0f, 0.0f));
+
+    BOOST_TEST(grid.getObjectsInRadius(glm::vec2(1.0f, 1.0f), 2.0f).empty());
+    BOOST_TEST(containsExactly(grid.getObjectsInRadius(glm::vec2(35.0f, 1.0f), 2.0f), ObjectList { moving, fixed }));
+    BOOST_TEST((grid.getNearestObjects(glm::vec3(30.0f, 1.0f, 0.0f), 1, acceptAll) == ObjectList { moving }));
+
+    // Moving within a cell keeps the object findable, removal uses its current position
+    moving->setPosition(glm::vec3(34.0f, 2.0f, 0.0f));
+    grid.remove(*moving);
+
+    BOOST_TEST((grid.getObjectsInRadius(glm::vec2(35.0f, 1.0f), 2.0f) == ObjectList { fixed }));
+    BOOST_TEST(!moving->grid());
+}
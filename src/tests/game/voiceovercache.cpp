@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2020-2021 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  Tests for VoiceOverCache class.
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include "../../engine/common/threadpool.h"
+#include "../../engine/game/voiceovercache.h"
+#include "../../engine/resource/resources.h"
+
+using namespace std;
+
+using namespace reone;
+using namespace reone::game;
+using namespace reone::resource;
+
+namespace fs = boost::filesystem;
+
+static constexpr size_t kSampleCount = 1000;
+static constexpr size_t kWavSize = 44 + kSampleCount;
+
+static void putUint16(ByteArray &data, uint16_t value) {
+    data.push_back(value & 0xff);
+    data.push_back((value >> 8) & 0xff);
+}
+
+static void putUint32(ByteArray &data, uint32_t value) {
+    putUint16(data, value & 0xffff);
+    putUint16(data, (value >> 16) & 0xffff);
+}
+
+static ByteArray makeWav() {
+    ByteArray data;
+    data.insert(data.end(), { 'R', 'I', 'F', 'F' });
+    putUint32(data, static_cast<uint32_t>(36 + kSampleCount));
+    data.insert(data.end(), { 'W', 'A', 'V', 'E', 'f', 'm', 't', ' ' });
+    putUint32(data, 16);
+    putUint16(data, 1); // PCM
+    putUint16(data, 1);
+    putUint32(data, 22050);
+    putUint32(data, 22050 * 2);
+    putUint16(data, 2);
+    putUint16(data, 16);
+    data.insert(data.end(), { 'd', 'a', 't', 'a' });
+    putUint32(data, static_cast<uint32_t>(kSampleCount));
+    data.resize(kWavSize, 0);
+    return move(data);
+}
+
+/**
+ * Voice-overs are read from a temporary directory, and the cache fits two of them.
+ */
+struct VoiceOverCacheFixture {
+    fs::path dir { fs::temp_directory_path() / fs::unique_path() };
+    Resources resources;
+    ThreadPool threadPool { 2 };
+    VoiceOverCache cache { resources, threadPool, 2 * kWavSize + kWavSize / 2 };
+
+    VoiceOverCacheFixture() {
+        fs::create_directories(dir);
+        for (auto &resRef : { "vo_a", "vo_b", "vo_c" }) {
+            writeFile(resRef, makeWav());
+        }
+        writeFile("vo_bad", ByteArray(kWavSize, 'x'));
+        resources.indexDirectory(dir);
+    }
+
+    ~VoiceOverCacheFixture() {
+        fs::remove_all(dir);
+    }
+
+    void writeFile(const string &resRef, const ByteArray &data) {
+        fs::ofstream out(dir / (resRef + ".wav"), ios::binary);
+        out.write(&data[0], data.size());
+    }
+
+    void load(const string &resRef) {
+        cache.prefetch({ resRef });
+        BOOST_TEST(cache.get(resRef));
+    }
+};
+
+BOOST_FIXTURE_TEST_CASE(VoiceOverCache_Get, VoiceOverCacheFixture) {
+    BOOST_TEST(!cache.get("vo_a"));
+
+    cache.prefetch({ "vo_a", "vo_missing" });
+
+    shared_ptr<VoiceOverCache::VoiceOver> voiceOver(cache.get("vo_a"));
+    BOOST_TEST(voiceOver);
+    BOOST_TEST(voiceOver->stream);
+    BOOST_TEST(voiceOver->size == kWavSize);
+
+    shared_ptr<VoiceOverCache::VoiceOver> missing(cache.get("vo_missing"));
+    BOOST_TEST(missing);
+    BOOST_TEST(!missing->stream);
+    BOOST_TEST(missing->size == 0);
+}
+
+BOOST_FIXTURE_TEST_CASE(VoiceOverCache_EvictLeastRecentlyUsed, VoiceOverCacheFixture) {
+    load("vo_a");
+    load("vo_b");
+    BOOST_TEST(cache.get("vo_a"));
+
+    // Exceeds the budget, either now or on the next prefetch, depending on whether vo_c finishes loading in time
+    load("vo_c");
+    cache.prefetch({});
+
+    // vo_b is the least recently used voice-over
+    BOOST_TEST(!cache.get("vo_b"));
+    BOOST_TEST(cache.get("vo_a"));
+    BOOST_TEST(cache.get("vo_c"));
+}
+
+BOOST_FIXTURE_TEST_CASE(VoiceOverCache_KeepCurrentCandidates, VoiceOverCacheFixture) {
+    load("vo_a");
+    load("vo_b");
+
+    // All voice-overs are candidates for the next entry, so none are evicted despite exceeding the budget
+    cache.prefetch({ "vo_a", "vo_b", "vo_c" });
+    BOOST_TEST(cache.get("vo_c"));
+    cache.prefetch({ "vo_a", "vo_b", "vo_c" });
+
+    BOOST_TEST(cache.get("vo_a"));
+    BOOST_TEST(cache.get("vo_b"));
+    BOOST_TEST(cache.get("vo_c"));
+}
+
+BOOST_FIXTURE_TEST_CASE(VoiceOverCache_DropFailedLoad, VoiceOverCacheFixture) {
+    cache.prefetch({ "vo_bad" });
+    BOOST_TEST(!cache.get("vo_bad"));
+
+    // Failure is not cached, the next prefetch reads the resource again
+    writeFile("vo_bad", makeWav());
+    load("vo_bad");
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2020-2021 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  Tests for lip animation sampling.
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include "../../engine/graphics/lip/animation.h"
+
+using namespace std;
+
+using namespace reone::graphics;
+
+static LipAnimation newAnimation() {
+    vector<LipAnimation::Keyframe> keyframes;
+    keyframes.push_back(LipAnimation::Keyframe { 0.0f, 1 });
+    keyframes.push_back(LipAnimation::Keyframe { 0.5f, 2 });
+    keyframes.push_back(LipAnimation::Keyframe { 1.0f, 3 });
+    keyframes.push_back(LipAnimation::Keyframe { 2.0f, 4 });
+
+    return LipAnimation(2.0f, move(keyframes));
+}
+
+BOOST_AUTO_TEST_CASE(LipAnimation_Sample_HoldsShapesOutsideKeyframes) {
+    LipAnimation animation(newAnimation());
+    int cursor = 0;
+    LipAnimation::Sample sample;
+
+    BOOST_TEST(animation.sample(0.0f, cursor, sample));
+    BOOST_TEST(static_cast<int>(sample.leftShape) == 1);
+    BOOST_TEST(static_cast<int>(sample.rightShape) == 1);
+    BOOST_TEST(sample.factor == 0.0f);
+
+    BOOST_TEST(animation.sample(3.0f, cursor, sample));
+    BOOST_TEST(static_cast<int>(sample.leftShape) == 4);
+    BOOST_TEST(static_cast<int>(sample.rightShape) == 4);
+    BOOST_TEST(sample.factor == 0.0f);
+}
+
+BOOST_AUTO_TEST_CASE(LipAnimation_Sample_CursorMatchesLookupFromScratch) {
+    LipAnimation animation(newAnimation());
+    int cursor = 0;
+
+    // Forward, then wrapped around as a looping animation would be
+    vector<float> times { 0.1f, 0.25f, 0.5f, 0.75f, 1.5f, 2.0f, 0.3f, 1.2f };
+    for (float time : times) {
+        LipAnimation::Sample expected;
+        int freshCursor = 0;
+        animation.sample(time, freshCursor, expected);
+
+        LipAnimation::Sample actual;
+        BOOST_TEST(animation.sample(time, cursor, actual));
+        BOOST_TEST(actual.leftShape == expected.leftShape);
+        BOOST_TEST(actual.rightShape == expected.rightShape);
+        BOOST_TEST(actual.factor == expected.factor);
+    }
+
+    LipAnimation::Sample sample;
+    animation.sample(0.75f, cursor, sample);
+    BOOST_TEST(static_cast<int>(sample.leftShape) == 2);
+    BOOST_TEST(static_cast<int>(sample.rightShape) == 3);
+    BOOST_TEST(sample.factor == 0.5f);
+}
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2020-2021 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "../../engine/common/types.h"
+
+namespace reone {
+
+namespace graphics {
+
+// Synthetic MDL and MDX data, sufficient to load a model without game data
+
+static constexpr int kMdlDataOffset = 12;
+
+// Offsets, relative to MDL data
+static constexpr int kOffNameOffsets = 200;
+static constexpr int kOffNames = 204;
+static constexpr int kOffNode = 212;
+static constexpr int kOffMesh = kOffNode + 80;
+static constexpr int kOffFaces = kOffMesh + 332;
+static constexpr int kOffIndicesOffset = kOffFaces + 2 * 32;
+static constexpr int kOffIndices = kOffIndicesOffset + 4;
+static constexpr int kOffControllerKeys = kOffIndices + 6 * 2;
+static constexpr int kOffControllerData = kOffControllerKeys + 16;
+static constexpr int kMdlDataSize = kOffControllerData + 4 * 4;
+
+template <class T>
+inline void put(ByteArray &mdl, int offset, T value) {
+    memcpy(&mdl[kMdlDataOffset + offset], &value, sizeof(T));
+}
+
+inline void putString(ByteArray &mdl, int offset, const std::string &value) {
+    memcpy(&mdl[kMdlDataOffset + offset], value.c_str(), value.size());
+}
+
+inline void putArrayDefinition(ByteArray &mdl, int offset, uint32_t arrOffset, uint32_t count) {
+    put(mdl, offset + 0, arrOffset);
+    put(mdl, offset + 4, count);
+    put(mdl, offset + 8, count);
+}
+
+/**
+ * Appends zero-initialized data to the MDL.
+ *
+ * @return offset of the appended data, relative to MDL data
+ */
+inline uint32_t allocate(ByteArray &mdl, size_t size) {
+    auto offset = static_cast<uint32_t>(mdl.size() - kMdlDataOffset);
+    mdl.resize(mdl.size() + size, '\0');
+    return offset;
+}
+
+/**
+ * @return offset of the appended array, relative to MDL data
+ */
+template <class T>
+inline uint32_t putArray(ByteArray &mdl, const std::vector<T> &values) {
+    uint32_t offset = allocate(mdl, values.size() * sizeof(T));
+    if (!values.empty()) {
+        memcpy(&mdl[kMdlDataOffset + offset], &values[0], values.size() * sizeof(T));
+    }
+    return offset;
+}
+
+/**
+ * @return offset of the appended null-terminated string, relative to MDL data
+ */
+inline uint32_t putCString(ByteArray &mdl, const std::string &value) {
+    uint32_t offset = allocate(mdl, value.size() + 1);
+    putString(mdl, offset, value);
+    return offset;
+}
+
+/**
+ * @return MDL of a model with a single mesh node: 4 vertices, 2 faces of
+ *         different materials and a position controller
+ */
+inline ByteArray newMdl() {
+    ByteArray mdl(kMdlDataOffset + kMdlDataSize, '\0');
+
+    // Geometry Header
+    putString(mdl, 8, "test");
+    put<uint32_t>(mdl, 40, kOffNode);
+    put<uint32_t>(mdl, 44, 1);
+
+    // Model Header
+    put(mdl, 132, 1.0f);
+    putString(mdl, 136, "NULL");
+    putArrayDefinition(mdl, 184, kOffNameOffsets, 1);
+
+    // Node names
+    put<uint32_t>(mdl, kOffNameOffsets, kOffNames);
+    putString(mdl, kOffNames, "Root");
+
+    // Node Header
+    put<uint16_t>(mdl, kOffNode + 0, 0x21); // header, mesh
+    put(mdl, kOffNode + 16, 1.0f);
+    put(mdl, kOffNode + 20, 2.0f);
+    put(mdl, kOffNode + 24, 3.0f);
+    put(mdl, kOffNode + 28, 1.0f);
+    putArrayDefinition(mdl, kOffNode + 56, kOffControllerKeys, 1);
+    putArrayDefinition(mdl, kOffNode + 68, kOffControllerData, 4);
+
+    // Mesh Header
+    putArrayDefinition(mdl, kOffMesh + 8, kOffFaces, 2);
+    put(mdl, kOffMesh + 60, 0.5f);
+    put(mdl, kOffMesh + 64, 0.25f);
+    put(mdl, kOffMesh + 68, 1.0f);
+    putString(mdl, kOffMesh + 88, "NULL");
+    putArrayDefinition(mdl, kOffMesh + 188, kOffIndicesOffset, 1);
+    put<uint32_t>(mdl, kOffMesh + 252, 6 * sizeof(float)); // vertex size
+    put<int32_t>(mdl, kOffMesh + 260, 0); // vertex coordinates
+    put<int32_t>(mdl, kOffMesh + 264, 3 * sizeof(float)); // normals
+    for (int offset = 268; offset < 292; offset += 4) {
+        put<int32_t>(mdl, kOffMesh + offset, -1);
+    }
+    put<uint16_t>(mdl, kOffMesh + 304, 4); // number of vertices
+    put<uint8_t>(mdl, kOffMesh + 313, 1); // render
+
+    // Faces
+    put<uint32_t>(mdl, kOffFaces + 16, 7);
+    put<uint32_t>(mdl, kOffFaces + 32 + 16, 9);
+
+    // Indices
+    put<uint32_t>(mdl, kOffIndicesOffset, kOffIndices);
+    std::vector<uint16_t> indices { 0, 1, 2, 2, 1, 3 };
+    for (int i = 0; i < 6; ++i) {
+        put(mdl, kOffIndices + 2 * i, indices[i]);
+    }
+
+    // Position controller with a single row
+    put<uint32_t>(mdl, kOffControllerKeys + 0, 8);
+    put<uint16_t>(mdl, kOffControllerKeys + 6, 1);
+    put<uint16_t>(mdl, kOffControllerKeys + 8, 0);
+    put<uint16_t>(mdl, kOffControllerKeys + 10, 1);
+    put<uint8_t>(mdl, kOffControllerKeys + 12, 3);
+    put(mdl, kOffControllerData + 4, 4.0f);
+    put(mdl, kOffControllerData + 8, 5.0f);
+    put(mdl, kOffControllerData + 12, 6.0f);
+
+    return std::move(mdl);
+}
+
+inline std::vector<float> newMdxVertices() {
+    std::vector<float> vertices;
+    for (int i = 0; i < 4 * 6; ++i) {
+        vertices.push_back(0.1f * i - 1.0f);
+    }
+    return std::move(vertices);
+}
+
+inline ByteArray newMdx() {
+    std::vector<float> vertices(newMdxVertices());
+    ByteArray mdx(vertices.size() * sizeof(float));
+    memcpy(&mdx[0], &vertices[0], mdx.size());
+    return std::move(mdx);
+}
+
+} // namespace graphics
+
+} // namespace reone
@@ -0,0 +1,395 @@
+/*
+ * Copyright (c) 2020-2021 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  Tests for MdlReader class.
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include "../../engine/graphics/context.h"
+#include "../../engine/graphics/mesh/mesh.h"
+#include "../../engine/graphics/model/animation.h"
+#include "../../engine/graphics/model/mdlreader.h"
+#include "../../engine/graphics/model/model.h"
+#include "../../engine/graphics/model/models.h"
+#include "../../engine/graphics/texture/textures.h"
+#include "../../engine/resource/resourceprovider.h"
+#include "../../engine/resource/resources.h"
+
+#include "mdlfixture.h"
+
+using namespace std;
+
+using namespace reone;
+using namespace reone::graphics;
+using namespace reone::resource;
+
+// Header sizes
+static constexpr int kModelHeaderSize = 196;
+static constexpr int kNodeHeaderSize = 80;
+static constexpr int kMeshHeaderSize = 332;
+static constexpr int kSkinHeaderSize = 100;
+static constexpr int kDanglyHeaderSize = 28;
+static constexpr int kAABBHeaderSize = 4;
+static constexpr int kSaberHeaderSize = 20;
+static constexpr int kLightHeaderSize = 92;
+static constexpr int kEmitterHeaderSize = 229;
+static constexpr int kReferenceHeaderSize = 36;
+static constexpr int kAnimationHeaderSize = 136;
+static constexpr int kAABBNodeSize = 40;
+static constexpr int kEventSize = 36;
+
+static constexpr int kSaberVertexCount = 96;
+
+/**
+ * @return offset of the appended node, followed by type-specific headers of the specified size
+ */
+static uint32_t putNode(ByteArray &mdl, uint16_t flags, uint16_t nameIndex, size_t headersSize = 0) {
+    uint32_t offset = allocate(mdl, kNodeHeaderSize + headersSize);
+    put(mdl, offset + 0, flags);
+    put(mdl, offset + 4, nameIndex);
+    put(mdl, offset + 28, 1.0f);
+    return offset;
+}
+
+static void putChildren(ByteArray &mdl, uint32_t nodeOffset, const vector<uint32_t> &childOffsets) {
+    putArrayDefinition(mdl, nodeOffset + 44, putArray(mdl, childOffsets), static_cast<uint32_t>(childOffsets.size()));
+}
+
+/**
+ * Appends a controller with a row per time, followed by values of all rows.
+ */
+static void putController(ByteArray &mdl, uint32_t nodeOffset, uint32_t type, uint8_t numColumns, const vector<float> &times, const vector<float> &values) {
+    uint32_t keyOffset = allocate(mdl, 16);
+    put(mdl, keyOffset + 0, type);
+    put(mdl, keyOffset + 6, static_cast<uint16_t>(times.size()));
+    put(mdl, keyOffset + 8, static_cast<uint16_t>(0));
+    put(mdl, keyOffset + 10, static_cast<uint16_t>(times.size()));
+    put(mdl, keyOffset + 12, numColumns);
+    putArrayDefinition(mdl, nodeOffset + 56, keyOffset, 1);
+
+    vector<float> data(times);
+    data.insert(data.end(), values.begin(), values.end());
+    putArrayDefinition(mdl, nodeOffset + 68, putArray(mdl, data), static_cast<uint32_t>(data.size()));
+}
+
+/**
+ * Fills a mesh header, that follows the node header. Vertex coordinates
+ * are read from the beginning of MDX.
+ */
+static void putMesh(ByteArray &mdl, uint32_t nodeOffset, uint16_t numVertices = 4) {
+    uint32_t offset = nodeOffset + kNodeHeaderSize;
+    putString(mdl, offset + 88, "NULL");
+    put<uint32_t>(mdl, offset + 252, 3 * sizeof(float)); // vertex size
+    put<int32_t>(mdl, offset + 260, 0); // vertex coordinates
+    for (int attrOffset = 264; attrOffset < 292; attrOffset += 4) {
+        put<int32_t>(mdl, offset + attrOffset, -1);
+    }
+    put(mdl, offset + 304, numVertices);
+    put<uint8_t>(mdl, offset + 313, 1); // render
+}
+
+static const vector<string> g_nodeNames { "Root", "Skin", "Dangly", "AABB", "Saber", "Light", "Emitter", "Reference" };
+
+/**
+ * @return MDL of a model with a node of every supported type, and an
+ *         animation with events
+ */
+static ByteArray newNodeTypesMdl() {
+    ByteArray mdl(kMdlDataOffset + kModelHeaderSize, '\0');
+
+    // Geometry Header
+    putString(mdl, 8, "types");
+    put<uint32_t>(mdl, 44, static_cast<uint32_t>(g_nodeNames.size()));
+
+    // Model Header
+    put(mdl, 132, 1.0f);
+    putString(mdl, 136, "NULL");
+
+    // Node names
+    vector<uint32_t> nameOffsets;
+    for (auto &name : g_nodeNames) {
+        nameOffsets.push_back(putCString(mdl, name));
+    }
+    putArrayDefinition(mdl, 184, putArray(mdl, nameOffsets), static_cast<uint32_t>(nameOffsets.size()));
+
+    uint32_t root = putNode(mdl, 0x1, 0);
+    put<uint32_t>(mdl, 40, root);
+
+    // Skin: bone 1 is the root node, bone 0 is the skin node itself
+    uint32_t skin = putNode(mdl, 0x61, 1, kMeshHeaderSize + kSkinHeaderSize);
+    putMesh(mdl, skin);
+    uint32_t skinHeader = skin + kNodeHeaderSize + kMeshHeaderSize;
+    put<uint32_t>(mdl, skinHeader + 12, 16); // bone weights
+    put<uint32_t>(mdl, skinHeader + 16, 32); // bone indices
+    put<uint32_t>(mdl, skinHeader + 20, putArray(mdl, vector<float> { 1.0f, 0.0f }));
+    put<uint32_t>(mdl, skinHeader + 24, 2);
+
+    uint32_t dangly = putNode(mdl, 0x121, 2, kMeshHeaderSize + kDanglyHeaderSize);
+    putMesh(mdl, dangly);
+    uint32_t danglyHeader = dangly + kNodeHeaderSize + kMeshHeaderSize;
+    putArrayDefinition(mdl, danglyHeader + 0, putArray(mdl, vector<float> { 255.0f, 127.5f }), 2);
+    put(mdl, danglyHeader + 12, 2.0f);
+    put(mdl, danglyHeader + 16, 3.0f);
+    put(mdl, danglyHeader + 20, 4.0f);
+    put<uint32_t>(mdl, danglyHeader + 24, putArray(mdl, vector<float> { 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f }));
+
+    // AABB: root of the tree splits into two leaves
+    uint32_t aabb = putNode(mdl, 0x221, 3, kMeshHeaderSize + kAABBHeaderSize);
+    putMesh(mdl, aabb);
+    uint32_t treeRoot = allocate(mdl, 3 * kAABBNodeSize);
+    uint32_t treeLeft = treeRoot + kAABBNodeSize;
+    uint32_t treeRight = treeLeft + kAABBNodeSize;
+    put<uint32_t>(mdl, aabb + kNodeHeaderSize + kMeshHeaderSize, treeRoot);
+    vector<float> treeBounds { -1.0f, -2.0f, -3.0f, 1.0f, 2.0f, 3.0f };
+    for (size_t i = 0; i < treeBounds.size(); ++i) {
+        put(mdl, static_cast<int>(treeRoot + 4 * i), treeBounds[i]);
+    }
+    put(mdl, treeRoot + 24, treeLeft);
+    put(mdl, treeRoot + 28, treeRight);
+    put<int32_t>(mdl, treeRoot + 32, -1);
+    put<uint32_t>(mdl, treeRoot + 36, 1);
+    put<int32_t>(mdl, treeLeft + 32, 0);
+    put<int32_t>(mdl, treeRight + 32, 1);
+
+    // Saber: vertex i is at (i, 0.5, -i), with texture coordinates (i / 100, 0) and normal (0, 0, 1)
+    uint32_t saber = putNode(mdl, 0x821, 4, kMeshHeaderSize + kSaberHeaderSize);
+    putMesh(mdl, saber, kSaberVertexCount);
+    vector<float> saberVertices, saberTexCoords, saberNormals;
+    for (int i = 0; i < kSaberVertexCount; ++i) {
+        saberVertices.insert(saberVertices.end(), { static_cast<float>(i), 0.5f, static_cast<float>(-i) });
+        saberTexCoords.insert(saberTexCoords.end(), { i / 100.0f, 0.0f });
+        saberNormals.insert(saberNormals.end(), { 0.0f, 0.0f, 1.0f });
+    }
+    uint32_t saberHeader = saber + kNodeHeaderSize + kMeshHeaderSize;
+    put<uint32_t>(mdl, saberHeader + 0, putArray(mdl, saberVertices));
+    put<uint32_t>(mdl, saberHeader + 4, putArray(mdl, saberTexCoords));
+    put<uint32_t>(mdl, saberHeader + 8, putArray(mdl, saberNormals));
+
+    // Light with a single lens flare and a color controller
+    uint32_t light = putNode(mdl, 0x3, 5, kLightHeaderSize);
+    uint32_t lightHeader = light + kNodeHeaderSize;
+    put(mdl, lightHeader + 0, 5.0f);
+    putArrayDefinition(mdl, lightHeader + 16, putArray(mdl, vector<float> { 0.5f }), 1);
+    putArrayDefinition(mdl, lightHeader + 28, putArray(mdl, vector<float> { 0.25f }), 1);
+    putArrayDefinition(mdl, lightHeader + 40, putArray(mdl, vector<float> { 1.0f, 0.0f, 0.0f }), 1);
+    uint32_t flareTexture = allocate(mdl, 12);
+    putString(mdl, flareTexture, "flare");
+    putArrayDefinition(mdl, lightHeader + 52, putArray(mdl, vector<uint32_t> { flareTexture }), 1);
+    put<uint32_t>(mdl, lightHeader + 64, 2); // priority
+    put<uint32_t>(mdl, lightHeader + 68, 1); // ambient only
+    put<uint32_t>(mdl, lightHeader + 72, 3); // dynamic type
+    put<uint32_t>(mdl, lightHeader + 80, 1); // shadow
+    put<uint32_t>(mdl, lightHeader + 88, 1); // fading
+    putController(mdl, light, 76, 3, { 0.0f }, { 1.0f, 0.5f, 0.25f });
+
+    // Emitter with a birthrate controller
+    uint32_t emitter = putNode(mdl, 0x5, 6, kEmitterHeaderSize);
+    uint32_t emitterHeader = emitter + kNodeHeaderSize;
+    put<uint32_t>(mdl, emitterHeader + 24, 2); // y grid
+    putString(mdl, emitterHeader + 32, "Fountain");
+    putString(mdl, emitterHeader + 64, "Linked");
+    putString(mdl, emitterHeader + 96, "Lighten");
+    put<uint32_t>(mdl, emitterHeader + 180, 1); // loop
+    put<uint32_t>(mdl, emitterHeader + 184, 3); // render order
+    put<uint32_t>(mdl, emitterHeader + 225, 3); // flags: p2p, p2p bezier
+    putController(mdl, emitter, 88, 1, { 0.0f }, { 10.0f });
+
+    uint32_t reference = putNode(mdl, 0x11, 7, kReferenceHeaderSize);
+    putString(mdl, reference + kNodeHeaderSize, "Missing");
+    put<uint32_t>(mdl, reference + kNodeHeaderSize + 32, 1);
+
+    putChildren(mdl, root, { skin, dangly, aabb, saber, light, emitter, reference });
+
+    // Animation: root node moves, light changes color, events are out of order
+    uint32_t animation = allocate(mdl, kAnimationHeaderSize);
+    putString(mdl, animation + 8, "Wave");
+    put(mdl, animation + 80, 2.0f);
+    put(mdl, animation + 84, 0.25f);
+    putString(mdl, animation + 88, "Root");
+
+    uint32_t events = allocate(mdl, 2 * kEventSize);
+    put(mdl, events, 1.5f);
+    putString(mdl, events + 4, "Hit");
+    put(mdl, events + kEventSize, 0.5f);
+    putString(mdl, events + kEventSize + 4, "Swing");
+    putArrayDefinition(mdl, animation + 120, events, 2);
+
+    uint32_t animRoot = putNode(mdl, 0x1, 0);
+    put(mdl, animation + 40, animRoot);
+    putController(mdl, animRoot, 8, 3, { 0.0f, 1.0f }, { 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f });
+
+    uint32_t animLight = putNode(mdl, 0x1, 5);
+    putController(mdl, animLight, 76, 3, { 0.0f }, { 0.0f, 1.0f, 0.0f });
+    putChildren(mdl, animRoot, { animLight });
+
+    putArrayDefinition(mdl, 88, putArray(mdl, vector<uint32_t> { animation }), 1);
+
+    return move(mdl);
+}
+
+BOOST_AUTO_TEST_CASE(MdlReader_Load_ReadsMeshArraysVerbatim) {
+    Context context;
+    Resources resources;
+    Textures textures(context, resources, true);
+    Models models(textures, resources, true);
+
+    ByteArray mdl(newMdl());
+    ByteArray mdx(newMdx());
+    vector<float> mdxVertices(newMdxVertices());
+
+    MdlReader reader(models, textures);
+    reader.load(mdl, mdx);
+    shared_ptr<Model> model(reader.model());
+
+    BOOST_TEST((model->name() == "test"));
+    BOOST_TEST(!model->superModel());
+
+    shared_ptr<ModelNode> node(model->rootNode());
+    BOOST_TEST((node->name() == "root"));
+    BOOST_TEST((node->restPosition() == glm::vec3(1.0f, 2.0f, 3.0f)));
+    BOOST_TEST((node->position().getNumFrames() == 1));
+    BOOST_TEST((node->position().getByFrame(0) == glm::vec3(4.0f, 5.0f, 6.0f)));
+
+    shared_ptr<ModelNode::TriangleMesh> mesh(node->mesh());
+    BOOST_TEST(mesh->render);
+    BOOST_TEST(!mesh->diffuseMap);
+    BOOST_TEST((mesh->diffuse == glm::vec3(0.5f, 0.25f, 1.0f)));
+    BOOST_TEST((mesh->mesh->vertices() == mdxVertices));
+    BOOST_TEST((mesh->mesh->indices() == vector<uint16_t> { 0, 1, 2, 2, 1, 3 }));
+    BOOST_TEST((mesh->materialFaces.size() == 2));
+    BOOST_TEST((mesh->materialFaces[7] == vector<uint32_t> { 0 }));
+    BOOST_TEST((mesh->materialFaces[9] == vector<uint32_t> { 1 }));
+}
+
+BOOST_AUTO_TEST_CASE(MdlReader_Load_ThrowsOnTruncatedModel) {
+    Context context;
+    Resources resources;
+    Textures textures(context, resources, true);
+    Models models(textures, resources, true);
+
+    ByteArray mdl(newMdl());
+    mdl.resize(kMdlDataOffset + kOffIndices);
+    ByteArray mdx(4 * 6 * sizeof(float), '\0');
+
+    MdlReader reader(models, textures);
+    BOOST_CHECK_THROW(reader.load(mdl, mdx), out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(MdlReader_Load_ReadsAllNodeTypes) {
+    Context context;
+    Resources resources;
+    Textures textures(context, resources, true);
+    Models models(textures, resources, true);
+
+    ByteArray mdl(newNodeTypesMdl());
+    ByteArray mdx(newMdx());
+
+    MdlReader reader(models, textures);
+    reader.load(mdl, mdx);
+    shared_ptr<Model> model(reader.model());
+
+    BOOST_TEST((model->name() == "types"));
+    BOOST_TEST((model->rootNode()->children().size() == 7));
+
+    shared_ptr<ModelNode> skin(model->getNodeByName("skin"));
+    BOOST_TEST(skin->isSkinMesh());
+    BOOST_TEST((skin->mesh()->skin->boneMap == vector<float> { 1.0f, 0.0f }));
+    BOOST_TEST((skin->mesh()->skin->boneNodeName == vector<string> { "skin", "root" }));
+    BOOST_TEST(skin->mesh()->mesh->attributes().offBoneWeights == 16);
+    BOOST_TEST(skin->mesh()->mesh->attributes().offBoneIndices == 32);
+    BOOST_TEST(skin->mesh()->mesh->vertices().size() == 12);
+
+    shared_ptr<ModelNode> dangly(model->getNodeByName("dangly"));
+    BOOST_TEST(dangly->isDanglyMesh());
+    shared_ptr<ModelNode::DanglyMesh> danglyMesh(dangly->mesh()->danglyMesh);
+    BOOST_TEST(danglyMesh->displacement == 1.0f);
+    BOOST_TEST(danglyMesh->tightness == 3.0f);
+    BOOST_TEST(danglyMesh->period == 4.0f);
+    BOOST_TEST(danglyMesh->constraints.size() == 2);
+    BOOST_TEST(danglyMesh->constraints[0].multiplier == 1.0f);
+    BOOST_TEST(danglyMesh->constraints[1].multiplier == 0.5f);
+    BOOST_TEST((danglyMesh->constraints[1].position == glm::vec3(4.0f, 5.0f, 6.0f)));
+
+    shared_ptr<ModelNode> aabb(model->getNodeByName("aabb"));
+    BOOST_TEST(aabb->isAABBMesh());
+    shared_ptr<ModelNode::AABBTree> tree(aabb->mesh()->aabbTree);
+    BOOST_TEST(tree->faceIndex == -1);
+    BOOST_TEST((tree->mostSignificantPlane == ModelNode::AABBTree::Plane::PositiveX));
+    BOOST_TEST((tree->aabb.min() == glm::vec3(-1.0f, -2.0f, -3.0f)));
+    BOOST_TEST((tree->aabb.max() == glm::vec3(1.0f, 2.0f, 3.0f)));
+    BOOST_TEST(tree->left->faceIndex == 0);
+    BOOST_TEST(tree->right->faceIndex == 1);
+
+    shared_ptr<ModelNode> saber(model->getNodeByName("saber"));
+    BOOST_TEST(saber->isSaberMesh());
+    const vector<float> &saberVertices = saber->mesh()->mesh->vertices();
+    BOOST_TEST(saberVertices.size() == 16 * 8);
+    BOOST_TEST((vector<float>(saberVertices.begin() + 8 * 8, saberVertices.begin() + 9 * 8) == vector<float> { 88.0f, 0.5f, -88.0f, 0.88f, 0.0f, 0.0f, 0.0f, 1.0f }));
+    BOOST_TEST(saber->mesh()->mesh->indices().size() == 36);
+    BOOST_TEST(saber->mesh()->mesh->attributes().stride == 8 * sizeof(float));
+
+    shared_ptr<ModelNode> light(model->getNodeByName("light"));
+    BOOST_TEST(light->isLight());
+    BOOST_TEST(light->light()->flareRadius == 5.0f);
+    BOOST_TEST(light->light()->priority == 2);
+    BOOST_TEST(light->light()->ambientOnly);
+    BOOST_TEST(light->light()->dynamicType == 3);
+    BOOST_TEST(!light->light()->affectDynamic);
+    BOOST_TEST(light->light()->shadow);
+    BOOST_TEST(light->light()->fading);
+    BOOST_TEST(light->light()->flares.size() == 1);
+    BOOST_TEST(light->light()->flares[0].size == 0.5f);
+    BOOST_TEST(light->light()->flares[0].position == 0.25f);
+    BOOST_TEST((light->light()->flares[0].colorShift == glm::vec3(1.0f, 0.0f, 0.0f)));
+    BOOST_TEST((light->color().getByFrame(0) == glm::vec3(1.0f, 0.5f, 0.25f)));
+
+    shared_ptr<ModelNode> emitter(model->getNodeByName("emitter"));
+    BOOST_TEST(emitter->isEmitter());
+    BOOST_TEST((emitter->emitter()->updateMode == ModelNode::Emitter::UpdateMode::Fountain));
+    BOOST_TEST((emitter->emitter()->renderMode == ModelNode::Emitter::RenderMode::Linked));
+    BOOST_TEST((emitter->emitter()->blendMode == ModelNode::Emitter::BlendMode::Lighten));
+    BOOST_TEST((emitter->emitter()->gridSize == glm::ivec2(1, 2)));
+    BOOST_TEST(emitter->emitter()->renderOrder == 3);
+    BOOST_TEST(emitter->emitter()->loop);
+    BOOST_TEST(emitter->emitter()->p2p);
+    BOOST_TEST(emitter->emitter()->p2pBezier);
+    BOOST_TEST(emitter->birthrate().getByFrame(0) == 10.0f);
+
+    shared_ptr<ModelNode> reference(model->getNodeByName("reference"));
+    BOOST_TEST(reference->isReference());
+    BOOST_TEST(!reference->reference()->model);
+    BOOST_TEST(reference->reference()->reattachable);
+
+    shared_ptr<Animation> animation(model->getAnimation("wave"));
+    BOOST_TEST(animation);
+    BOOST_TEST(animation->length() == 2.0f);
+    BOOST_TEST(animation->transitionTime() == 0.25f);
+    BOOST_TEST(animation->events().size() == 2);
+    BOOST_TEST((animation->events()[0].name == "swing"));
+    BOOST_TEST(animation->events()[0].time == 0.5f);
+    BOOST_TEST((animation->events()[1].name == "hit"));
+    BOOST_TEST(animation->rootNode()->position().getNumFrames() == 2);
+    BOOST_TEST((animation->rootNode()->position().getByFrame(1) == glm::vec3(0.0f, 1.0f, 0.0f)));
+
+    // Animation nodes are specialized by flags of the model nodes of the same name
+    shared_ptr<ModelNode> animLight(animation->getNodeByName("light"));
+    BOOST_TEST(animLight);
+    BOOST_TEST(!animLight->isLight());
+    BOOST_TEST((animLight->color().getByFrame(0) == glm::vec3(0.0f, 1.0f, 0.0f)));
+}
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2020-2021 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  Tests for Models class.
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include "../../engine/common/threadpool.h"
+#include "../../engine/graphics/context.h"
+#include "../../engine/graphics/model/model.h"
+#include "../../engine/graphics/model/models.h"
+#include "../../engine/graphics/texture/textures.h"
+#include "../../engine/resource/resources.h"
+
+#include "mdlfixture.h"
+
+using namespace std;
+
+using namespace reone;
+using namespace reone::graphics;
+using namespace reone::resource;
+
+namespace fs = boost::filesystem;
+
+/**
+ * Models are read from a temporary directory. Models must not be
+ * initialized, as there is no OpenGL context.
+ */
+struct ModelsFixture {
+    fs::path dir { fs::temp_directory_path() / fs::unique_path() };
+    Context context;
+    Resources resources;
+    Textures textures { context, resources, true };
+    Models models { textures, resources, true };
+    ThreadPool threadPool { 4 };
+
+    ModelsFixture() {
+        fs::create_directories(dir);
+        ByteArray mdl(newMdl());
+        ByteArray mdx(newMdx());
+        for (auto &resRef : { "model_a", "model_b" }) {
+            writeFile(string(resRef) + ".mdl", mdl);
+            writeFile(string(resRef) + ".mdx", mdx);
+        }
+        writeFile("model_bad.mdl", ByteArray(mdl.begin(), mdl.begin() + kMdlDataOffset + kOffIndices));
+        writeFile("model_bad.mdx", mdx);
+        resources.indexDirectory(dir);
+    }
+
+    ~ModelsFixture() {
+        fs::remove_all(dir);
+    }
+
+    void writeFile(const string &filename, const ByteArray &data) {
+        fs::ofstream out(dir / filename, ios::binary);
+        out.write(&data[0], data.size());
+    }
+};
+
+BOOST_FIXTURE_TEST_CASE(Models_Load_ConcurrentRequestsParseOnce, ModelsFixture) {
+    // Every parsed model is queued for initialization, unless headless
+    Models renderModels(textures, resources);
+
+    static constexpr int kRequestCount = 16;
+    vector<shared_ptr<Model>> loaded(kRequestCount);
+    threadPool.parallelFor(kRequestCount, [&](int i) {
+        loaded[i] = renderModels.load("model_a");
+    });
+
+    BOOST_TEST(loaded[0]);
+    for (auto &model : loaded) {
+        BOOST_TEST((model == loaded[0]));
+    }
+    BOOST_TEST(renderModels.getPendingCount() == 1);
+}
+
+BOOST_FIXTURE_TEST_CASE(Models_Load_FailureIsNotCached, ModelsFixture) {
+    BOOST_CHECK_THROW(models.load("model_bad"), out_of_range);
+
+    writeFile("model_bad.mdl", newMdl());
+    resources.invalidateCache();
+
+    BOOST_TEST(models.load("model_bad"));
+}
+
+BOOST_FIXTURE_TEST_CASE(Models_GetMany_PreservesOrder, ModelsFixture) {
+    vector<shared_ptr<Model>> loaded(models.getMany({ "model_b", "model_missing", "model_a", "" }, threadPool));
+
+    BOOST_TEST(loaded.size() == 4);
+    BOOST_TEST(loaded[0]);
+    BOOST_TEST((loaded[0] == models.load("model_b")));
+    BOOST_TEST(!loaded[1]);
+    BOOST_TEST(loaded[2]);
+    BOOST_TEST((loaded[2] == models.load("model_a")));
+    BOOST_TEST(!loaded[3]);
+}
+
+BOOST_FIXTURE_TEST_CASE(Models_GetMany_DoesNotWaitForQueuedJobs, ModelsFixture) {
+    ThreadPool busyPool(1);
+    promise<void> release;
+    shared_future<void> released(release.get_future());
+    future<void> busy(busyPool.enqueue([released]() { released.wait(); }));
+
+    vector<shared_ptr<Model>> loaded(models.getMany({ "model_a", "model_b" }, busyPool));
+
+    BOOST_TEST(loaded[0]);
+    BOOST_TEST(loaded[1]);
+
+    release.set_value();
+    busy.get();
+}
+
+BOOST_FIXTURE_TEST_CASE(Models_Load_HeadlessQueuesNothing, ModelsFixture) {
+    BOOST_TEST(models.load("model_a"));
+    BOOST_TEST(models.getPendingCount() == 0);
+}
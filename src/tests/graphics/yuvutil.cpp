@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2020-2021 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  Tests and a microbenchmark for YUV to RGB conversion routines.
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include "../../engine/graphics/yuvutil.h"
+
+using namespace std;
+
+using namespace reone::graphics;
+
+static constexpr int kMaxError = 2;
+
+static void convertReference(int y, int u, int v, int rgb[3]) {
+    float luma = 1.164f * (y - 16);
+    float d = u - 128.0f;
+    float e = v - 128.0f;
+    rgb[0] = max(0, min(255, static_cast<int>(lround(luma + 1.596f * e))));
+    rgb[1] = max(0, min(255, static_cast<int>(lround(luma - 0.391f * d - 0.813f * e))));
+    rgb[2] = max(0, min(255, static_cast<int>(lround(luma + 2.018f * d))));
+}
+
+static void fillRandom(vector<uint8_t> &plane, mt19937 &rng) {
+    uniform_int_distribution<int> dist(0, 255);
+    for (auto &sample : plane) {
+        sample = static_cast<uint8_t>(dist(rng));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(ConvertYUV420ToRGBA_MatchesReference) {
+    // Odd dimensions exercise both vectorized and scalar paths, as well as chroma rounding
+    static constexpr int kWidth = 37;
+    static constexpr int kHeight = 5;
+    static constexpr int kChromaWidth = (kWidth + 1) / 2;
+    static constexpr int kChromaHeight = (kHeight + 1) / 2;
+
+    mt19937 rng(42);
+    vector<uint8_t> y(kWidth * kHeight);
+    vector<uint8_t> u(kChromaWidth * kChromaHeight);
+    vector<uint8_t> v(kChromaWidth * kChromaHeight);
+    fillRandom(y, rng);
+    fillRandom(u, rng);
+    fillRandom(v, rng);
+
+    // Extremes, where intermediate results saturate
+    y[0] = 255;
+    u[0] = 255;
+    v[0] = 255;
+    y[2] = 0;
+    u[1] = 0;
+    v[1] = 0;
+
+    vector<uint8_t> rgba(4 * kWidth * kHeight);
+    convertYUV420ToRGBA(&y[0], &u[0], &v[0], kWidth, kHeight, &rgba[0]);
+
+    for (int row = 0; row < kHeight; ++row) {
+        for (int col = 0; col < kWidth; ++col) {
+            int chromaIdx = (row / 2) * kChromaWidth + col / 2;
+            int expected[3];
+            convertReference(y[row * kWidth + col], u[chromaIdx], v[chromaIdx], expected);
+
+            const uint8_t *actual = &rgba[4 * (row * kWidth + col)];
+            for (int i = 0; i < 3; ++i) {
+                BOOST_TEST(abs(actual[i] - expected[i]) <= kMaxError);
+            }
+            BOOST_TEST(actual[3] == 255);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(ConvertYUV420ToRGBA_Benchmark) {
+    static constexpr int kWidth = 640;
+    static constexpr int kHeight = 480;
+    static constexpr int kFrameCount = 100;
+
+    mt19937 rng(42);
+    vector<uint8_t> y(kWidth * kHeight);
+    vector<uint8_t> u(kWidth * kHeight / 4);
+    vector<uint8_t> v(kWidth * kHeight / 4);
+    fillRandom(y, rng);
+    fillRandom(u, rng);
+    fillRandom(v, rng);
+
+    vector<uint8_t> rgba(4 * kWidth * kHeight);
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < kFrameCount; ++i) {
+        convertYUV420ToRGBA(&y[0], &u[0], &v[0], kWidth, kHeight, &rgba[0]);
+    }
+    float time = chrono::duration<float>(chrono::steady_clock::now() - start).count();
+
+    double pixels = static_cast<double>(kWidth) * kHeight * kFrameCount;
+    BOOST_TEST_MESSAGE(boost::format("YUV420 to RGBA benchmark: %d frames of %dx%d in %.2f ms, %.2f Mpx/s") % kFrameCount % kWidth % kHeight % (1000.0f * time) % (pixels / time / 1e6));
+    BOOST_TEST(rgba[3] == 255);
+}
@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2020-2021 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  Script VM microbenchmarks. Each test reports interpreter throughput, so
+ *  that regressions can be spotted in the test log.
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include "../../engine/script/argumentlist.h"
+#include "../../engine/script/execution.h"
+#include "../../engine/script/executioncontext.h"
+#include "../../engine/script/optimizer.h"
+#include "../../engine/script/program.h"
+#include "../../engine/script/routine.h"
+#include "../../engine/script/routineprovider.h"
+#include "../../engine/script/variable.h"
+
+#include "programbuilder.h"
+
+using namespace std;
+
+using namespace reone::script;
+
+static constexpr int kIterationCount = 100000;
+static constexpr int kModulus = 1000003;
+
+namespace {
+
+class BenchmarkRoutines : public IRoutineProvider {
+public:
+    BenchmarkRoutines() {
+        _routines.push_back(Routine("Add", VariableType::Int, { VariableType::Int, VariableType::Int }, [](auto &args, auto &ctx) {
+            return Variable::ofInt(args[0].intValue + args[1].intValue);
+        }));
+    }
+
+    const Routine &get(int index) override {
+        return _routines[index];
+    }
+
+private:
+    vector<Routine> _routines;
+};
+
+} // namespace
+
+/**
+ * Builds a program, equivalent to:
+ *
+ * int i = 0, sum = 0;
+ * while (i < count) { sum = <body>; ++i; }
+ * return sum;
+ *
+ * Body is emitted by the specified function, which must leave the new sum on
+ * top of the stack, with i and sum below it.
+ */
+static shared_ptr<ScriptProgram> buildLoop(int count, const function<void(ProgramBuilder &)> &emitBody, int &loopInstructionCount) {
+    ProgramBuilder builder("benchmark");
+    builder.addConstant(0); // i
+    builder.addConstant(0); // sum
+
+    uint32_t loopOffset = builder.offset();
+    int loopStart = builder.instructionCount();
+    builder.addStackOp(ByteCode::CopyTopSP, -8);
+    builder.addConstant(count);
+    builder.add(ByteCode::LessThan, InstructionType::IntInt, 2);
+    int exitJump = builder.addJump(ByteCode::JumpIfZero);
+
+    emitBody(builder);
+
+    builder.addStackOp(ByteCode::CopyDownSP, -8);
+    builder.addStackOp(ByteCode::AdjustSP, -4);
+    builder.addStackOp(ByteCode::IncRelToSP, -8);
+    builder.addJump(ByteCode::Jump, loopOffset);
+    loopInstructionCount = builder.instructionCount() - loopStart;
+
+    builder.setJumpTarget(exitJump, builder.offset());
+    builder.add(ByteCode::Return, InstructionType::None, 2);
+
+    return builder.build();
+}
+
+static int runBenchmark(const string &name, const shared_ptr<ScriptProgram> &program, IRoutineProvider *routines, int loopInstructionCount) {
+    auto context = make_unique<ExecutionContext>();
+    context->routines = routines;
+    ScriptExecution execution(program, move(context));
+
+    auto start = chrono::steady_clock::now();
+    int result = execution.run();
+    float time = chrono::duration<float>(chrono::steady_clock::now() - start).count();
+
+    double instructions = static_cast<double>(loopInstructionCount) * kIterationCount;
+    BOOST_TEST_MESSAGE(boost::format("ScriptExecution benchmark %s: %.0f instructions in %.2f ms, %.2f Minstr/s") % name % instructions % (1000.0f * time) % (instructions / time / 1e6));
+
+    return result;
+}
+
+/**
+ * Runs the original and the optimized program side by side, verifying that
+ * both produce the expected result. Throughput of the optimized program is
+ * reported in terms of the original instructions.
+ */
+static void runBenchmark(const string &name, const function<shared_ptr<ScriptProgram>(int &)> &build, IRoutineProvider *routines, int expected) {
+    int loopInstructionCount = 0;
+    auto original = build(loopInstructionCount);
+    auto optimized = build(loopInstructionCount);
+    int removedCount = ScriptOptimizer().optimize(*optimized);
+
+    BOOST_TEST(removedCount > 0);
+    BOOST_TEST(runBenchmark(name, original, routines, loopInstructionCount) == expected);
+    BOOST_TEST(runBenchmark(name + " (optimized)", optimized, routines, loopInstructionCount) == expected);
+}
+
+BOOST_AUTO_TEST_CASE(ScriptExecution_Benchmark_Loop) {
+    auto build = [](int &loopInstructionCount) {
+        return buildLoop(kIterationCount, [](ProgramBuilder &builder) {
+            builder.addStackOp(ByteCode::CopyTopSP, -4);
+        }, loopInstructionCount);
+    };
+    runBenchmark("loop", build, nullptr, 0);
+}
+
+BOOST_AUTO_TEST_CASE(ScriptExecution_Benchmark_Arithmetic) {
+    auto build = [](int &loopInstructionCount) {
+        return buildLoop(kIterationCount, [](ProgramBuilder &builder) {
+            // sum = (sum * 3 + i) % kModulus
+            builder.addStackOp(ByteCode::CopyTopSP, -4);
+            builder.addConstant(3);
+            builder.add(ByteCode::Multiply, InstructionType::IntInt, 2);
+            builder.addStackOp(ByteCode::CopyTopSP, -12);
+            builder.add(ByteCode::Add, InstructionType::IntInt, 2);
+            builder.addConstant(kModulus);
+            builder.add(ByteCode::Mod, InstructionType::IntInt, 2);
+        }, loopInstructionCount);
+    };
+
+    int expected = 0;
+    for (int i = 0; i < kIterationCount; ++i) {
+        expected = (expected * 3 + i) % kModulus;
+    }
+
+    runBenchmark("arithmetic", build, nullptr, expected);
+}
+
+BOOST_AUTO_TEST_CASE(ScriptExecution_Benchmark_RoutineCalls) {
+    BenchmarkRoutines routines;
+
+    auto build = [](int &loopInstructionCount) {
+        return buildLoop(kIterationCount, [](ProgramBuilder &builder) {
+            // sum = Add(sum, 1)
+            builder.addConstant(1);
+            builder.addStackOp(ByteCode::CopyTopSP, -8);
+            builder.addCallRoutine(0, 2);
+        }, loopInstructionCount);
+    };
+    runBenchmark("routine calls", build, &routines, kIterationCount);
+}
@@ -21,11 +21,16 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include "../../engine/script/argumentlist.h"
 #include "../../engine/script/execution.h"
 #include "../../engine/script/executioncontext.h"
 #include "../../engine/script/program.h"
+#include "../../engine/script/routine.h"
+#include "../../engine/script/routineprovider.h"
 #include "../../engine/script/variable.h"
 
+#include "programbuilder.h"
+
 using namespace std;
 
 using namespace reone::script;
@@ -118,3 +123,165 @@ BOOST_AUTO_TEST_CASE(ScriptExecution_CopyTopBp) {
     BOOST_TEST((execution.getStackVariable(4).intValue == 1));
     BOOST_TEST((execution.getStackVariable(5).intValue == 2));
 }
+
+BOOST_AUTO_TEST_CASE(ScriptExecution_PooledStackIsEmpty) {
+    Instruction instr;
+    auto program = make_shared<ScriptProgram>("");
+
+    instr.offset = 13;
+    instr.byteCode = ByteCode::PushConstant;
+    instr.type = InstructionType::Int;
+    instr.intValue = 42;
+    instr.nextOffset = instr.offset + 6;
+    program->add(instr);
+
+    program->setLength(instr.nextOffset);
+
+    for (int i = 0; i < 2; ++i) {
+        ScriptExecution execution(program, make_unique<ExecutionContext>());
+        int result = execution.run();
+
+        BOOST_TEST((result == 42));
+        BOOST_TEST((execution.getStackSize() == 1));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(ScriptExecution_CallRoutine) {
+    class TestRoutines : public IRoutineProvider {
+    public:
+        TestRoutines() {
+            _routine = Routine("Subtract", VariableType::Int, { VariableType::Int, VariableType::Int }, [](auto &args, auto &ctx) {
+                return Variable::ofInt(args[0].intValue - args[1].intValue);
+            });
+        }
+
+        const Routine &get(int index) override {
+            return _routine;
+        }
+
+    private:
+        Routine _routine;
+    } routines;
+
+    Instruction instr;
+    auto program = make_shared<ScriptProgram>("");
+
+    // Arguments are pushed in reverse order
+    instr.offset = 13;
+    instr.byteCode = ByteCode::PushConstant;
+    instr.type = InstructionType::Int;
+    instr.intValue = 2;
+    instr.nextOffset = instr.offset + 6;
+    program->add(instr);
+
+    instr.offset = instr.nextOffset;
+    instr.intValue = 5;
+    instr.nextOffset = instr.offset + 6;
+    program->add(instr);
+
+    instr.offset = instr.nextOffset;
+    instr.byteCode = ByteCode::CallRoutine;
+    instr.type = InstructionType::None;
+    instr.routine = 0;
+    instr.argCount = 2;
+    instr.nextOffset = instr.offset + 5;
+    program->add(instr);
+
+    program->setLength(instr.nextOffset);
+
+    auto context = make_unique<ExecutionContext>();
+    context->routines = &routines;
+    ScriptExecution execution(program, move(context));
+    int result = execution.run();
+
+    BOOST_TEST((result == 3));
+    BOOST_TEST((execution.getStackSize() == 1));
+    BOOST_TEST((routines.get(0).callCount() == 1));
+}
+
+BOOST_AUTO_TEST_CASE(ScriptExecution_RunAnotherProgram) {
+    vector<shared_ptr<ScriptProgram>> programs;
+    for (int value : { 3, 5 }) {
+        ProgramBuilder builder;
+        builder.addConstant(value);
+        builder.addConstant(value);
+        builder.add(ByteCode::Return, InstructionType::None, 2);
+        programs.push_back(builder.build());
+    }
+
+    ScriptExecution execution(programs[0], make_unique<ExecutionContext>());
+
+    BOOST_TEST((execution.run() == 3));
+    BOOST_TEST((execution.run(programs[1]) == 5));
+    BOOST_TEST((execution.getStackSize() == 2));
+}
+
+BOOST_AUTO_TEST_CASE(ScriptExecution_ResumeClosure) {
+    class TestRoutines : public IRoutineProvider {
+    public:
+        vector<Variable> actions;
+
+        TestRoutines() {
+            _routines.push_back(Routine("Capture", VariableType::Void, { VariableType::Action }, [this](auto &args, auto &ctx) {
+                actions.push_back(args[0]);
+                return Variable();
+            }));
+            _routines.push_back(Routine("GetCaller", VariableType::Int, { }, [](auto &args, auto &ctx) {
+                return Variable::ofInt(static_cast<int>(ctx.callerId));
+            }));
+        }
+
+        const Routine &get(int index) override {
+            return _routines[index];
+        }
+
+    private:
+        vector<Routine> _routines;
+    } routines;
+
+    // int a = 7; Capture(a + GetCaller()); Capture(a + GetCaller()); a = 9;
+    ProgramBuilder builder;
+    builder.addConstant(7);
+    builder.addStoreState(0, 4);
+    int skipClosure = builder.addJump(ByteCode::Jump);
+    builder.addStackOp(ByteCode::CopyTopSP, -4);
+    builder.addCallRoutine(1, 0);
+    builder.add(ByteCode::Add, InstructionType::IntInt, 2);
+    builder.add(ByteCode::Return, InstructionType::None, 2);
+    builder.setJumpTarget(skipClosure, builder.offset());
+    builder.addCallRoutine(0, 1);
+    builder.addCallRoutine(0, 1);
+    builder.addConstant(9);
+    builder.addStackOp(ByteCode::CopyDownSP, -8);
+    builder.addStackOp(ByteCode::AdjustSP, -4);
+    builder.add(ByteCode::Return, InstructionType::None, 2);
+    auto program = builder.build();
+
+    auto context = make_unique<ExecutionContext>();
+    context->routines = &routines;
+    context->callerId = 2;
+    ScriptExecution execution(program, move(context));
+    execution.run();
+
+    BOOST_TEST((execution.getStackSize() == 1));
+    BOOST_TEST((execution.getStackVariable(0).intValue == 9));
+    BOOST_TEST((routines.actions.size() == 2));
+
+    // Closures captured by the same STORE_STATE, and their copies, share a single frame
+    Variable copy(routines.actions[1]);
+    shared_ptr<ExecutionContext> first(routines.actions[0].context());
+    shared_ptr<ExecutionContext> second(routines.actions[1].context());
+    BOOST_TEST((first->savedState));
+    BOOST_TEST((first->savedState == second->savedState));
+    BOOST_TEST((copy.context()->savedState == first->savedState));
+    BOOST_TEST((first->savedState->locals.size() == 1));
+
+    // Frame is immutable: assignments after STORE_STATE are not visible to the closure
+    BOOST_TEST((ScriptExecution::resume(*first, 100) == 107));
+    BOOST_TEST((ScriptExecution::resume(*second, 200) == 207));
+    BOOST_TEST((first->callerId == 2));
+    BOOST_TEST((first->savedState->locals[0].intValue == 7));
+
+    ExecutionContext stateless;
+    BOOST_TEST((ScriptExecution::resume(stateless, 100) == -1));
+}
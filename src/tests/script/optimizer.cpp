@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2020-2021 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  Tests for ScriptOptimizer class.
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include "../../engine/script/execution.h"
+#include "../../engine/script/executioncontext.h"
+#include "../../engine/script/optimizer.h"
+#include "../../engine/script/program.h"
+#include "../../engine/script/variable.h"
+
+#include "programbuilder.h"
+
+using namespace std;
+
+using namespace reone::script;
+
+/**
+ * Runs the original and the optimized program side by side and verifies
+ * that their results and final stacks are identical.
+ *
+ * @return number of instructions removed by the optimizer
+ */
+static int verifyOptimization(const function<void(ProgramBuilder &)> &emit) {
+    ProgramBuilder originalBuilder;
+    emit(originalBuilder);
+    auto original = originalBuilder.build();
+
+    ProgramBuilder optimizedBuilder;
+    emit(optimizedBuilder);
+    auto optimized = optimizedBuilder.build();
+    int removedCount = ScriptOptimizer().optimize(*optimized);
+
+    ScriptExecution originalExecution(original, make_unique<ExecutionContext>());
+    ScriptExecution optimizedExecution(optimized, make_unique<ExecutionContext>());
+
+    BOOST_TEST((originalExecution.run() == optimizedExecution.run()));
+    BOOST_TEST((originalExecution.getStackSize() == optimizedExecution.getStackSize()));
+
+    for (int i = 0; i < originalExecution.getStackSize() && i < optimizedExecution.getStackSize(); ++i) {
+        const Variable &left = originalExecution.getStackVariable(i);
+        const Variable &right = optimizedExecution.getStackVariable(i);
+        BOOST_TEST((left.type == right.type));
+        BOOST_TEST((left.intValue == right.intValue));
+    }
+
+    return removedCount;
+}
+
+BOOST_AUTO_TEST_CASE(ScriptOptimizer_VariableDeclaration) {
+    int removedCount = verifyOptimization([](ProgramBuilder &builder) {
+        // int a = 5; int b = 7; int c = a + b;
+        for (int value : { 5, 7 }) {
+            builder.add(ByteCode::Reserve, InstructionType::Int, 2);
+            builder.addConstant(value);
+            builder.addStackOp(ByteCode::CopyDownSP, -8);
+            builder.addStackOp(ByteCode::AdjustSP, -4);
+        }
+        builder.add(ByteCode::Reserve, InstructionType::Int, 2);
+        builder.addStackOp(ByteCode::CopyTopSP, -12);
+        builder.addStackOp(ByteCode::CopyTopSP, -12);
+        builder.add(ByteCode::Add, InstructionType::IntInt, 2);
+        builder.addStackOp(ByteCode::CopyDownSP, -8);
+        builder.addStackOp(ByteCode::AdjustSP, -4);
+        builder.add(ByteCode::Return, InstructionType::None, 2);
+    });
+
+    BOOST_TEST((removedCount == 7));
+}
+
+BOOST_AUTO_TEST_CASE(ScriptOptimizer_CompareAndJump) {
+    for (ByteCode compare : { ByteCode::Equal, ByteCode::NotEqual, ByteCode::GreaterThanOrEqual, ByteCode::GreaterThan, ByteCode::LessThan, ByteCode::LessThanOrEqual }) {
+        for (int value : { 1, 2, 3 }) {
+            int removedCount = verifyOptimization([&](ProgramBuilder &builder) {
+                // if (value <op> 2) return 1; else return 0;
+                builder.addConstant(value);
+                builder.addConstant(2);
+                builder.add(compare, InstructionType::IntInt, 2);
+                int elseJump = builder.addJump(ByteCode::JumpIfZero);
+                builder.addConstant(1);
+                int endJump = builder.addJump(ByteCode::Jump);
+                builder.setJumpTarget(elseJump, builder.offset());
+                builder.addConstant(0);
+                builder.setJumpTarget(endJump, builder.offset());
+                builder.add(ByteCode::Return, InstructionType::None, 2);
+            });
+
+            BOOST_TEST((removedCount == 2));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(ScriptOptimizer_CompareAndJump_MismatchedTypes) {
+    // Comparison claims integer operands, but one of them is a float, whose intValue is zero
+    for (ByteCode compare : { ByteCode::Equal, ByteCode::NotEqual, ByteCode::LessThan, ByteCode::GreaterThanOrEqual }) {
+        for (bool constantRight : { false, true }) {
+            int removedCount = verifyOptimization([&](ProgramBuilder &builder) {
+                if (constantRight) {
+                    builder.addFloatConstant(0.5f);
+                    builder.addConstant(0);
+                } else {
+                    builder.addConstant(0);
+                    builder.addFloatConstant(0.5f);
+                }
+                builder.add(compare, InstructionType::IntInt, 2);
+                int elseJump = builder.addJump(ByteCode::JumpIfZero);
+                builder.addConstant(1);
+                int endJump = builder.addJump(ByteCode::Jump);
+                builder.setJumpTarget(elseJump, builder.offset());
+                builder.addConstant(0);
+                builder.setJumpTarget(endJump, builder.offset());
+                builder.add(ByteCode::Return, InstructionType::None, 2);
+            });
+
+            BOOST_TEST((removedCount == (constantRight ? 2 : 1)));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(ScriptOptimizer_JumpTargetIsNotFused) {
+    int removedCount = verifyOptimization([](ProgramBuilder &builder) {
+        // Jump into the middle of a fusable sequence
+        builder.addConstant(3);
+        int jump = builder.addJump(ByteCode::Jump);
+        builder.addStackOp(ByteCode::CopyDownSP, -4);
+        builder.setJumpTarget(jump, builder.offset());
+        builder.addStackOp(ByteCode::AdjustSP, -4);
+        builder.addConstant(4);
+        builder.add(ByteCode::Return, InstructionType::None, 2);
+    });
+
+    BOOST_TEST((removedCount == 0));
+}
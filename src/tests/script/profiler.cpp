@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2020-2021 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  Tests for ScriptProfiler class.
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include "../../engine/script/argumentlist.h"
+#include "../../engine/script/execution.h"
+#include "../../engine/script/executioncontext.h"
+#include "../../engine/script/profiler.h"
+#include "../../engine/script/program.h"
+#include "../../engine/script/routine.h"
+#include "../../engine/script/routineprovider.h"
+#include "../../engine/script/variable.h"
+
+using namespace std;
+
+using namespace reone::script;
+
+BOOST_AUTO_TEST_CASE(ScriptProfiler_CollapsedStacks) {
+    class TestRoutines : public IRoutineProvider {
+    public:
+        TestRoutines() {
+            _routine = Routine("Consume", VariableType::Void, { VariableType::Int }, [](auto &args, auto &ctx) {
+                return Variable();
+            });
+        }
+
+        const Routine &get(int index) override {
+            return _routine;
+        }
+
+    private:
+        Routine _routine;
+    } routines;
+
+    Instruction instr;
+    auto program = make_shared<ScriptProgram>("test");
+
+    instr.offset = 13;
+    instr.byteCode = ByteCode::JumpToSubroutine;
+    instr.jumpOffset = 21;
+    instr.nextOffset = instr.offset + 6;
+    program->add(instr);
+
+    instr.offset = instr.nextOffset;
+    instr.byteCode = ByteCode::Return;
+    instr.nextOffset = instr.offset + 2;
+    program->add(instr);
+
+    instr.offset = instr.nextOffset;
+    instr.byteCode = ByteCode::PushConstant;
+    instr.type = InstructionType::Int;
+    instr.intValue = 7;
+    instr.nextOffset = instr.offset + 6;
+    program->add(instr);
+
+    instr.offset = instr.nextOffset;
+    instr.byteCode = ByteCode::CallRoutine;
+    instr.type = InstructionType::None;
+    instr.routine = 0;
+    instr.argCount = 1;
+    instr.nextOffset = instr.offset + 5;
+    program->add(instr);
+
+    instr.offset = instr.nextOffset;
+    instr.byteCode = ByteCode::Return;
+    instr.nextOffset = instr.offset + 2;
+    program->add(instr);
+
+    program->setLength(instr.nextOffset);
+
+    ScriptProfiler profiler(16);
+    profiler.setEnabled(true);
+
+    auto context = make_unique<ExecutionContext>();
+    context->routines = &routines;
+    context->profiler = &profiler;
+    ScriptExecution(program, move(context)).run();
+
+    ostringstream out;
+    profiler.exportCollapsedStacks(out, true);
+
+    BOOST_TEST((out.str() == "test 2\ntest;test:sub_0015 3\n"));
+    BOOST_TEST((profiler.currentNode() == 0));
+    BOOST_TEST((profiler.getRecordCount() == 5));
+}
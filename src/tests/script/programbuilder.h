@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2020-2021 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "../../engine/script/program.h"
+
+namespace reone {
+
+namespace script {
+
+/**
+ * Appends instructions to a program, computing their offsets.
+ */
+class ProgramBuilder {
+public:
+    ProgramBuilder(const std::string &name = "test") : _program(std::make_shared<ScriptProgram>(name)) {
+    }
+
+    uint32_t offset() const { return _offset; }
+
+    void add(ByteCode byteCode, InstructionType type, uint32_t size) {
+        Instruction ins;
+        ins.byteCode = byteCode;
+        ins.type = type;
+        add(std::move(ins), size);
+    }
+
+    void addConstant(int value) {
+        Instruction ins;
+        ins.byteCode = ByteCode::PushConstant;
+        ins.type = InstructionType::Int;
+        ins.intValue = value;
+        add(std::move(ins), 6);
+    }
+
+    void addStringConstant(const std::string &value) {
+        Instruction ins;
+        ins.byteCode = ByteCode::PushConstant;
+        ins.type = InstructionType::String;
+        ins.strValue = value;
+        add(std::move(ins), 4 + static_cast<uint32_t>(value.size()));
+    }
+
+    void addFloatConstant(float value) {
+        Instruction ins;
+        ins.byteCode = ByteCode::PushConstant;
+        ins.type = InstructionType::Float;
+        ins.floatValue = value;
+        add(std::move(ins), 6);
+    }
+
+    void addStackOp(ByteCode byteCode, int stackOffset, uint16_t size = 4) {
+        Instruction ins;
+        ins.byteCode = byteCode;
+        ins.type = InstructionType::One;
+        ins.stackOffset = stackOffset;
+        ins.size = size;
+        add(std::move(ins), byteCode == ByteCode::CopyDownSP || byteCode == ByteCode::CopyTopSP ? 8 : 6);
+    }
+
+    /**
+     * @return index of the added instruction, to patch its target later
+     */
+    int addJump(ByteCode byteCode, uint32_t target = 0) {
+        Instruction ins;
+        ins.byteCode = byteCode;
+        ins.jumpOffset = static_cast<int>(target);
+        add(std::move(ins), 6);
+        return static_cast<int>(_instructions.size()) - 1;
+    }
+
+    void addCallRoutine(int routine, int argCount) {
+        Instruction ins;
+        ins.byteCode = ByteCode::CallRoutine;
+        ins.routine = routine;
+        ins.argCount = argCount;
+        add(std::move(ins), 5);
+    }
+
+    /**
+     * Adds STORE_STATE, whose closure starts right after the following jump.
+     */
+    void addStoreState(uint16_t sizeGlobals, int sizeLocals) {
+        Instruction ins;
+        ins.byteCode = ByteCode::StoreState;
+        ins.type = static_cast<InstructionType>(16);
+        ins.size = sizeGlobals;
+        ins.sizeLocals = sizeLocals;
+        add(std::move(ins), 10);
+    }
+
+    void setJumpTarget(int index, uint32_t target) {
+        _instructions[index].jumpOffset = static_cast<int>(target);
+    }
+
+    std::shared_ptr<ScriptProgram> build() {
+        for (auto &ins : _instructions) {
+            _program->add(ins);
+        }
+        _program->setLength(_offset);
+        _program->link();
+        return _program;
+    }
+
+    int instructionCount() const { return static_cast<int>(_instructions.size()); }
+
+private:
+    std::shared_ptr<ScriptProgram> _program;
+    std::vector<Instruction> _instructions;
+    uint32_t _offset { 13 };
+
+    void add(Instruction ins, uint32_t size) {
+        ins.offset = _offset;
+        ins.nextOffset = _offset + size;
+        _offset = ins.nextOffset;
+        _instructions.push_back(std::move(ins));
+    }
+};
+
+} // namespace script
+
+} // namespace reone
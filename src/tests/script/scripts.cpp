@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2020-2021 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+/** @file
+ *  Tests for Scripts class.
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include "../../engine/common/threadpool.h"
+#include "../../engine/resource/resources.h"
+#include "../../engine/script/program.h"
+#include "../../engine/script/scripts.h"
+
+using namespace std;
+
+using namespace reone;
+using namespace reone::resource;
+using namespace reone::script;
+
+namespace fs = boost::filesystem;
+
+static constexpr int kScriptCount = 16;
+
+/**
+ * @return NCS file of a script program, consisting of the specified instructions
+ */
+static ByteArray newNcs(const ByteArray &instructions) {
+    uint32_t length = 13 + static_cast<uint32_t>(instructions.size());
+    ByteArray ncs { 'N', 'C', 'S', ' ', 'V', '1', '.', '0', 0x42 };
+    for (int i = 3; i >= 0; --i) {
+        ncs.push_back(static_cast<char>((length >> (8 * i)) & 0xff));
+    }
+    ncs.insert(ncs.end(), instructions.begin(), instructions.end());
+    return move(ncs);
+}
+
+/**
+ * Scripts are read from a temporary directory.
+ */
+struct ScriptsFixture {
+    fs::path dir { fs::temp_directory_path() / fs::unique_path() };
+    Resources resources;
+    vector<string> resRefs;
+
+    ScriptsFixture() {
+        fs::create_directories(dir);
+        for (int i = 0; i < kScriptCount; ++i) {
+            resRefs.push_back("script_" + to_string(i));
+            writeFile(resRefs.back() + ".ncs", newNcs({ 0x20, 0x00 })); // RETN
+        }
+        writeFile("script_bad.ncs", newNcs({ 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04 })); // CPDOWNSP without RETN
+        resources.indexDirectory(dir);
+    }
+
+    ~ScriptsFixture() {
+        fs::remove_all(dir);
+    }
+
+    void writeFile(const string &filename, const ByteArray &data) {
+        fs::ofstream out(dir / filename, ios::binary);
+        out.write(&data[0], data.size());
+    }
+};
+
+BOOST_FIXTURE_TEST_CASE(Scripts_Precompile_CachesValidScripts, ScriptsFixture) {
+    ThreadPool threadPool(4);
+    Scripts scripts(resources);
+    vector<string> precompiled(resRefs);
+    precompiled.push_back("script_bad");
+    precompiled.push_back("script_missing");
+
+    scripts.precompile(precompiled, threadPool);
+
+    BOOST_TEST(scripts.waitPrecompiled() == kScriptCount);
+    for (auto &resRef : resRefs) {
+        BOOST_TEST(scripts.get(resRef));
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE(Scripts_Get_DoesNotWaitForQueuedScripts, ScriptsFixture) {
+    ThreadPool threadPool(1);
+    promise<void> release;
+    shared_future<void> released(release.get_future());
+    future<void> busy(threadPool.enqueue([released]() { released.wait(); }));
+    {
+        Scripts scripts(resources);
+        scripts.precompile(resRefs, threadPool);
+
+        BOOST_TEST(scripts.get(resRefs.back()));
+
+        release.set_value();
+    }
+    busy.get();
+}
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2020-2021 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  Tests for ScriptValidator class.
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include "../../engine/script/program.h"
+#include "../../engine/script/routine.h"
+#include "../../engine/script/routineprovider.h"
+#include "../../engine/script/validator.h"
+#include "../../engine/script/variable.h"
+
+#include "programbuilder.h"
+
+using namespace std;
+
+using namespace reone::script;
+
+namespace {
+
+class TestRoutines : public IRoutineProvider {
+public:
+    TestRoutines() : _routine("Negate", VariableType::Int, { VariableType::Int }) {
+    }
+
+    const Routine &get(int index) override {
+        return _routine;
+    }
+
+private:
+    Routine _routine;
+};
+
+} // namespace
+
+/**
+ * Emits a program that calls a subroutine, which pushes one of two constants,
+ * depending on a condition, passes it to a routine and discards the result.
+ */
+static shared_ptr<ScriptProgram> buildProgram(bool balanced) {
+    ProgramBuilder builder;
+    int callSub = builder.addJump(ByteCode::JumpToSubroutine);
+    builder.add(ByteCode::Return, InstructionType::None, 2);
+
+    builder.setJumpTarget(callSub, builder.offset());
+    builder.addConstant(1);
+    int jumpElse = builder.addJump(ByteCode::JumpIfZero);
+    builder.addConstant(2);
+    int jumpEnd = builder.addJump(ByteCode::Jump);
+    builder.setJumpTarget(jumpElse, builder.offset());
+    if (balanced) {
+        builder.addConstant(3);
+    }
+    builder.setJumpTarget(jumpEnd, builder.offset());
+    builder.addCallRoutine(0, 1);
+    builder.addStackOp(ByteCode::AdjustSP, -4);
+    builder.add(ByteCode::Return, InstructionType::None, 2);
+
+    return builder.build();
+}
+
+BOOST_AUTO_TEST_CASE(ScriptValidator_BalancedProgram) {
+    TestRoutines routines;
+    auto program = buildProgram(true);
+
+    BOOST_CHECK_NO_THROW(ScriptValidator(&routines).validate(*program));
+    BOOST_CHECK_NO_THROW(ScriptValidator().validate(*program));
+}
+
+BOOST_AUTO_TEST_CASE(ScriptValidator_InconsistentStackDepth) {
+    TestRoutines routines;
+    auto program = buildProgram(false);
+
+    BOOST_CHECK_THROW(ScriptValidator(&routines).validate(*program), runtime_error);
+
+    // Without routine signatures, stack balance of the subroutine is unknown
+    BOOST_CHECK_NO_THROW(ScriptValidator().validate(*program));
+}
+
+BOOST_AUTO_TEST_CASE(ScriptValidator_InvalidControlFlow) {
+    ProgramBuilder underflowBuilder;
+    underflowBuilder.addStackOp(ByteCode::AdjustSP, -4);
+    underflowBuilder.add(ByteCode::Return, InstructionType::None, 2);
+    auto underflow = underflowBuilder.build();
+
+    BOOST_CHECK_THROW(ScriptValidator().validate(*underflow), runtime_error);
+
+    ProgramBuilder fallOffBuilder;
+    fallOffBuilder.addConstant(1);
+    auto fallOff = fallOffBuilder.build();
+
+    BOOST_CHECK_THROW(ScriptValidator().validate(*fallOff), runtime_error);
+}
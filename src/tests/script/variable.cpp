@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2020-2021 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/** @file
+ *  Tests for Variable struct.
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include "../../engine/script/enginetype.h"
+#include "../../engine/script/variable.h"
+
+using namespace std;
+
+using namespace reone::script;
+
+BOOST_AUTO_TEST_CASE(Variable_StringsAreInterned) {
+    Variable first(Variable::ofString("Hello"));
+    Variable second(Variable::ofString("Hello"));
+    Variable third(Variable::ofString("World"));
+
+    BOOST_TEST((first.handle == second.handle));
+    BOOST_TEST((first == second));
+    BOOST_TEST((first != third));
+    BOOST_TEST((Variable::ofString("") == Variable::ofString(string())));
+}
+
+BOOST_AUTO_TEST_CASE(Variable_StringOutlivesCopies) {
+    Variable copy;
+    {
+        Variable original(Variable::ofString("Hello"));
+        copy = original;
+        Variable moved(move(original));
+        BOOST_TEST((original.type == VariableType::Void));
+    }
+    BOOST_TEST((copy.strValue() == "Hello"));
+    BOOST_TEST(((copy + Variable::ofString(", World")).strValue() == "Hello, World"));
+}
+
+BOOST_AUTO_TEST_CASE(Variable_EngineTypeIsReleased) {
+    auto engineType = make_shared<EngineType>();
+    {
+        Variable effect(Variable::ofEffect(engineType));
+        Variable copy(effect);
+        BOOST_TEST((copy.engineType() == engineType));
+        BOOST_TEST((engineType.use_count() == 2l));
+    }
+    BOOST_TEST((engineType.use_count() == 1l));
+}
@@ -17,10 +17,15 @@
 
 #include "tools.h"
 
+#include "../engine/audio/format/mp3reader.h"
+#include "../engine/audio/format/wavreader.h"
+#include "../engine/audio/stream.h"
 #include "../engine/common/streamreader.h"
 
 using namespace std;
 
+using namespace reone::audio;
+
 namespace fs = boost::filesystem;
 
 namespace reone {
@@ -28,8 +33,15 @@ namespace reone {
 namespace tools {
 
 void AudioTool::invoke(Operation operation, const fs::path &target, const fs::path &gamePath, const fs::path &destPath) {
-    if (operation == Operation::Unwrap) {
-        unwrap(target, destPath);
+    switch (operation) {
+        case Operation::Unwrap:
+            unwrap(target, destPath);
+            break;
+        case Operation::Benchmark:
+            benchmark(target);
+            break;
+        default:
+            break;
     }
 }
 
@@ -77,11 +89,82 @@ void AudioTool::unwrap(const fs::path &path, const fs::path &destPath) {
     unwrapped.write(&data[0], data.size());
 }
 
+struct DecodeStats {
+    int fileCount { 0 };
+    int failedCount { 0 };
+    size_t inputSize { 0 };
+    size_t outputSize { 0 };
+    double audioDuration { 0.0 };
+    double decodeTime { 0.0 };
+};
+
+void AudioTool::benchmark(const fs::path &path) {
+    map<string, DecodeStats> statsByExt;
+    AudioStream::Frame frame;
+
+    for (auto &entry : fs::recursive_directory_iterator(path)) {
+        if (!fs::is_regular_file(entry.path())) continue;
+
+        string ext(boost::to_lower_copy(entry.path().extension().string()));
+        if (ext != ".wav" && ext != ".mp3") continue;
+
+        DecodeStats &stats = statsByExt[ext];
+        ++stats.fileCount;
+
+        auto data = make_shared<ByteArray>(fs::file_size(entry.path()));
+        fs::ifstream in(entry.path(), ios::binary);
+        in.read(&(*data)[0], data->size());
+
+        try {
+            auto start = chrono::steady_clock::now();
+
+            shared_ptr<AudioStream> stream;
+            if (ext == ".mp3") {
+                Mp3Reader mp3;
+                mp3.load(data);
+                stream = mp3.stream();
+            } else {
+                WavReader wav;
+                wav.load(data);
+                stream = wav.stream();
+            }
+            unique_ptr<IAudioDecoder> decoder(stream->createDecoder());
+            size_t outputSize = 0;
+            while (decoder->decode(frame)) {
+                outputSize += frame.samples.size();
+            }
+
+            stats.decodeTime += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+            stats.inputSize += data->size();
+            stats.outputSize += outputSize;
+            stats.audioDuration += stream->duration();
+        } catch (const exception &e) {
+            cout << entry.path().string() << ": " << e.what() << endl;
+            ++stats.failedCount;
+        }
+    }
+
+    for (auto &pair : statsByExt) {
+        const DecodeStats &stats = pair.second;
+        double inputMb = stats.inputSize / 1048576.0;
+        double outputMb = stats.outputSize / 1048576.0;
+        double decodeTime = max(stats.decodeTime, 1e-6);
+
+        cout << boost::format("%s: %d files, %d failed") % pair.first % stats.fileCount % stats.failedCount << endl;
+        cout << boost::format("  %.1f MB in, %.1f MB of PCM out, %.1f s of audio decoded in %.3f s") % inputMb % outputMb % stats.audioDuration % stats.decodeTime << endl;
+        cout << boost::format("  %.1f MB/s of PCM, %.0fx real time") % (outputMb / decodeTime) % (stats.audioDuration / decodeTime) << endl;
+    }
+}
+
 bool AudioTool::supports(Operation operation, const fs::path &target) const {
-    return
-        !fs::is_directory(target) &&
-        target.extension() == ".wav" &&
-        operation == Operation::Unwrap;
+    switch (operation) {
+        case Operation::Unwrap:
+            return !fs::is_directory(target) && target.extension() == ".wav";
+        case Operation::Benchmark:
+            return fs::is_directory(target);
+        default:
+            return false;
+    }
 }
 
 } // namespace tools
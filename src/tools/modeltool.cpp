@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2020-2021 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "tools.h"
+
+#include "../engine/graphics/context.h"
+#include "../engine/graphics/model/mdlreader.h"
+#include "../engine/graphics/model/models.h"
+#include "../engine/graphics/texture/textures.h"
+#include "../engine/resource/resources.h"
+
+using namespace std;
+
+using namespace reone::graphics;
+using namespace reone::resource;
+
+namespace fs = boost::filesystem;
+
+namespace reone {
+
+namespace tools {
+
+static constexpr int kNumSlowestModels = 5;
+
+void ModelTool::invoke(Operation operation, const fs::path &target, const fs::path &gamePath, const fs::path &destPath) {
+    if (operation == Operation::BenchmarkModels) {
+        benchmark(target);
+    }
+}
+
+static ByteArray readFile(const fs::path &path) {
+    ByteArray result(fs::file_size(path));
+    fs::ifstream in(path, ios::binary);
+    in.read(&result[0], result.size());
+    return move(result);
+}
+
+struct ModelFile {
+    string resRef;
+    ByteArray mdl;
+    ByteArray mdx;
+    double parseTime { 0.0 };
+};
+
+void ModelTool::benchmark(const fs::path &path) {
+    vector<ModelFile> files;
+    for (auto &entry : fs::recursive_directory_iterator(path)) {
+        fs::path mdlPath(entry.path());
+        if (!fs::is_regular_file(mdlPath) || boost::to_lower_copy(mdlPath.extension().string()) != ".mdl") continue;
+
+        fs::path mdxPath(mdlPath);
+        mdxPath.replace_extension(".mdx");
+        if (!fs::exists(mdxPath)) continue;
+
+        ModelFile file;
+        file.resRef = boost::to_lower_copy(mdlPath.stem().string());
+        file.mdl = readFile(mdlPath);
+        file.mdx = readFile(mdxPath);
+        files.push_back(move(file));
+    }
+
+    // Headless Models resolve supermodels and referenced models from the
+    // target directory. Loading every model once beforehand keeps both
+    // I/O and supermodel parsing out of the measurement.
+    Resources resources;
+    resources.indexDirectory(path);
+    Context context;
+    Textures textures(context, resources, true);
+    Models models(textures, resources, true);
+    for (auto &file : files) {
+        try {
+            models.load(file.resRef);
+        } catch (const exception &) {
+            // Reported by the timed pass below
+        }
+    }
+
+    int failedCount = 0;
+    size_t inputSize = 0;
+    double parseTime = 0.0;
+
+    for (auto &file : files) {
+        try {
+            auto start = chrono::steady_clock::now();
+
+            MdlReader mdl(models, textures);
+            mdl.load(file.mdl, file.mdx);
+
+            file.parseTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+            parseTime += file.parseTime;
+            inputSize += file.mdl.size() + file.mdx.size();
+        } catch (const exception &e) {
+            cout << file.resRef << ": " << e.what() << endl;
+            ++failedCount;
+        }
+    }
+
+    double inputMb = inputSize / 1048576.0;
+    double time = max(parseTime, 1e-6);
+    int parsedCount = static_cast<int>(files.size()) - failedCount;
+
+    cout << boost::format("%d models, %d failed") % files.size() % failedCount << endl;
+    cout << boost::format("  %.1f MB of MDL and MDX parsed in %.3f s") % inputMb % parseTime << endl;
+    cout << boost::format("  %.1f MB/s, %.0f models/s") % (inputMb / time) % (parsedCount / time) << endl;
+
+    sort(files.begin(), files.end(), [](auto &left, auto &right) { return left.parseTime > right.parseTime; });
+    cout << "Slowest models:" << endl;
+    for (int i = 0; i < kNumSlowestModels && i < parsedCount; ++i) {
+        const ModelFile &file = files[i];
+        double sizeKb = (file.mdl.size() + file.mdx.size()) / 1024.0;
+        cout << boost::format("  %s: %.1f KB in %.3f ms") % file.resRef % sizeKb % (1000.0 * file.parseTime) << endl;
+    }
+}
+
+bool ModelTool::supports(Operation operation, const fs::path &target) const {
+    return operation == Operation::BenchmarkModels && fs::is_directory(target);
+}
+
+} // namespace tools
+
+} // namespace reone
@@ -49,7 +49,10 @@ static const unordered_map<string, Operation> g_operations {
     { "to-pth", Operation::ToPTH },
     { "to-ascii", Operation::ToASCII },
     { "to-tlk", Operation::ToTLK },
-    { "to-lip", Operation::ToLIP }
+    { "to-lip", Operation::ToLIP },
+    { "validate", Operation::Validate },
+    { "benchmark", Operation::Benchmark },
+    { "benchmark-models", Operation::BenchmarkModels }
 };
 
 Program::Program(int argc, char **argv) : _argc(argc), _argv(argv) {
@@ -96,6 +99,9 @@ void Program::initOptions() {
         ("to-ascii", "convert binary PTH to ASCII")
         ("to-tlk", "convert JSON to TLK")
         ("to-lip", "convert JSON to LIP")
+        ("validate", "decode and validate all scripts of the game")
+        ("benchmark", "measure decoding throughput of WAV and MP3 files in target directory")
+        ("benchmark-models", "measure parsing throughput of models in target directory")
         ("target", po::value<string>(), "target name or path to input file");
 }
 
@@ -151,7 +157,9 @@ void Program::loadTools() {
     _tools.push_back(make_shared<GffTool>());
     _tools.push_back(make_shared<TpcTool>());
     _tools.push_back(make_shared<PthTool>());
+    _tools.push_back(make_shared<ModelTool>());
     _tools.push_back(make_shared<AudioTool>());
+    _tools.push_back(make_shared<ScriptTool>());
 }
 
 shared_ptr<ITool> Program::getTool() const {
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2020-2021 The reone project contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "tools.h"
+
+#include "../engine/common/pathutil.h"
+#include "../engine/common/threadpool.h"
+#include "../engine/resource/folder.h"
+#include "../engine/resource/keybifprovider.h"
+#include "../engine/script/program.h"
+#include "../engine/script/scripts.h"
+
+using namespace std;
+
+using namespace reone::resource;
+using namespace reone::script;
+
+namespace fs = boost::filesystem;
+
+namespace reone {
+
+namespace tools {
+
+static constexpr char kKeyFilename[] = "chitin.key";
+static constexpr char kModulesDirectoryName[] = "modules";
+static constexpr char kOverrideDirectoryName[] = "override";
+
+void ScriptTool::invoke(Operation operation, const fs::path &target, const fs::path &gamePath, const fs::path &destPath) {
+    if (operation == Operation::Validate) {
+        validate(gamePath);
+    }
+}
+
+void ScriptTool::validate(const fs::path &gamePath) {
+    vector<Script> scripts;
+
+    auto readStart = chrono::steady_clock::now();
+
+    fs::path keyPath(getPathIgnoreCase(gamePath, kKeyFilename, false));
+    if (!keyPath.empty()) {
+        KeyBifResourceProvider keyBif;
+        keyBif.init(keyPath);
+        appendScripts(kKeyFilename, keyBif, scripts);
+    }
+    fs::path modulesPath(getPathIgnoreCase(gamePath, kModulesDirectoryName, false));
+    if (!modulesPath.empty()) {
+        for (auto &entry : fs::directory_iterator(modulesPath)) {
+            fs::path path(entry.path());
+            string ext(boost::to_lower_copy(path.extension().string()));
+            if (ext == ".rim") {
+                RimReader rim;
+                rim.load(path);
+                appendScripts(path.filename().string(), rim, scripts);
+            } else if (ext == ".mod" || ext == ".erf") {
+                ErfReader erf;
+                erf.load(path);
+                appendScripts(path.filename().string(), erf, scripts);
+            }
+        }
+    }
+    fs::path overridePath(getPathIgnoreCase(gamePath, kOverrideDirectoryName, false));
+    if (!overridePath.empty()) {
+        Folder folder;
+        folder.load(overridePath);
+        appendScripts(kOverrideDirectoryName, folder, scripts);
+    }
+
+    float readTime = chrono::duration<float>(chrono::steady_clock::now() - readStart).count();
+    int count = static_cast<int>(scripts.size());
+    vector<string> errors(count);
+    vector<int> instructionCounts(count, 0);
+
+    auto compileStart = chrono::steady_clock::now();
+
+    // Routine signatures are not available outside of the game, so stack
+    // balance is only checked for subroutines that do not call routines
+    ThreadPool threadPool;
+    threadPool.parallelFor(count, [&](int i) {
+        try {
+            shared_ptr<ScriptProgram> program(Scripts::compile(scripts[i].resRef, scripts[i].data));
+            instructionCounts[i] = static_cast<int>(program->instructions().size());
+        } catch (const exception &ex) {
+            errors[i] = ex.what();
+        }
+    });
+
+    float compileTime = chrono::duration<float>(chrono::steady_clock::now() - compileStart).count();
+    int failedCount = 0;
+    int instructionCount = 0;
+
+    for (int i = 0; i < count; ++i) {
+        if (!errors[i].empty()) {
+            cout << scripts[i].source << " " << scripts[i].resRef << ": " << errors[i] << endl;
+            ++failedCount;
+        }
+        instructionCount += instructionCounts[i];
+    }
+
+    cout << boost::format("Validated %d scripts, %d failed") % count % failedCount << endl;
+    cout << boost::format("Read in %.3f s, compiled %d instructions in %.3f s using %d threads") % readTime % instructionCount % compileTime % (threadPool.threadCount() + 1) << endl;
+}
+
+void ScriptTool::appendScripts(const string &source, IResourceProvider &provider, vector<Script> &scripts) {
+    for (auto &resRef : provider.getResRefs(ResourceType::Ncs)) {
+        shared_ptr<ByteArray> data(provider.find(resRef, ResourceType::Ncs));
+        if (!data) continue;
+
+        Script script;
+        script.source = source;
+        script.resRef = resRef;
+        script.data = move(data);
+        scripts.push_back(move(script));
+    }
+}
+
+bool ScriptTool::supports(Operation operation, const fs::path &target) const {
+    return operation == Operation::Validate;
+}
+
+} // namespace tools
+
+} // namespace reone
@@ -172,6 +172,30 @@ class AudioTool : public ITool {
 
 private:
     void unwrap(const boost::filesystem::path &path, const boost::filesystem::path &destPath);
+
+    /**
+     * Decodes every WAV and MP3 file in the directory, recursively, and
+     * reports decoding throughput per format.
+     */
+    void benchmark(const boost::filesystem::path &path);
+};
+
+class ModelTool : public ITool {
+public:
+    void invoke(
+        Operation operation,
+        const boost::filesystem::path &target,
+        const boost::filesystem::path &gamePath,
+        const boost::filesystem::path &destPath) override;
+
+    bool supports(Operation operation, const boost::filesystem::path &target) const override;
+
+private:
+    /**
+     * Parses every MDL and MDX pair in the directory, recursively, and
+     * reports parsing throughput.
+     */
+    void benchmark(const boost::filesystem::path &path);
 };
 
 class LipTool : public ITool {
@@ -189,6 +213,31 @@ private:
     void toLIP(const boost::filesystem::path &path, const boost::filesystem::path &destPath);
 };
 
+class ScriptTool : public ITool {
+public:
+    void invoke(
+        Operation operation,
+        const boost::filesystem::path &target,
+        const boost::filesystem::path &gamePath,
+        const boost::filesystem::path &destPath) override;
+
+    bool supports(Operation operation, const boost::filesystem::path &target) const override;
+
+private:
+    struct Script {
+        std::string source; /**< name of the file that contains this script */
+        std::string resRef;
+        std::shared_ptr<ByteArray> data;
+    };
+
+    /**
+     * Decodes and validates all scripts of the game installation in parallel.
+     */
+    void validate(const boost::filesystem::path &gamePath);
+
+    void appendScripts(const std::string &source, resource::IResourceProvider &provider, std::vector<Script> &scripts);
+};
+
 } // namespace tools
 
 } // namespace reone
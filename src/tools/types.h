@@ -36,7 +36,10 @@ enum class Operation {
     ToPTH,
     ToASCII,
     ToTLK,
-    ToLIP
+    ToLIP,
+    Validate,
+    Benchmark,
+    BenchmarkModels
 };
 
 } // namespace tools